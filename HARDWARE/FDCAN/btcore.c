@@ -0,0 +1,70 @@
+#include "btcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//CANλʱ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+const _bt_limits bt_fdcan_nominal={512,2,256,2,128,128};
+const _bt_limits bt_fdcan_data={32,1,32,1,16,16};
+
+//λʱ
+//clk:ںʱ(Hz)
+//bitrate:(bit/s)
+//sp:(0.1%),875Ϊ87.5%
+//lim:ĴȡֵΧ,bt_fdcan_nominalbt_fdcan_data
+//t:,1ʱҲСһ
+//ֵ:0,ɹ;1,BT_TOL_PPM;2,ûκοõ
+uint8_t bt_solve(uint32_t clk,uint32_t bitrate,uint16_t sp,const _bt_limits *lim,_bt_timing *t)
+{
+	uint32_t presc,n,nmin,nmax,div,diff,ppm,best_ppm=0xFFFFFFFF;
+	uint32_t s1,s2,spe,best_spe=0xFFFFFFFF;
+	uint8_t k;
+	if(bitrate==0||clk<bitrate||sp==0||sp>=1000)return 2;
+	nmin=1+lim->tseg1_min+lim->tseg2_min;
+	nmax=1+lim->tseg1_max+lim->tseg2_max;
+	for(presc=1;presc<=lim->presc_max;presc++)
+	{
+		n=clk/presc/bitrate;							//ÿλtq,ȡȡ
+		if(n+1<nmin)break;								//Ƶٴtq
+		for(k=0;k<2;k++,n++)
+		{
+			if(n<nmin||n>nmax)continue;
+			div=presc*n;
+			diff=clk>div*bitrate?clk-div*bitrate:div*bitrate-clk;
+			ppm=diff?(uint32_t)((uint64_t)diff*1000000/((uint64_t)div*bitrate)):0;
+			if(ppm>best_ppm)continue;
+			//:1+tseg1=n*sp/1000,ȡֵΧ
+			s2=n-(n*sp+500)/1000;
+			if(s2<lim->tseg2_min)s2=lim->tseg2_min;
+			if(s2>lim->tseg2_max)s2=lim->tseg2_max;
+			s1=n-1-s2;
+			if(s1<lim->tseg1_min)
+			{
+				s1=lim->tseg1_min;
+				s2=n-1-s1;
+			}
+			if(s1>lim->tseg1_max)
+			{
+				s1=lim->tseg1_max;
+				s2=n-1-s1;
+			}
+			if(s2<lim->tseg2_min||s2>lim->tseg2_max)continue;
+			spe=(1+s1)*10000/n;							//Ƚʱ0.01%
+			spe=spe>sp*10u?spe-sp*10u:sp*10u-spe;
+			if(ppm==best_ppm&&spe>=best_spe)continue;	//ƵС,ͬʱƵС
+			best_ppm=ppm;
+			best_spe=spe;
+			t->presc=presc;
+			t->tseg1=s1;
+			t->tseg2=s2;
+			t->sjw=s2<lim->sjw_max?s2:lim->sjw_max;
+			t->bitrate=clk/div;
+			t->err_ppm=ppm;
+			t->sp=(1+s1)*1000/n;
+		}
+		if(best_ppm==0&&best_spe==0)break;				//Ѿ,ƵٴҲ
+	}
+	if(best_ppm==0xFFFFFFFF)return 2;
+	return best_ppm>BT_TOL_PPM?1:0;
+}
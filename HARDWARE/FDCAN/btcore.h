@@ -0,0 +1,44 @@
+#ifndef _BTCORE_H
+#define _BTCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CANλʱ:ںʱӡʺͲƵʱ
+//ֻñ׼C,HALFDCAN,PCϲ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//һλ=(1+tseg1+tseg2)ʱݶ(tq),tq=presc/ںʱ,ڵ1+tseg1tqĩβ
+//зƵ:С,βӽҪ,ηƵС(ÿλtq,ͬ,CiA 601-3Ľ)
+//SJWȡtseg2(),ݶκٲöηֿ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define BT_TOL_PPM				1000	//ֵ(ppm)Ϊûпõλʱ
+
+//λʱĴȡֵΧ
+typedef struct
+{
+	uint16_t presc_max;			//Ƶ1~presc_max
+	uint16_t tseg1_min;
+	uint16_t tseg1_max;
+	uint8_t tseg2_min;
+	uint8_t tseg2_max;
+	uint8_t sjw_max;
+}_bt_limits;
+
+//
+typedef struct
+{
+	uint16_t presc;				//Ƶ
+	uint16_t tseg1;				//+λ1(tq)
+	uint8_t tseg2;				//λ2(tq)
+	uint8_t sjw;				//ͬԾ(tq)
+	uint32_t bitrate;			//ʵʲ(ȡ)
+	uint32_t err_ppm;			//(ppm)
+	uint16_t sp;				//ʵʲ(0.1%)
+}_bt_timing;
+
+extern const _bt_limits bt_fdcan_nominal;	//STM32H7 FDCANٲö:Ƶ1~512,tseg1 2~256,tseg2 2~128,sjw 1~128
+extern const _bt_limits bt_fdcan_data;		//STM32H7 FDCANݶ:Ƶ1~32,tseg1 1~32,tseg2 1~16,sjw 1~16
+
+uint8_t bt_solve(uint32_t clk,uint32_t bitrate,uint16_t sp,const _bt_limits *lim,_bt_timing *t);	//λʱ,0ɹ,1BT_TOL_PPM,2
+#endif
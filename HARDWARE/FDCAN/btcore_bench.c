@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////////
+//bt_solveٶ,Keil,TOOLS/hosttest.sh bench:
+//gcc -O2 -IHARDWARE/FDCAN HARDWARE/FDCAN/btcore_bench.c HARDWARE/FDCAN/btcore.c
+//ֱзƵ/tseg1/tseg2Ƚ,ÿʱ(us);btcore_test.c
+//////////////////////////////////////////////////////////////////////////////////
+#include "btcore.h"
+#include <stdio.h>
+#include <time.h>
+
+typedef struct
+{
+	const char *name;
+	uint32_t clk,bitrate;
+	uint16_t sp;
+	const _bt_limits *lim;
+}_bench_case;
+
+static const _bench_case cases[4]=
+{
+	{"nominal 500K",200000000,500000,800,&bt_fdcan_nominal},
+	{"nominal 83.3K",200000000,83333,875,&bt_fdcan_nominal},
+	{"nominal 10K",80000000,10000,875,&bt_fdcan_nominal},
+	{"data 2M",200000000,2000000,750,&bt_fdcan_data},
+};
+static volatile uint32_t sink;
+
+//:С,βС,ηƵС
+static uint32_t brute(uint32_t clk,uint32_t br,uint16_t sp,const _bt_limits *l)
+{
+	uint32_t p,s1,s2,n,ppm,spe,bppm=0xFFFFFFFF,bspe=0xFFFFFFFF,bp=0;
+	uint64_t r,d;
+	for(p=1;p<=l->presc_max;p++)
+		for(s1=l->tseg1_min;s1<=l->tseg1_max;s1++)
+			for(s2=l->tseg2_min;s2<=l->tseg2_max;s2++)
+			{
+				n=1+s1+s2;
+				r=(uint64_t)p*n*br;
+				d=clk>r?clk-r:r-clk;
+				ppm=(uint32_t)(d*1000000/r);
+				spe=(1+s1)*10000/n;
+				spe=spe>sp*10u?spe-sp*10u:sp*10u-spe;
+				if(ppm<bppm||(ppm==bppm&&spe<bspe))
+				{
+					bppm=ppm;
+					bspe=spe;
+					bp=p;
+				}
+			}
+	return bp;
+}
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec*1e6+ts.tv_nsec/1e3;
+}
+
+int main(void)
+{
+	const _bench_case *c;
+	_bt_timing t;
+	double t0,solve,full;
+	int i,k,n;
+	for(i=0;i<4;i++)
+	{
+		c=&cases[i];
+		n=20000;
+		t0=now_us();
+		for(k=0;k<n;k++)sink+=bt_solve(c->clk,c->bitrate,c->sp,c->lim,&t);
+		solve=(now_us()-t0)/n;
+		n=c->lim==&bt_fdcan_data?2000:3;
+		t0=now_us();
+		for(k=0;k<n;k++)sink+=brute(c->clk,c->bitrate,c->sp,c->lim);
+		full=(now_us()-t0)/n;
+		printf("btcore bench: %-14s bt_solve %7.2f us, brute force %9.0f us (%.0fx)\n",c->name,solve,full,full/solve);
+	}
+	return 0;
+}
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////////
+//btcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -IHARDWARE/FDCAN HARDWARE/FDCAN/btcore_test.c HARDWARE/FDCAN/btcore.c
+//4ںʱӡ10ٲöβʡ4,4ںʱӡ5ݶβʡ4,240,
+//зƵ/tseg1/tseg2ĽȽ:ƵҪͬ;ټڼĴΧڡ
+//ٶȼbtcore_bench.c
+//////////////////////////////////////////////////////////////////////////////////
+#include "btcore.h"
+#include <stdio.h>
+
+#define CHECK(c)	do{if(!(c)){printf("btcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+
+static const uint32_t clks[4]={200000000,80000000,40000000,160000000};
+static const uint32_t rates[10]={10000,20000,50000,83333,100000,125000,250000,500000,800000,1000000};
+static const uint32_t drates[5]={1000000,2000000,4000000,5000000,8000000};
+static const uint16_t sps[4]={750,800,875,900};
+
+//(0.01%),btcore.cıȽϷͬ
+static uint32_t sp_err(uint32_t s1,uint32_t s2,uint16_t sp)
+{
+	uint32_t spe=(1+s1)*10000/(1+s1+s2);
+	return spe>sp*10u?spe-sp*10u:sp*10u-spe;
+}
+
+//:С,βС,ηƵС
+//ÿƵÿλtq㲨,ȵǰõĲʱtseg1
+static void ref(uint32_t clk,uint32_t br,uint16_t sp,const _bt_limits *l,uint32_t *bppm,uint32_t *bspe,uint32_t *bp)
+{
+	uint32_t p,n,s1,s2,ppm,spe;
+	uint64_t r,d;
+	*bppm=*bspe=0xFFFFFFFF;
+	*bp=0;
+	for(p=1;p<=l->presc_max;p++)
+	{
+		for(n=1+l->tseg1_min+l->tseg2_min;n<=1u+l->tseg1_max+l->tseg2_max;n++)
+		{
+			r=(uint64_t)p*n*br;
+			d=clk>r?clk-r:r-clk;
+			ppm=(uint32_t)(d*1000000/r);
+			if(ppm>*bppm)continue;
+			for(s1=l->tseg1_min;s1<=l->tseg1_max;s1++)
+			{
+				s2=n-1-s1;
+				if(s2<l->tseg2_min||s2>l->tseg2_max)continue;
+				spe=sp_err(s1,s2,sp);
+				if(ppm<*bppm||(ppm==*bppm&&spe<*bspe))
+				{
+					*bppm=ppm;
+					*bspe=spe;
+					*bp=p;
+				}
+			}
+		}
+	}
+}
+
+//ٱȽ,
+static int check(uint32_t clk,uint32_t br,uint16_t sp,const _bt_limits *l)
+{
+	_bt_timing t;
+	uint32_t bppm,bspe,bp,n;
+	uint8_t r;
+	r=bt_solve(clk,br,sp,l,&t);
+	ref(clk,br,sp,l,&bppm,&bspe,&bp);
+	if(bp==0)
+	{
+		CHECK(r==2);
+		return 0;
+	}
+	CHECK(r==(bppm>BT_TOL_PPM));
+	CHECK(t.err_ppm==bppm&&sp_err(t.tseg1,t.tseg2,sp)==bspe&&t.presc==bp);
+	CHECK(t.presc>=1&&t.presc<=l->presc_max);
+	CHECK(t.tseg1>=l->tseg1_min&&t.tseg1<=l->tseg1_max&&t.tseg2>=l->tseg2_min&&t.tseg2<=l->tseg2_max);
+	CHECK(t.sjw==(t.tseg2<l->sjw_max?t.tseg2:l->sjw_max));
+	n=1+t.tseg1+t.tseg2;
+	CHECK(t.bitrate==clk/(t.presc*n)&&t.sp==(1+t.tseg1)*1000/n);
+	return 0;
+}
+
+static int test_solve(void)
+{
+	int c,i,j;
+	for(c=0;c<4;c++)for(i=0;i<10;i++)for(j=0;j<4;j++)
+		if(check(clks[c],rates[i],sps[j],&bt_fdcan_nominal))return 1;
+	for(c=0;c<4;c++)for(i=0;i<5;i++)for(j=0;j<4;j++)
+		if(check(clks[c],drates[i],sps[j],&bt_fdcan_data))return 1;
+	return 0;
+}
+
+//õλʱͲ
+static int test_fixed(void)
+{
+	_bt_timing t;
+	CHECK(bt_solve(200000000,500000,800,&bt_fdcan_nominal,&t)==0);
+	CHECK(t.presc==2&&t.tseg1==159&&t.tseg2==40&&t.sjw==40&&t.bitrate==500000&&t.sp==800&&t.err_ppm==0);
+	CHECK(bt_solve(200000000,2000000,750,&bt_fdcan_data,&t)==0);
+	CHECK(t.presc==5&&t.tseg1==14&&t.tseg2==5&&t.sjw==5&&t.bitrate==2000000&&t.sp==750);
+	CHECK(bt_solve(40000000,7000000,800,&bt_fdcan_data,&t)==1&&t.err_ppm>BT_TOL_PPM);	//40Mֲ7M,
+	CHECK(bt_solve(200000000,0,800,&bt_fdcan_nominal,&t)==2);
+	CHECK(bt_solve(200000000,300,800,&bt_fdcan_nominal,&t)==2);							//Ƶ
+	CHECK(bt_solve(200000000,500000,0,&bt_fdcan_nominal,&t)==2);
+	CHECK(bt_solve(200000000,500000,1000,&bt_fdcan_nominal,&t)==2);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_fixed()||test_solve())return 1;
+	printf("btcore: ok (240 cases)\n");
+	return 0;
+}
@@ -1,13 +1,18 @@
 #include "fdcan.h"
+#include "ldcore.h"
 #include "usart.h"
 #include "delay.h"
+#include "string.h"
+#if SYSTEM_SUPPORT_OS
+#include "includes.h"					//os ʹ
+#endif
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32H7
 //FDCAN	   
 //ԭ@ALIENTEK
 //̳:www.openedv.com
 //:2018/6/29
-//汾V1.0
+//汾V1.6
 //ȨУؾ
 //Copyright(C) ӿƼ޹˾ 2014-2024
 //All rights reserved									  
@@ -16,6 +21,93 @@ FDCAN_HandleTypeDef FDCAN1_Handler;
 FDCAN_RxHeaderTypeDef FDCAN1_RxHeader;
 FDCAN_TxHeaderTypeDef FDCAN1_TxHeader;
 
+#if SYSTEM_SUPPORT_OS
+#define FDCAN1_SR_ALLOC()		OS_CPU_SR cpu_sr=0
+#define FDCAN1_ENTER_CRITICAL()	OS_ENTER_CRITICAL()
+#define FDCAN1_EXIT_CRITICAL()	OS_EXIT_CRITICAL()
+#else
+#define FDCAN1_SR_ALLOC()		u32 primask
+#define FDCAN1_ENTER_CRITICAL()	{primask=__get_PRIMASK();__disable_irq();}
+#define FDCAN1_EXIT_CRITICAL()	__set_PRIMASK(primask)
+#endif
+#define FDCAN1_RXQ_MASK			(FDCAN1_RXQ_NUM-1)
+
+//״̬ж:״̬仯жϴ
+#define FDCAN1_BUS_ITS			(FDCAN_IT_BUS_OFF|FDCAN_IT_ERROR_PASSIVE|FDCAN_IT_ERROR_WARNING|FDCAN_IT_ERROR_LOGGING_OVERFLOW)
+//Эж:ÿγ,һκص,FDCAN1_BusPoll´,һֱ(ûӦ)ʱռCPU
+#define FDCAN1_PERR_ITS			(FDCAN_IT_ARB_PROTOCOL_ERROR|FDCAN_IT_DATA_PROTOCOL_ERROR)
+
+//Զشʱûгʱ֡طʱ,fdcoreFD_TX_FAIL
+#if FDCAN1_AUTO_RETX
+#define FDCAN1_RETX				FDCAN1_RETX_TIME
+#else
+#define FDCAN1_RETX				0
+#endif
+
+//ϢRAMԪصݴС
+#if FDCAN1_DATA_MAX<=8
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_8
+#elif FDCAN1_DATA_MAX<=12
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_12
+#elif FDCAN1_DATA_MAX<=16
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_16
+#elif FDCAN1_DATA_MAX<=20
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_20
+#elif FDCAN1_DATA_MAX<=24
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_24
+#elif FDCAN1_DATA_MAX<=32
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_32
+#elif FDCAN1_DATA_MAX<=48
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_48
+#else
+#define FDCAN1_ELMT_SIZE		FDCAN_DATA_BYTES_64
+#endif
+
+//CAN FDֽ֡,0ʾܷCAN FD֡
+#if FDCAN1_FD_EN
+#define FDCAN1_FD_LEN			FDCAN1_DATA_MAX
+#else
+#define FDCAN1_FD_LEN			0
+#endif
+
+//ն,ÿӲFIFOһ,жд,ȡ
+typedef struct
+{
+    _fdcan_frame frame[FDCAN1_RXQ_NUM];
+    volatile u16 wr;            //д֡(ɼ)
+    volatile u16 rd;            //ȡ֡(ɼ)
+    u32 rx;                     //յ֡
+    u32 lost;                   //ӲFIFO󶪵֡(RFxLжϴ,ÿٶ1֡)
+    u32 bytes;                  //յֽ
+    u32 trunc;                  //ݳFDCAN1_DATA_MAXضϵ֡
+    u16 hw_peak;                //ӲFIFO
+    u16 sw_peak;                //
+}_fdcan_rxq;
+
+static u8 fdcan1_load(_fd_tx *q,u8 s,u8 i);
+static void fdcan1_abort(_fd_tx *q,u8 s);
+static u8 fdcan1_txb(_fd_tx *q,u8 s);
+
+static _fdcan_rxq fdcan1_rxq[2];
+static _fd_txmsg fdcan1_txm[FDCAN1_TXQ_NUM];
+static u8 fdcan1_txbuf[FDCAN1_TXQ_NUM*FDCAN1_DATA_MAX];    //ÿ֡,뵽DLCӦĳ
+//Ͷ,λͳʱfdcore.c
+static _fd_tx fdcan1_txq={fdcan1_txm,fdcan1_txbuf,FDCAN1_TXQ_NUM,FDCAN1_TXB_NUM,FDCAN1_FD_LEN,FDCAN1_PAD,FDCAN1_RETX,fdcan1_load,fdcan1_abort,fdcan1_txb};
+//״̬,״̬ת˱fdcore.c(FDCAN1_Busfdcan1_ld)
+static _fd_bus fdcan1_bus={FDCAN1_BOFF_MIN,FDCAN1_BOFF_MAX,FDCAN1_BOFF_STABLE};
+static _ld fdcan1_ld;           //߸
+static u8 fdcan1_std_filters;   //õı׼ID˲
+static u8 fdcan1_ext_filters;   //õչID˲
+static u8 fdcan1_rxbuf[64];     //HALDLCȡ,64ֽ,ȡٸƵն
+static u8 fdcan1_dtiming[4]={FDCAN1_DATA_PRESC,FDCAN1_DATA_SJW,FDCAN1_DATA_TSG1,FDCAN1_DATA_TSG2};  //ݶλʱ
+static u32 fdcan1_bitrate;      //ٲöβ
+static void (*fdcan1_hook)(const _fdcan_frame *frame)=NULL;   //֡
+#if SYSTEM_SUPPORT_OS
+static OS_EVENT *fdcan1_sem=NULL;   //յ֡ʱFDCAN1_Wait
+#endif
+
+static u32 fdcan1_tick(void);
+
 //ʼFDCAN1Ϊ500Kbit/S
 //FDCAN1ʱԴΪPLL1Q=200Mhz
 //presc:ƵֵȡֵΧ1~512
@@ -27,46 +119,116 @@ FDCAN_TxHeaderTypeDef FDCAN1_TxHeader;
 //    ,ʼʧ; 
 u8 FDCAN1_Mode_Init(u16 presc,u8 ntsjw,u16 ntsg1,u8 ntsg2,u32 mode)
 {
-    FDCAN_FilterTypeDef FDCAN1_RXFilter;
-        
     //ʼFDCAN1
     HAL_FDCAN_DeInit(&FDCAN1_Handler);                              //ǰ
+    fd_tx_reset(&fdcan1_txq);                                       //û֡
     FDCAN1_Handler.Instance=FDCAN1;
+#if FDCAN1_FD_EN
+    FDCAN1_Handler.Init.FrameFormat=FDCAN_FRAME_FD_BRS;             //CAN FD,ÿ֡BRSλǷл
+#else
     FDCAN1_Handler.Init.FrameFormat=FDCAN_FRAME_CLASSIC;            //ͳģʽ
+#endif
     FDCAN1_Handler.Init.Mode=mode;                                  //ػ
-    FDCAN1_Handler.Init.AutoRetransmission=DISABLE;                 //رԶشͳģʽһҪرգ
+#if FDCAN1_AUTO_RETX
+    FDCAN1_Handler.Init.AutoRetransmission=ENABLE;                  //Զش,طͶеĳʱ
+#else
+    FDCAN1_Handler.Init.AutoRetransmission=DISABLE;                 //رԶش,ֻһ
+#endif
     FDCAN1_Handler.Init.TransmitPause=DISABLE;                      //رմͣ
     FDCAN1_Handler.Init.ProtocolException=DISABLE;                  //رЭ쳣
     FDCAN1_Handler.Init.NominalPrescaler=presc;                     //Ƶϵ
     FDCAN1_Handler.Init.NominalSyncJumpWidth=ntsjw;                 //ͬԾ
     FDCAN1_Handler.Init.NominalTimeSeg1=ntsg1;                      //tsg1Χ:2~256
     FDCAN1_Handler.Init.NominalTimeSeg2=ntsg2;                      //tsg2Χ:2~128
+    FDCAN1_Handler.Init.DataPrescaler=fdcan1_dtiming[0];            //ݶηƵϵ,ͳģʽ²
+    FDCAN1_Handler.Init.DataSyncJumpWidth=fdcan1_dtiming[1];
+    FDCAN1_Handler.Init.DataTimeSeg1=fdcan1_dtiming[2];
+    FDCAN1_Handler.Init.DataTimeSeg2=fdcan1_dtiming[3];
     FDCAN1_Handler.Init.MessageRAMOffset=0;                         //ϢRAMƫ
-    FDCAN1_Handler.Init.StdFiltersNbr=0;                            //׼ϢID˲
-    FDCAN1_Handler.Init.ExtFiltersNbr=0;                            //չϢID˲
-    FDCAN1_Handler.Init.RxFifo0ElmtsNbr=1;                          //FIFO0Ԫر
-    FDCAN1_Handler.Init.RxFifo0ElmtSize=FDCAN_DATA_BYTES_8;         //FIFO0ԪشС8ֽ
+    FDCAN1_Handler.Init.StdFiltersNbr=FDCAN1_STD_FILTER_NUM;        //׼ϢID˲
+    FDCAN1_Handler.Init.ExtFiltersNbr=FDCAN1_EXT_FILTER_NUM;        //չϢID˲
+    FDCAN1_Handler.Init.RxFifo0ElmtsNbr=FDCAN1_RXF0_NUM;            //FIFO0Ԫر
+    FDCAN1_Handler.Init.RxFifo0ElmtSize=FDCAN1_ELMT_SIZE;          //FIFO0ԪشС
+    FDCAN1_Handler.Init.RxFifo1ElmtsNbr=FDCAN1_RXF1_NUM;            //FIFO1Ԫر
+    FDCAN1_Handler.Init.RxFifo1ElmtSize=FDCAN1_ELMT_SIZE;          //FIFO1ԪشС
     FDCAN1_Handler.Init.RxBuffersNbr=0;                             //ջ
-    FDCAN1_Handler.Init.TxEventsNbr=0;                              //¼
-    FDCAN1_Handler.Init.TxBuffersNbr=0;                             //ͻ
-    FDCAN1_Handler.Init.TxFifoQueueElmtsNbr=1;                      //FIFOԪر
+    FDCAN1_Handler.Init.TxEventsNbr=FDCAN1_TXE_NUM;                 //¼FIFOԪر
+    FDCAN1_Handler.Init.TxBuffersNbr=FDCAN1_TXB_NUM;                //ר÷ͻ
+    FDCAN1_Handler.Init.TxFifoQueueElmtsNbr=0;                      //÷FIFO,Ͷ
     FDCAN1_Handler.Init.TxFifoQueueMode=FDCAN_TX_FIFO_OPERATION;    //FIFOģʽ
-    FDCAN1_Handler.Init.TxElmtSize=FDCAN_DATA_BYTES_8;              //ʹС:8ֽ
+    FDCAN1_Handler.Init.TxElmtSize=FDCAN1_ELMT_SIZE;                //ʹС
     if(HAL_FDCAN_Init(&FDCAN1_Handler)!=HAL_OK) return 1;           //ʼFDCAN
+    fdcan1_bitrate=FDCAN1_CLK/presc/(1+ntsg1+ntsg2);
+    fdcan1_std_filters=0;
+    fdcan1_ext_filters=0;
+    memset(fdcan1_rxq,0,sizeof(fdcan1_rxq));
+    fd_bus_reset(&fdcan1_bus);
+#if FDCAN1_FD_EN
+    ld_init(&fdcan1_ld,fdcan1_bitrate,FDCAN1_CLK/fdcan1_dtiming[0]/(1+fdcan1_dtiming[2]+fdcan1_dtiming[3]),FDCAN1_LOAD_WIN,fdcan1_tick());
+#else
+    ld_init(&fdcan1_ld,fdcan1_bitrate,0,FDCAN1_LOAD_WIN,fdcan1_tick());
+#endif
   
-    //RX˲   
-    FDCAN1_RXFilter.IdType=FDCAN_STANDARD_ID;                       //׼ID
-    FDCAN1_RXFilter.FilterIndex=0;                                  //˲                   
-    FDCAN1_RXFilter.FilterType=FDCAN_FILTER_MASK;                   //˲
-    FDCAN1_RXFilter.FilterConfig=FDCAN_FILTER_TO_RXFIFO0;           //0FIFO0  
-    FDCAN1_RXFilter.FilterID1=0x0000;                               //32λID
-    FDCAN1_RXFilter.FilterID2=0x0000;                               //FDCANΪͳģʽĻ32λ
-    if(HAL_FDCAN_ConfigFilter(&FDCAN1_Handler,&FDCAN1_RXFilter)!=HAL_OK) return 2;//˲ʼ
+    //ûƥ˲֡FDCAN1_NONMATCH,ĬȫFIFO0;ҪʱFDCAN1_Filter
+    if(HAL_FDCAN_ConfigGlobalFilter(&FDCAN1_Handler,FDCAN1_NONMATCH,FDCAN1_NONMATCH,DISABLE,DISABLE)!=HAL_OK) return 2;
+    HAL_FDCAN_ConfigTimestampCounter(&FDCAN1_Handler,FDCAN_TIMESTAMP_PRESC_1);  //ʱλ:1λʱ
+    HAL_FDCAN_EnableTimestampCounter(&FDCAN1_Handler,FDCAN_TIMESTAMP_INTERNAL);
+#if FDCAN1_FD_EN
+    //ݶηƵΪ12ʱ÷ʱ:ڶ=⵽շ·ʱ+λ(λ:FDCANʱ)
+    if(fdcan1_dtiming[0]<=2)
+    {
+        HAL_FDCAN_ConfigTxDelayCompensation(&FDCAN1_Handler,fdcan1_dtiming[0]*(fdcan1_dtiming[2]+1),0);
+        HAL_FDCAN_EnableTxDelayCompensation(&FDCAN1_Handler);
+    }
+#endif
     HAL_FDCAN_Start(&FDCAN1_Handler);                               //FDCAN
-    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,FDCAN_IT_RX_FIFO0_NEW_MESSAGE,0);
+#if FDCAN1_RX0_INT_ENABLE
+    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,FDCAN_IT_RX_FIFO0_NEW_MESSAGE|FDCAN_IT_RX_FIFO0_MESSAGE_LOST|
+                                   FDCAN_IT_RX_FIFO1_NEW_MESSAGE|FDCAN_IT_RX_FIFO1_MESSAGE_LOST|
+                                   FDCAN_IT_TX_COMPLETE|FDCAN_IT_TX_ABORT_COMPLETE|FDCAN_IT_TX_EVT_FIFO_NEW_DATA|
+                                   FDCAN1_BUS_ITS|FDCAN1_PERR_ITS,0);
+#endif
     return 0;
 }
 
+//ʳʼFDCAN1,Ƶʱbt_solve(ƵС,SJWtseg2)
+//bitrate:ٲöβ(bit/s),FDCAN1_CLK/512/385~FDCAN1_CLK/3
+//sp:(0.1%),һ800~875
+//mode:ͬFDCAN1_Mode_Init
+//ֵ:0,ʼOK;3,㲻BT_TOL_PPMڵλʱ;ͬFDCAN1_Mode_Init
+u8 FDCAN1_Init_Rate(u32 bitrate,u16 sp,u32 mode)
+{
+    _bt_timing bt;
+    if(bt_solve(FDCAN1_CLK,bitrate,sp,&bt_fdcan_nominal,&bt)) return 3;
+    return FDCAN1_Mode_Init(bt.presc,bt.sjw,bt.tseg1,bt.tseg2,mode);
+}
+
+//ݶλʱ,´FDCAN1_Mode_InitʱЧ
+//bitrate:ݶβ(bit/s)
+//sp:(0.1%),ݶһ700~800
+//ֵ:0,ɹ;1,㲻BT_TOL_PPMڵλʱ
+u8 FDCAN1_Data_Rate(u32 bitrate,u16 sp)
+{
+    _bt_timing bt;
+    if(bt_solve(FDCAN1_CLK,bitrate,sp,&bt_fdcan_data,&bt)) return 1;
+    FDCAN1_Data_Timing(bt.presc,bt.sjw,bt.tseg1,bt.tseg2);
+    return 0;
+}
+
+//ݶλʱ(CAN FDлĲ),´FDCAN1_Mode_InitʱЧ
+//=200M/presc/(1+tsg1+tsg2)
+//presc:Ƶֵ,1~32;Ϊ12ʱʱ
+//sjw:ͬԾ,1~16
+//tsg1:1~32
+//tsg2:1~16
+void FDCAN1_Data_Timing(u8 presc,u8 sjw,u8 tsg1,u8 tsg2)
+{
+    fdcan1_dtiming[0]=presc;
+    fdcan1_dtiming[1]=sjw;
+    fdcan1_dtiming[2]=tsg1;
+    fdcan1_dtiming[3]=tsg2;
+}
+
 //FDCAN1ײãʱʹ
 //HAL_FDCAN_Init()
 //hsdram:FDCAN1
@@ -108,6 +270,115 @@ void HAL_FDCAN_MspDeInit(FDCAN_HandleTypeDef* hfdcan)
 #endif
 }
 
+//ǰ(ms)
+static u32 fdcan1_tick(void)
+{
+#if SYSTEM_SUPPORT_OS
+    return OSTimeGet();
+#else
+    return HAL_GetTick();
+#endif
+}
+
+//fdcoreص:ѵi֡װר÷ͻs,д뷢¼FIFO(MessageMarkerΪi)
+//ֵ:0,ɹ;1,ʧ(ûʼ)
+static u8 fdcan1_load(_fd_tx *q,u8 s,u8 i)
+{
+    _fd_txmsg *m=&q->msg[i];
+    FDCAN1_TxHeader.Identifier=m->id;                               //32λID
+    FDCAN1_TxHeader.IdType=(m->flags&FDCAN1_F_EXT)?FDCAN_EXTENDED_ID:FDCAN_STANDARD_ID;
+    FDCAN1_TxHeader.TxFrameType=(m->flags&FDCAN1_F_RTR)?FDCAN_REMOTE_FRAME:FDCAN_DATA_FRAME;
+    FDCAN1_TxHeader.DataLength=(u32)fd_len2dlc(m->len)<<16;         //ݳ
+    FDCAN1_TxHeader.ErrorStateIndicator=FDCAN_ESI_ACTIVE;            
+    FDCAN1_TxHeader.BitRateSwitch=(m->flags&FDCAN1_F_BRS)?FDCAN_BRS_ON:FDCAN_BRS_OFF;
+    FDCAN1_TxHeader.FDFormat=(m->flags&(FDCAN1_F_FD|FDCAN1_F_BRS))?FDCAN_FD_CAN:FDCAN_CLASSIC_CAN;
+    FDCAN1_TxHeader.TxEventFifoControl=FDCAN_STORE_TX_EVENTS;       //淢¼
+    FDCAN1_TxHeader.MessageMarker=i;                                //¼һһ֡
+    if(HAL_FDCAN_AddMessageToTxBuffer(&FDCAN1_Handler,&FDCAN1_TxHeader,m->data,1<<s)!=HAL_OK) return 1;
+    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,FDCAN_IT_TX_COMPLETE,1<<s);    //HALÿɺصûж
+    if(HAL_FDCAN_EnableTxBufferRequest(&FDCAN1_Handler,1<<s)!=HAL_OK) return 1;
+    return 0;
+}
+
+//fdcoreص:ȡר÷ͻs,ȡɺڷȡж(FDCAN1_TxPoll)ﴦ
+static void fdcan1_abort(_fd_tx *q,u8 s)
+{
+    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,FDCAN_IT_TX_ABORT_COMPLETE,1<<s);
+    HAL_FDCAN_AbortTxRequest(&FDCAN1_Handler,1<<s);
+}
+
+//fdcoreص:ר÷ͻs״̬,û(TXBRP)ѷ(TXBTO)
+static u8 fdcan1_txb(_fd_tx *q,u8 s)
+{
+    u8 st=0;
+    if(FDCAN1_Handler.Instance->TXBRP&(1<<s))st|=FD_TXB_PENDING;
+    if(FDCAN1_Handler.Instance->TXBTO&(1<<s))st|=FD_TXB_SENT;
+    return st;
+}
+
+//ȡ¼FIFO¼,fdcoreMessageMarkerҵӦ֡,صʱ;¼ĸʽDLC߸
+static void fdcan1_tx_event(void)
+{
+    FDCAN_TxEventFifoTypeDef ev;
+    u8 flags;
+    while(FDCAN1_Handler.Instance->TXEFS&FDCAN_TXEFS_EFFL)
+    {
+        if(HAL_FDCAN_GetTxEvent(&FDCAN1_Handler,&ev)!=HAL_OK)break;
+        flags=(ev.IdType==FDCAN_EXTENDED_ID?FDCAN1_F_EXT:0)|(ev.TxFrameType==FDCAN_REMOTE_FRAME?FDCAN1_F_RTR:0)|
+              (ev.FDFormat==FDCAN_FD_CAN?FDCAN1_F_FD:0)|(ev.BitRateSwitch==FDCAN_BRS_ON?FDCAN1_F_BRS:0);
+        ld_frame(&fdcan1_ld,flags,fd_rx_len(ev.DataLength>>16,flags));
+        fd_tx_event(&fdcan1_txq,ev.MessageMarker,ev.Identifier,ev.TxTimestamp,fdcan1_tick());
+    }
+}
+
+//canһ֡,Ͷк,ȼװר÷ͻ巢
+//id:׼ID(11λ)չID(29λ)
+//flags:FDCAN1_F_EXT,չID;FDCAN1_F_RTR,Զ֡;FDCAN1_F_FD,CAN FD֡;FDCAN1_F_BRS,CAN FD֡ݶл
+//data:
+//len:ݳ,ͳ֡0~8,CAN FD֡0~64;CAN FD֡ȲDLCӦĳʱFDCAN1_PADһ
+//timeout:ʱʱ(ms),ͳʱط,ʱûͶ;FDCAN1_FOREVER,ʱ,ͳͶ
+//        (ԶشʱӲһֱط,FDCAN1_FOREVER֡FDCAN1_RETX_TIME msûͰFDCAN1_TX_FAIL)
+//done:ɻص,(FDCAN1_TX_SENT/FDCAN1_TX_NOTS)ʱ(FDCAN1_TX_TIMEOUT)(FDCAN1_TX_FAIL)ʱ,NULLص
+//     жFDCAN1_TxPollٽ,Ҫ췵,ܵȴ
+//arg:صĲ
+//ֵ:0,ɹ;
+//		 1,Ͷ;
+//		 2,;
+u8 FDCAN1_Submit(u32 id,u8 flags,const u8 *data,u8 len,u32 timeout,void (*done)(void *arg,u8 status,u16 ts),void *arg)
+{
+    u8 res;
+    FDCAN1_SR_ALLOC();
+    FDCAN1_ENTER_CRITICAL();
+    res=fd_tx_submit(&fdcan1_txq,id,flags,data,len,timeout,done,arg,fdcan1_tick());
+    FDCAN1_EXIT_CRITICAL();
+    return res;
+}
+
+//canһ֡,ʱ,ص,ͳʱط(ԶشʱӲط,FDCAN1_RETX_TIME ms)
+//ͬFDCAN1_Submit
+//ֵ:0,ɹ;
+//		 1,Ͷ;
+//		 2,;
+u8 FDCAN1_Send(u32 id,u8 flags,const u8 *data,u8 len)
+{
+    return FDCAN1_Submit(id,flags,data,len,FDCAN1_FOREVER,NULL,NULL);
+}
+
+//鷢ͳʱ:Ķ,װ뷢ͻȡ;
+//鷢ɺͷ¼(жʱ﷢),FDCAN1_TXE_WAIT msûз¼İFDCAN1_TX_NOTS
+//ڷﶨڵ
+//ֵ:msҪٵһ,1~FDCAN1_TXPOLL_MAX
+u32 FDCAN1_TxPoll(void)
+{
+    u32 wait;
+    FDCAN1_SR_ALLOC();
+    FDCAN1_ENTER_CRITICAL();
+    fdcan1_tx_event();
+    wait=fd_tx_poll(&fdcan1_txq,fdcan1_tick(),FDCAN1_TXE_WAIT,FDCAN1_TXPOLL_MAX);
+    FDCAN1_EXIT_CRITICAL();
+    return wait;
+}
+
 //canһ(̶ʽ:IDΪ0X12,׼֡,֡)	
 //len:ݳ(Ϊ8),ΪFDCAN_DLC_BYTES_2~FDCAN_DLC_BYTES_8				     
 //msg:ָ,Ϊ8ֽ.
@@ -115,51 +386,404 @@ void HAL_FDCAN_MspDeInit(FDCAN_HandleTypeDef* hfdcan)
 //		 ,ʧ;
 u8 FDCAN1_Send_Msg(u8* msg,u32 len)
 {	
-    FDCAN1_TxHeader.Identifier=0x12;                           //32λID
-    FDCAN1_TxHeader.IdType=FDCAN_STANDARD_ID;                  //׼ID
-    FDCAN1_TxHeader.TxFrameType=FDCAN_DATA_FRAME;              //֡
-    FDCAN1_TxHeader.DataLength=len;                            //ݳ
-    FDCAN1_TxHeader.ErrorStateIndicator=FDCAN_ESI_ACTIVE;            
-    FDCAN1_TxHeader.BitRateSwitch=FDCAN_BRS_OFF;               //رл
-    FDCAN1_TxHeader.FDFormat=FDCAN_CLASSIC_CAN;                //ͳCANģʽ
-    FDCAN1_TxHeader.TxEventFifoControl=FDCAN_NO_TX_EVENTS;     //޷¼
-    FDCAN1_TxHeader.MessageMarker=0;                           
+    return FDCAN1_Send(0x12,0,msg,fd_dlc2len(len>>16));
+}
+
+//һ˲,FDCAN1_Mode_Init֮,ÿ³ʼҪ
+//ext:0,׼ID;1,չID
+//type:FDCAN_FILTER_RANGE,id1~id2Χ;FDCAN_FILTER_DUAL,id1id2(IDб);FDCAN_FILTER_MASK,id1ΪID,id2Ϊ
+//fifo:0,FIFO0;1,FIFO1(FIFO0ȡ);2,
+//ֵ:0,ɹ;1,˲;2,
+u8 FDCAN1_Filter(u8 ext,u32 type,u32 id1,u32 id2,u8 fifo)
+{
+    FDCAN_FilterTypeDef FDCAN1_RXFilter;
+    u8 *n=ext?&fdcan1_ext_filters:&fdcan1_std_filters;
     
-    if(HAL_FDCAN_AddMessageToTxFifoQ(&FDCAN1_Handler,&FDCAN1_TxHeader,msg)!=HAL_OK) return 1;//
-    return 0;	
+    if(*n>=(ext?FDCAN1_EXT_FILTER_NUM:FDCAN1_STD_FILTER_NUM)) return 1;
+    if(fifo>2||type>FDCAN_FILTER_MASK) return 2;
+    FDCAN1_RXFilter.IdType=ext?FDCAN_EXTENDED_ID:FDCAN_STANDARD_ID;
+    FDCAN1_RXFilter.FilterIndex=*n;                                 //˲
+    FDCAN1_RXFilter.FilterType=type;                                //˲
+    FDCAN1_RXFilter.FilterConfig=fifo==0?FDCAN_FILTER_TO_RXFIFO0:fifo==1?FDCAN_FILTER_TO_RXFIFO1:FDCAN_FILTER_REJECT;
+    FDCAN1_RXFilter.FilterID1=id1;
+    FDCAN1_RXFilter.FilterID2=id2;
+    FDCAN1_RXFilter.RxBufferIndex=0;
+    FDCAN1_RXFilter.IsCalibrationMsg=0;
+    if(HAL_FDCAN_ConfigFilter(&FDCAN1_Handler,&FDCAN1_RXFilter)!=HAL_OK) return 2;
+    (*n)++;
+    return 0;
 }
 
-//canڽݲѯ
-//buf:ݻ;	 
+//ӲFIFO֡ȡն,ʱӲFIFO
+//fifo:0,FIFO0;1,FIFO1
+//ֵ:ȡ֡
+static u8 fdcan1_drain(u8 fifo)
+{
+    _fdcan_rxq *q=&fdcan1_rxq[fifo];
+    _fdcan_frame *f;
+    u32 loc=fifo?FDCAN_RX_FIFO1:FDCAN_RX_FIFO0;
+    u16 fill,n=0;
+    
+    fill=HAL_FDCAN_GetRxFifoFillLevel(&FDCAN1_Handler,loc);
+    if(fill>q->hw_peak)q->hw_peak=fill;
+    while(fill--)
+    {
+        if((u16)(q->wr-q->rd)>=FDCAN1_RXQ_NUM)break;                //,ȡߺȡ
+        f=&q->frame[q->wr&FDCAN1_RXQ_MASK];
+        if(HAL_FDCAN_GetRxMessage(&FDCAN1_Handler,loc,&FDCAN1_RxHeader,fdcan1_rxbuf)!=HAL_OK)break;
+        f->id=FDCAN1_RxHeader.Identifier;
+        f->ts=FDCAN1_RxHeader.RxTimestamp;
+        f->flags=(FDCAN1_RxHeader.IdType==FDCAN_EXTENDED_ID?FDCAN1_F_EXT:0)|(FDCAN1_RxHeader.RxFrameType==FDCAN_REMOTE_FRAME?FDCAN1_F_RTR:0);
+        if(FDCAN1_RxHeader.FDFormat==FDCAN_FD_CAN)
+        {
+            f->flags|=FDCAN1_F_FD;
+            if(FDCAN1_RxHeader.BitRateSwitch==FDCAN_BRS_ON)f->flags|=FDCAN1_F_BRS;
+            if(FDCAN1_RxHeader.ErrorStateIndicator==FDCAN_ESI_PASSIVE)f->flags|=FDCAN1_F_ESI;
+        }
+        f->len=fd_rx_len(FDCAN1_RxHeader.DataLength>>16,f->flags);    //ͳ֡DLC 9~15Ҳ8ֽ
+        ld_frame(&fdcan1_ld,f->flags,f->len);   //ضǰĳ
+        if(f->len>FDCAN1_DATA_MAX)
+        {
+            f->len=FDCAN1_DATA_MAX;
+            q->trunc++;
+        }
+        memcpy(f->data,fdcan1_rxbuf,f->len);
+        q->bytes+=f->len;
+        f->fifo=fifo;
+        f->filter=FDCAN1_RxHeader.IsFilterMatchingFrame?0xFF:FDCAN1_RxHeader.FilterIndex;
+        if(fdcan1_hook!=NULL)fdcan1_hook(f);
+        q->wr++;
+        q->rx++;
+        n++;
+    }
+    if((u16)(q->wr-q->rd)>q->sw_peak)q->sw_peak=q->wr-q->rd;
+    return n;
+}
+
+//֡,ÿ֡ӲFIFOȡʱ(жϷʽʱڽж),Ҫ췵
+//hook:Ӻ,NULLȡ
+void FDCAN1_SetHook(void (*hook)(const _fdcan_frame *frame))
+{
+    fdcan1_hook=hook;
+}
+
+//ٲöβ,FDCAN1_Mode_Init֮Ч
+u32 FDCAN1_Bitrate(void)
+{
+    return fdcan1_bitrate;
+}
+
+//ȡ֡ǰ:ѯʽʱӲFIFOȡ;жϷʽʱʱӲFIFO֡ȡ
+static void fdcan1_refill(void)
+{
+    FDCAN1_SR_ALLOC();
+    FDCAN1_ENTER_CRITICAL();                                        //һֻȡһFIFO,жϵʱ䲻һFIFO
+    fdcan1_drain(1);
+    FDCAN1_EXIT_CRITICAL();
+    FDCAN1_ENTER_CRITICAL();
+    fdcan1_drain(0);
+    FDCAN1_EXIT_CRITICAL();
+}
+
+//նȡһ֡,FIFO1
+//ֵ:1,ȡ;0,п
+static u8 fdcan1_pop(_fdcan_frame *frame)
+{
+    _fdcan_rxq *q;
+    u8 i;
+    FDCAN1_SR_ALLOC();
+    fdcan1_refill();
+    FDCAN1_ENTER_CRITICAL();
+    for(i=2;i>0;i--)
+    {
+        q=&fdcan1_rxq[i-1];
+        if(q->wr!=q->rd)
+        {
+            if(frame!=NULL)memcpy(frame,&q->frame[q->rd&FDCAN1_RXQ_MASK],sizeof(_fdcan_frame));
+            q->rd++;
+            FDCAN1_EXIT_CRITICAL();
+            return 1;
+        }
+    }
+    FDCAN1_EXIT_CRITICAL();
+    return 0;
+}
+
+//canڽݲѯ,ȴ
+//buf:ݻ,FDCAN1_DATA_MAXֽ;	 
 //ֵ:0,ݱյ;
 //		 ,յݳ;
 u8 FDCAN1_Receive_Msg(u8 *buf)
 {	
-    if(HAL_FDCAN_GetRxMessage(&FDCAN1_Handler,FDCAN_RX_FIFO0,&FDCAN1_RxHeader,buf)!=HAL_OK)return 0;//
-	return FDCAN1_RxHeader.DataLength>>16;	
+    _fdcan_frame f;
+    if(!fdcan1_pop(&f))return 0;
+    memcpy(buf,f.data,f.len);
+    return f.len;	
+}
+
+//ȴյһ֡,ȡ
+//OSʱźϵȴ,ռCPU;ÿ1msѯһ
+//timeout:ʱʱ(ms),0ȴ,FDCAN1_FOREVERһֱȴ
+//ֵ:1,֡;0,ʱ
+u8 FDCAN1_Wait(u32 timeout)
+{
+    u32 t=0;
+#if SYSTEM_SUPPORT_OS
+    u32 start;
+    u8 err;
+    FDCAN1_SR_ALLOC();
+    if(OSRunning&&fdcan1_sem==NULL)
+    {
+        FDCAN1_ENTER_CRITICAL();
+        if(fdcan1_sem==NULL)fdcan1_sem=OSSemCreate(0);
+        FDCAN1_EXIT_CRITICAL();
+    }
+    start=OSTimeGet();
+#endif
+    while(1)
+    {
+        fdcan1_refill();
+        if(fdcan1_rxq[0].wr!=fdcan1_rxq[0].rd||fdcan1_rxq[1].wr!=fdcan1_rxq[1].rd)return 1;
+#if SYSTEM_SUPPORT_OS && FDCAN1_RX0_INT_ENABLE
+        if(OSRunning&&fdcan1_sem!=NULL)
+        {
+            t=OSTimeGet()-start;
+            if(timeout==FDCAN1_FOREVER)OSSemPend(fdcan1_sem,0,&err);
+            else if(t<timeout)OSSemPend(fdcan1_sem,timeout-t,&err);
+            else return 0;
+            continue;
+        }
+#endif
+        if(timeout!=FDCAN1_FOREVER&&t++>=timeout)return 0;
+        delay_ms(1);
+    }
+}
+
+//ȴյһ֡ȡ
+//frame:յ֡
+//timeout:ʱʱ(ms),ͬFDCAN1_Wait
+//ֵ:1,յ;0,ʱ
+u8 FDCAN1_Read(_fdcan_frame *frame,u32 timeout)
+{
+    if(!FDCAN1_Wait(timeout))return 0;
+    return fdcan1_pop(frame);                                       //0:ȡ
+}
+
+//Э״̬(PSR)ʹ(ECR),fdcore״̬ʹͳ
+//PSRĴECRĴ¼,ֻ;жٽ
+static void fdcan1_bus_read(void)
+{
+    u32 psr=FDCAN1_Handler.Instance->PSR;
+    u32 ecr=FDCAN1_Handler.Instance->ECR;
+    u8 tec,rec,cel,state;
+    
+    tec=ecr&0xFF;                                                   //TECǵ8λ,ͷļFDCAN_ECR_TECֻ4λ
+    rec=(ecr&FDCAN_ECR_REC)>>FDCAN_ECR_REC_Pos;
+    if(ecr&FDCAN_ECR_RP)rec=128;                                    //ʱRECͣ128ϲټ
+    cel=(ecr&FDCAN_ECR_CEL)>>FDCAN_ECR_CEL_Pos;
+    if(cel)ld_error(&fdcan1_ld,cel);
+    if(psr&FDCAN_PSR_BO)state=FDCAN1_BUS_OFF;                       //ӲCCCR.INIT,ֹͣշ
+    else if(psr&FDCAN_PSR_EP)state=FDCAN1_BUS_PASSIVE;
+    else if(psr&FDCAN_PSR_EW)state=FDCAN1_BUS_WARNING;
+    else state=FDCAN1_BUS_ACTIVE;
+    if(fd_bus_update(&fdcan1_bus,state,tec,rec,cel,psr&FDCAN_PSR_LEC,(psr&FDCAN_PSR_DLEC)>>FDCAN_PSR_DLEC_Pos,fdcan1_tick()))
+        fd_tx_scan(&fdcan1_txq,fdcan1_tick());                      //ָ,߹رʱķ󰴳
+}
+
+//߼,ڷﶨڵ(FDCAN1_TxPollһ):
+//״̬(жʱ);߹رպȵ˱ʱ俪ʼָ;ͳƴڽʱ㸺;´Эж
+//ֵ:msҪٵһ,1~FDCAN1_BUSPOLL_MAX
+u32 FDCAN1_BusPoll(void)
+{
+    u32 now,wait=FDCAN1_BUSPOLL_MAX;
+    FDCAN1_SR_ALLOC();
+    if(FDCAN1_Handler.State!=HAL_FDCAN_STATE_BUSY)return wait;     //ûʼ
+    FDCAN1_ENTER_CRITICAL();
+    fdcan1_bus_read();
+    now=fdcan1_tick();
+    if(fd_bus_poll(&fdcan1_bus,now,&wait))
+        CLEAR_BIT(FDCAN1_Handler.Instance->CCCR,FDCAN_CCCR_INIT);   //ʼָ:Ӳ⵽12911λص
+    ld_tick(&fdcan1_ld,now);
+#if FDCAN1_RX0_INT_ENABLE
+    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,FDCAN1_PERR_ITS,0);
+#endif
+    FDCAN1_EXIT_CRITICAL();
+    return wait;
+}
+
+//ȡ״̬͸
+//bus:
+void FDCAN1_Bus(_fdcan_bus *bus)
+{
+    _fd_bus *b=&fdcan1_bus;
+    FDCAN1_SR_ALLOC();
+    FDCAN1_ENTER_CRITICAL();
+    bus->state=b->state;
+    bus->tec=b->tec;
+    bus->rec=b->rec;
+    bus->tec_max=b->tec_max;
+    bus->rec_max=b->rec_max;
+    bus->lec=b->lec;
+    bus->errors=b->errors;
+    memcpy(bus->lec_cnt,b->lec_cnt,sizeof(bus->lec_cnt));
+    bus->warnings=b->warnings;
+    bus->passives=b->passives;
+    bus->busoffs=b->busoffs;
+    bus->recoveries=b->recoveries;
+    bus->backoff=b->backoff;
+    bus->off_time=b->off_time;
+    bus->load=fdcan1_ld.load;
+    bus->load_peak=fdcan1_ld.peak;
+    bus->load_avg=fdcan1_ld.avg;
+    bus->fps=fdcan1_ld.fps;
+    bus->eps=fdcan1_ld.eps;
+    FDCAN1_EXIT_CRITICAL();
+}
+
+//շͳ
+void FDCAN1_Report(void)
+{
+    static const char *state[4]={"error active","warning","error passive","bus-off"};
+    _fdcan_rxq *q;
+    _fdcan_bus b;
+    u8 i;
+    for(i=0;i<2;i++)
+    {
+        q=&fdcan1_rxq[i];
+        printf("can rx fifo%d: %u frames %u bytes, lost %u, truncated %u, hw peak %u/%u, queue %u peak %u/%u\r\n",i,q->rx,q->bytes,
+            q->lost,q->trunc,q->hw_peak,i?FDCAN1_RXF1_NUM:FDCAN1_RXF0_NUM,(u16)(q->wr-q->rd),q->sw_peak,FDCAN1_RXQ_NUM);
+    }
+    printf("can tx: %u frames %u bytes, queue %u peak %u/%u, full %u, timeout %u, failed %u, preempt %u, no event %u, longest wait %u ms\r\n",
+        fdcan1_txq.tx,fdcan1_txq.bytes,fdcan1_txq.heap_n,fdcan1_txq.peak,FDCAN1_TXQ_NUM,fdcan1_txq.full,fdcan1_txq.timeout,fdcan1_txq.fail,
+        fdcan1_txq.preempt,fdcan1_txq.nots,fdcan1_txq.wait);
+    printf("can filters: std %u ext %u\r\n",fdcan1_std_filters,fdcan1_ext_filters);
+    FDCAN1_Bus(&b);
+    printf("can bus: %s, tec %u rec %u (max %u/%u), errors %u (stuff %u form %u ack %u bit1 %u bit0 %u crc %u)\r\n",state[b.state],
+        b.tec,b.rec,b.tec_max,b.rec_max,b.errors,b.lec_cnt[0],b.lec_cnt[1],b.lec_cnt[2],b.lec_cnt[3],b.lec_cnt[4],b.lec_cnt[5]);
+    printf("can bus: warning %u, passive %u, bus-off %u, recovery %u, backoff %u ms, off %u ms\r\n",b.warnings,b.passives,
+        b.busoffs,b.recoveries,b.backoff,b.off_time);
+    printf("can load: %u.%u%% peak %u.%u%% avg %u.%u%%, %u frames/s, %u errors/s\r\n",b.load/10,b.load%10,b.load_peak/10,
+        b.load_peak%10,b.load_avg/10,b.load_avg%10,b.fps,b.eps);
+#if FDCAN1_FD_EN
+    printf("can fd: data phase %u Kbit/s (presc %u sjw %u tsg1 %u tsg2 %u), tdc %s\r\n",FDCAN1_CLK/1000/fdcan1_dtiming[0]/(1+fdcan1_dtiming[2]+fdcan1_dtiming[3]),
+        fdcan1_dtiming[0],fdcan1_dtiming[1],fdcan1_dtiming[2],fdcan1_dtiming[3],fdcan1_dtiming[0]<=2?"on":"off");
+#endif
+}
+
+//ԶⲨ:úѡ߼ģʽ(ֻղ,Ӧ)֡,յFDCAN1_AUTOBAUD_FRAMES֡
+//ȷ֡ûгЭΪ,modeʼ;Эʱһ
+//ҪбĽڵӦ,ͽڵӦ綨󷢴֡,ղȷ֡
+//rates:ѡ,õķǰ
+//num:ѡ
+//sp:(0.1%)
+//dwell:ÿms
+//timeout:ʱ(ms),FDCAN1_FOREVERһֱѭ
+//mode:⵽Ĺģʽ,ͬFDCAN1_Mode_Init
+//ֵ:⵽Ĳ;0,ʱû⵽,FDCAN1ͣڼģʽ,Ҫ³ʼ
+u32 FDCAN1_AutoBaud(const u32 *rates,u8 num,u16 sp,u32 dwell,u32 timeout,u32 mode)
+{
+    _bt_timing bt;
+    u32 t,elapsed=0,perr;
+    u8 i=0;
+    FDCAN1_SR_ALLOC();
+    
+    if(num==0) return 0;
+    while(timeout==FDCAN1_FOREVER||elapsed<timeout)
+    {
+        t=0;
+        if(bt_solve(FDCAN1_CLK,rates[i],sp,&bt_fdcan_nominal,&bt)==0&&
+           FDCAN1_Mode_Init(bt.presc,bt.sjw,bt.tseg1,bt.tseg2,FDCAN_MODE_BUS_MONITORING)==0)
+        {
+            while(t<dwell)                                          //жϻPSRʱlec_cnt,Mode_Init
+            {
+                delay_ms(1);
+                t++;
+                FDCAN1_ENTER_CRITICAL();
+                fdcan1_bus_read();
+                FDCAN1_EXIT_CRITICAL();
+                perr=fdcan1_bus.lec_cnt[0]+fdcan1_bus.lec_cnt[1]+fdcan1_bus.lec_cnt[2]+fdcan1_bus.lec_cnt[3]+fdcan1_bus.lec_cnt[4]+fdcan1_bus.lec_cnt[5];
+                if(perr)break;                                      //ʲ
+                fdcan1_refill();
+                if(fdcan1_rxq[0].rx+fdcan1_rxq[1].rx>=FDCAN1_AUTOBAUD_FRAMES)
+                {
+                    if(FDCAN1_Mode_Init(bt.presc,bt.sjw,bt.tseg1,bt.tseg2,mode)) return 0;
+                    return rates[i];
+                }
+            }
+        }
+        elapsed+=t?t:1;
+        i=(i+1)%num;
+    }
+    return 0;
 }
 
 #if FDCAN1_RX0_INT_ENABLE  
 //FDCAN1жϷ
 void FDCAN1_IT0_IRQHandler(void)
 {
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+    OSIntEnter();
+#endif
     HAL_FDCAN_IRQHandler(&FDCAN1_Handler);
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+    OSIntExit();
+#endif
+}
+
+//FIFOжϹ:ȡ֡,FDCAN1_Wait,ٴFIFOж
+//fifo:0,FIFO0;1,FIFO1
+//its:жϱ־
+static void fdcan1_rx_irq(u8 fifo,u32 its)
+{
+    if(its&(FDCAN_IT_RX_FIFO0_MESSAGE_LOST|FDCAN_IT_RX_FIFO1_MESSAGE_LOST))fdcan1_rxq[fifo].lost++;
+#if SYSTEM_SUPPORT_OS
+    if(fdcan1_drain(fifo)&&fdcan1_sem!=NULL)OSSemPost(fdcan1_sem);
+#else
+    fdcan1_drain(fifo);
+#endif
+    HAL_FDCAN_ActivateNotification(&FDCAN1_Handler,fifo?(FDCAN_IT_RX_FIFO1_NEW_MESSAGE|FDCAN_IT_RX_FIFO1_MESSAGE_LOST):
+                                   (FDCAN_IT_RX_FIFO0_NEW_MESSAGE|FDCAN_IT_RX_FIFO0_MESSAGE_LOST),0);   //HALصǰصж
 }
 
 //FIFO0ص
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
 {
-    u8 i=0;
-    u8 rxdata[8];
-    if((RxFifo0ITs&FDCAN_IT_RX_FIFO0_NEW_MESSAGE)!=RESET)   //FIFO1ж
-    {
-        //ȡFIFO0нյ
-        HAL_FDCAN_GetRxMessage(hfdcan,FDCAN_RX_FIFO0,&FDCAN1_RxHeader,rxdata);
-        printf("id:%#x\r\n",FDCAN1_RxHeader.Identifier);
-        printf("len:%d\r\n",FDCAN1_RxHeader.DataLength>>16);
-        for(i=0;i<8;i++)
-        printf("rxdata[%d]:%d\r\n",i,rxdata[i]);
-        HAL_FDCAN_ActivateNotification(hfdcan,FDCAN_IT_RX_FIFO0_NEW_MESSAGE,0);
-    }
+    fdcan1_rx_irq(0,RxFifo0ITs);
 }
-#endif	
+
+//FIFO1ص
+void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo1ITs)
+{
+    fdcan1_rx_irq(1,RxFifo1ITs);
+}
+
+//ɻص:ר÷ͻ
+void HAL_FDCAN_TxBufferCompleteCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes)
+{
+    fd_tx_scan(&fdcan1_txq,fdcan1_tick());
+    HAL_FDCAN_ActivateNotification(hfdcan,FDCAN_IT_TX_COMPLETE,0);
+}
+
+//ȡɻص:λ֡ŻͶ,ʱ֡
+void HAL_FDCAN_TxBufferAbortCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes)
+{
+    fd_tx_scan(&fdcan1_txq,fdcan1_tick());
+    HAL_FDCAN_ActivateNotification(hfdcan,FDCAN_IT_TX_ABORT_COMPLETE,0);
+}
+
+//״̬ص:״̬仯¼Э
+void HAL_FDCAN_ErrorCallback(FDCAN_HandleTypeDef *hfdcan)
+{
+    hfdcan->ErrorCode=HAL_FDCAN_ERROR_NONE;                         //HALֻλ,ĻԺÿж϶
+    fdcan1_bus_read();
+    HAL_FDCAN_ActivateNotification(hfdcan,FDCAN1_BUS_ITS,0);       //ЭжFDCAN1_BusPoll
+}
+
+//¼FIFOص:ȡʱ,ص
+void HAL_FDCAN_TxEventFifoCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t TxEventFifoITs)
+{
+    fdcan1_tx_event();
+    fd_tx_fill(&fdcan1_txq);
+    HAL_FDCAN_ActivateNotification(hfdcan,FDCAN_IT_TX_EVT_FIFO_NEW_DATA,0);
+}
+#endif
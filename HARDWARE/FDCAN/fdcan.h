@@ -1,6 +1,8 @@
 #ifndef _FDCAN_H
 #define _FDCAN_H
 #include "sys.h"
+#include "fdcore.h"
+#include "btcore.h"
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32H7
 //FDCAN	   
@@ -10,13 +12,169 @@
 //汾V1.0
 //ȨУؾ
 //Copyright(C) ӿƼ޹˾ 2014-2024
-//All rights reserved									  
-////////////////////////////////////////////////////////////////////////////////// 	
+//All rights reserved
+//********************************************************************************
+//V1.1 20261019
+//ϢRAMFDCAN1_RXF0_NUM/FDCAN1_RXF1_NUM/FDCAN1_TX_NUM:FIFO64Ԫ,FIFO 32Ԫ
+//FDCAN1_Filter(),IDб/Χ/˲,ÿ˲ָFIFO0FIFO1;ûƥ֡FDCAN1_NONMATCH
+//жϰӲFIFO֡ȫȡն,FDCAN1_Read/FDCAN1_Waitȴ,ȴڼռCPU
+//FIFO1֡FIFO0֡ȡ,ҪٴID˲FIFO1
+//ͳӲFIFO(֡)FIFO,FDCAN1_Report()("can")
+//V1.2 20261019
+//֧CAN FD(FDCAN1_FD_EN):ݶβʵ(FDCAN1_Data_Timing),֡ѡл(BRS),
+//ݶηƵΪ12ʱʱ(TDC);ݳ0~64ֽ,12~64ֽڰDLCȡ,ֽڲFDCAN1_PAD
+//ϢRAMԪشСFDCAN1_DATA_MAXѡ,ʱǷ񳬳FDCAN1_RAM_WORDS
+//FDCAN1_Send(ID,־,,),FDCAN1_Send_Msg(IDΪ0X12,׼֡)
+//DLCתͲfdcore.c,HAL,PCϲ
+//V1.3 20261019
+//FDCAN1_SetHook(),ÿյһ֡ȡʱ(ж),CAN¼
+//FDCAN1_Bitrate(),ٲöβ,ʱĵλ1λʱ
+//V1.4 20261019
+//͸Ϊȼ+ר÷ͻ:FDCAN1_Send/FDCAN1_Submit֡Ͷ(FDCAN1_TXQ_NUM),
+//ٲȼ(IDԽСԽȷ,ͬIDȽȳ),ΪFIFOڷһ֡ͷʧ
+//FDCAN1_TXB_NUMר÷ͻӲIDٲ,жв;ȫʱȼߵ֡,
+//ȡȼ͵һ֡λ(Ż),ȼ֡סȼ֡(ȼת)
+//򿪷¼FIFO,ÿ֡ȡ֡ʼʱ(λ1λʱ,ͽʱͬһ)
+//FDCAN1_Submitָʱɻص:ʱصFDCAN1_TX_SENTʱ,ʱûʱصFDCAN1_TX_TIMEOUT
+//Զشرʱͳ֡:гʱķŻضطֱʱ,ûгʱ(FDCAN1_Send)ǰһֻһ,صFDCAN1_TX_FAIL
+//ʱFDCAN1_TxPoll,Ҫڵ
+//еλͳʱfdcore.c(fd_tx_xxx),ֻĴ
+//V1.5 20261019
+//λʱ(btcore.c):FDCAN1_Init_Rate/FDCAN1_Data_RateʺͲԶƵʱ,
+//FDCAN1_AutoBaud():úѡ߼ģʽ֡,յȷ֡ûЭʳʼ
+//V1.6 20261019
+//״̬:״̬仯(//߹ر)¼ЭжPSR/ECR,
+//ͳƴ(LEC/DLEC)Э󡢽״̬Ĵ
+//߹رպFDCAN1_BusPollԶָ,ָǰȴʱFDCAN1_BOFF_MINʼ,ָֹܿرʱӱ,FDCAN1_BOFF_MAX
+//߸ͳ(ldcore.c):շÿһ֡ÿ֡λͲۼ,ÿFDCAN1_LOAD_WIN msһθ
+//Զش(FDCAN1_AUTO_RETX),FDCAN1_Send֡طFDCAN1_RETX_TIME ms,FDCAN1_TX_FAIL
+//FDCAN1_Bus()ȡ״̬͸,FDCAN1_Report()Ҳ
+//״̬תͳƺ˱fdcore.c(fd_bus_xxx),ؼldcore.c,ֻдĴ
+//////////////////////////////////////////////////////////////////////////////////
 
-//FDCAN1RX0жʹ
-#define FDCAN1_RX0_INT_ENABLE	0		//0,ʹ;1,ʹ.
+#define FDCAN1_CLK				200000000	//FDCANںʱ(PLL1Q),λʱ䰴
+
+//FDCAN1жʹ(FIFO/ȡ¼)
+#define FDCAN1_RX0_INT_ENABLE	1		//0,ʹ,FDCAN1_Receive_Msg/FDCAN1_ReadѯӲFIFO,FDCAN1_TxPollﲹ䷢ͻ;1,ʹ,жﴦ
+
+//CAN FD:0,ͳCAN(ϵTJA1050ִֻ֧ͳCAN);1,CAN FD,Ҫ֧CAN FDշ
+#define FDCAN1_FD_EN			0
+
+//ݶλʱ(FDCAN1_FD_ENΪ1ʱЧ),FDCAN1_Mode_Init֮ǰFDCAN1_Data_Timing޸
+//Ĭ200M/4/(1+19+5)=2Mbit/s,80%;ƵΪ12ʱTDC,1,8,31,8Ϊ5Mbit/s
+#define FDCAN1_DATA_PRESC		4		//Ƶ,1~32
+#define FDCAN1_DATA_SJW			5		//ͬԾ,1~16
+#define FDCAN1_DATA_TSG1		19		//1~32
+#define FDCAN1_DATA_TSG2		5		//1~16
+#define FDCAN1_PAD				0xCC	//ݳȲDLCӦĳʱֽ
+
+//ϢRAM(FDCAN1FDCAN22560,һԪռ2+FDCAN1_DATA_MAX/4)
+#define FDCAN1_RAM_WORDS		1280	//FDCAN1ʹõ,һFDCAN2
+#if FDCAN1_FD_EN
+#define FDCAN1_DATA_MAX			64		//һֽ֡:8,12,16,20,24,32,48,64,Ĳղ
+#define FDCAN1_RXF0_NUM			32		//FIFO0Ԫظ,1~64
+#define FDCAN1_RXF1_NUM			16		//FIFO1Ԫظ,0~64
+#define FDCAN1_RXQ_NUM			32		//ÿFIFOն,2
+#define FDCAN1_TXQ_NUM			16		//Ͷ,1~64(FD_TXQ_MAX)
+#else
+#define FDCAN1_DATA_MAX			8
+#define FDCAN1_RXF0_NUM			64
+#define FDCAN1_RXF1_NUM			64
+#define FDCAN1_RXQ_NUM			64
+#define FDCAN1_TXQ_NUM			32
+#endif
+#define FDCAN1_TXB_NUM			8		//ר÷ͻ,1~32,ӲЩﰴIDٲ
+#define FDCAN1_TXE_NUM			16		//¼FIFOԪظ,1~32,ÿռ2
+#define FDCAN1_TXE_WAIT			2		//ȶmsķ¼,FDCAN1_TX_NOTS
+#define FDCAN1_TXPOLL_MAX		10		//FDCAN1_TxPollķֵ(ms)
+#define FDCAN1_AUTOBAUD_FRAMES	2		//ԶⲨʱյ֡ȷ֡ȷ
+#define FDCAN1_AUTO_RETX		1		//Զش:1,,ͳ(ûӦ)ʱӲط;0,ر,ֻһ
+#define FDCAN1_RETX_TIME		100		//ԶشʱFDCAN1_Send֡ȶms,ûFDCAN1_TX_FAIL
+#define FDCAN1_LOAD_WIN			1000	//߸صͳƴ(ms)
+#define FDCAN1_BOFF_MIN			10		//߹رպȶmsʼָ
+#define FDCAN1_BOFF_MAX			1000	//ָFDCAN1_BOFF_STABLE msֹرʱȴʱӱ,ôms
+#define FDCAN1_BOFF_STABLE		5000	//ָ󳬹ômsŹرյ,ȴʱصFDCAN1_BOFF_MIN
+#define FDCAN1_BUSPOLL_MAX		10		//FDCAN1_BusPollķֵ(ms),Ҳ´Эжϵļ
+#define FDCAN1_STD_FILTER_NUM	16		//׼ID˲,0~128,ÿռ1
+#define FDCAN1_EXT_FILTER_NUM	8		//չID˲,0~64,ÿռ2
+#define FDCAN1_NONMATCH			FDCAN_ACCEPT_IN_RX_FIFO0	//ûƥκ˲֡:FDCAN_ACCEPT_IN_RX_FIFO0/1,FIFO0/1;FDCAN_REJECT,
+#define FDCAN1_FOREVER			0xFFFFFFFF	//FDCAN1_Read/FDCAN1_Waitһֱȴ;FDCAN1_Submitʱ(ͬFD_FOREVER)
+
+#if (FDCAN1_STD_FILTER_NUM+FDCAN1_EXT_FILTER_NUM*2+FDCAN1_TXE_NUM*2+(FDCAN1_RXF0_NUM+FDCAN1_RXF1_NUM+FDCAN1_TXB_NUM)*(2+FDCAN1_DATA_MAX/4))>FDCAN1_RAM_WORDS
+#error "FDCAN1 message RAM overflow"
+#endif
+
+//֡־
+#define FDCAN1_F_EXT			FD_F_EXT	//չID
+#define FDCAN1_F_RTR			FD_F_RTR	//Զ֡
+#define FDCAN1_F_FD				FD_F_FD		//CAN FD֡
+#define FDCAN1_F_BRS			FD_F_BRS	//CAN FD֡,ݶлݶβ
+#define FDCAN1_F_ESI			FD_F_ESI	//յ֡:ͽڵ㴦ڴ󱻶״̬
+
+//ɻص״̬
+#define FDCAN1_TX_SENT			FD_TX_SENT		//ѷ,tsΪ֡ʼʱ
+#define FDCAN1_TX_TIMEOUT		FD_TX_TIMEOUT	//ʱûз,Ѷ
+#define FDCAN1_TX_NOTS			FD_TX_NOTS		//ѷ,¼ʧ,tsЧ
+#define FDCAN1_TX_FAIL			FD_TX_FAIL		//ûгʱ֡ͳ(Զشر)FDCAN1_RETX_TIME msû(Զش),Ѷ
+
+//״̬
+#define FDCAN1_BUS_ACTIVE		FD_BUS_ACTIVE	//
+#define FDCAN1_BUS_WARNING		FD_BUS_WARNING	//96
+#define FDCAN1_BUS_PASSIVE		FD_BUS_PASSIVE	//,128
+#define FDCAN1_BUS_OFF			FD_BUS_OFF		//߹ر,ʹ255,ղ,ȴָ
+
+//״̬͸
+typedef struct
+{
+	u8 state;					//FDCAN1_BUS_xxx
+	u8 tec;						//ʹ
+	u8 rec;						//մ,ʱΪ128
+	u8 tec_max;					//ʹֵ
+	u8 rec_max;					//մֵ
+	u8 lec;						//һЭĴ:1,2ʽ,3Ӧ,4λ1,5λ0,6CRC
+	u32 errors;					//ʹӵЭ(ECR.CELۼ)
+	u32 lec_cnt[6];				//PSRʱЭ,,ٲöκݶκϼ
+	u32 warnings;				//뾯״̬Ĵ
+	u32 passives;				//뱻״̬Ĵ
+	u32 busoffs;				//߹رյĴ
+	u32 recoveries;				//ʼָĴ
+	u32 backoff;				//߹رպָǰȴʱ(ms)
+	u32 off_time;				//߹رյۼʱ(ms)
+	u16 load;					//ϸͳƴڵ߸(0.1%),λ,
+	u16 load_peak;				//ֵ(0.1%)
+	u16 load_avg;				//ʼƽ(0.1%)
+	u32 fps;					//ϸͳƴÿ֡(+)
+	u32 eps;					//ϸͳƴÿĴ֡
+}_fdcan_bus;
+
+//յһ֡
+typedef struct
+{
+	u32 id;						//ID
+	u16 ts;						//ʱ(֡ʼʱļֵ,λ1λʱ)
+	u8 flags;					//FDCAN1_F_xxx
+	u8 len;						//ֽ
+	u8 fifo;					//0,FIFO0;1,FIFO1
+	u8 filter;					//ƥ˲,0xFFʾûƥ
+	u8 data[FDCAN1_DATA_MAX];
+}_fdcan_frame;
 
 u8 FDCAN1_Mode_Init(u16 presc,u8 ntsjw,u16 ntsg1,u8 ntsg2,u32 mode);
+u8 FDCAN1_Init_Rate(u32 bitrate,u16 sp,u32 mode);			//ʺͲ(0.1%)ʼ
+u8 FDCAN1_Data_Rate(u32 bitrate,u16 sp);					//ʺͲݶλʱ,´γʼʱЧ
+u32 FDCAN1_AutoBaud(const u32 *rates,u8 num,u16 sp,u32 dwell,u32 timeout,u32 mode);	//ԶⲨʲʼ,ز,0û⵽
+void FDCAN1_Data_Timing(u8 presc,u8 sjw,u8 tsg1,u8 tsg2);		//ݶλʱ,´FDCAN1_Mode_InitʱЧ
+u8 FDCAN1_Send(u32 id,u8 flags,const u8 *data,u8 len);		//һ֡,Ͷ
+u8 FDCAN1_Submit(u32 id,u8 flags,const u8 *data,u8 len,u32 timeout,void (*done)(void *arg,u8 status,u16 ts),void *arg);	//һ֡,ʱɻص
+u32 FDCAN1_TxPoll(void);									//鷢ͳʱ,´εǰȴms
+u8 FDCAN1_Filter(u8 ext,u32 type,u32 id1,u32 id2,u8 fifo);	//һ˲
 u8 FDCAN1_Send_Msg(u8* msg,u32 len);
 u8 FDCAN1_Receive_Msg(u8 *buf);
+u8 FDCAN1_Wait(u32 timeout);								//ȴյһ֡,ȡ
+u8 FDCAN1_Read(_fdcan_frame *frame,u32 timeout);			//ȴյһ֡ȡ
+void FDCAN1_Report(void);									//շͳ
+void FDCAN1_SetHook(void (*hook)(const _fdcan_frame *frame));	//֡,NULLȡ
+u32 FDCAN1_Bitrate(void);									//ٲöβ
+u32 FDCAN1_BusPoll(void);									//߹رջָͳ,´εǰȴms
+void FDCAN1_Bus(_fdcan_bus *bus);							//ȡ״̬͸
 #endif
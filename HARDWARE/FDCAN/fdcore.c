@@ -0,0 +1,430 @@
+#include "fdcore.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CAN/CAN FD֡ʽ
+//:2026/10/19
+//汾V1.2
+//////////////////////////////////////////////////////////////////////////////////
+
+//гʱ֡ʱ״̬
+#define FD_EXPIRED(m)			((m)->timed==2?FD_TX_FAIL:FD_TX_TIMEOUT)
+
+//DLCӦֽ
+static const uint8_t fd_dlc_len[16]={0,1,2,3,4,5,6,7,8,12,16,20,24,32,48,64};
+
+//DLCתΪֽ
+//dlc:0~15
+uint8_t fd_dlc2len(uint8_t dlc)
+{
+	return fd_dlc_len[dlc&0x0F];
+}
+
+//ֽתΪDLC,DLCӦĳʱȡ(CAN FD),6464
+//len:0~64
+uint8_t fd_len2dlc(uint8_t len)
+{
+	uint8_t dlc=8;
+	if(len<=8)return len;
+	while(dlc<15&&fd_dlc_len[dlc]<len)dlc++;
+	return dlc;
+}
+
+//鷢Ͳ
+//id:׼ID(11λ)չID(29λ)
+//flags:FD_F_xxx
+//len:ݳ
+//fd_max:CAN FDֽ֡,0ʾܷCAN FD֡
+//ֵ:0,ȷ;2,(FDCAN1_Sendķֵͬ)
+uint8_t fd_check(uint32_t id,uint8_t flags,uint8_t len,uint8_t fd_max)
+{
+	if(flags&(FD_F_FD|FD_F_BRS))
+	{
+		if(len>64||len>fd_max||(flags&FD_F_RTR))return 2;		//CAN FDûԶ֡
+	}
+	else if(len>8)return 2;
+	if(id>((flags&FD_F_EXT)?0x1FFFFFFFu:0x7FFu))return 2;
+	return 0;
+}
+
+//ݲ뵽DLCӦĳ
+//buf:fd_dlc2len(fd_len2dlc(len))ֽ
+//data:,lenֽ
+//pad:ֽ
+//ֵ:DLC
+uint8_t fd_pad(uint8_t *buf,const uint8_t *data,uint8_t len,uint8_t pad)
+{
+	uint8_t dlc=fd_len2dlc(len);
+	memcpy(buf,data,len);
+	memset(buf+len,pad,fd_dlc_len[dlc]-len);
+	return dlc;
+}
+
+//յֽ֡
+//dlc:֡DLC
+//flags:FD_F_FD,CAN FD֡;FD_F_RTR,Զ֡
+//ֵ:Զ֡Ϊ0,ͳ֡DLC 9~15Ϊ8
+uint8_t fd_rx_len(uint8_t dlc,uint8_t flags)
+{
+	dlc&=0x0F;
+	if(flags&FD_F_RTR)return 0;
+	if(flags&FD_F_FD)return fd_dlc_len[dlc];
+	return dlc>8?8:dlc;
+}
+
+//ٲȼ,ԽСԽȷ:ID(11λ),IDE,չID18λ,RTR
+//ͬIDʱ׼֡չ֡,ͬIDʱ֡Զ֡
+uint32_t fd_key(uint32_t id,uint8_t flags)
+{
+	uint32_t rtr=(flags&FD_F_RTR)?1:0;
+	if(flags&FD_F_EXT)return ((id>>18)<<20)|(1u<<19)|((id&0x3FFFF)<<1)|rtr;
+	return (id<<20)|rtr;
+}
+
+//aǷb:ȼߵȷ,ͬȼӵȷ
+static uint8_t fd_before(const _fd_tx *q,uint8_t a,uint8_t b)
+{
+	if(q->msg[a].key!=q->msg[b].key)return q->msg[a].key<q->msg[b].key;
+	return (int32_t)(q->msg[a].seq-q->msg[b].seq)<0;
+}
+
+//ѵi֡ŵѵposλ,λ
+static void fd_heap_set(_fd_tx *q,uint8_t pos,uint8_t i)
+{
+	q->heap[pos]=i;
+	q->msg[i].pos=pos;
+}
+
+//:ϸ
+static void fd_heap_up(_fd_tx *q,uint8_t pos)
+{
+	uint8_t i=q->heap[pos];
+	while(pos>0&&fd_before(q,i,q->heap[(pos-1)/2]))
+	{
+		fd_heap_set(q,pos,q->heap[(pos-1)/2]);
+		pos=(pos-1)/2;
+	}
+	fd_heap_set(q,pos,i);
+}
+
+//:³
+static void fd_heap_down(_fd_tx *q,uint8_t pos)
+{
+	uint8_t i=q->heap[pos];
+	uint8_t c;
+	while((c=pos*2+1)<q->heap_n)
+	{
+		if(c+1<q->heap_n&&fd_before(q,q->heap[c+1],q->heap[c]))c++;
+		if(!fd_before(q,q->heap[c],i))break;
+		fd_heap_set(q,pos,q->heap[c]);
+		pos=c;
+	}
+	fd_heap_set(q,pos,i);
+}
+
+//Ͷ
+static void fd_heap_push(_fd_tx *q,uint8_t i)
+{
+	q->msg[i].state=FD_TXS_QUEUED;
+	fd_heap_set(q,q->heap_n++,i);
+	fd_heap_up(q,q->heap_n-1);
+	if(q->heap_n>q->peak)q->peak=q->heap_n;
+}
+
+//Ͷɾposλõ֡
+static void fd_heap_del(_fd_tx *q,uint8_t pos)
+{
+	if(--q->heap_n==pos)return;
+	fd_heap_set(q,pos,q->heap[q->heap_n]);
+	fd_heap_up(q,pos);
+	fd_heap_down(q,q->msg[q->heap[pos]].pos);
+}
+
+//ȡר÷ͻs,ȡ(Ѿ)fd_tx_scanﴦ
+static void fd_tx_abort(_fd_tx *q,uint8_t s)
+{
+	q->msg[q->slot[s]].state=FD_TXS_ABORT;
+	q->abort(q,s);
+}
+
+//һ֡:ͷר÷ͻͶԪ,ɻص
+//status:FD_TX_xxx
+//ts:֡ʼʱ
+static void fd_tx_end(_fd_tx *q,uint8_t i,uint8_t status,uint16_t ts,uint32_t now)
+{
+	_fd_txmsg *m=&q->msg[i];
+	if((m->state==FD_TXS_LOADED||m->state==FD_TXS_ABORT)&&q->slot[m->slot]==i)q->slot[m->slot]=0xFF;
+	if(status==FD_TX_TIMEOUT)q->timeout++;
+	else if(status==FD_TX_FAIL)q->fail++;
+	else
+	{
+		if(m->state!=FD_TXS_SENT&&now-m->t>q->wait)q->wait=now-m->t;	//¼ڷɴ,Ƶȴʱ
+		if(status==FD_TX_NOTS)q->nots++;
+		q->tx++;
+		q->bytes+=m->len;
+	}
+	m->state=FD_TXS_FREE;
+	q->freel[q->free_n++]=i;
+	if(m->done!=NULL)m->done(m->arg,status,ts);
+}
+
+//շͶ,û֡صFD_TX_TIMEOUT;øıҲҪ
+void fd_tx_reset(_fd_tx *q)
+{
+	uint8_t size=q->fd_max>8?q->fd_max:8;
+	uint8_t i;
+	for(i=0;i<q->num;i++)
+	{
+		if(q->msg[i].state!=FD_TXS_FREE&&q->msg[i].done!=NULL)q->msg[i].done(q->msg[i].arg,FD_TX_TIMEOUT,0);
+		q->msg[i].state=FD_TXS_FREE;
+		q->msg[i].data=q->buf+(uint32_t)i*size;
+		q->freel[i]=q->num-1-i;
+	}
+	q->free_n=q->num;
+	q->heap_n=0;
+	memset(q->slot,0xFF,sizeof(q->slot));
+}
+
+//һ֡,ȼװר÷ͻ
+//id:׼ID(11λ)չID(29λ)
+//flags:FD_F_xxx
+//len:ݳ,CAN FD֡ȲDLCӦĳʱpad
+//timeout:ʱʱ(ms),ͳʱط,ʱûͶ;FD_FOREVER,ʱ,ͳͶ
+//        (retxΪ0ʱӲһֱط,FD_FOREVER֡retx msûͰFD_TX_FAIL)
+//done:ɻص,NULLص
+//now:ǰʱ(ms)
+//ֵ:0,ɹ;1,;2,
+uint8_t fd_tx_submit(_fd_tx *q,uint32_t id,uint8_t flags,const uint8_t *data,uint8_t len,
+					 uint32_t timeout,void (*done)(void *arg,uint8_t status,uint16_t ts),void *arg,uint32_t now)
+{
+	_fd_txmsg *m;
+	uint8_t i;
+	if(fd_check(id,flags,len,q->fd_max))return 2;
+	if(q->free_n==0)
+	{
+		q->full++;
+		return 1;
+	}
+	i=q->freel[--q->free_n];
+	m=&q->msg[i];
+	m->id=id;
+	m->flags=flags;
+	m->len=len;
+	m->key=fd_key(id,flags);
+	m->seq=q->seq++;
+	m->t=now;
+	m->timed=timeout!=FD_FOREVER;
+	m->deadline=now+timeout;
+	if(!m->timed&&q->retx)
+	{
+		m->timed=2;
+		m->deadline=now+q->retx;
+	}
+	m->done=done;
+	m->arg=arg;
+	fd_pad(m->data,data,len,q->pad);
+	fd_heap_push(q,i);
+	fd_tx_fill(q);
+	return 0;
+}
+
+//Ͷвеר÷ͻ
+//ﻹͬȼ(ͬID)֡ʱװ,װ,֤ͬIDȽȳ(ӲͬIDȺ)
+//ȫҶڻȼ֡ʱ,ȡһ֡λ
+void fd_tx_fill(_fd_tx *q)
+{
+	uint8_t s,i,j,free,worst;
+	while(q->heap_n)
+	{
+		i=q->heap[0];
+		free=0xFF;
+		worst=0xFF;
+		for(s=0;s<q->nslot;s++)
+		{
+			j=q->slot[s];
+			if(j==0xFF)
+			{
+				if(free==0xFF)free=s;
+				continue;
+			}
+			if(q->msg[j].key==q->msg[i].key)return;
+			if(q->msg[j].state==FD_TXS_ABORT)worst=0xFE;						//Ѿλ,ȡ
+			else if(worst!=0xFE&&(worst==0xFF||q->msg[j].key>q->msg[q->slot[worst]].key))worst=s;
+		}
+		if(free==0xFF)
+		{
+			if(worst<q->nslot&&q->msg[q->slot[worst]].key>q->msg[i].key)
+			{
+				fd_tx_abort(q,worst);
+				q->preempt++;
+			}
+			return;
+		}
+		fd_heap_del(q,0);
+		if(q->load(q,free,i))
+		{
+			fd_heap_push(q,i);
+			return;
+		}
+		q->msg[i].state=FD_TXS_LOADED;
+		q->msg[i].slot=free;
+		q->slot[free]=i;
+	}
+}
+
+//ר÷ͻ:ĵȷ¼;ͳûгʱͶ;ȡĳʱ˾Ͷ,ŻͶ;Ȼ󲹳仺
+//߹رջָҲҪһ,߹رʱӲķ󰴳
+void fd_tx_scan(_fd_tx *q,uint32_t now)
+{
+	_fd_txmsg *m;
+	uint8_t s,i,st;
+	for(s=0;s<q->nslot;s++)
+	{
+		i=q->slot[s];
+		if(i==0xFF)continue;
+		st=q->status(q,s);
+		if(st&FD_TXB_PENDING)continue;
+		m=&q->msg[i];
+		if(st&FD_TXB_SENT)
+		{
+			q->slot[s]=0xFF;
+			if(now-m->t>q->wait)q->wait=now-m->t;
+			m->state=FD_TXS_SENT;
+			m->t=now;
+		}
+		else if(m->state==FD_TXS_LOADED&&!m->timed)fd_tx_end(q,i,FD_TX_FAIL,0,now);	//ȡ,Ƿͳ
+		else if(m->timed&&(int32_t)(now-m->deadline)>=0)fd_tx_end(q,i,FD_EXPIRED(m),0,now);
+		else
+		{
+			q->slot[s]=0xFF;
+			fd_heap_push(q,i);
+		}
+	}
+	fd_tx_fill(q);
+}
+
+//¼:ʱiҵӦ֡,صʱ
+//i:loadصʱi(FDCANMessageMarker)
+//id:¼ID,֡IDͬʱǳʱѾ֡,
+//ts:֡ʼʱ
+void fd_tx_event(_fd_tx *q,uint8_t i,uint32_t id,uint16_t ts,uint32_t now)
+{
+	if(i>=q->num||q->msg[i].state<FD_TXS_LOADED||q->msg[i].id!=id)return;
+	fd_tx_end(q,i,FD_TX_SENT,ts,now);
+}
+
+//鷢ͳʱ:Ķ,װ뷢ͻȡ;ev_wait msûз¼İFD_TX_NOTS
+//now:ǰʱ(ms)
+//max:ֵ
+//ֵ:msҪٵһ,1~max
+uint32_t fd_tx_poll(_fd_tx *q,uint32_t now,uint32_t ev_wait,uint32_t max)
+{
+	_fd_txmsg *m;
+	uint32_t t,wait=max;
+	uint8_t i;
+	fd_tx_scan(q,now);
+	for(i=0;i<q->num;i++)
+	{
+		m=&q->msg[i];
+		if(m->state==FD_TXS_SENT)
+		{
+			if(now-m->t>=ev_wait)fd_tx_end(q,i,FD_TX_NOTS,0,now);
+			else wait=1;
+			continue;
+		}
+		if(m->state==FD_TXS_FREE||m->state==FD_TXS_ABORT||!m->timed)continue;
+		t=m->deadline-now;
+		if((int32_t)t<=0)
+		{
+			if(m->state==FD_TXS_QUEUED)
+			{
+				fd_heap_del(q,m->pos);
+				fd_tx_end(q,i,FD_EXPIRED(m),0,now);
+			}
+			else fd_tx_abort(q,m->slot);							//ȡɺfd_tx_scanﰴʱ
+		}
+		else if(t<wait)wait=t;
+	}
+	fd_tx_fill(q);
+	return wait;
+}
+
+//״̬ͳ,ò;ʼʱ
+void fd_bus_reset(_fd_bus *b)
+{
+	uint32_t min=b->boff_min,max=b->boff_max,stable=b->boff_stable;
+	memset(b,0,sizeof(_fd_bus));
+	b->boff_min=min;
+	b->boff_max=max;
+	b->boff_stable=stable;
+	b->backoff=min;
+}
+
+//״̬ʹͳ
+//state:FD_BUS_xxx
+//tec/rec:/մ,ʱrecΪ128
+//cel:ϴζʹӵЭ
+//lec/dlec:ٲö/ݶһЭĴ,0ûд,7ûб仯
+//now:ǰʱ(ms)
+//ֵ:1,߹رջָ(),Ҫ¼鷢ͻ;0,
+uint8_t fd_bus_update(_fd_bus *b,uint8_t state,uint8_t tec,uint8_t rec,uint8_t cel,uint8_t lec,uint8_t dlec,uint32_t now)
+{
+	uint8_t up=0;
+	b->tec=tec;
+	b->rec=rec;
+	if(tec>b->tec_max)b->tec_max=tec;
+	if(rec>b->rec_max)b->rec_max=rec;
+	b->errors+=cel;
+	if(lec>=1&&lec<=6)
+	{
+		b->lec=lec;
+		b->lec_cnt[lec-1]++;
+	}
+	if(dlec>=1&&dlec<=6)
+	{
+		b->lec=dlec;
+		b->lec_cnt[dlec-1]++;
+	}
+	if(state==b->state)return 0;
+	if(state==FD_BUS_OFF)
+	{
+		b->busoffs++;
+		if(b->recoveries&&now-b->up_t<b->boff_stable)				//ָֹܿر,ȴʱӱ
+		{
+			b->backoff*=2;
+			if(b->backoff>b->boff_max)b->backoff=b->boff_max;
+		}
+		else b->backoff=b->boff_min;
+		b->boff_t=now;
+		b->boff_run=0;
+	}
+	else if(state==FD_BUS_PASSIVE&&b->state<FD_BUS_PASSIVE)b->passives++;
+	else if(state==FD_BUS_WARNING&&b->state<FD_BUS_WARNING)b->warnings++;
+	if(b->state==FD_BUS_OFF)
+	{
+		b->off_time+=now-b->boff_t;
+		b->up_t=now;
+		b->boff_run=0;
+		up=1;
+	}
+	b->state=state;
+	return up;
+}
+
+//߹رպǷ˿ʼָʱ
+//now:ǰʱ(ms)
+//wait:Ҫȵʱ*waitʱΪҪȵʱ
+//ֵ:1,ʼָ,ÿ²(Ӳ⵽12911λص);0,ʲô
+uint8_t fd_bus_poll(_fd_bus *b,uint32_t now,uint32_t *wait)
+{
+	uint32_t t;
+	if(b->state!=FD_BUS_OFF||b->boff_run)return 0;
+	t=now-b->boff_t;
+	if(t>=b->backoff)
+	{
+		b->boff_run=1;
+		b->recoveries++;
+		return 1;
+	}
+	if(b->backoff-t<*wait)*wait=b->backoff-t;
+	return 0;
+}
@@ -0,0 +1,155 @@
+#ifndef _FDCORE_H
+#define _FDCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CAN/CAN FD֡ʽ:DLCͳȵתͲ顢ݡճ
+//ֻñ׼C,HALFDCAN,fdcan.cPCԹ
+//:2026/10/19
+//汾V1.2
+//********************************************************************************
+//DLC 0~8Ӧ0~8ֽ,9~15Ӧ12,16,20,24,32,48,64ֽ(CAN FD);ͳ֡DLC 9~15Ҳֻ8ֽ
+//CAN FD֡ĳȲDLCӦĳʱȡ,ֽfd_pad
+//V1.1 20261019
+//ӷͶ(_fd_tx):ٲȼ(),װnslotר÷ͻ,ӲڻﰴIDٲ
+//ﻹͬID֡ʱװ,֤ͬIDȽȳ;ȫʱȼߵ֡,ȡȼ͵һ֡λ
+//Ӳload/abort/statusص,ʱ(ms)ɵߴ,߸𻥳(ж)
+//V1.2 20261019
+//Ͷretx:ӲԶشʱûгʱ֡طretx ms,FD_TX_FAIL
+//״̬(_fd_bus):߶ʹ뽻fd_bus_update,ͳƽ״̬ĴЭ;
+//߹رպfd_bus_poll˱ʱ֪ͨ߿ʼָ,ָֹܿرʱȴʱӱ
+//////////////////////////////////////////////////////////////////////////////////
+
+//֡־,FDCAN1_F_xxxͬ
+#define FD_F_EXT				0x01	//չID
+#define FD_F_RTR				0x02	//Զ֡
+#define FD_F_FD					0x04	//CAN FD֡
+#define FD_F_BRS				0x08	//CAN FD֡,ݶл
+#define FD_F_ESI				0x10	//յ֡:ͽڵ㴦ڴ󱻶״̬
+
+#define FD_TXQ_MAX				64		//Ͷ֡
+#define FD_TXB_MAX				32		//ר÷ͻ
+#define FD_FOREVER				0xFFFFFFFF	//fd_tx_submit:ʱ
+
+//ɻص״̬
+#define FD_TX_SENT				0		//ѷ,tsΪ֡ʼʱ
+#define FD_TX_TIMEOUT			1		//ʱûз,Ѷ
+#define FD_TX_NOTS				2		//ѷ,¼ʧ,tsЧ
+#define FD_TX_FAIL				3		//ûгʱ֡ͳ(ûӦ),Ѷ
+
+//ר÷ͻӲ״̬,statusصķֵ
+#define FD_TXB_PENDING			0x01	//ͻûн
+#define FD_TXB_SENT				0x02	//ѷ
+
+//״̬
+#define FD_BUS_ACTIVE			0		//
+#define FD_BUS_WARNING			1		//96
+#define FD_BUS_PASSIVE			2		//,128
+#define FD_BUS_OFF				3		//߹ر,ʹ255,ղ,ȴָ
+
+//ͶԪص״̬
+#define FD_TXS_FREE				0		//
+#define FD_TXS_QUEUED			1		//Ͷ
+#define FD_TXS_LOADED			2		//ר÷ͻȴ
+#define FD_TXS_ABORT			3		//ȡ(λʱ)
+#define FD_TXS_SENT				4		//ѷ,ȷ¼
+
+//Ͷһ֡
+typedef struct
+{
+	uint32_t id;
+	uint32_t key;				//ٲȼ,ԽСԽȷ
+	uint32_t seq;				//Ӵ,ͬȼӵȷ
+	uint32_t t;					//ӵʱ,Ϊʱ
+	uint32_t deadline;			//ʱʱ
+	void (*done)(void *arg,uint8_t status,uint16_t ts);	//ɻص
+	void *arg;
+	uint8_t *data;				//,Ѳ뵽DLCӦĳ
+	uint8_t flags;				//FD_F_xxx
+	uint8_t len;				//ֽ(ֽ)
+	uint8_t timed;				//1,гʱ;2,ûгʱ,retx msFD_TX_FAIL
+	uint8_t state;				//FD_TXS_xxx
+	uint8_t slot;				//ڵר÷ͻ
+	uint8_t pos;				//ڶλ
+}_fd_txmsg;
+
+typedef struct _fd_tx
+{
+	//,ɵ,Ȼfd_tx_reset
+	_fd_txmsg *msg;				//numԪ
+	uint8_t *buf;				//num*(fd_max8д)ֽ,ÿ֡
+	uint8_t num;				//Ͷ,1~FD_TXQ_MAX
+	uint8_t nslot;				//ר÷ͻ,1~FD_TXB_MAX
+	uint8_t fd_max;				//CAN FDֽ֡,0ʾܷCAN FD֡
+	uint8_t pad;				//ֽ
+	uint32_t retx;				//ӲԶشʱûгʱ֡طms;0,ӲԶش,ͳͶ
+	uint8_t (*load)(struct _fd_tx *q,uint8_t s,uint8_t i);	//msg[i]װ뻺s,¼i;0ɹ
+	void (*abort)(struct _fd_tx *q,uint8_t s);				//ȡs,fd_tx_scan
+	uint8_t (*status)(struct _fd_tx *q,uint8_t s);			//s״̬FD_TXB_xxx
+
+	//״̬
+	uint8_t heap[FD_TXQ_MAX];	//Ͷ:ȼĶ
+	uint8_t freel[FD_TXQ_MAX];	//Ԫջ
+	uint8_t slot[FD_TXB_MAX];	//ÿר÷ͻ֡,0xFFʾ
+	uint8_t heap_n;
+	uint8_t free_n;
+	uint32_t seq;
+
+	//ͳ
+	uint32_t tx;				//֡
+	uint32_t bytes;				//ֽ
+	uint32_t full;				//,ûз֡
+	uint32_t timeout;			//ʱ֡
+	uint32_t fail;				//ͳ֡
+	uint32_t preempt;			//Ϊȼ֡λ(ȡŻض)Ĵ
+	uint32_t nots;				//¼ʧ֡
+	uint32_t wait;				//ӵʱ(ms)
+	uint8_t peak;				//Ͷ
+}_fd_tx;
+
+//״̬ʹͳ
+typedef struct
+{
+	//,ɵ,Ȼfd_bus_reset
+	uint32_t boff_min;			//߹رպȶmsʼָ
+	uint32_t boff_max;			//ָboff_stable msֹرʱȴʱӱ,ôms
+	uint32_t boff_stable;		//ָ󳬹ômsŹرյ,ȴʱصboff_min
+
+	//״̬ͳ
+	uint8_t state;				//FD_BUS_xxx
+	uint8_t tec;				//ʹ
+	uint8_t rec;				//մ,ʱΪ128
+	uint8_t tec_max;			//ʹֵ
+	uint8_t rec_max;			//մֵ
+	uint8_t lec;				//һЭĴ:1,2ʽ,3Ӧ,4λ1,5λ0,6CRC
+	uint8_t boff_run;			//1,Ѿʼָ,Ӳ⵽߿
+	uint32_t errors;			//ʹӵЭ
+	uint32_t lec_cnt[6];		//Э,,ٲöκݶκϼ
+	uint32_t warnings;			//뾯״̬Ĵ
+	uint32_t passives;			//뱻״̬Ĵ
+	uint32_t busoffs;			//߹رյĴ
+	uint32_t recoveries;		//ʼָĴ
+	uint32_t backoff;			//߹رպָǰȴʱ(ms)
+	uint32_t off_time;			//߹رյۼʱ(ms)
+	uint32_t boff_t;			//߹رյʱ
+	uint32_t up_t;				//ϴδ߹رջָʱ
+}_fd_bus;
+
+uint8_t fd_dlc2len(uint8_t dlc);												//DLC(0~15)תΪֽ
+uint8_t fd_len2dlc(uint8_t len);												//ֽתΪDLC,ȡ
+uint8_t fd_check(uint32_t id,uint8_t flags,uint8_t len,uint8_t fd_max);			//鷢Ͳ,0ȷ,2
+uint8_t fd_pad(uint8_t *buf,const uint8_t *data,uint8_t len,uint8_t pad);		//ݲ뵽DLCӦĳ,DLC
+uint8_t fd_rx_len(uint8_t dlc,uint8_t flags);									//յֽ֡
+
+uint32_t fd_key(uint32_t id,uint8_t flags);									//ٲȼ,ԽСԽȷ
+void fd_tx_reset(_fd_tx *q);													//շͶ,û֡صFD_TX_TIMEOUT
+uint8_t fd_tx_submit(_fd_tx *q,uint32_t id,uint8_t flags,const uint8_t *data,uint8_t len,
+					 uint32_t timeout,void (*done)(void *arg,uint8_t status,uint16_t ts),void *arg,uint32_t now);	//һ֡,0ɹ,1,2
+void fd_tx_fill(_fd_tx *q);														//веר÷ͻ
+void fd_tx_scan(_fd_tx *q,uint32_t now);										//ר÷ͻ(/ȡж)
+void fd_tx_event(_fd_tx *q,uint8_t i,uint32_t id,uint16_t ts,uint32_t now);	//¼:msg[i]ʱts
+uint32_t fd_tx_poll(_fd_tx *q,uint32_t now,uint32_t ev_wait,uint32_t max);		//鳬ʱ,´ٵõms
+
+void fd_bus_reset(_fd_bus *b);													//״̬ͳ,ò
+uint8_t fd_bus_update(_fd_bus *b,uint8_t state,uint8_t tec,uint8_t rec,uint8_t cel,uint8_t lec,uint8_t dlec,uint32_t now);	//״̬,1߹رջָ
+uint8_t fd_bus_poll(_fd_bus *b,uint32_t now,uint32_t *wait);					//1˿ʼָʱ
+#endif
@@ -0,0 +1,541 @@
+//////////////////////////////////////////////////////////////////////////////////
+//fdcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -IHARDWARE/FDCAN HARDWARE/FDCAN/fdcore_test.c HARDWARE/FDCAN/fdcore.c
+//DLCͳȵתͲ(IDΧͳ֡/CAN FD֡ȡCAN FDԶ֧֡CAN FDʱܾ)
+//뵽DLCȡʱDLCȡ(ͳ֡DLC 9~15Ϊ8,Զ֡Ϊ0)
+//Ͷ:ģר÷ͻ(IDٲáȡûӦ𡢷¼)鷢˳λʱ;
+//ѹԼÿֻ֡һΡͬIDȽȳϷ֡ȶ֡ȼ
+//Զشʱûгʱ֡retx msFD_TX_FAIL
+//״̬:ࡢ״̬Ĵ߹رպ˱ʱ(ӱޡȶصС)͹رʱ
+//////////////////////////////////////////////////////////////////////////////////
+#include "fdcore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(c)	do{if(!(c)){printf("fdcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define PAD			0xCC
+#define TNUM		16			//Ͷ
+#define NREC		4096		//¼֡
+
+//ģר÷ͻ
+static _fd_txmsg tm[TNUM];
+static uint8_t tbuf[TNUM*64];
+static _fd_tx q;
+static uint32_t hw_pend;		//͵Ļ
+static uint32_t hw_sent;		//ѷĻ
+static uint32_t hw_abort;		//ȡĻ
+static uint8_t hw_mark[FD_TXB_MAX];
+static uint32_t hw_id[FD_TXB_MAX];
+static uint8_t hw_flags[FD_TXB_MAX];
+static uint8_t hw_len[FD_TXB_MAX];
+static uint8_t hw_data[FD_TXB_MAX][64];
+static uint8_t hw_nack;			//1,ûӦ(ͳ)
+static uint8_t hw_noev;			//1,д¼
+static uint8_t hw_evfirst;		//1,ȴ¼ٴ
+static uint8_t hw_late;			//1,ȡʱ֡Ѿڷ,ȡʧ
+static uint8_t hw_loads;		//loadصĴ
+static uint16_t hw_ts;
+static uint32_t now;
+
+//Ϸ֡
+static uint32_t out_id[NREC];
+static uint8_t out_flags[NREC];
+static uint8_t out_len[NREC];
+static uint8_t out_data[NREC][64];
+static uint32_t out_n;
+
+//ɻصĽ,argΪύ
+static uint8_t done_st[NREC];
+static uint16_t done_ts[NREC];
+static uint32_t done_n;
+static uint32_t done_twice;
+
+static void done(void *arg,uint8_t status,uint16_t ts)
+{
+	long n=(long)arg;
+	if(done_st[n]!=0xFF)done_twice++;
+	done_st[n]=status;
+	done_ts[n]=ts;
+	done_n++;
+}
+
+static uint8_t hw_load(_fd_tx *t,uint8_t s,uint8_t i)
+{
+	_fd_txmsg *m=&t->msg[i];
+	hw_loads++;
+	hw_id[s]=m->id;
+	hw_flags[s]=m->flags;
+	hw_len[s]=fd_dlc2len(fd_len2dlc(m->len));
+	memcpy(hw_data[s],m->data,hw_len[s]);
+	hw_mark[s]=i;
+	hw_pend|=1u<<s;
+	hw_sent&=~(1u<<s);
+	return 0;
+}
+
+static void hw_cancel(_fd_tx *t,uint8_t s)
+{
+	hw_abort|=1u<<s;
+}
+
+static uint8_t hw_status(_fd_tx *t,uint8_t s)
+{
+	return ((hw_pend>>s)&1?FD_TXB_PENDING:0)|((hw_sent>>s)&1?FD_TXB_SENT:0);
+}
+
+//s֡,Ӧʱ¼д¼,Ȼжһfd_tx_scan
+static void hw_tx(uint8_t s)
+{
+	uint8_t mark=hw_mark[s];		//¼FIFOǷʱֵ,fd_tx_scanװһ֡
+	uint32_t id=hw_id[s];
+	hw_pend&=~(1u<<s);
+	hw_ts+=47+8*hw_len[s];
+	if(!hw_nack)
+	{
+		hw_sent|=1u<<s;
+		if(out_n<NREC)
+		{
+			out_id[out_n]=hw_id[s];
+			out_flags[out_n]=hw_flags[s];
+			out_len[out_n]=hw_len[s];
+			memcpy(out_data[out_n],hw_data[s],hw_len[s]);
+			out_n++;
+		}
+		if(hw_evfirst&&!hw_noev)fd_tx_event(&q,mark,id,hw_ts,now);
+	}
+	fd_tx_scan(&q,now);
+	if(!hw_nack&&!hw_evfirst&&!hw_noev)fd_tx_event(&q,mark,id,hw_ts,now);
+}
+
+//Ϸһ֡:ȡ(hw_lateʱȡʧ,֡),͵ĻﰴIDٲ,ͬIDСȷ
+//ֵ:Ļ,0xFFû֡;*invΪ1ʱ֡ȼ֡
+static uint8_t bus_step(uint8_t *inv)
+{
+	uint32_t a;
+	uint8_t s,best=0xFF;
+	while(hw_abort)
+	{
+		a=hw_abort;
+		hw_abort=0;
+		for(s=0;s<q.nslot;s++)
+		{
+			if(!((a>>s)&1)||!((hw_pend>>s)&1))continue;
+			if(hw_late)hw_tx(s);
+			else hw_pend&=~(1u<<s);
+		}
+		fd_tx_scan(&q,now);
+	}
+	for(s=0;s<q.nslot;s++)
+	{
+		if(!((hw_pend>>s)&1))continue;
+		if(best==0xFF||fd_key(hw_id[s],hw_flags[s])<fd_key(hw_id[best],hw_flags[best]))best=s;
+	}
+	if(best==0xFF)return 0xFF;
+	*inv=q.heap_n&&q.msg[q.heap[0]].key<fd_key(hw_id[best],hw_flags[best]);
+	hw_tx(best);
+	return best;
+}
+
+//һֱû֡
+static void bus_run(void)
+{
+	uint8_t inv;
+	while(bus_step(&inv)!=0xFF);
+}
+
+static void tx_setup(uint8_t num,uint8_t nslot,uint8_t fd_max)
+{
+	memset(&q,0,sizeof(q));
+	memset(tm,0,sizeof(tm));
+	q.msg=tm;
+	q.buf=tbuf;
+	q.num=num;
+	q.nslot=nslot;
+	q.fd_max=fd_max;
+	q.pad=PAD;
+	q.load=hw_load;
+	q.abort=hw_cancel;
+	q.status=hw_status;
+	fd_tx_reset(&q);
+	hw_pend=hw_sent=hw_abort=0;
+	hw_nack=hw_noev=hw_evfirst=hw_late=0;
+	hw_loads=0;
+	hw_ts=0;
+	now=0;
+	out_n=0;
+	done_n=0;
+	done_twice=0;
+	memset(done_st,0xFF,sizeof(done_st));
+}
+
+static int test_dlc(void)
+{
+	uint8_t len,dlc;
+	for(dlc=0;dlc<16;dlc++)CHECK(fd_len2dlc(fd_dlc2len(dlc))==dlc);
+	for(len=0;len<=64;len++)
+	{
+		dlc=fd_len2dlc(len);
+		CHECK(fd_dlc2len(dlc)>=len);
+		CHECK(dlc==0||fd_dlc2len(dlc-1)<len);		//ȡDLC
+	}
+	CHECK(fd_len2dlc(13)==10&&fd_len2dlc(33)==14&&fd_len2dlc(49)==15);
+	CHECK(fd_len2dlc(65)==15&&fd_dlc2len(0x1F)==64);
+	return 0;
+}
+
+static int test_check(void)
+{
+	CHECK(fd_check(0x7FF,0,8,64)==0);
+	CHECK(fd_check(0x800,0,1,64)==2);				//׼ID11λ
+	CHECK(fd_check(0x1FFFFFFF,FD_F_EXT,1,64)==0);
+	CHECK(fd_check(0x20000000,FD_F_EXT,1,64)==2);
+	CHECK(fd_check(0x100,0,9,64)==2);				//ͳ֡8ֽ
+	CHECK(fd_check(0x100,FD_F_RTR,0,64)==0);
+	CHECK(fd_check(0x100,FD_F_FD,64,64)==0);
+	CHECK(fd_check(0x100,FD_F_FD,65,64)==2);
+	CHECK(fd_check(0x100,FD_F_FD,20,16)==2);		//FDCAN1_DATA_MAX
+	CHECK(fd_check(0x100,FD_F_BRS,12,16)==0);		//BRSҲCAN FD֡
+	CHECK(fd_check(0x100,FD_F_FD|FD_F_RTR,0,64)==2);	//CAN FDûԶ֡
+	CHECK(fd_check(0x100,FD_F_FD,8,0)==2);			//ͳCANܷCAN FD֡
+	CHECK(fd_check(0x100,0,8,0)==0);
+	return 0;
+}
+
+static int test_pad(void)
+{
+	uint8_t d[64],buf[64];
+	uint8_t i,len;
+	for(i=0;i<64;i++)d[i]=i;
+	for(len=0;len<=64;len++)
+	{
+		memset(buf,0,sizeof(buf));
+		CHECK(fd_pad(buf,d,len,PAD)==fd_len2dlc(len));
+		CHECK(memcmp(buf,d,len)==0);
+		for(i=len;i<fd_dlc2len(fd_len2dlc(len));i++)CHECK(buf[i]==PAD);
+		for(;i<64;i++)CHECK(buf[i]==0);				//дDLCȵĲ
+	}
+	return 0;
+}
+
+static int test_rx_len(void)
+{
+	uint8_t dlc;
+	for(dlc=0;dlc<16;dlc++)
+	{
+		CHECK(fd_rx_len(dlc,0)==(dlc>8?8:dlc));
+		CHECK(fd_rx_len(dlc,FD_F_EXT)==(dlc>8?8:dlc));
+		CHECK(fd_rx_len(dlc,FD_F_FD|FD_F_BRS)==fd_dlc2len(dlc));
+		CHECK(fd_rx_len(dlc,FD_F_RTR)==0);			//Զ֡DLCĳ,û
+	}
+	return 0;
+}
+
+static int test_key(void)
+{
+	CHECK(fd_key(0x100,0)<fd_key(0x100,FD_F_RTR));				//֡Զ֡
+	CHECK(fd_key(0x100,FD_F_RTR)<fd_key(0x100<<18,FD_F_EXT));	//ͬID׼֡չ֡
+	CHECK(fd_key(0x100<<18,FD_F_EXT)<fd_key((0x100<<18)|1,FD_F_EXT));
+	CHECK(fd_key(0x7FF,FD_F_RTR)<fd_key(0x1FFFFFFF,FD_F_EXT));		//SRRRTR,IDE
+	CHECK(fd_key(0x3FFFF,FD_F_EXT)<fd_key(0x001,0));			//չ֡IDΪ0,ڱ׼ID 1
+	return 0;
+}
+
+//ٲȼ:IDСȷ,ͬID׼֡չ֡,֡Զ֡,ͬIDӵȷ
+static int test_order(void)
+{
+	uint8_t d[64];
+	uint8_t i;
+	for(i=0;i<64;i++)d[i]=i;
+	tx_setup(TNUM,2,64);
+	CHECK(fd_tx_submit(&q,0x300,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	CHECK(fd_tx_submit(&q,0x100<<18,FD_F_EXT,d,8,FD_FOREVER,done,(void*)1,now)==0);
+	CHECK(fd_tx_submit(&q,0x100,FD_F_RTR,d,0,FD_FOREVER,done,(void*)2,now)==0);
+	CHECK(fd_tx_submit(&q,0x100,0,d,2,FD_FOREVER,done,(void*)3,now)==0);
+	CHECK(fd_tx_submit(&q,0x100,0,d+1,2,FD_FOREVER,done,(void*)4,now)==0);
+	CHECK(fd_tx_submit(&q,0x123,FD_F_FD|FD_F_BRS,d,13,FD_FOREVER,done,(void*)5,now)==0);
+	CHECK(q.preempt==1&&hw_abort==1);	//0x300λ0x100Զ֡,ȡǰȡ֡
+	bus_run();
+	CHECK(out_n==6);
+	CHECK(out_id[0]==0x100&&out_flags[0]==0&&out_len[0]==2&&out_data[0][0]==0);
+	CHECK(out_id[1]==0x100&&out_flags[1]==0&&out_data[1][0]==1);	//ͬIDӵȷ
+	CHECK(out_id[2]==0x100&&out_flags[2]==FD_F_RTR);
+	CHECK(out_id[3]==(0x100<<18)&&out_flags[3]==FD_F_EXT);			//ID 0x1000x123
+	CHECK(out_id[4]==0x123&&out_len[4]==16);						//13ֽڲ16ֽ
+	CHECK(memcmp(out_data[4],d,13)==0&&out_data[4][13]==PAD&&out_data[4][15]==PAD);
+	CHECK(out_id[5]==0x300);
+	CHECK(done_n==6&&done_twice==0);
+	for(i=0;i<6;i++)CHECK(done_st[i]==FD_TX_SENT);
+	CHECK(done_ts[3]<done_ts[4]&&done_ts[4]<done_ts[2]&&done_ts[2]<done_ts[1]&&done_ts[1]<done_ts[5]&&done_ts[5]<done_ts[0]);
+	CHECK(q.tx==6&&q.bytes==8+8+0+2+2+13&&q.free_n==TNUM&&q.heap_n==0);
+	return 0;
+}
+
+//ȫʱȼ֡ûȼ͵֡λ;λʱȡ֡;ȡʧ(Ѿ)֡
+static int test_preempt(void)
+{
+	uint8_t d[8]={0};
+	uint8_t inv;
+	tx_setup(TNUM,2,0);
+	CHECK(fd_tx_submit(&q,0x500,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	CHECK(fd_tx_submit(&q,0x600,0,d,8,FD_FOREVER,done,(void*)1,now)==0);
+	CHECK(hw_pend==3&&q.heap_n==0);
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)2,now)==0);
+	CHECK(q.preempt==1&&hw_abort==2);								//ȡ0x600ڵĻ1
+	CHECK(fd_tx_submit(&q,0x101,0,d,8,FD_FOREVER,done,(void*)3,now)==0);
+	CHECK(q.preempt==1);											//Ȼ1ȡ
+	CHECK(bus_step(&inv)==1&&out_id[0]==0x100&&!inv);				//0x100װ뻺1,0x1010x500λ
+	CHECK(q.preempt==2);
+	bus_run();
+	CHECK(out_n==4&&out_id[1]==0x101&&out_id[2]==0x500&&out_id[3]==0x600);
+	CHECK(done_n==4&&done_twice==0&&q.tx==4);
+
+	tx_setup(TNUM,1,0);
+	hw_late=1;
+	CHECK(fd_tx_submit(&q,0x500,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)1,now)==0);
+	bus_run();
+	CHECK(out_n==2&&out_id[0]==0x500&&out_id[1]==0x100);
+	CHECK(done_n==2&&done_st[0]==FD_TX_SENT&&done_st[1]==FD_TX_SENT&&done_twice==0);
+	return 0;
+}
+
+//ʱ:ֱӶ,ȡ;ûгʱ֡Ӱ
+static int test_timeout(void)
+{
+	uint8_t d[8]={0};
+	uint32_t w;
+	tx_setup(TNUM,1,0);
+	CHECK(fd_tx_submit(&q,0x200,0,d,8,5,done,(void*)0,now)==0);			//װ뻺
+	CHECK(fd_tx_submit(&q,0x300,0,d,8,8,done,(void*)1,now)==0);			//
+	CHECK(fd_tx_submit(&q,0x400,0,d,8,FD_FOREVER,done,(void*)2,now)==0);
+	now=4;
+	CHECK(fd_tx_poll(&q,now,2,10)==1&&done_n==0);						//1ms0x200ʱ
+	now=5;
+	w=fd_tx_poll(&q,now,2,10);
+	CHECK(w==3&&done_n==0&&hw_abort==1);								//0x200ȡ
+	now=6;
+	bus_run();
+	CHECK(done_st[0]==FD_TX_TIMEOUT&&out_n==2&&out_id[0]==0x300&&out_id[1]==0x400);
+	CHECK(done_n==3&&done_st[1]==FD_TX_SENT&&done_st[2]==FD_TX_SENT&&q.timeout==1);
+	now=100;
+	CHECK(fd_tx_poll(&q,now,2,10)==10);
+
+	tx_setup(TNUM,1,0);
+	CHECK(fd_tx_submit(&q,0x200,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	CHECK(fd_tx_submit(&q,0x300,0,d,8,3,done,(void*)1,now)==0);
+	now=3;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==1&&done_st[1]==FD_TX_TIMEOUT&&q.heap_n==0&&q.timeout==1);
+	bus_run();
+	CHECK(out_n==1&&out_id[0]==0x200&&done_st[0]==FD_TX_SENT);
+	return 0;
+}
+
+//ûӦ:ûгʱֻ֡һ,صFD_TX_FAIL;гʱķŻضط
+//¼ʧʱev_waitFD_TX_NOTS
+static int test_fail(void)
+{
+	uint8_t d[8]={0};
+	uint8_t inv;
+	tx_setup(TNUM,2,0);
+	hw_nack=1;
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	CHECK(fd_tx_submit(&q,0x200,0,d,8,50,done,(void*)1,now)==0);
+	CHECK(bus_step(&inv)==0&&done_n==1&&done_st[0]==FD_TX_FAIL&&q.fail==1);
+	CHECK(bus_step(&inv)!=0xFF&&done_n==1&&hw_loads==3);				//0x200װ
+	CHECK(bus_step(&inv)!=0xFF&&done_n==1);
+	hw_nack=0;
+	CHECK(bus_step(&inv)!=0xFF&&done_n==2&&done_st[1]==FD_TX_SENT&&out_n==1);
+
+	tx_setup(TNUM,2,0);
+	hw_noev=1;
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)0,now)==0);
+	bus_run();
+	CHECK(done_n==0&&out_n==1);
+	now=1;
+	CHECK(fd_tx_poll(&q,now,2,10)==1&&done_n==0);
+	now=2;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==1&&done_st[0]==FD_TX_NOTS&&q.nots==1&&q.tx==1);
+	return 0;
+}
+
+//
+static int test_full(void)
+{
+	uint8_t d[64]={0};
+	long i;
+	tx_setup(4,2,0);
+	for(i=0;i<4;i++)CHECK(fd_tx_submit(&q,0x100+i,0,d,8,FD_FOREVER,done,(void*)i,now)==0);
+	CHECK(fd_tx_submit(&q,0x10,0,d,8,FD_FOREVER,done,(void*)4,now)==1&&q.full==1);
+	CHECK(fd_tx_submit(&q,0x800,0,d,8,FD_FOREVER,done,(void*)4,now)==2);
+	CHECK(fd_tx_submit(&q,0x10,FD_F_FD,d,8,FD_FOREVER,done,(void*)4,now)==2);	//fd_maxΪ0
+	CHECK(q.peak==2);
+	fd_tx_reset(&q);
+	CHECK(done_n==4&&done_st[0]==FD_TX_TIMEOUT&&done_st[3]==FD_TX_TIMEOUT&&q.free_n==4);
+	hw_pend=0;
+	CHECK(fd_tx_submit(&q,0x10,0,d,8,FD_FOREVER,done,(void*)4,now)==0);
+	bus_run();
+	CHECK(out_n==1&&done_st[4]==FD_TX_SENT);
+	return 0;
+}
+
+//Զش:ûӦʱӲһֱط(һֱ),ûгʱ֡retx msȡ,صFD_TX_FAIL
+static int test_retx(void)
+{
+	uint8_t d[8]={0};
+	uint8_t inv;
+	tx_setup(TNUM,1,0);
+	q.retx=100;
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)0,now)==0);	//װ뻺,һֱط
+	CHECK(fd_tx_submit(&q,0x200,0,d,8,FD_FOREVER,done,(void*)1,now)==0);
+	CHECK(fd_tx_submit(&q,0x300,0,d,8,50,done,(void*)2,now)==0);
+	CHECK(tm[0].timed==2&&tm[0].deadline==100&&tm[2].timed==1);
+	now=50;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==1&&done_st[2]==FD_TX_TIMEOUT);
+	now=99;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==1&&hw_abort==0);
+	now=100;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==2&&done_st[1]==FD_TX_FAIL&&hw_abort==1);			//ֱӶ,ȡ
+	CHECK(bus_step(&inv)==0xFF&&done_n==3&&done_st[0]==FD_TX_FAIL);
+	CHECK(q.fail==2&&q.timeout==1&&q.tx==0&&out_n==0&&q.free_n==TNUM);
+	CHECK(fd_tx_submit(&q,0x100,0,d,8,FD_FOREVER,done,(void*)3,now)==0);
+	bus_run();
+	CHECK(done_n==4&&done_st[3]==FD_TX_SENT&&out_n==1);
+	return 0;
+}
+
+//״̬:ࡢ״̬Ĵ߹رպ˱ܺͻָ
+static int test_bus(void)
+{
+	_fd_bus b;
+	uint32_t wait;
+	memset(&b,0xAA,sizeof(b));
+	b.boff_min=10;
+	b.boff_max=40;
+	b.boff_stable=1000;
+	fd_bus_reset(&b);
+	CHECK(b.boff_min==10&&b.boff_max==40&&b.boff_stable==1000&&b.backoff==10);
+	CHECK(b.state==FD_BUS_ACTIVE&&b.errors==0&&b.busoffs==0&&b.lec_cnt[5]==0);
+
+	CHECK(fd_bus_update(&b,FD_BUS_ACTIVE,8,0,1,3,0,0)==0);				//ûӦ
+	CHECK(b.errors==1&&b.lec==3&&b.lec_cnt[2]==1&&b.tec_max==8);
+	CHECK(fd_bus_update(&b,FD_BUS_ACTIVE,0,1,0,7,7,0)==0);				//7:ûб仯
+	CHECK(b.lec==3&&b.lec_cnt[2]==1&&b.tec==0&&b.tec_max==8&&b.rec_max==1);
+	fd_bus_update(&b,FD_BUS_ACTIVE,0,0,2,1,6,0);							//ٲö,ݶCRC
+	CHECK(b.errors==3&&b.lec==6&&b.lec_cnt[0]==1&&b.lec_cnt[5]==1);
+
+	fd_bus_update(&b,FD_BUS_WARNING,100,0,0,0,0,0);
+	fd_bus_update(&b,FD_BUS_PASSIVE,130,128,0,0,0,0);
+	fd_bus_update(&b,FD_BUS_WARNING,120,128,0,0,0,0);					//ӱص治
+	fd_bus_update(&b,FD_BUS_PASSIVE,130,128,0,0,0,0);
+	CHECK(b.warnings==1&&b.passives==2&&b.rec_max==128);
+	wait=50;
+	CHECK(fd_bus_poll(&b,0,&wait)==0&&wait==50);						//ûйر
+
+	//һιرյboff_min
+	CHECK(fd_bus_update(&b,FD_BUS_OFF,255,128,0,0,0,100)==0);
+	CHECK(b.busoffs==1&&b.backoff==10&&b.passives==2);
+	wait=50;
+	CHECK(fd_bus_poll(&b,105,&wait)==0&&wait==5);
+	CHECK(fd_bus_poll(&b,110,&wait)==1&&b.recoveries==1);
+	CHECK(fd_bus_poll(&b,111,&wait)==0);								//Ѿʼָ
+	CHECK(fd_bus_update(&b,FD_BUS_ACTIVE,0,0,0,0,0,120)==1&&b.off_time==20);
+
+	//ָboff_stableֹر,ȴʱӱ,boff_max
+	fd_bus_update(&b,FD_BUS_OFF,255,0,0,0,0,200);
+	CHECK(b.backoff==20);
+	wait=50;
+	CHECK(fd_bus_poll(&b,219,&wait)==0&&wait==1);
+	CHECK(fd_bus_poll(&b,220,&wait)==1);
+	CHECK(fd_bus_update(&b,FD_BUS_ACTIVE,0,0,0,0,0,230)==1&&b.off_time==50);
+	fd_bus_update(&b,FD_BUS_OFF,255,0,0,0,0,300);
+	CHECK(b.backoff==40&&fd_bus_poll(&b,340,&wait)==1);
+	fd_bus_update(&b,FD_BUS_ACTIVE,0,0,0,0,0,350);
+	fd_bus_update(&b,FD_BUS_OFF,255,0,0,0,0,400);
+	CHECK(b.backoff==40&&fd_bus_poll(&b,440,&wait)==1);
+	fd_bus_update(&b,FD_BUS_ACTIVE,0,0,0,0,0,450);
+
+	//ȶٹر,صboff_min
+	fd_bus_update(&b,FD_BUS_OFF,255,0,0,0,0,1450);
+	CHECK(b.backoff==10&&b.busoffs==5&&b.recoveries==4&&b.off_time==50+50+50);
+	return 0;
+}
+
+//ύʱûӦȡʧܡ¼Ⱥ,ÿֻ֡һΡͬIDȽȳûȼת
+static int test_stress(void)
+{
+	static const uint32_t ids[8]={0x050,0x123,0x123<<18,0x400,0x7FF,0x1ABCDE,0x050<<18,0x001};
+	uint8_t seq[8]={0};
+	uint8_t last[8];
+	uint8_t d[64];
+	uint32_t n=0,k,inv=0;
+	uint8_t j,len,flags,dummy;
+	int round;
+	srand(1);
+	tx_setup(TNUM,4,64);
+	memset(last,0,sizeof(last));
+	for(round=0;round<200000&&n<NREC;round++)
+	{
+		hw_nack=rand()%16==0;
+		hw_late=rand()%4==0;
+		hw_evfirst=rand()&1;
+		switch(rand()%4)
+		{
+			case 0:
+			case 1:
+				j=rand()%8;
+				flags=(ids[j]>0x7FF||j==6)?FD_F_EXT:0;
+				if(rand()&1)flags|=FD_F_FD;
+				len=(flags&FD_F_FD)?rand()%65:2+rand()%7;
+				memset(d,0,sizeof(d));
+				d[0]=j;
+				d[1]=seq[j]+1;
+				k=fd_tx_submit(&q,ids[j],flags,d,len<2?2:len,rand()%3?FD_FOREVER:1+rand()%20,done,(void*)(long)n,now);
+				CHECK(k<=1);
+				if(k==0)
+				{
+					seq[j]++;
+					n++;
+				}
+				break;
+			case 2:
+				if(bus_step(&dummy)!=0xFF&&dummy&&!hw_late)inv++;
+				break;
+			default:
+				now+=rand()%3;
+				fd_tx_poll(&q,now,2,10);
+				break;
+		}
+	}
+	hw_nack=0;
+	hw_late=0;
+	bus_run();
+	now+=100;
+	fd_tx_poll(&q,now,2,10);
+	CHECK(done_n==n&&done_twice==0&&q.free_n==TNUM&&q.heap_n==0);
+	CHECK(q.tx+q.timeout+q.fail==n&&q.tx==out_n&&q.preempt>0&&q.timeout>0&&q.fail>0);
+	CHECK(inv==0);
+	for(k=0;k<out_n;k++)
+	{
+		j=out_data[k][0];
+		CHECK(out_id[k]==ids[j]);
+		CHECK((uint8_t)(out_data[k][1]-last[j])<128&&out_data[k][1]!=last[j]);	//ͬIDȽȳ
+		last[j]=out_data[k][1];
+	}
+	return 0;
+}
+
+int main(void)
+{
+	if(test_dlc()||test_check()||test_pad()||test_rx_len())return 1;
+	if(test_key()||test_order()||test_preempt()||test_timeout()||test_fail()||test_full()||test_retx()||test_stress())return 1;
+	if(test_bus())return 1;
+	printf("fdcore: ok (tx queue: %u frames, %u sent, %u timeout, %u failed, %u preempt)\n",(unsigned)done_n,(unsigned)q.tx,
+		(unsigned)q.timeout,(unsigned)q.fail,(unsigned)q.preempt);
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "ldcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//CAN߸ؼ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//CAN FDݳȰDLCȡ
+static const uint8_t ld_fd_len[8]={12,16,20,24,32,48,64,64};
+
+//ͳ,òʺʹ
+//nom:ٲöβ(bit/s)
+//dat:ݶβ(bit/s),0ʾٲöͬ
+//window:ͳƴ(ms),01000
+//now:ǰʱ(ms)
+void ld_init(_ld *ld,uint32_t nom,uint32_t dat,uint32_t window,uint32_t now)
+{
+	ld->window=window?window:1000;
+	ld->ns_bit=nom?1000000000/nom:0;
+	ld->ns_dbit=dat?1000000000/dat:ld->ns_bit;
+	ld->t0=now;
+	ld->busy=ld->busy_total=0;
+	ld->frames=ld->errors=0;
+	ld->time_total=ld->frames_total=ld->errors_total=0;
+	ld->load=ld->peak=ld->avg=0;
+	ld->fps=ld->eps=0;
+}
+
+//һ֡λ,λ
+//flags:LD_F_xxx
+//len:ֽ,Զ֡
+//dbits:ݶ(ESI~CRC綨)λ,ֻCAN FD֡BRSʱΪ0
+//ֵ:ٲöβʴλ
+uint32_t ld_bits(uint8_t flags,uint8_t len,uint32_t *dbits)
+{
+	uint32_t n,arb,dat;
+	if(flags&LD_F_RTR)len=0;
+	if(!(flags&(LD_F_FD|LD_F_BRS)))
+	{
+		if(len>8)len=8;
+		n=((flags&LD_F_EXT)?54:34)+8*(uint32_t)len;		//SOF~CRC,ҪĲ
+		*dbits=0;
+		return n+(n-1)/4+13;							//CRC綨Ӧ֡β֡
+	}
+	if(len>8)
+	{
+		if(len>64)len=64;
+		n=0;
+		while(ld_fd_len[n]<len)n++;
+		len=ld_fd_len[n];
+	}
+	arb=(flags&LD_F_EXT)?36:17;							//SOF~BRS
+	dat=5+8*(uint32_t)len;								//ESIDLC
+	dat+=dat/4;											//̬
+	dat+=len>16?4+21+7+1:4+17+6+1;						//CRC̶λCRC綨
+	arb+=(arb-1)/4+12;									//Ӧ֡β֡
+	if(flags&LD_F_BRS)
+	{
+		*dbits=dat;
+		return arb;
+	}
+	*dbits=0;
+	return arb+dat;
+}
+
+//ϳһ֡(յ򷢳)
+void ld_frame(_ld *ld,uint8_t flags,uint8_t len)
+{
+	uint32_t bits,dbits;
+	bits=ld_bits(flags,len,&dbits);
+	ld->busy+=(uint64_t)bits*ld->ns_bit+(uint64_t)dbits*ld->ns_dbit;
+	ld->frames++;
+}
+
+//ϳn֡
+void ld_error(_ld *ld,uint32_t n)
+{
+	ld->busy+=(uint64_t)n*LD_ERR_BITS*ld->ns_bit;
+	ld->errors+=n;
+}
+
+//ڽʱ㸺,ʼһ;ܾûʱʵʾʱ
+//now:ǰʱ(ms)
+//ֵ:1,ڽ,Ѹ;0,ڻû
+uint8_t ld_tick(_ld *ld,uint32_t now)
+{
+	uint32_t t=now-ld->t0;
+	uint64_t load;
+	if(t<ld->window)return 0;
+	load=ld->busy/((uint64_t)t*1000);					//ns/(ms*1000000)*1000
+	ld->load=load>1000?1000:(uint16_t)load;
+	if(ld->load>ld->peak)ld->peak=ld->load;
+	ld->fps=(uint32_t)((uint64_t)ld->frames*1000/t);
+	ld->eps=(uint32_t)((uint64_t)ld->errors*1000/t);
+	ld->busy_total+=ld->busy;
+	ld->time_total+=t;
+	ld->frames_total+=ld->frames;
+	ld->errors_total+=ld->errors;
+	load=ld->busy_total/((uint64_t)ld->time_total*1000);
+	ld->avg=load>1000?1000:(uint16_t)load;
+	ld->t0=now;
+	ld->busy=0;
+	ld->frames=ld->errors=0;
+	return 1;
+}
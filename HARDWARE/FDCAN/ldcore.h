@@ -0,0 +1,59 @@
+#ifndef _LDCORE_H
+#define _LDCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CAN߸ؼ:֡λͲۼæʱ,ÿͳƴһθ
+//ֻñ׼C,HALFDCAN,ʱɵߴ,PCϲ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//һ֡λλ(ÿ4λһλ),ĸ:
+//  ͳ֡:׼ID 47+8n+(33+8n)/4,չID 67+8n+(53+8n)/4(3λ֡)
+//  CAN FD֡:ٲö(SOF~BRS)Ӧ֡β֡ٲöβ,ESI~CRC綨ݶβ(BRSʱ),
+//  CRCǰCRCĹ̶λҲ;ݳȰDLCȡ
+//֡LD_ERR_BITSλ(־6λ+ڵĴ־6λ+綨8λ+֡3λ)
+//ʹ÷:ld_initòʺʹ;ÿյ/һ֡ld_frame,ÿЭld_error;
+//  ڵld_tick,ڽʱload/peak/avg/fps/eps
+//////////////////////////////////////////////////////////////////////////////////
+
+#define LD_ERR_BITS				23		//һ֡ռλ
+
+//֡־,FDCAN1_F_xxxͬ
+#define LD_F_EXT				0x01	//չID
+#define LD_F_RTR				0x02	//Զ֡
+#define LD_F_FD					0x04	//CAN FD֡
+#define LD_F_BRS				0x08	//CAN FD֡,ݶл
+
+typedef struct
+{
+	//,ld_init
+	uint32_t window;			//ͳƴ(ms)
+	uint32_t ns_bit;			//ٲöһλʱ(ns)
+	uint32_t ns_dbit;			//ݶһλʱ(ns)
+
+	//ǰ
+	uint32_t t0;				//ڿʼʱ(ms)
+	uint64_t busy;				//æʱ(ns)
+	uint32_t frames;
+	uint32_t errors;
+
+	//ۼ
+	uint64_t busy_total;		//ld_initæʱ(ns)
+	uint32_t time_total;		//ld_initͳƹʱ(ms)
+	uint32_t frames_total;
+	uint32_t errors_total;
+
+	//,ld_tickڴڽʱ
+	uint16_t load;				//ϸڵĸ(0.1%)
+	uint16_t peak;				//ֵ(0.1%)
+	uint16_t avg;				//ld_initƽ(0.1%)
+	uint32_t fps;				//ϸÿ֡
+	uint32_t eps;				//ϸÿĴ֡
+}_ld;
+
+void ld_init(_ld *ld,uint32_t nom,uint32_t dat,uint32_t window,uint32_t now);	//ͳ,nom/datΪٲö/ݶβ(datΪ0ͬnom)
+uint32_t ld_bits(uint8_t flags,uint8_t len,uint32_t *dbits);					//һ֡λ(),ٲöβʵλ,*dbitsΪݶελ
+void ld_frame(_ld *ld,uint8_t flags,uint8_t len);								//ϳһ֡
+void ld_error(_ld *ld,uint32_t n);												//ϳn֡
+uint8_t ld_tick(_ld *ld,uint32_t now);											//ڽʱ㸺,1
+#endif
@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////////
+//ldcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -IHARDWARE/FDCAN HARDWARE/FDCAN/ldcore_test.c HARDWARE/FDCAN/ldcore.c
+//һ֡λ(ͳ֡׼/չIDԶ֡CAN FDDLCȡBRSʱ),
+//ڸ/֡//ֵ/ƽֵ,CAN FDBRSĸ,100%ʱ,Ϊ0
+//////////////////////////////////////////////////////////////////////////////////
+#include "ldcore.h"
+#include <stdio.h>
+
+#define CHECK(c)	do{if(!(c)){printf("ldcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+
+static int test_bits(void)
+{
+	uint32_t d,a,len,n;
+	for(len=0;len<=8;len++)
+	{
+		n=34+8*len;													//׼ID:SOF~CRC 34+8nλҪ
+		CHECK(ld_bits(0,(uint8_t)len,&d)==n+(n-1)/4+13&&d==0);
+		CHECK(ld_bits(LD_F_EXT,(uint8_t)len,&d)==67+8*len+(53+8*len)/4&&d==0);
+	}
+	CHECK(ld_bits(0,8,&d)==135&&ld_bits(0,0,&d)==47+8);
+	CHECK(ld_bits(LD_F_RTR,8,&d)==55);								//Զ֡û
+	CHECK(ld_bits(0,12,&d)==135);									//ͳ֡8ֽ
+
+	//CAN FD:ȰDLCȡ
+	CHECK(ld_bits(LD_F_FD,9,&d)==ld_bits(LD_F_FD,12,&d)&&ld_bits(LD_F_FD,13,&d)==ld_bits(LD_F_FD,16,&d));
+	CHECK(ld_bits(LD_F_FD,33,&d)==ld_bits(LD_F_FD,48,&d)&&ld_bits(LD_F_FD,49,&d)==ld_bits(LD_F_FD,64,&d));
+	CHECK(ld_bits(LD_F_FD,12,&d)<ld_bits(LD_F_FD,13,&d));
+	CHECK(ld_bits(LD_F_FD,64,&d)==712&&d==0);						//ٲö33λ+ݶ679λ
+	a=ld_bits(LD_F_FD|LD_F_BRS,64,&d);
+	CHECK(a==33&&d==679);
+	a=ld_bits(LD_F_FD|LD_F_BRS|LD_F_EXT,64,&d);
+	CHECK(a==56&&d==679);											//չID19λ:36+8λ+12
+	for(len=0;len<=64;len++)										//BRSʱ֮
+	{
+		a=ld_bits(LD_F_FD|LD_F_BRS,(uint8_t)len,&d);
+		CHECK(ld_bits(LD_F_FD,(uint8_t)len,&n)==a+d&&n==0);
+	}
+	CHECK(ld_bits(LD_F_FD,100,&d)==712);
+	return 0;
+}
+
+//500K,ÿ1000֡8ֽ(270us):27%;ٹ2sֻ100֡
+static int test_load(void)
+{
+	_ld ld;
+	uint32_t i;
+	ld_init(&ld,500000,0,1000,5);
+	for(i=0;i<1000;i++)ld_frame(&ld,0,8);
+	CHECK(ld_tick(&ld,1004)==0);
+	CHECK(ld_tick(&ld,1005)==1);
+	CHECK(ld.load==270&&ld.fps==1000&&ld.eps==0&&ld.peak==270&&ld.avg==270);
+	ld_error(&ld,100);
+	CHECK(ld_tick(&ld,3005)==1);
+	CHECK(ld.load==2&&ld.eps==50&&ld.fps==0&&ld.peak==270);		//100*23λ*2us=4.6ms/2s
+	CHECK(ld.avg==(270000000ull+4600000)/3000000);
+	CHECK(ld.frames_total==1000&&ld.errors_total==100&&ld.time_total==3000);
+	for(i=0;i<10000;i++)ld_frame(&ld,0,8);
+	ld_tick(&ld,4005);
+	CHECK(ld.load==1000&&ld.peak==1000);							//ʱ䰴100%
+	return 0;
+}
+
+//500K/2M,ÿ1000֡64ֽڴBRS:33*2us+679*0.5us=405.5us
+static int test_fd(void)
+{
+	_ld ld;
+	uint32_t i;
+	ld_init(&ld,500000,2000000,100,0);
+	for(i=0;i<100;i++)ld_frame(&ld,LD_F_FD|LD_F_BRS,64);
+	CHECK(ld_tick(&ld,100)==1&&ld.load==405&&ld.fps==1000);
+	ld_init(&ld,500000,0,100,0);									//ݶβΪ0ͬٲö
+	for(i=0;i<100;i++)ld_frame(&ld,LD_F_FD|LD_F_BRS,64);
+	CHECK(ld_tick(&ld,100)==1&&ld.load==1000);
+	return 0;
+}
+
+//Ϊ0(ûʼ)ʱΪ0,Ϊ01000ms
+static int test_zero(void)
+{
+	_ld ld;
+	ld_init(&ld,0,0,0,0);
+	CHECK(ld.window==1000);
+	ld_frame(&ld,0,8);
+	CHECK(ld_tick(&ld,1000)==1&&ld.load==0&&ld.fps==1);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_bits()||test_load()||test_fd()||test_zero())return 1;
+	printf("ldcore: ok\n");
+	return 0;
+}
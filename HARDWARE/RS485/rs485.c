@@ -1,6 +1,7 @@
 #include "rs485.h"
 #include "pcf8574.h"
-#include "delay.h"
+#include "serial.h"
+#include "stdio.h"
 //////////////////////////////////////////////////////////////////////////////////	 
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32F7
@@ -12,101 +13,134 @@
 //ȨУؾ
 //Copyright(C) ӿƼ޹˾ 2014-2024
 //All rights reserved									  
+//********************************************************************************
+//V1.1 20261019
+//2ͨôSYSTEM/serial(SERIAL2ʵ),DMAշ,߿ʱһ֡
+//V1.2 20261019
+//շƿѡPCF8574ӲDEGPIO,rs485.hеRS485_DE_MODE
+//ͳÿηͺлؽյʱ(RS485_Report)
+//V1.3 20261019
+//ýճʱһ֡,RS485_Receive_Dataٵȴ,RS485_Wait
 ////////////////////////////////////////////////////////////////////////////////// 	
 
-UART_HandleTypeDef USART2_RS485Handler;  //USART2(RS485)
+static u32 rs485_baud;		//
+static u32 rs485_t0;		//һRS485_Send_DataʼʱDWT
+static u16 rs485_len;		//һη͵ֽ
+static u32 rs485_cnt=0;		//ͳƵķʹ
+static u32 rs485_total;		//һδӵ÷͵лؽյʱ(us)
+static u32 rs485_wire;		//һϵʱ(us)
+static u32 rs485_over_max=0;//лؽյĶʱ(ʱ-ʱ)ֵ(us)
 
-#if EN_USART2_RX   		//ʹ˽   	  
-//ջ 	
-u8 RS485_RX_BUF[64];  	//ջ,64ֽ.
-//յݳ
-u8 RS485_RX_CNT=0;  
+//¼һη͵лؽյʱ,лؽպ
+static void rs485_measure(void)
+{
+	u32 total,over;
+	total=(DWT->CYCCNT-rs485_t0)/(SystemCoreClock/1000000);
+#if RS485_DE_MODE==1
+	total+=RS485_DE_DEASSERT*1000000/(16*rs485_baud);	//ֹͣλӲᱣDEһʱ
+#endif
+	rs485_total=total;
+	rs485_wire=(u32)rs485_len*10000000u/rs485_baud;			//1ʼλ+8λ+1ֹͣλ
+	over=total>rs485_wire?total-rs485_wire:0;
+	if(over>rs485_over_max)rs485_over_max=over;
+	rs485_cnt++;
+}
 
-void USART2_IRQHandler(void)
+#if RS485_DE_MODE
+//շص,ʼʱtx=1,һֹͣλtx=0(ڷж)
+static void rs485_dir(u8 tx)
 {
-    u8 res;	  
-    if(__HAL_UART_GET_IT(&USART2_RS485Handler,UART_IT_RXNE)!=RESET)  //ж
-	{	 	
-        HAL_UART_Receive(&USART2_RS485Handler,&res,1,1000);
-		if(RS485_RX_CNT<64)
-		{
-			RS485_RX_BUF[RS485_RX_CNT]=res;		//¼յֵ
-			RS485_RX_CNT++;						//1 
-		} 
-	} 
-}    
+#if RS485_DE_MODE==2
+	HAL_GPIO_WritePin(RS485_DE_GPIO,RS485_DE_PIN,tx?GPIO_PIN_SET:GPIO_PIN_RESET);
+#endif
+	if(!tx)rs485_measure();
+}
 #endif
 
 //ʼIO 2
 //bound:
 void RS485_Init(u32 bound)
 {
-    //GPIO˿
+#if RS485_DE_MODE
 	GPIO_InitTypeDef GPIO_Initure;
-	
+#endif
+	rs485_baud=bound;
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;	//DWTڼͳлʱ
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;
+	SERIAL_Init(SERIAL2,bound);				//PA2,3,ʱ֡
+	SERIAL_SetRxTimeout(SERIAL2,RS485_RX_GAP);
+#if RS485_DE_MODE==0
     PCF8574_Init();                         //ʼPCF8574ڿRE
-	
-	__HAL_RCC_GPIOA_CLK_ENABLE();			//ʹGPIOAʱ
-	__HAL_RCC_USART2_CLK_ENABLE();			//ʹUSART2ʱ
-	
-	GPIO_Initure.Pin=GPIO_PIN_2|GPIO_PIN_3; //PA2,3
-	GPIO_Initure.Mode=GPIO_MODE_AF_PP;		//
-	GPIO_Initure.Pull=GPIO_PULLUP;			//
-	GPIO_Initure.Speed=GPIO_SPEED_FREQ_VERY_HIGH;//
-	GPIO_Initure.Alternate=GPIO_AF7_USART2;	//ΪUSART2
-	HAL_GPIO_Init(GPIOA,&GPIO_Initure);	   	//ʼPA2,3
-    
-    //USART ʼ
-	USART2_RS485Handler.Instance=USART2;			        //USART2
-	USART2_RS485Handler.Init.BaudRate=bound;		        //
-	USART2_RS485Handler.Init.WordLength=UART_WORDLENGTH_8B;	//ֳΪ8λݸʽ
-	USART2_RS485Handler.Init.StopBits=UART_STOPBITS_1;		//һֹͣλ
-	USART2_RS485Handler.Init.Parity=UART_PARITY_NONE;		//żУλ
-	USART2_RS485Handler.Init.HwFlowCtl=UART_HWCONTROL_NONE;	//Ӳ
-	USART2_RS485Handler.Init.Mode=UART_MODE_TX_RX;		    //շģʽ
-	HAL_UART_Init(&USART2_RS485Handler);			        //HAL_UART_Init()ʹUSART2
-    
-    __HAL_UART_CLEAR_IT(&USART2_RS485Handler,UART_CLEAR_TCF);
-#if EN_USART2_RX
-	__HAL_UART_ENABLE_IT(&USART2_RS485Handler,UART_IT_RXNE);//ж
-	HAL_NVIC_EnableIRQ(USART2_IRQn);				        //ʹUSART1ж
-	HAL_NVIC_SetPriority(USART2_IRQn,3,3);			        //ռȼ3ȼ3
-#endif	
-    RS485_TX_Set(0);                                        //Ϊģʽ	
+    RS485_TX_Set(0);                        //Ϊģʽ	
+#elif RS485_DE_MODE==1
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	GPIO_Initure.Pin=GPIO_PIN_1;			//PA1,USART2_DE
+	GPIO_Initure.Mode=GPIO_MODE_AF_PP;
+	GPIO_Initure.Pull=GPIO_PULLDOWN;		//λͳʼڼ䱣ֽ
+	GPIO_Initure.Speed=GPIO_SPEED_FREQ_HIGH;
+	GPIO_Initure.Alternate=GPIO_AF7_USART2;
+	HAL_GPIO_Init(GPIOA,&GPIO_Initure);
+	SERIAL_SetDE(SERIAL2,RS485_DE_ASSERT,RS485_DE_DEASSERT);
+	SERIAL_SetDir(SERIAL2,rs485_dir);		//ֻͳ
+#else
+	GPIO_Initure.Pin=RS485_DE_PIN;
+	GPIO_Initure.Mode=GPIO_MODE_OUTPUT_PP;
+	GPIO_Initure.Pull=GPIO_PULLDOWN;
+	GPIO_Initure.Speed=GPIO_SPEED_FREQ_HIGH;
+	HAL_GPIO_WritePin(RS485_DE_GPIO,RS485_DE_PIN,GPIO_PIN_RESET);	//ģʽ
+	HAL_GPIO_Init(RS485_DE_GPIO,&GPIO_Initure);
+	SERIAL_SetDir(SERIAL2,rs485_dir);
+#endif
 }
 
 //RS485lenֽ.
+//RS485_DE_MODEΪ0ʱȷɲлؽպŷ;Ϊ12ʱд뷢ͻ,Ӳ/жлؽ
 //buf:׵ַ
-//len:͵ֽ(Ϊ˺ͱĽƥ,ｨ鲻Ҫ64ֽ)
+//len:͵ֽ(Ϊ˺ͱĽƥ,ｨ鲻ҪSERIAL2_RX_LENֽ)
 void RS485_Send_Data(u8 *buf,u8 len)
 {
+	SERIAL_RxClear(SERIAL2);	//ǰûȡߵ
+	rs485_t0=DWT->CYCCNT;
+	rs485_len=len;
+#if RS485_DE_MODE==0
 	RS485_TX_Set(1);			//Ϊģʽ
-    HAL_UART_Transmit(&USART2_RS485Handler,buf,len,1000);//2
-	RS485_RX_CNT=0;	  
+	SERIAL_Write(SERIAL2,buf,len);
+	SERIAL_Flush(SERIAL2,RS485_TX_TIMEOUT);	//һֽڷлؽ
 	RS485_TX_Set(0);			//Ϊģʽ	
+	rs485_measure();
+#else
+	SERIAL_Write(SERIAL2,buf,len);
+#endif
 }
-//RS485ѯյ
-//buf:ջ׵ַ
-//len:ݳ
+//RS485ѯյ,ȡյһ֡,ûʱ
+//buf:ջ׵ַ,255ֽ
+//len:ݳ,0ʾûյ;255ֽڵֻ֡ȡǰ255ֽ
 void RS485_Receive_Data(u8 *buf,u8 *len)
 {
-	u8 rxlen=RS485_RX_CNT;
-	u8 i=0;
-	*len=0;				//ĬΪ0
-	delay_ms(10);		//ȴ10ms,10msûнյһ,Ϊս
-	if(rxlen==RS485_RX_CNT&&rxlen)//յ,ҽ
-	{
-		for(i=0;i<rxlen;i++)
-		{
-			buf[i]=RS485_RX_BUF[i];	
-		}		
-		*len=RS485_RX_CNT;	//¼ݳ
-		RS485_RX_CNT=0;		//
-	}
+	*len=SERIAL_Read(SERIAL2,buf,255,0);
 } 
+//ȴյһ֡,ȡ,ȴʱ,֡(RS485_RX_GAP)
+//timeout:ȴʱ(ms)
+//ֵ:1,յ;0,ʱ
+u8 RS485_Wait(u32 timeout)
+{
+	return SERIAL_Wait(SERIAL2,timeout);
+}
 //RS485ģʽ.
+//RS485_DE_MODEΪ1ʱɴӲ,ﲻκβ
 //en:0,;1,.
 void RS485_TX_Set(u8 en)
 {
+#if RS485_DE_MODE==0
 	PCF8574_WriteBit(RS485_RE_IO,en);
+#elif RS485_DE_MODE==2
+	HAL_GPIO_WritePin(RS485_DE_GPIO,RS485_DE_PIN,en?GPIO_PIN_SET:GPIO_PIN_RESET);
+#endif
+}
+
+//շлͳ:һδӵ÷͵лؽյʱ䡢ϵʱ䡢ʱֵ
+void RS485_Report(void)
+{
+	printf("rs485 de mode %u: sends %u last %u us (wire %u us) turnaround max %u us\r\n",
+		RS485_DE_MODE,rs485_cnt,rs485_total,rs485_wire,rs485_over_max);
 }
@@ -12,16 +12,40 @@
 //ȨУؾ
 //Copyright(C) ӿƼ޹˾ 2014-2024
 //All rights reserved									  
+//********************************************************************************
+//V1.1 20261019
+//2ͨôSYSTEM/serial(SERIAL2ʵ):DMAշ,жϷ֡,յ֡Ŷ
+//ȥRS485_RX_BUF/RS485_RX_CNTֽյж
+//RS485_Receive_DataȴRS485_RX_TIMEOUT,յһ֡
+//V1.2 20261019
+//PCF8574_WriteBitҪһI2CһI2Cд,д껹10msʱ,ÿηǰлһη,
+//һ֡Ҫ໨20ms;ӴӲDEGPIOַƷʽ,лؽֻҪus
+//RS485_Report()лʱͳ
+//V1.3 20261019
+//֡ôӲճʱ(RTOR),ʱλRS485_RX_GAP,9600һ֡0.5msھȡ
+//RS485_Receive_DataΪֻȡյ֡,ȴ;ҪȴʱRS485_Wait(),ȴڼ䲻ռõߵĻ
+//V1.4 20261019
+//2֡Ӵ256ֽ(Modbus RTU),RS485_Receive_Dataȡ255ֽ
 ////////////////////////////////////////////////////////////////////////////////// 	
 
-extern u8 RS485_RX_BUF[64]; 		//ջ,64ֽ
-extern u8 RS485_RX_CNT;   			//յݳ
+#define RS485_RX_GAP			5		//֡:һֹͣλôλʱûݾͽһ֡
+										//0,ÿж(1ַ,10λ);Modbus RTUҪ3.5ַ,Ϊ35
+#define RS485_TX_TIMEOUT		1000	//RS485_Send_Dataȴɵʱ(ms)
 
-//봮жϽգEN_USART2_RXΪ1Ϊ0
-#define EN_USART2_RX 	1			//0,;1,.
+//շ:
+//0,PCF8574P6(ĬϽӷ),ÿлҪ20ms
+//1,USART2ӲDE,PA1(ΪETH_REF_CLK,̫ʱ),ҪշDE/REӵPA1
+//2,GPIO(RS485_DE_GPIO/RS485_DE_PIN),ҪշDE/REӵ,ڷжлؽ
+#define RS485_DE_MODE			0
+#define RS485_DE_ASSERT			8		//ӲDE:һʼλ֮ǰʹDEʱ,λ1/16λ,0~31
+#define RS485_DE_DEASSERT		8		//ӲDE:һֹͣλ֮󱣳DEʱ,λ1/16λ,0~31
+#define RS485_DE_GPIO			GPIOA	//GPIOʽDE,GPIOʱSERIAL_Init(GPIOA)
+#define RS485_DE_PIN			GPIO_PIN_1
 
 void RS485_Init(u32 bound);
 void RS485_Send_Data(u8 *buf,u8 len);
 void RS485_Receive_Data(u8 *buf,u8 *len);	
+u8 RS485_Wait(u32 timeout);					//ȴյһ֡
 void RS485_TX_Set(u8 en);
+void RS485_Report(void);					//շлͳ
 #endif
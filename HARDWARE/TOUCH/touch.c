@@ -4,6 +4,7 @@
 #include "stdlib.h"
 #include "math.h"
 #include "24cxx.h"
+#include <lib_math.h>
 //////////////////////////////////////////////////////////////////////////////////
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32
@@ -94,7 +95,7 @@ u16 TP_Read_AD(u8 CMD)
     return (Num);
 }
 //ȡһֵ(xy)
-//ȡREAD_TIMES,Щ,
+//ȡREAD_TIMES,Щ(,Math_SortU16),
 //ȻȥͺLOST_VAL,ȡƽֵ
 //xy:ָCMD_RDX/CMD_RDY
 //ֵ:
@@ -102,25 +103,14 @@ u16 TP_Read_AD(u8 CMD)
 #define LOST_VAL 1	  	//ֵ
 u16 TP_Read_XOY(u8 xy)
 {
-    u16 i, j;
+    u16 i;
     u16 buf[READ_TIMES];
     u16 sum = 0;
     u16 temp;
 
     for (i = 0; i < READ_TIMES; i++)buf[i] = TP_Read_AD(xy);
 
-    for (i = 0; i < READ_TIMES - 1; i++) //
-    {
-        for (j = i + 1; j < READ_TIMES; j++)
-        {
-            if (buf[i] > buf[j]) //
-            {
-                temp = buf[i];
-                buf[i] = buf[j];
-                buf[j] = temp;
-            }
-        }
-    }
+    Math_SortU16(buf, READ_TIMES); //
 
     sum = 0;
 
@@ -1,6 +1,7 @@
 #include "tpad.h"
 #include "delay.h"
 #include "usart.h"
+#include <lib_math.h>
 //////////////////////////////////////////////////////////////////////////////////	 
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32H7
@@ -26,25 +27,14 @@ u8 TPAD_Init(u8 psc)
 {
 	u16 buf[10];
 	u16 temp;
-	u8 j,i;
+	u8 i;
 	TIM2_CH1_Cap_Init(TPAD_ARR_MAX_VAL,psc-1);//÷Ƶϵ
 	for(i=0;i<10;i++)//ȡ10
 	{				 
 		buf[i]=TPAD_Get_Val();
 		delay_ms(10);	    
 	}				    
-	for(i=0;i<9;i++)//
-	{
-		for(j=i+1;j<10;j++)
-		{
-			if(buf[i]>buf[j])//
-			{
-				temp=buf[i];
-				buf[i]=buf[j];
-				buf[j]=temp;
-			}
-		}
-	}
+	Math_SortU16(buf,10);//
 	temp=0;
 	for(i=2;i<8;i++)temp+=buf[i];//ȡм8ݽƽ
 	tpad_default_val=temp/6;
@@ -2,6 +2,9 @@
 #include "qspi.h"
 #include "delay.h"
 #include "usart.h" 
+#if SYSTEM_SUPPORT_OS
+#include "includes.h"					//os ʹ
+#endif
 //////////////////////////////////////////////////////////////////////////////////	 
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32 
@@ -18,6 +21,48 @@
 u16 W25QXX_TYPE=W25Q256;	//ĬW25Q256
 u8 W25QXX_QPI_MODE=0;		//QSPIģʽ־:0,SPIģʽ;1,QPIģʽ.
 
+#if SYSTEM_SUPPORT_OS
+static OS_EVENT *w25qxx_mutex=NULL;	//,һμʱ
+static OS_TCB *w25qxx_owner=NULL;	//
+static u16 w25qxx_nest=0;			//Ĵ
+#endif
+
+//,ͬһǶ(W25QXX_WriteW25QXX_Erase_Sector)
+//OSǰֻmain,жﲻܵȴ,
+void W25QXX_Lock(void)
+{
+#if SYSTEM_SUPPORT_OS
+	u8 err;
+	OS_CPU_SR cpu_sr=0;
+	if(!OSRunning||OSIntNesting)return;
+	if(w25qxx_mutex==NULL)
+	{
+		OS_ENTER_CRITICAL();
+		if(w25qxx_mutex==NULL)w25qxx_mutex=OSMutexCreate(W25QXX_MUTEX_PRIO,&err);
+		OS_EXIT_CRITICAL();
+	}
+	if(w25qxx_owner==OSTCBCur)		//Ѿ
+	{
+		w25qxx_nest++;
+		return;
+	}
+	OSMutexPend(w25qxx_mutex,0,&err);
+	w25qxx_owner=OSTCBCur;
+	w25qxx_nest=1;
+#endif
+}
+
+//,W25QXX_LockɶԵ
+void W25QXX_Unlock(void)
+{
+#if SYSTEM_SUPPORT_OS
+	if(!OSRunning||OSIntNesting||w25qxx_owner!=OSTCBCur)return;
+	if(--w25qxx_nest)return;
+	w25qxx_owner=NULL;
+	OSMutexPost(w25qxx_mutex);
+#endif
+}
+
 //4KbytesΪһSector
 //16Ϊ1Block
 //W25Q256
@@ -27,6 +72,7 @@ u8 W25QXX_QPI_MODE=0;		//QSPIģʽ
 void W25QXX_Init(void)
 { 
     u8 temp;    
+	W25QXX_Lock();
 	QSPI_Init();					//ʼQSPI
  	W25QXX_Qspi_Enable();			//ʹQSPIģʽ
 	W25QXX_TYPE=W25QXX_ReadID();	//ȡFLASH ID.
@@ -44,11 +90,13 @@ void W25QXX_Init(void)
 		temp=3<<4;					//P4&P5=11,8dummy clocks,104M
 		QSPI_Transmit(&temp,1);		//1ֽ	   
     }
+	W25QXX_Unlock();
 }  
 //W25QXXQSPIģʽ 
 void W25QXX_Qspi_Enable(void)
 {
 	u8 stareg2;
+	W25QXX_Lock();
 	stareg2=W25QXX_ReadSR(2);		//ȶ״̬Ĵ2ԭʼֵ
 	if((stareg2&0X02)==0)			//QEλδʹ
 	{
@@ -58,13 +106,16 @@ void W25QXX_Qspi_Enable(void)
 	}
 	QSPI_Send_CMD(W25X_EnterQPIMode,0,0,QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);//дcommandָ,ַΪ0,_8λַ_޵ַ_ߴָ,޿,0ֽ
 	W25QXX_QPI_MODE=1;				//QSPIģʽ
+	W25QXX_Unlock();
 }
 
 //W25QXX˳QSPIģʽ 
 void W25QXX_Qspi_Disable(void)
 { 
+	W25QXX_Lock();
 	QSPI_Send_CMD(W25X_ExitQPIMode,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);//дcommandָ,ַΪ0,_8λַ_޵ַ_4ߴָ,޿,0ֽ
 	W25QXX_QPI_MODE=0;				//SPIģʽ
+	W25QXX_Unlock();
 }
 
 //ȡW25QXX״̬ĴW25QXXһ3״̬Ĵ
@@ -102,9 +153,11 @@ u8 W25QXX_ReadSR(u8 regno)
             command=W25X_ReadStatusReg1;    
             break;
     }   
+	W25QXX_Lock();
 	if(W25QXX_QPI_MODE)QSPI_Send_CMD(command,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_4_LINES);	//QPI,дcommandָ,ַΪ0,4ߴ_8λַ_޵ַ_4ߴָ,޿,1ֽ
 	else QSPI_Send_CMD(command,0,0,QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_1_LINE);				//SPI,дcommandָ,ַΪ0,ߴ_8λַ_޵ַ_ߴָ,޿,1ֽ
 	QSPI_Receive(&byte,1);	        
+	W25QXX_Unlock();
 	return byte;   
 }   
 
@@ -127,25 +180,31 @@ void W25QXX_Write_SR(u8 regno,u8 sr)
             command=W25X_WriteStatusReg1;    
             break;
     }   
+	W25QXX_Lock();
 	if(W25QXX_QPI_MODE)QSPI_Send_CMD(command,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_4_LINES);	//QPI,дcommandָ,ַΪ0,4ߴ_8λַ_޵ַ_4ߴָ,޿,1ֽ
 	else QSPI_Send_CMD(command,0,0, QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_1_LINE);				//SPI,дcommandָ,ַΪ0,ߴ_8λַ_޵ַ_ߴָ,޿,1ֽ
 	QSPI_Transmit(&sr,1);	         	      
+	W25QXX_Unlock();
 }  
 
 //W25QXXдʹ	
 //S1ĴWELλ   
 void W25QXX_Write_Enable(void)   
 {
+	W25QXX_Lock();
 	if(W25QXX_QPI_MODE)QSPI_Send_CMD(W25X_WriteEnable,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);	//QPI,дʹָ,ַΪ0,_8λַ_޵ַ_4ߴָ,޿,0ֽ
 	else QSPI_Send_CMD(W25X_WriteEnable,0,0,QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);				//SPI,дʹָ,ַΪ0,_8λַ_޵ַ_ߴָ,޿,0ֽ
+	W25QXX_Unlock();
 } 
 
 //W25QXXдֹ	
 //WEL  
 void W25QXX_Write_Disable(void)   
 {  
+	W25QXX_Lock();
 	if(W25QXX_QPI_MODE)QSPI_Send_CMD(W25X_WriteDisable,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);//QPI,дָֹ,ַΪ0,_8λַ_޵ַ_4ߴָ,޿,0ֽ
 	else QSPI_Send_CMD(W25X_WriteDisable,0,0,QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);				//SPI,дָֹ,ַΪ0,_8λַ_޵ַ_ߴָ,޿,0ֽ 
+	W25QXX_Unlock();
 } 
 
 //ֵ:				   
@@ -159,9 +218,11 @@ u16 W25QXX_ReadID(void)
 {
 	u8 temp[2];
 	u16 deviceid;
+	W25QXX_Lock();
 	if(W25QXX_QPI_MODE)QSPI_Send_CMD(W25X_ManufactDeviceID,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_4_LINES,QSPI_ADDRESS_24_BITS,QSPI_DATA_4_LINES);//QPI,id,ַΪ0,4ߴ_24λַ_4ߴַ_4ߴָ,޿,2ֽ
 	else QSPI_Send_CMD(W25X_ManufactDeviceID,0,0,QSPI_INSTRUCTION_1_LINE,QSPI_ADDRESS_1_LINE,QSPI_ADDRESS_24_BITS,QSPI_DATA_1_LINE);			//SPI,id,ַΪ0,ߴ_24λַ_ߴַ_ߴָ,޿,2ֽ
 	QSPI_Receive(temp,2);
+	W25QXX_Unlock();
 	deviceid=(temp[0]<<8)|temp[1];
 	return deviceid;
 }    
@@ -173,8 +234,10 @@ u16 W25QXX_ReadID(void)
 //NumByteToRead:Ҫȡֽ(65535)
 void W25QXX_Read(u8* pBuffer,u32 ReadAddr,u16 NumByteToRead)   
 { 
+	W25QXX_Lock();
 	QSPI_Send_CMD(W25X_FastReadData,ReadAddr,8,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_4_LINES,QSPI_ADDRESS_32_BITS,QSPI_DATA_4_LINES);	//QPI,ٶ,ַΪReadAddr,4ߴ_32λַ_4ߴַ_4ߴָ,8,NumByteToRead
 	QSPI_Receive(pBuffer,NumByteToRead); 
+	W25QXX_Unlock();
 }  
 
 //SPIһҳ(0~65535)д256ֽڵ
@@ -184,10 +247,12 @@ void W25QXX_Read(u8* pBuffer,u32 ReadAddr,u16 NumByteToRead)
 //NumByteToWrite:Ҫдֽ(256),Ӧóҳʣֽ!!!	 
 void W25QXX_Write_Page(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
 {
+	W25QXX_Lock();
 	W25QXX_Write_Enable();					//дʹ
 	QSPI_Send_CMD(W25X_PageProgram,WriteAddr,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_4_LINES,QSPI_ADDRESS_32_BITS,QSPI_DATA_4_LINES);	//QPI,ҳдָ,ַΪWriteAddr,4ߴ_32λַ_4ߴַ_4ߴָ,޿,NumByteToWrite
 	QSPI_Transmit(pBuffer,NumByteToWrite);	         	      
 	W25QXX_Wait_Busy();					   //ȴд
+	W25QXX_Unlock();
 } 
 
 //޼дSPI FLASH 
@@ -201,6 +266,7 @@ void W25QXX_Write_Page(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
 void W25QXX_Write_NoCheck(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)   
 { 			 		 
 	u16 pageremain;	   
+	W25QXX_Lock();
 	pageremain=256-WriteAddr%256; //ҳʣֽ		 	    
 	if(NumByteToWrite<=pageremain)pageremain=NumByteToWrite;//256ֽ
 	while(1)
@@ -217,6 +283,7 @@ void W25QXX_Write_NoCheck(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
 			else pageremain=NumByteToWrite; 	  //256ֽ
 		}
 	}   
+	W25QXX_Unlock();
 } 
 
 //дSPI FLASH  
@@ -233,6 +300,7 @@ void W25QXX_Write(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
 	u16 secremain;	   
  	u16 i;    
 	u8 * W25QXX_BUF;	  
+	W25QXX_Lock();							//W25QXX_BUFFERҲ
    	W25QXX_BUF=W25QXX_BUFFER;	     
  	secpos=WriteAddr/4096;//ַ  
 	secoff=WriteAddr%4096;//ڵƫ
@@ -269,16 +337,34 @@ void W25QXX_Write(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
 			else secremain=NumByteToWrite;			//һд
 		}	 
 	};	 
+	W25QXX_Unlock();
+}
+
+//ȴ
+//Ҫʮmsʮs,OSTimeDlyȴ,(ȼ̳еW25QXX_MUTEX_PRIO)
+//תռסCPU,ճ;OSǰжﻹǲѯȴ
+static void w25qxx_wait_erase(void)
+{
+#if SYSTEM_SUPPORT_OS
+	if(OSRunning&&!OSIntNesting)
+	{
+		while((W25QXX_ReadSR(1)&0x01)==0x01)OSTimeDly(1);
+		return;
+	}
+#endif
+	W25QXX_Wait_Busy();
 }
 
 //оƬ		  
 //ȴʱ䳬...
 void W25QXX_Erase_Chip(void)   
 {                                   
+	W25QXX_Lock();
     W25QXX_Write_Enable();					//SET WEL 
     W25QXX_Wait_Busy();   
 	QSPI_Send_CMD(W25X_ChipErase,0,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_NONE,QSPI_ADDRESS_8_BITS,QSPI_DATA_NONE);//QPI,дȫƬָ,ַΪ0,_8λַ_޵ַ_4ߴָ,޿,0ֽ
-	W25QXX_Wait_Busy();						//ȴоƬ
+	w25qxx_wait_erase();						//ȴоƬ
+	W25QXX_Unlock();
 } 
 
 //һ
@@ -289,16 +375,20 @@ void W25QXX_Erase_Sector(u32 Dst_Addr)
 	 
  	//printf("fe:%x\r\n",Dst_Addr);			//falsh,  	  
  	Dst_Addr*=4096;
+	W25QXX_Lock();
     W25QXX_Write_Enable();                  //SET WEL 	 
     W25QXX_Wait_Busy();  
 	QSPI_Send_CMD(W25X_SectorErase,Dst_Addr,0,QSPI_INSTRUCTION_4_LINES,QSPI_ADDRESS_4_LINES,QSPI_ADDRESS_32_BITS,QSPI_DATA_NONE);//QPI,дָ,ַΪ0,_32λַ_4ߴַ_4ߴָ,޿,0ֽ
-    W25QXX_Wait_Busy();   				    //ȴ
+    w25qxx_wait_erase();   				    //ȴ
+	W25QXX_Unlock();
 }
 
 //ȴ
 void W25QXX_Wait_Busy(void)   
 {   
+	W25QXX_Lock();
 	while((W25QXX_ReadSR(1)&0x01)==0x01);   // ȴBUSYλ
+	W25QXX_Unlock();
 }   
 
 
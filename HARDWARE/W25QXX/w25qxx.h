@@ -12,6 +12,13 @@
 //ȨУؾ
 //Copyright(C) ӿƼ޹˾ 2014-2024
 //All rights reserved									  
+//********************************************************************************
+//V1.1 20261019
+//ӻ:W25QXX_Lock/W25QXX_Unlock,W25QXX_*ʱ,ͬʱдW25QXX,
+//W25QXX_Writeõ4KBW25QXX_BUFFERҲ
+//ͬһظ(Ƕ׼),Ҫʱ(Ȳд)ټһ
+//OSǰжﲻ,жﲻܶдW25QXX
+//ʱOSTimeDlyȴæ,񲻿ת,Ϊȼ̳пס
 ////////////////////////////////////////////////////////////////////////////////// 	
 
 //W25Xϵ/QϵоƬб	   
@@ -28,6 +35,9 @@
 #define W25Q128	0XEF17
 #define W25Q256 0XEF18
 
+//ȼ(ȼ̳),ûʹ,ҸждW25QXX
+#define W25QXX_MUTEX_PRIO		0
+
 extern u16 W25QXX_TYPE;					//W25QXXоƬͺ		   
  
 ////////////////////////////////////////////////////////////////////////////////// 
@@ -73,4 +83,6 @@ void W25QXX_Write(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite);//д
 void W25QXX_Erase_Chip(void);    	  	//Ƭ
 void W25QXX_Erase_Sector(u32 Dst_Addr);	//
 void W25QXX_Wait_Busy(void);           	//ȴ
+void W25QXX_Lock(void);					//,ͬһǶ
+void W25QXX_Unlock(void);				//
 #endif
@@ -37,6 +37,8 @@ const u32 memblksize[SRAMBANK]={MEM1_BLOCK_SIZE,MEM2_BLOCK_SIZE,MEM3_BLOCK_SIZE,
 								MEM4_BLOCK_SIZE,MEM5_BLOCK_SIZE,MEM6_BLOCK_SIZE};					//ڴֿС
 const u32 memsize[SRAMBANK]={MEM1_MAX_SIZE,MEM2_MAX_SIZE,MEM3_MAX_SIZE,
 							MEM4_MAX_SIZE,MEM5_MAX_SIZE,MEM6_MAX_SIZE};								//ڴܴС
+u32 memused[SRAMBANK];		//ڴ,/ͷʱ,ɨڴ
+u32 mempeak[SRAMBANK];		//ڴֵ
 
 //ڴ
 struct _m_mallco_dev mallco_dev=
@@ -72,6 +74,8 @@ void mymemset(void *s,u8 c,u32 count)
 void my_mem_init(u8 memx)  
 {  
     mymemset(mallco_dev.memmap[memx],0,memtblsize[memx]*4);	//ڴ״̬  
+	memused[memx]=0;
+	mempeak[memx]=0;
  	mallco_dev.memrdy[memx]=1;								//ڴʼOK  
 }  
 //ȡڴʹ
@@ -79,13 +83,27 @@ void my_mem_init(u8 memx)
 //ֵ:ʹ(10,0~1000,0.0%~100.0%)
 u16 my_mem_perused(u8 memx)  
 {  
-    u32 used=0;  
+    return (memused[memx]*1000)/(memtblsize[memx]);  
+}  
+//ȡڴ,ڹƬ̶
+//memx:ڴ
+//ֵ:ڴ
+u32 my_mem_maxfree(u8 memx)  
+{  
+    u32 maxfree=0;  
+	u32 cmemb=0;
     u32 i;  
+	if(!mallco_dev.memrdy[memx])return 0;
     for(i=0;i<memtblsize[memx];i++)  
     {  
-        if(mallco_dev.memmap[memx][i])used++; 
+        if(mallco_dev.memmap[memx][i])
+		{
+			cmemb=0; 
+			i+=mallco_dev.memmap[memx][i]-1;	//ѷ
+		}
+		else if(++cmemb>maxfree)maxfree=cmemb;
     } 
-    return (used*1000)/(memtblsize[memx]);  
+    return maxfree;  
 }  
 //ڴ(ڲ)
 //memx:ڴ
@@ -111,6 +129,8 @@ u32 my_mem_malloc(u8 memx,u32 size)
             {  
                 mallco_dev.memmap[memx][offset+i]=nmemb;  
             }  
+			memused[memx]+=nmemb;
+			if(memused[memx]>mempeak[memx])mempeak[memx]=memused[memx];
             return (offset*memblksize[memx]);//ƫƵַ  
 		}
     }  
@@ -136,6 +156,7 @@ u8 my_mem_free(u8 memx,u32 offset)
         {  
             mallco_dev.memmap[memx][index+i]=0;  
         }  
+		memused[memx]-=nmemb;
         return 0;  
     }else return 2;//ƫƳ.  
 }  
@@ -76,6 +76,10 @@ struct _m_mallco_dev
 	u8  memrdy[SRAMBANK]; 				//ڴǷ
 };
 extern struct _m_mallco_dev mallco_dev;	 //mallco.c涨
+extern u32 memused[SRAMBANK];			//ڴڴ
+extern u32 mempeak[SRAMBANK];			//ڴڴֵ
+extern const u32 memtblsize[SRAMBANK];	//ڴڴ
+extern const u32 memblksize[SRAMBANK];	//ڴڴС
 
 void mymemset(void *s,u8 c,u32 count);	//ڴ
 void mymemcpy(void *des,void *src,u32 n);//ڴ     
@@ -83,6 +87,7 @@ void my_mem_init(u8 memx);				//
 u32 my_mem_malloc(u8 memx,u32 size);	//ڴ(ڲ)
 u8 my_mem_free(u8 memx,u32 offset);		//ڴͷ(ڲ)
 u16 my_mem_perused(u8 memx) ;			//ڴʹ(/ڲ) 
+u32 my_mem_maxfree(u8 memx);			//ڴ(/ڲ)
 ////////////////////////////////////////////////////////////////////////////////
 //ûú
 void myfree(u8 memx,void *ptr);  			//ڴͷ(ⲿ)
@@ -0,0 +1,70 @@
+#include "bootprof.h"
+#include "usart.h"
+//////////////////////////////////////////////////////////////////////////////////	 
+//׶κʱͳ
+//DWTڼÿʼ׶δʱ,ɺͨʱϸ
+//:2026/10/19
+//汾V1.0
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#if BOOTPROF_EN
+//׶μ¼
+typedef struct
+{
+	const char *name;		//׶
+	u32 cyc;				//׶κʱ(CPU)
+	u32 mhz;				//׶οʼʱںƵ(MHz),ʱӳʼǰƵʲͬ
+}_bootprof_stage;
+
+static _bootprof_stage bootprof_tbl[BOOTPROF_STAGE_MAX];
+static u8 bootprof_cnt=0;	//Ѽ¼Ľ׶
+static u32 bootprof_last=0;	//һαʱCYCCNT
+static u32 bootprof_mhz=64;	//һαʱںƵ(MHz),λHSI(64Mhz)
+
+//DWTڼ,ʼͳ
+//CYCCNTΪ32λ,400MhzԼ10.7һ,׶βܳʱ
+void BOOTPROF_Init(void)
+{
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;	//ʹDWT
+	DWT->CYCCNT=0;									//
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;				//CYCCNT
+	bootprof_cnt=0;
+	bootprof_last=0;
+	bootprof_mhz=SystemCoreClock/1000000;
+}
+
+//ǰ׶,¼һαĺʱ
+//ʱ׶οʼʱƵʻus:лʱӵĽ׶(Stm32_Clock_Init)󲿷ʱڵPLL,ʱHSI,
+//ʱ400Mhzܶ
+//name:׶,ǳַ(ָֻ)
+void BOOTPROF_Mark(const char *name)
+{
+	u32 now=DWT->CYCCNT;
+	if(bootprof_cnt<BOOTPROF_STAGE_MAX)
+	{
+		bootprof_tbl[bootprof_cnt].name=name;
+		bootprof_tbl[bootprof_cnt].cyc=now-bootprof_last;
+		bootprof_tbl[bootprof_cnt].mhz=bootprof_mhz;
+		bootprof_cnt++;
+	}
+	bootprof_mhz=SystemCoreClock/1000000;			//һ׶εƵ
+	bootprof_last=DWT->CYCCNT;						//Ǳĺʱ
+}
+
+//ͨ׶κʱ
+void BOOTPROF_Report(void)
+{
+	u8 i;
+	u32 us;
+	u32 total_cyc=0,total_us=0;
+	printf("boot profile:\r\n");
+	for(i=0;i<bootprof_cnt;i++)
+	{
+		us=bootprof_tbl[i].cyc/bootprof_tbl[i].mhz;
+		total_cyc+=bootprof_tbl[i].cyc;
+		total_us+=us;
+		printf("  %-20s %10u cyc %8u us\r\n",bootprof_tbl[i].name,bootprof_tbl[i].cyc,us);
+	}
+	printf("  %-20s %10u cyc %8u us\r\n","total",total_cyc,total_us);
+}
+#endif
@@ -0,0 +1,29 @@
+#ifndef _BOOTPROF_H
+#define _BOOTPROF_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////	 
+//׶κʱͳ
+//DWTڼÿʼ׶δʱ,ɺͨʱϸ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ʹ÷:
+//1,ϵBOOTPROF_Init()
+//2,ÿʼ׶νBOOTPROF_Mark("׶"),¼һαĺʱ
+//3,ȫ׶νBOOTPROF_Report()ϸ
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#define BOOTPROF_EN				1		//0,ر;1,ʱͳ
+#define BOOTPROF_STAGE_MAX		20		//¼Ľ׶
+
+#if BOOTPROF_EN
+void BOOTPROF_Init(void);				//DWT,ʼͳ
+void BOOTPROF_Mark(const char *name);	//ǰ׶
+void BOOTPROF_Report(void);				//׶κʱ
+#else
+#define BOOTPROF_Init()
+#define BOOTPROF_Mark(name)
+#define BOOTPROF_Report()
+#endif
+
+#endif
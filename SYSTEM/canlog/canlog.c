@@ -0,0 +1,261 @@
+#include "canlog.h"
+#include "fdcan.h"
+#include "w25qxx.h"
+#include "malloc.h"
+#include "usart.h"
+#include "stdio.h"
+#include "includes.h"
+//////////////////////////////////////////////////////////////////////////////////
+//CAN¼
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if CANLOG_EN
+#define CANLOG_SECT_NUM			(CANLOG_SIZE/CL_BLOCK_SIZE)	//¼
+#define CANLOG_LINE_MAX			256		//ʱÿǰȴڷͻôռ
+
+//
+#define CANLOG_REQ_NONE			0
+#define CANLOG_REQ_CANDUMP		1
+#define CANLOG_REQ_ASC			2
+#define CANLOG_REQ_ERASE		3
+
+static _cl_ring canlog_ring;
+static u8 canlog_ok=0;				//1,ѳʼ
+static volatile u8 canlog_req=CANLOG_REQ_NONE;
+static volatile u32 canlog_last;	//һ֡Ľ
+static u32 canlog_head;				//һҪд
+static u32 canlog_written;			//д˶ٸ
+static u32 canlog_erases;			//˶ٸ
+static u32 canlog_wmax;				//дһ()ʱ(ms)
+static u32 canlog_exp_frames;		//ϴε֡
+static u32 canlog_exp_lost;			//ϴεĿͷ¼Ķ֡
+
+//֡,FDCAN1ж
+static void canlog_hook(const _fdcan_frame *frame)
+{
+	canlog_last=OSTimeGet();
+	cl_put(&canlog_ring,frame->id,frame->flags,frame->ts,canlog_last,frame->data,frame->len);
+}
+
+//ʼ,ʼ¼
+//ɨ¼Ŀͷ,д
+//ֵ:0,ɹ;1,ڴ治
+u8 CANLOG_Init(void)
+{
+	_cl_head h;
+	u8 *mem;
+	u32 i,seq=0,last=0;
+	u8 found=0;
+	mem=mymalloc(SRAM12,CANLOG_BLOCK_NUM*CL_BLOCK_SIZE);
+	if(mem==NULL)return 1;
+	for(i=0;i<CANLOG_SECT_NUM;i++)
+	{
+		W25QXX_Read((u8*)&h,CANLOG_ADDR+i*CL_BLOCK_SIZE,sizeof(h));
+		if(h.magic!=CL_MAGIC)continue;
+		if(!found||(s32)(h.seq-seq)>0)
+		{
+			seq=h.seq;
+			last=i;
+			found=1;
+		}
+	}
+	//ÿд֮ǰ,ϴдһֵʱ²
+	canlog_head=found?(last+1)%CANLOG_SECT_NUM:0;
+	cl_init(&canlog_ring,mem,CANLOG_BLOCK_NUM,FDCAN1_Bitrate(),found?seq+1:0);
+	canlog_last=OSTimeGet();
+	canlog_ok=1;
+	FDCAN1_SetHook(canlog_hook);
+	return 0;
+}
+
+//һдһ,д֮ǰֻһ
+//4KB,ÿγW25QXXʱ䲻һĲдʱ(400ms,һ45ms),
+//(64KB,2s),дW25QXX̫
+//ͷд,дһʱͷЧ
+static void canlog_write(u8 *blk)
+{
+	_cl_head *h=(_cl_head*)blk;
+	u32 addr=CANLOG_ADDR+canlog_head*CL_BLOCK_SIZE;
+	u32 t=OSTimeGet();
+	W25QXX_Lock();						//дͷ֮䲻дW25QXX
+	W25QXX_Erase_Sector(addr/4096);
+	canlog_erases++;
+	W25QXX_Write_NoCheck(blk+CL_HEAD_SIZE,addr+CL_HEAD_SIZE,h->used-CL_HEAD_SIZE);
+	W25QXX_Write_NoCheck(blk,addr,CL_HEAD_SIZE);
+	W25QXX_Unlock();
+	canlog_head=(canlog_head+1)%CANLOG_SECT_NUM;
+	canlog_written++;
+	t=OSTimeGet()-t;
+	if(t>canlog_wmax)canlog_wmax=t;
+}
+
+//ѻдĿȫдFLASH
+//flush:1,ûдĿҲдȥ
+static void canlog_drain(u8 flush)
+{
+	u8 *blk;
+	OS_CPU_SR cpu_sr=0;
+	if(flush)
+	{
+		OS_ENTER_CRITICAL();
+		cl_flush(&canlog_ring);
+		OS_EXIT_CRITICAL();
+	}
+	while((blk=cl_peek(&canlog_ring))!=NULL)
+	{
+		canlog_write(blk);
+		cl_pop(&canlog_ring);
+	}
+}
+
+//ȫ¼,ͷʼд
+//ֻͷЧ(ʱ),ÿ
+static void canlog_erase(void)
+{
+	u32 i,magic;
+	for(i=0;i<CANLOG_SECT_NUM;i++)
+	{
+		W25QXX_Read((u8*)&magic,CANLOG_ADDR+i*CL_BLOCK_SIZE,4);
+		if(magic!=CL_MAGIC)continue;
+		W25QXX_Erase_Sector((CANLOG_ADDR+i*CL_BLOCK_SIZE)/4096);
+		canlog_erases++;
+	}
+	canlog_head=0;
+	printf("canlog: erased\r\n");
+}
+
+//nֽڵʮ
+static void canlog_hex(const u8 *data,u8 n,u8 space)
+{
+	u8 i;
+	for(i=0;i<n;i++)printf(space?" %02X":"%02X",data[i]);
+}
+
+//ʽһ֡
+static void canlog_line(u8 fmt,const _cl_frame *f)
+{
+	char id[12];
+	while(usart_tx_free()<CANLOG_LINE_MAX)OSTimeDly(1);	//ȴڷȥ,
+	if(fmt==CANLOG_FMT_CANDUMP)
+	{
+		printf((f->flags&CL_F_EXT)?"(%010u.%06u) %s %08X#":"(%010u.%06u) %s %03X#",f->sec,f->usec,CANLOG_IFNAME,f->id);
+		if(f->flags&CL_F_FD)printf("#%X",((f->flags&CL_F_BRS)?1:0)|((f->flags&CL_F_ESI)?2:0));
+		else if(f->flags&CL_F_RTR)printf("R");
+		canlog_hex(f->data,f->len,0);
+	}
+	else
+	{
+		sprintf(id,(f->flags&CL_F_EXT)?"%Xx":"%X",f->id);		//ASCչIDx
+		if(f->flags&CL_F_FD)
+		{
+			printf("%4u.%06u CANFD   1 Rx   %8s %d %d %X %2u",f->sec,f->usec,id,(f->flags&CL_F_BRS)?1:0,
+				(f->flags&CL_F_ESI)?1:0,fd_len2dlc(f->len),f->len);
+			canlog_hex(f->data,f->len,1);
+		}
+		else
+		{
+			printf("%4u.%06u 1  %-15s Rx   %c",f->sec,f->usec,id,(f->flags&CL_F_RTR)?'r':'d');
+			if(!(f->flags&CL_F_RTR))
+			{
+				printf(" %u",f->len);
+				canlog_hex(f->data,f->len,1);
+			}
+		}
+	}
+	printf("\r\n");
+}
+
+//ɵʼȫ¼,ȰѻĿдȥ
+//ڼյµʱֹ,µ´CANLOG_Pollִ
+static void canlog_export(u8 fmt)
+{
+	_cl_cursor c;
+	_cl_frame f;
+	_cl_head *h;
+	u8 *buf;
+	u32 i,s,start,addr;
+	buf=mymalloc(SRAM12,CL_BLOCK_SIZE);
+	if(buf==NULL)
+	{
+		printf("canlog: no memory\r\n");
+		return;
+	}
+	canlog_drain(1);
+	canlog_exp_frames=0;
+	canlog_exp_lost=0;
+	start=canlog_head;					//һҪдɵ
+	if(fmt==CANLOG_FMT_ASC)
+	{
+		printf("date Thu Jan 1 00:00:00.000 am 1970\r\n");
+		printf("base hex  timestamps absolute\r\n");
+		printf("internal events logged\r\n");
+		printf("Begin Triggerblock Thu Jan 1 00:00:00.000 am 1970\r\n");
+	}
+	for(i=0;i<CANLOG_SECT_NUM&&canlog_req==CANLOG_REQ_NONE;i++)
+	{
+		s=(start+i)%CANLOG_SECT_NUM;
+		addr=CANLOG_ADDR+s*CL_BLOCK_SIZE;
+		W25QXX_Read(buf,addr,CL_HEAD_SIZE);
+		h=(_cl_head*)buf;
+		if(h->magic!=CL_MAGIC||h->used<=CL_HEAD_SIZE||h->used>CL_BLOCK_SIZE)continue;	//ûдûд
+		W25QXX_Read(buf+CL_HEAD_SIZE,addr+CL_HEAD_SIZE,h->used-CL_HEAD_SIZE);
+		canlog_exp_lost+=h->lost;
+		if(cl_open(&c,buf))continue;
+		while(cl_next(&c,&f))
+		{
+			canlog_line(fmt,&f);
+			canlog_exp_frames++;
+		}
+	}
+	if(fmt==CANLOG_FMT_ASC)printf("End TriggerBlock\r\n");
+	myfree(SRAM12,buf);
+}
+
+//¼ѭ:дĿдFLASH,ʱдûдĿ,ִе/
+//ֵ:´εǰȴʱ(ms)
+u32 CANLOG_Poll(void)
+{
+	u8 req;
+	if(!canlog_ok)return 1000;
+	canlog_drain(canlog_ring.cur!=NULL&&(s32)(OSTimeGet()-canlog_last)>=CANLOG_FLUSH_MS);
+	req=canlog_req;
+	canlog_req=CANLOG_REQ_NONE;
+	if(req==CANLOG_REQ_ERASE)
+	{
+		canlog_drain(1);
+		canlog_erase();
+	}
+	else if(req!=CANLOG_REQ_NONE)canlog_export(req==CANLOG_REQ_ASC?CANLOG_FMT_ASC:CANLOG_FMT_CANDUMP);
+	return CANLOG_POLL_MS;
+}
+
+//󵼳
+//fmt:CANLOG_FMT_CANDUMPCANLOG_FMT_ASC
+void CANLOG_Export(u8 fmt)
+{
+	canlog_req=fmt==CANLOG_FMT_ASC?CANLOG_REQ_ASC:CANLOG_REQ_CANDUMP;
+}
+
+//ȫ¼
+void CANLOG_Erase(void)
+{
+	canlog_req=CANLOG_REQ_ERASE;
+}
+
+//ͳ
+void CANLOG_Report(void)
+{
+	if(!canlog_ok)
+	{
+		printf("canlog: not started\r\n");
+		return;
+	}
+	printf("canlog: %u frames, lost %u, %u blocks, ram %u/%u blocks peak %u, %u bytes -> %u bytes\r\n",canlog_ring.frames,
+		canlog_ring.lost,canlog_ring.blocks,cl_fill(&canlog_ring),CANLOG_BLOCK_NUM,canlog_ring.peak,canlog_ring.raw,canlog_ring.bytes);
+	printf("canlog flash: sector %u/%u, seq %u, written %u sectors, %u sector erases, wear %u cycles, longest write %u ms\r\n",
+		canlog_head,CANLOG_SECT_NUM,canlog_ring.seq,canlog_written,canlog_erases,canlog_ring.seq/CANLOG_SECT_NUM,canlog_wmax);
+	printf("canlog last export: %u frames, lost %u\r\n",canlog_exp_frames,canlog_exp_lost);
+}
+#endif
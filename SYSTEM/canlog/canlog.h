@@ -0,0 +1,53 @@
+#ifndef _CANLOG_H
+#define _CANLOG_H
+#include "sys.h"
+#include "clcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//CAN¼:¼FDCAN1յÿһ֡(Ӳʱ),ѹ浽W25Q256,Ӵ1
+//ѹͿʽclcore.c,︺FDCAN1дW25QXX͵
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ж(FDCAN1_SetHook)֡ѹдRAM4KB黷λ(SRAM1/2ڴ),
+//¼(CANLOG_Poll)дĿдW25QXX,CANLOG_FLUSH_MSûдĿҲдȥ
+//FLASHѭд,ÿд֮ǰȲ,ɵݱ,дͬ;
+//λɨͷҵ,д,ܴͷʼд
+//ͷд,дһͷЧ,ʱ
+//:CANLOG_Export(),¼ɵʼ
+//  candumpʽ(candump -l־ʽ,canplayerط)Vector ASCʽ
+//  ڼ䲻дFLASH,յ֡RAM,֡(һͷ)
+//ʹ÷:
+//1,W25QXX_InitFDCAN1_Mode_Init֮CANLOG_Init()
+//2,һȼѭOSTimeDly(CANLOG_Poll()),FLASHʱOSTimeDlyȴæ,ռCPU
+//W25QXXдл,ͬʱдW25QXX;дһʱ,
+//дW25QXXһĲдʱ
+//дʱFLASHÿԼд70KBѹ:500Kbit/sͳ֡ز֡,
+//1Mbit/sͳ֡CAN FDʱᶪ֡,֡ڿͷ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CANLOG_EN				1		//0,ر;1,CAN¼
+#define CANLOG_BLOCK_NUM		32		//RAM(ÿ4KB),2;ʱܳŹдʱ(400ms)
+#define CANLOG_ADDR				0x01200000	//W25QXXļ¼,64KB
+#define CANLOG_SIZE				0x00C00000	//¼С,64KB
+#define CANLOG_FLUSH_MS			1000	//û֡msдûдĿ
+#define CANLOG_POLL_MS			10		//CANLOG_Pollصĵȴʱ(ms)
+#define CANLOG_IFNAME			"can0"	//candumpʽĽӿ
+
+//ʽ
+#define CANLOG_FMT_CANDUMP		0		//(.΢) can0 123#11223344
+#define CANLOG_FMT_ASC			1		//Vector ASC
+
+#if CANLOG_EN
+u8 CANLOG_Init(void);					//ʼ,ʼ¼,0ɹ,1ڴ治
+u32 CANLOG_Poll(void);					//дFLASH,´εǰȴʱ(ms)
+void CANLOG_Export(u8 fmt);				//󵼳,CANLOG_Poll
+void CANLOG_Erase(void);				//ȫ¼,CANLOG_Pollִ
+void CANLOG_Report(void);				//ͳ
+#else
+#define CANLOG_Init()			0
+#define CANLOG_Poll()			1000
+#define CANLOG_Export(fmt)
+#define CANLOG_Erase()
+#define CANLOG_Report()
+#endif
+#endif
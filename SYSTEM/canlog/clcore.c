@@ -0,0 +1,273 @@
+#include "clcore.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CAN¼Ǻ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//ʼ
+//mem:numĻ
+//num:,2
+//bitrate:(ٲö),ʱĵλ1λʱ
+//seq:һ,FLASHһ
+void cl_init(_cl_ring *r,uint8_t *mem,uint16_t num,uint32_t bitrate,uint32_t seq)
+{
+	memset(r,0,sizeof(_cl_ring));
+	r->mem=mem;
+	r->num=num;
+	r->bpm=bitrate/1000;
+	if(r->bpm==0)r->bpm=1;
+	r->seq=seq;
+}
+
+//
+uint16_t cl_fill(const _cl_ring *r)
+{
+	return (uint16_t)(r->wr-r->rd);
+}
+
+//дĿ,NULLʾû(ߵ)
+uint8_t *cl_peek(_cl_ring *r)
+{
+	if(r->wr==r->rd)return NULL;
+	return r->mem+(uint32_t)(r->rd&(r->num-1))*CL_BLOCK_SIZE;
+}
+
+//ͷcl_peekȡĿ(ߵ)
+void cl_pop(_cl_ring *r)
+{
+	if(r->wr!=r->rd)r->rd++;
+}
+
+//ʱͽһ֡ʱ
+//ֵ:0,ʱǰ(򲻱);1,һ֡һ֡(FIFO֡),ʱ䲻,ο㲻
+static uint8_t cl_clock(_cl_ring *r,uint16_t ts,uint32_t tick)
+{
+	uint32_t dt,us,acc,bits,n;
+	int32_t base,x;
+	if(!r->started)
+	{
+		r->started=1;
+		r->sec=tick/1000;
+		r->usec=tick%1000*1000;
+	}
+	else
+	{
+		dt=tick-r->tick;
+		if((int32_t)dt<0)dt=0;					//֡ȡʱȡ,һ֡ʱͬһ
+		if(dt>=CL_COARSE_MS)					//̫,Ȱǰ,οֵǰ,ʣµĲü
+		{
+			n=dt-CL_COARSE_MS/2;
+			r->sec+=n/1000;
+			r->usec+=n%1000*1000;
+			r->ts+=(uint16_t)((n&0xFFFF)*(r->bpm&0xFFFF));
+			dt-=n;
+		}
+		//ֵ65536λ,ȡӽֵǸ
+		base=(int16_t)(ts-r->ts);
+		x=(int32_t)(dt*r->bpm)-base+32768;
+		if(x>0)base+=(x/65536)*65536;
+		if(base<0)return 1;
+		bits=base;
+		acc=r->rem+bits%r->bpm*1000;			//ʱͷһ֡,ʱ䲻ۻ
+		us=bits/r->bpm*1000+acc/r->bpm;
+		r->rem=acc%r->bpm;
+		r->usec+=us%1000000;
+		r->sec+=us/1000000+r->usec/1000000;
+		r->usec%=1000000;
+	}
+	r->ts=ts;
+	r->tick=tick;
+	return 0;
+}
+
+//varintֽ
+static uint8_t cl_vlen(uint32_t v)
+{
+	uint8_t n=1;
+	while(v>=0x80)
+	{
+		v>>=7;
+		n++;
+	}
+	return n;
+}
+
+//дvarint
+static uint8_t *cl_vput(uint8_t *p,uint32_t v)
+{
+	while(v>=0x80)
+	{
+		*p++=(uint8_t)(v|0x80);
+		v>>=7;
+	}
+	*p++=(uint8_t)v;
+	return p;
+}
+
+//ʼ¿
+//ֵ:0,ɹ;1,ûпտ
+static uint8_t cl_start(_cl_ring *r)
+{
+	_cl_head *h;
+	if(cl_fill(r)>=r->num)return 1;
+	r->cur=r->mem+(uint32_t)(r->wr&(r->num-1))*CL_BLOCK_SIZE;
+	h=(_cl_head*)r->cur;
+	h->magic=CL_MAGIC;
+	h->seq=r->seq++;
+	h->sec=r->sec;
+	h->usec=r->usec;
+	h->lost=r->lost_pend;
+	r->lost_pend=0;
+	r->pos=CL_HEAD_SIZE;
+	r->count=0;
+	r->prev_id=0;
+	r->psec=r->sec;
+	r->pusec=r->usec;
+	return 0;
+}
+
+//ǰ,
+static void cl_close(_cl_ring *r)
+{
+	_cl_head *h=(_cl_head*)r->cur;
+	h->used=r->pos;
+	h->count=r->count;
+	r->cur=NULL;
+	r->wr++;									//дٸwr
+	r->blocks++;
+	if(cl_fill(r)>r->peak)r->peak=cl_fill(r);
+}
+
+//ǰ(м¼ʱ),;Ҫcl_put(ж)
+void cl_flush(_cl_ring *r)
+{
+	if(r->cur!=NULL&&r->count)cl_close(r);
+}
+
+//¼һ֡(ߵ,ڽж)
+//id,flags,data,len:յ֡,flagsΪCL_F_xxx
+//ts:֡ʱֵ
+//tick:ǰ(ms)
+//ֵ:0,ɹ;1,,
+uint8_t cl_put(_cl_ring *r,uint32_t id,uint8_t flags,uint16_t ts,uint32_t tick,const uint8_t *data,uint8_t len)
+{
+	uint32_t dt=0,zz=0;
+	uint16_t need;
+	uint8_t *p;
+	r->frames++;
+	cl_clock(r,ts,tick);
+	if(len>64)len=64;
+	flags&=CL_F_MASK;
+	if(r->cur!=NULL)
+	{
+		if(r->sec-r->psec>=CL_GAP_MAX/1000000)dt=CL_GAP_MAX;
+		else dt=(r->sec-r->psec)*1000000+r->usec-r->pusec;
+		if(dt>=CL_GAP_MAX)cl_close(r);			//̫,¿Ŀͷ¼¼ʱ
+	}
+	if(r->cur==NULL)
+	{
+		if(cl_start(r))
+		{
+			r->lost++;
+			r->lost_pend++;
+			return 1;
+		}
+		dt=0;
+	}
+	if(id!=r->prev_id||r->count==0)zz=(id>=r->prev_id)?(id-r->prev_id)<<1:((r->prev_id-id)<<1)-1;
+	else flags|=CL_F_SAMEID;
+	need=1+cl_vlen(dt)+(flags&CL_F_SAMEID?0:cl_vlen(zz))+1+len;
+	if(r->pos+need>CL_BLOCK_SIZE)				//ǰŲ,һ
+	{
+		cl_close(r);
+		if(cl_start(r))
+		{
+			r->lost++;
+			r->lost_pend++;
+			return 1;
+		}
+		dt=0;
+		flags&=CL_F_MASK;
+		zz=id<<1;
+		need=1+1+cl_vlen(zz)+1+len;
+	}
+	p=r->cur+r->pos;
+	*p++=flags;
+	p=cl_vput(p,dt);
+	if(!(flags&CL_F_SAMEID))p=cl_vput(p,zz);
+	*p++=len;
+	memcpy(p,data,len);
+	r->pos+=need;
+	r->count++;
+	r->prev_id=id;
+	r->psec=r->sec;
+	r->pusec=r->usec;
+	r->raw+=14+len;
+	r->bytes+=need;
+	return 0;
+}
+
+//varint
+//ֵ:0,ɹ;1,
+static uint8_t cl_vget(_cl_cursor *c,uint32_t *v)
+{
+	uint32_t x=0;
+	uint8_t s=0,b;
+	do
+	{
+		if(c->pos>=c->used||s>28)return 1;
+		b=c->blk[c->pos++];
+		x|=(uint32_t)(b&0x7F)<<s;
+		s+=7;
+	}while(b&0x80);
+	*v=x;
+	return 0;
+}
+
+//ʼһ
+//blk:(ٿͷusedֽ)
+//ֵ:0,ɹ;1,ͷЧ(ûдûд)
+uint8_t cl_open(_cl_cursor *c,const uint8_t *blk)
+{
+	const _cl_head *h=(const _cl_head*)blk;
+	if(h->magic!=CL_MAGIC||h->used<CL_HEAD_SIZE||h->used>CL_BLOCK_SIZE)return 1;
+	c->blk=blk;
+	c->pos=CL_HEAD_SIZE;
+	c->used=h->used;
+	c->sec=h->sec;
+	c->usec=h->usec;
+	c->id=0;
+	return 0;
+}
+
+//һ֡
+//ֵ:1,ɹ;0,ݴ
+uint8_t cl_next(_cl_cursor *c,_cl_frame *f)
+{
+	uint32_t dt,zz;
+	uint8_t flags;
+	if(c->pos>=c->used)return 0;
+	flags=c->blk[c->pos++];
+	if(cl_vget(c,&dt))return 0;
+	if(!(flags&CL_F_SAMEID))
+	{
+		if(cl_vget(c,&zz))return 0;
+		if(zz&1)c->id-=(zz>>1)+1;
+		else c->id+=zz>>1;
+	}
+	if(c->pos>=c->used)return 0;
+	f->len=c->blk[c->pos++];
+	if(f->len>64||c->pos+f->len>c->used)return 0;
+	f->data=c->blk+c->pos;
+	c->pos+=f->len;
+	c->usec+=dt%1000000;
+	c->sec+=dt/1000000+c->usec/1000000;
+	c->usec%=1000000;
+	f->sec=c->sec;
+	f->usec=c->usec;
+	f->id=c->id;
+	f->flags=flags&CL_F_MASK;
+	return 1;
+}
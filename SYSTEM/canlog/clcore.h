@@ -0,0 +1,115 @@
+#ifndef _CLCORE_H
+#define _CLCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CAN¼Ǻ:֡ѹ4KB黷λ
+//ֻñ׼C,HALOSFDCAN,PCģ߲
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//յ֡cl_put(ڽж)ѹд뵱ǰ,д󽻸()дFLASH
+//ֻwr͵ǰ,ֻrd,ߵ߲Ҫж
+//ʽ:ͷ(_cl_head,24ֽ)+¼,ÿ鵥,ǰĿ
+//¼ʽ:־(1) ʱ(varint,us) [ID(zigzag varint)] (1) 
+//  ־:5λΪCL_F_xxx,CL_F_SAMEIDʾIDһͬ,ID
+//  ʱ:һԿͷʱ,һ;ID:һ0
+//ʱ:FDCAN16λʱ(λ1λʱ)֡,жϼ˼,
+//  гCL_COARSE_MSʱȰǰ;ʱӿ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CL_BLOCK_SIZE			4096	//С,W25QXXһ
+#define CL_HEAD_SIZE			24		//ͷС
+#define CL_MAGIC				0x474C4E43	//ͷ"CNLG"
+#define CL_COARSE_MS			10000	//гʱ(ms)Ȱǰ,ܴ2^31/ÿmsλ
+#define CL_GAP_MAX				0x10000000	//֡ʱ(us)ʱʼ¿
+
+//֡־,FDCAN1_F_xxxͬ
+#define CL_F_EXT				0x01	//չID
+#define CL_F_RTR				0x02	//Զ֡
+#define CL_F_FD					0x04	//CAN FD֡
+#define CL_F_BRS				0x08	//CAN FD֡,ݶл
+#define CL_F_ESI				0x10	//ͽڵ󱻶
+#define CL_F_MASK				0x1F
+#define CL_F_SAMEID				0x20	//¼ûID(һͬ)
+
+//ͷ,С
+typedef struct
+{
+	uint32_t magic;				//CL_MAGIC
+	uint32_t seq;				//,ÿ1
+	uint32_t sec;				//鿪ʼʱ(һ¼)
+	uint32_t usec;
+	uint16_t used;				//ֽ(ͷ)
+	uint16_t count;				//¼
+	uint32_t lost;				//֮ǰΪ֡
+}_cl_head;
+
+//һ֡
+typedef struct
+{
+	uint32_t sec;				//ʱ
+	uint32_t usec;
+	uint32_t id;
+	uint8_t flags;				//CL_F_xxx
+	uint8_t len;				//ֽ
+	const uint8_t *data;		//ָ
+}_cl_frame;
+
+//һα
+typedef struct
+{
+	const uint8_t *blk;
+	uint16_t pos;
+	uint16_t used;
+	uint32_t sec;
+	uint32_t usec;
+	uint32_t id;
+}_cl_cursor;
+
+typedef struct
+{
+	//
+	uint8_t *mem;				//num*CL_BLOCK_SIZEֽ,4ֽڶ
+	uint16_t num;				//,2
+	uint32_t bpm;				//ÿmsλ
+
+	//黷λ
+	volatile uint16_t wr;		//дĿ(ɼ),޸
+	volatile uint16_t rd;		//ȡߵĿ(ɼ),޸
+
+	//״̬
+	uint8_t *cur;				//дĿ,NULLʾû
+	uint16_t pos;				//ǰֽ
+	uint16_t count;				//ǰ¼
+	uint32_t seq;				//һ
+	uint32_t prev_id;			//ǰһ¼ID
+	uint32_t psec;				//ǰһ¼ʱ
+	uint32_t pusec;
+	uint32_t lost_pend;			//ûǵͷĶ֡
+
+	//ʱ
+	uint8_t started;
+	uint16_t ts;				//һ֡ʱֵ
+	uint32_t tick;				//һ֡Ľ(ms)
+	uint32_t rem;				//usµͷ(λ:1/1000λ,Сbpm)
+	uint32_t sec;				//һ֡ʱ
+	uint32_t usec;
+
+	//ͳ
+	uint32_t frames;			//յ֡
+	uint32_t lost;				//֡
+	uint32_t blocks;			//дĿ
+	uint32_t raw;				//ѹʱֽ(ÿ֡14ֽ+)
+	uint32_t bytes;				//ѹֽ
+	uint16_t peak;				//
+}_cl_ring;
+
+void cl_init(_cl_ring *r,uint8_t *mem,uint16_t num,uint32_t bitrate,uint32_t seq);	//ʼ,seqΪһ
+uint8_t cl_put(_cl_ring *r,uint32_t id,uint8_t flags,uint16_t ts,uint32_t tick,const uint8_t *data,uint8_t len);	//¼һ֡,0ɹ,1
+void cl_flush(_cl_ring *r);										//ǰ(м¼ʱ),
+uint8_t *cl_peek(_cl_ring *r);									//дĿ,NULLʾû
+void cl_pop(_cl_ring *r);										//ͷcl_peekȡĿ
+uint16_t cl_fill(const _cl_ring *r);							//
+uint8_t cl_open(_cl_cursor *c,const uint8_t *blk);				//ʼһ,0ɹ,1ͷЧ
+uint8_t cl_next(_cl_cursor *c,_cl_frame *f);					//һ֡,1ɹ,0ݴ
+#endif
@@ -0,0 +1,214 @@
+//////////////////////////////////////////////////////////////////////////////////
+//clcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/canlog SYSTEM/canlog/clcore_test.c SYSTEM/canlog/clcore.c
+//ģ:֡λƽʱ(16λ,λ1λʱ),Ĵ0~2msĶȡӳ;
+//߰дҳ/ĺʱѿ"дFLASH",,ͷ֡ȽID־ݺʱ(1us)
+//500Kbit/sͳ֡(ÿ20һʱ)ʱв֡;
+//̫С/̫1Mbit/sͳ֡CAN FD 64ֽ֡ʱ֡,֡ڿͷ;鲻ܽ
+//////////////////////////////////////////////////////////////////////////////////
+#include "clcore.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(c)	do{if(!(c)){printf("clcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define NF			100000		//ÿģ֡
+#define FLASH_SIZE	(16*1024*1024)
+
+typedef struct
+{
+	uint64_t sof;				//֡ʼʱ(λ)
+	uint32_t id;
+	uint8_t flags;
+	uint8_t len;
+	uint8_t data[64];
+}_sim_frame;
+
+//һģĽ
+typedef struct
+{
+	uint32_t lost;				//_cl_ring.lost
+	uint32_t head_lost;			//ͷĶ֮֡
+	uint32_t decoded;			//֡
+	uint32_t bad;				//ͷ֡һµ֡
+	uint32_t blocks;
+	uint32_t seq_err;			//ŲĴ
+	uint16_t peak;
+	uint32_t raw,bytes;
+}_sim_res;
+
+static _sim_frame frames[NF];
+static uint8_t flash[FLASH_SIZE];
+static uint8_t mem[32*CL_BLOCK_SIZE];
+static uint32_t rnd_s=1;
+static uint32_t fd_lost,mbit_lost;			//CAN FD/1Mbit/sʱ֡
+
+static uint32_t rnd(void)
+{
+	rnd_s^=rnd_s<<13;
+	rnd_s^=rnd_s>>17;
+	rnd_s^=rnd_s<<5;
+	return rnd_s;
+}
+
+//߰һдFLASH
+static uint32_t store(_cl_ring *r,uint32_t fl)
+{
+	memcpy(flash+fl,cl_peek(r),CL_BLOCK_SIZE);
+	cl_pop(r);
+	return fl+CL_BLOCK_SIZE;
+}
+
+//bitrate:;num:;erase_ms/page_ms:һ4KB(ÿһ,canlog.cͬ)/дһҳʱ
+//slow_ms:ÿ20һʱΪslow_ms(W25Q256һ45ms,400ms)
+//idle:1,ÿ50000֡15s400s;fd:1,CAN FD 64ֽ֡
+static void sim(uint32_t bitrate,uint16_t num,double erase_ms,double slow_ms,double page_ms,uint8_t idle,uint8_t fd,_sim_res *res)
+{
+	_cl_ring r;
+	_cl_cursor c;
+	_cl_frame g;
+	_cl_head *h;
+	_sim_frame *f;
+	uint64_t clk=0,us,t0=0,exp;
+	uint32_t bpm=bitrate/1000,fl=0,off,i,j=0,k,seq;
+	int64_t e;
+	double busy_until=0,tms,cost;
+	memset(res,0,sizeof(_sim_res));
+	cl_init(&r,mem,num,bitrate,100);
+	rnd_s=1;
+	for(i=0;i<NF;i++)
+	{
+		f=&frames[i];
+		f->id=(rnd()%4==0)?(rnd()&0x1FFFFFFF):(0x100+rnd()%20);		//󲿷֡ID
+		f->flags=f->id>0x7FF?CL_F_EXT:0;
+		if(rnd()%50==0)f->flags|=CL_F_RTR;
+		f->len=(f->flags&CL_F_RTR)?0:rnd()%9;
+		if(fd&&!(f->flags&CL_F_RTR))
+		{
+			f->flags|=CL_F_FD|CL_F_BRS;
+			f->len=64;
+		}
+		for(k=0;k<f->len;k++)f->data[k]=(uint8_t)rnd();
+		if(idle&&i%50000==49999)clk+=(uint64_t)bpm*(i%100000==99999?400000:15000);
+		f->sof=clk;
+		if(fd)clk+=30+(64*8+50)*bpm/2000/4;							//ݶ4
+		else clk+=((f->flags&CL_F_EXT)?67:47)+8*f->len+(8*f->len+34)/5;
+		//Ȱһ֮֡ǰдĿдFLASH
+		tms=(double)f->sof/bpm;
+		while(cl_peek(&r)!=NULL&&busy_until<=tms)
+		{
+			h=(_cl_head*)cl_peek(&r);
+			cost=page_ms*((h->used+255)/256)+(res->blocks%20==19?slow_ms:erase_ms);
+			fl=store(&r,fl);
+			res->blocks++;
+			busy_until=(busy_until<tms-10?tms:busy_until)+cost;
+		}
+		cl_put(&r,f->id,f->flags,(uint16_t)f->sof,(uint32_t)(f->sof/bpm)+rnd()%3,f->data,f->len);
+	}
+	cl_flush(&r);
+	while(cl_peek(&r)!=NULL)fl=store(&r,fl);
+	res->lost=r.lost;
+	res->peak=r.peak;
+	res->raw=r.raw;
+	res->bytes=r.bytes;
+
+	//,ͷǵĶ֡
+	seq=100;
+	for(off=0;off<fl;off+=CL_BLOCK_SIZE)
+	{
+		h=(_cl_head*)(flash+off);
+		if(cl_open(&c,flash+off)){res->bad++;break;}
+		if(h->seq!=seq++)res->seq_err++;
+		res->head_lost+=h->lost;
+		j+=h->lost;
+		while(cl_next(&c,&g))
+		{
+			if(j>=NF){res->bad++;break;}
+			f=&frames[j++];
+			res->decoded++;
+			us=(uint64_t)g.sec*1000000+g.usec;
+			exp=f->sof*1000/bpm;
+			if(res->decoded==1)t0=us-exp;
+			e=(int64_t)(us-t0)-(int64_t)exp;
+			if(g.id!=f->id||g.flags!=f->flags||g.len!=f->len||memcmp(g.data,f->data,f->len)||e>1||e<-1)res->bad++;
+		}
+	}
+	res->head_lost+=r.lost_pend;								//Ķ֡ûпͷ¼
+}
+
+static int test_full(void)
+{
+	_sim_res s;
+	sim(500000,32,45,400,0.7,0,0,&s);							//500Kbit/s(Ĳ)
+	CHECK(s.lost==0&&s.decoded==NF&&s.bad==0&&s.seq_err==0);
+	CHECK(s.peak<32&&s.raw>s.bytes*3/2);						//,ѹʴ1.5
+	sim(500000,32,45,400,0.7,1,0,&s);							//15s/400sʱȻȷ
+	CHECK(s.lost==0&&s.decoded==NF&&s.bad==0&&s.seq_err==0);
+	return 0;
+}
+
+//CAN FD 64ֽ֡(500K/2M)1Mbit/sͳ֡رȰдFLASH:
+//֡,֡ڿͷ,û֡ܽ
+static int test_fd(void)
+{
+	_sim_res s;
+	sim(500000,32,45,400,0.7,0,1,&s);
+	CHECK(s.lost>0&&s.head_lost==s.lost&&s.peak==32);
+	CHECK(s.decoded+s.lost==NF&&s.bad==0&&s.seq_err==0);
+	fd_lost=s.lost;
+	sim(1000000,32,45,400,0.7,0,0,&s);
+	CHECK(s.lost>0&&s.head_lost==s.lost);
+	CHECK(s.decoded+s.lost==NF&&s.bad==0&&s.seq_err==0);
+	mbit_lost=s.lost;
+	return 0;
+}
+
+//4,2s:ʱ֡,֡һͷ,֡ܽ
+static int test_overrun(void)
+{
+	_sim_res s;
+	sim(500000,4,2000,2000,3,0,0,&s);
+	CHECK(s.lost>0&&s.head_lost==s.lost);
+	CHECK(s.decoded+s.lost==NF&&s.bad==0&&s.seq_err==0);
+	return 0;
+}
+
+//ͷЧݱضʱܽ
+static int test_bad(void)
+{
+	_cl_ring r;
+	_cl_cursor c;
+	_cl_frame g;
+	uint8_t *b,d[8]={1,2,3,4,5,6,7,8};
+	_cl_head *h;
+	uint32_t i,n=0;
+	cl_init(&r,mem,4,500000,7);
+	for(i=0;i<10;i++)CHECK(cl_put(&r,0x123,0,(uint16_t)(i*200),i,d,8)==0);
+	cl_flush(&r);
+	CHECK(cl_fill(&r)==1);
+	b=cl_peek(&r);
+	h=(_cl_head*)b;
+	CHECK(h->magic==CL_MAGIC&&h->seq==7&&h->count==10&&h->lost==0);
+	CHECK(cl_open(&c,b)==0);
+	while(cl_next(&c,&g))n++;
+	CHECK(n==10&&g.id==0x123&&g.len==8&&memcmp(g.data,d,8)==0);
+	h->used-=5;													//һ¼
+	CHECK(cl_open(&c,b)==0);
+	for(n=0;cl_next(&c,&g);n++);
+	CHECK(n==9);
+	h->used=CL_BLOCK_SIZE+1;
+	CHECK(cl_open(&c,b)==1);
+	h->used=CL_HEAD_SIZE-1;
+	CHECK(cl_open(&c,b)==1);
+	h->magic=0;
+	CHECK(cl_open(&c,b)==1);
+	cl_pop(&r);
+	CHECK(cl_peek(&r)==NULL);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_bad()||test_full()||test_overrun()||test_fd())return 1;
+	printf("clcore: ok (500K full load no loss, 1M full load lost %u%%, fd full load lost %u%%)\n",mbit_lost*100/NF,fd_lost*100/NF);
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "canopen.h"
+#include "stdio.h"
+#include "includes.h"
+//////////////////////////////////////////////////////////////////////////////////
+//FDCAN1ϵCANopen-liteڵ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if CANOPEN_EN
+static _co_node *canopen_node;
+
+//sendص:FDCAN1Ͷ
+static u8 canopen_can_send(_co_node *co,u16 cob,const u8 *data,u8 len)
+{
+	return FDCAN1_Send(cob,0,data,len);
+}
+
+//עڵ
+//co:ڵ,óԱ
+//ֵ:0,ɹ;1,ڵŻֵ;2,PDOӳ;3,COB-IDַظ
+u8 CANOPEN_Open(_co_node *co)
+{
+	u8 res;
+	if(co->send==NULL)co->send=canopen_can_send;
+	canopen_node=NULL;
+	res=co_init(co);
+	if(res==0)canopen_node=co;
+	return res;
+}
+
+//յһ֡ʱ(CAN)
+//frame:FDCAN1_Readյ֡
+//ֵ:1,Ǳڵ֡,Ѵ;0,,ߴ
+u8 CANOPEN_Input(const _fdcan_frame *frame)
+{
+	if(canopen_node==NULL||(frame->flags&(FDCAN1_F_EXT|FDCAN1_F_RTR|FDCAN1_F_FD)))return 0;
+	return co_input(canopen_node,(u16)frame->id,frame->data,frame->len,OSTimeGet());
+}
+
+//ġTPDO,鳬ʱ,CANѭ
+//ֵ:ٶmsҪٵһ,ΪFDCAN1_Waitĵȴʱ
+u32 CANOPEN_Poll(void)
+{
+	u32 wait;
+	if(canopen_node==NULL)return CANOPEN_POLL_MAX;
+	wait=co_poll(canopen_node,OSTimeGet());
+	return wait?wait:1;
+}
+
+//ڵ״̬ͳ
+void CANOPEN_Report(void)
+{
+	_co_node *co=canopen_node;
+	u8 i;
+	if(co==NULL)
+	{
+		printf("canopen: not open\r\n");
+		return;
+	}
+	printf("canopen node %u state %#x hb %ums: rx %u tx %u full %u, sdo %u abort %u, rpdo short %u\r\n",
+		co->id,co->state,co->hb_time,co->rx_frames,co->tx_frames,co->tx_full,co->sdo_reqs,co->sdo_aborts,co->pdo_short);
+	for(i=0;i<co->tpdo_num;i++)printf("tpdo%u cob %#x type %u len %u\r\n",i+1,co->tpdo_cfg[i].cob,co->tpdo_cfg[i].type,co->tp[i].len);
+	for(i=0;i<co->rpdo_num;i++)printf("rpdo%u cob %#x type %u len %u\r\n",i+1,co->rpdo_cfg[i].cob,co->rpdo_cfg[i].type,co->rp[i].len);
+	for(i=0;i<co->hbc_num;i++)printf("heartbeat node %u state %#x\r\n",co->hbc[i].node,co->hbc[i].state);
+}
+#endif
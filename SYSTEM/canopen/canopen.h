@@ -0,0 +1,35 @@
+#ifndef _CANOPEN_H
+#define _CANOPEN_H
+#include "sys.h"
+#include "fdcan.h"
+#include "cocore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//FDCAN1ϵCANopen-liteڵ
+//Эcocore.c,︺ѽڵӵFDCAN1յ֡ṩʱ(OS,ms)
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ֻһڵ,ֵ䡢PDOͻصӦö(main.c)
+//CANopenֻôͳCAN֡11λID,չ֡Զ֡CAN FD֡ڵ
+//ʹ÷:
+//1,FDCAN1_Mode_Init֮_co_node,CANOPEN_Open()ע,֮
+//2,CANѭ:FDCAN1_Wait(CANOPEN_Poll());յ֡CANOPEN_Input(),0֡Ǳڵ֡
+//3,Ӧ޸TPDOӳıCANOPEN_POLL_MAX msڷ,Ҳco_tpdo_event
+//ڵĺCAN,صҲCANִ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CANOPEN_EN				1		//0,ر;1,CANopenڵ
+#define CANOPEN_POLL_MAX		CO_POLL_MAX	//CANOPEN_Pollصȴʱ(ms)
+
+#if CANOPEN_EN
+u8 CANOPEN_Open(_co_node *co);						//עڵ,sendΪNULLʱFDCAN1;0ɹ,Ϊco_initĴ
+u8 CANOPEN_Input(const _fdcan_frame *frame);		//յһ֡,1:Ǳڵ֡,Ѵ
+u32 CANOPEN_Poll(void);								////TPDO,鳬ʱ,´ٵõʱ(ms)
+void CANOPEN_Report(void);							//ڵ״̬ͳ
+#else
+#define CANOPEN_Open(co)		0
+#define CANOPEN_Input(frame)	0
+#define CANOPEN_Poll()			CANOPEN_POLL_MAX
+#define CANOPEN_Report()
+#endif
+#endif
@@ -0,0 +1,566 @@
+#include "cocore.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CANopen-lite
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//ַ
+#define CO_RX_NMT				0
+#define CO_RX_SYNC				1
+#define CO_RX_SDO				2
+#define CO_RX_RPDO				3
+#define CO_RX_HB				4
+
+//SDO״̬
+#define CO_SDO_IDLE				0
+#define CO_SDO_DOWN				1		//ֶ
+#define CO_SDO_UP				2		//ֶϴ
+
+//COB-IDĹϣֵ
+static uint8_t co_hash(uint16_t cob)
+{
+	return (uint8_t)(((uint32_t)cob*2654435761u)>>24)&(CO_HASH_SIZE-1);
+}
+
+//ַ
+//ֵ:0,ɹ;1,COB-IDظ
+static uint8_t co_rx_add(_co_node *co,uint16_t cob,uint8_t kind,uint8_t n)
+{
+	uint8_t h=co_hash(cob),i;
+	if(co->rx_num>=CO_RX_MAX)return 1;
+	while((i=co->hash[h])!=0)
+	{
+		if(co->rx[i-1].cob==cob)return 1;
+		h=(h+1)&(CO_HASH_SIZE-1);
+	}
+	co->rx[co->rx_num].cob=cob;
+	co->rx[co->rx_num].kind=kind;
+	co->rx[co->rx_num].n=n;
+	co->hash[h]=++co->rx_num;
+	return 0;
+}
+
+//COB-IDַ,NULLʾǱڵ֡
+static const _co_rx *co_rx_find(const _co_node *co,uint16_t cob)
+{
+	uint8_t h=co_hash(cob),i;
+	while((i=co->hash[h])!=0)
+	{
+		if(co->rx[i-1].cob==cob)return &co->rx[i-1];
+		h=(h+1)&(CO_HASH_SIZE-1);
+	}
+	return NULL;
+}
+
+//Ҷ,ֵ䰴,ֲ
+const _co_entry *co_find(const _co_node *co,uint16_t index,uint8_t sub)
+{
+	uint32_t key=(uint32_t)index<<8|sub,k;
+	uint16_t lo=0,hi=co->od_num,mid;
+	while(lo<hi)
+	{
+		mid=(lo+hi)/2;
+		k=(uint32_t)co->od[mid].index<<8|co->od[mid].sub;
+		if(k==key)return &co->od[mid];
+		if(k<key)lo=mid+1;
+		else hi=mid;
+	}
+	return NULL;
+}
+
+//PDOӳ
+//ֵ:0,ɹ;1,ӳĶ󲻴ڡӳ䡢λڶСܳ8ֽ
+static uint8_t co_pdo_map(_co_node *co,const _co_pdo_cfg *cfg,_co_pdo *p,uint8_t attr)
+{
+	const _co_entry *e;
+	uint8_t i,len=0;
+	p->len=0;
+	if(cfg->num>CO_PDO_MAP)return 1;
+	for(i=0;i<cfg->num;i++)
+	{
+		e=co_find(co,(uint16_t)(cfg->map[i]>>16),(uint8_t)(cfg->map[i]>>8));
+		if(e==NULL||(e->attr&(CO_MAP|attr))!=(CO_MAP|attr)||(cfg->map[i]&0xFF)!=e->size*8u)return 1;
+		len+=e->size;
+		if(len>8)return 1;
+		p->ent[i]=e;
+	}
+	p->len=len;
+	return 0;
+}
+
+//ȫPDOӳ,ؽCOB-IDַ
+//ֵ:0,ɹ;2,PDOӳ;3,ַCOB-IDظ
+static uint8_t co_map(_co_node *co)
+{
+	uint8_t i;
+	co->rx_num=0;
+	memset(co->hash,0,sizeof(co->hash));
+	if(co_rx_add(co,0x000,CO_RX_NMT,0)||co_rx_add(co,0x080,CO_RX_SYNC,0)||co_rx_add(co,0x600+co->id,CO_RX_SDO,0))return 3;
+	for(i=0;i<co->rpdo_num;i++)
+	{
+		co->rp[i].len=0;
+		if(co->rpdo_cfg[i].cob&CO_PDO_OFF)continue;
+		if(co_pdo_map(co,&co->rpdo_cfg[i],&co->rp[i],CO_WO))return 2;
+		if(co->rp[i].len&&co_rx_add(co,(uint16_t)(co->rpdo_cfg[i].cob&0x7FF),CO_RX_RPDO,i))return 3;
+	}
+	for(i=0;i<co->tpdo_num;i++)
+	{
+		memset(&co->tp[i],0,sizeof(_co_pdo));
+		if(co->tpdo_cfg[i].cob&CO_PDO_OFF)continue;
+		if(co_pdo_map(co,&co->tpdo_cfg[i],&co->tp[i],CO_RO))return 2;
+	}
+	for(i=0;i<co->hbc_num;i++)
+	{
+		co->hbc[i].state=CO_HB_LOST;
+		if(co->hbc[i].node&&co_rx_add(co,0x700+co->hbc[i].node,CO_RX_HB,i))return 3;
+	}
+	return 0;
+}
+
+//ֵ,PDOӳ,COB-IDַ;֮co_poll
+//ֵ:0,ɹ;1,ڵŻֵ(û);2,PDOӳ;3,ַCOB-IDظ
+uint8_t co_init(_co_node *co)
+{
+	uint16_t i;
+	co->state=CO_NMT_BOOT;
+	co->boot=1;
+	co->err=0;
+	co->sdo_state=CO_SDO_IDLE;
+	co->rx_frames=co->tx_frames=co->tx_full=0;
+	co->sdo_reqs=co->sdo_aborts=co->pdo_short=0;
+	if(co->id<1||co->id>127||co->tpdo_num>CO_PDO_MAX||co->rpdo_num>CO_PDO_MAX)return 1;
+	for(i=1;i<co->od_num;i++)
+	{
+		if(((uint32_t)co->od[i-1].index<<8|co->od[i-1].sub)>=((uint32_t)co->od[i].index<<8|co->od[i].sub))return 1;
+	}
+	return co_map(co);
+}
+
+//һ֡
+//ֵ:0,ɹ;1,ͻ
+static uint8_t co_send(_co_node *co,uint16_t cob,const uint8_t *data,uint8_t len)
+{
+	if(co->send(co,cob,data,len))
+	{
+		co->tx_full++;
+		return 1;
+	}
+	co->tx_frames++;
+	return 0;
+}
+
+//ıNMT״̬
+static void co_state(_co_node *co,uint8_t state)
+{
+	uint8_t i;
+	if(co->state==state)return;
+	if(co->state==CO_NMT_OPERATIONAL)
+	{
+		for(i=0;i<co->tpdo_num;i++)co->tp[i].sent=0;		//ٽ״̬ʱ·
+	}
+	co->state=state;
+	if(state==CO_NMT_STOPPED)co->sdo_state=CO_SDO_IDLE;
+	if(co->nmt)co->nmt(co,state);
+}
+
+//ڱڵִNMT(յNMTĻ򱾵ص)
+void co_nmt(_co_node *co,uint8_t cs)
+{
+	switch(cs)
+	{
+		case CO_NMT_START:
+			if(co->state!=CO_NMT_BOOT)co_state(co,CO_NMT_OPERATIONAL);
+			break;
+		case CO_NMT_STOP:
+			if(co->state!=CO_NMT_BOOT)co_state(co,CO_NMT_STOPPED);
+			break;
+		case CO_NMT_ENTER_PREOP:
+			if(co->state!=CO_NMT_BOOT)co_state(co,CO_NMT_PREOP);
+			break;
+		case CO_NMT_RESET_NODE:
+		case CO_NMT_RESET_COMM:
+			co_state(co,CO_NMT_BOOT);
+			co->sdo_state=CO_SDO_IDLE;
+			co_map(co);
+			co->boot=1;
+			break;
+	}
+}
+
+//͵nTPDO,co_poll﷢(ֹܽʱ)
+void co_tpdo_event(_co_node *co,uint8_t n)
+{
+	if(n<co->tpdo_num)co->tp[n].pend=1;
+}
+
+//TPDOӳıƴ
+static void co_pdo_pack(const _co_pdo *p,uint8_t *buf)
+{
+	uint8_t i,off=0;
+	for(i=0;off<p->len;i++)
+	{
+		memcpy(buf+off,p->ent[i]->data,p->ent[i]->size);
+		off+=p->ent[i]->size;
+	}
+}
+
+//TPDO
+//ֵ:0,ɹ;1,ͻ
+static uint8_t co_tpdo_send(_co_node *co,uint8_t n,const uint8_t *buf,uint32_t now)
+{
+	_co_pdo *p=&co->tp[n];
+	if(co_send(co,(uint16_t)(co->tpdo_cfg[n].cob&0x7FF),buf,p->len))return 1;
+	memcpy(p->last,buf,p->len);
+	p->t=now;
+	p->sent=1;
+	p->pend=0;
+	return 0;
+}
+
+//SDOֹ
+static void co_sdo_abort(_co_node *co,uint16_t index,uint8_t sub,uint32_t code)
+{
+	uint8_t f[8];
+	f[0]=0x80;
+	f[1]=(uint8_t)index;
+	f[2]=(uint8_t)(index>>8);
+	f[3]=sub;
+	f[4]=(uint8_t)code;
+	f[5]=(uint8_t)(code>>8);
+	f[6]=(uint8_t)(code>>16);
+	f[7]=(uint8_t)(code>>24);
+	co->sdo_state=CO_SDO_IDLE;
+	co->sdo_aborts++;
+	co_send(co,0x580+co->id,f,8);
+}
+
+//SDOӦ,f[0]Ϊ,f[1..3]Ϊ,ɵ
+static void co_sdo_reply(_co_node *co,uint8_t *f)
+{
+	co_send(co,0x580+co->id,f,8);
+}
+
+//ҪʵĶ󲢼Ȩ
+//need:CO_RO,CO_WOд
+//ֵ:0,ɹ;Ϊֹ
+static uint32_t co_access(_co_node *co,uint16_t index,uint8_t sub,uint8_t need,const _co_entry **e)
+{
+	uint16_t i;
+	*e=co_find(co,index,sub);
+	if(*e==NULL)
+	{
+		for(i=0;i<co->od_num;i++)if(co->od[i].index==index)return CO_ABORT_NOSUB;
+		return CO_ABORT_NOOBJ;
+	}
+	if(!((*e)->attr&need))return need==CO_WO?CO_ABORT_READONLY:CO_ABORT_WRITEONLY;
+	return 0;
+}
+
+//SDOд
+//ͨŲ(0x1400~0x1BFF)д½PDO,Ϸʱָԭֵ
+//ֵ:0,ɹ;Ϊֹ
+static uint32_t co_store(_co_node *co,const _co_entry *e,const uint8_t *src)
+{
+	uint8_t old[8];
+	if(e->index>=0x1400&&e->index<0x1C00&&e->size<=sizeof(old))
+	{
+		memcpy(old,e->data,e->size);
+		memcpy(e->data,src,e->size);
+		if(co_map(co))
+		{
+			memcpy(e->data,old,e->size);
+			co_map(co);
+			return CO_ABORT_PARAM;
+		}
+	}
+	else memcpy(e->data,src,e->size);
+	if(co->write)co->write(co,e);
+	return 0;
+}
+
+//յSDO
+static void co_sdo(_co_node *co,const uint8_t *d,uint32_t now)
+{
+	const _co_entry *e;
+	uint16_t index=d[1]|(uint16_t)d[2]<<8;
+	uint8_t sub=d[3],f[8],n,t;
+	uint32_t code,size;
+	co->sdo_reqs++;
+	memset(f,0,8);
+	f[1]=d[1];
+	f[2]=d[2];
+	f[3]=d[3];
+	switch(d[0]>>5)
+	{
+		case 1:										//ʼ
+			code=co_access(co,index,sub,CO_WO,&e);
+			if(code)break;
+			if(d[0]&0x02)							//
+			{
+				n=(d[0]&0x01)?4-((d[0]>>2)&3):(uint8_t)e->size;
+				if(n!=e->size||e->size>4)
+				{
+					code=CO_ABORT_LEN;
+					break;
+				}
+				code=co_store(co,e,d+4);
+				if(code)break;
+				co->sdo_state=CO_SDO_IDLE;
+			}
+			else
+			{
+				size=d[4]|(uint32_t)d[5]<<8|(uint32_t)d[6]<<16|(uint32_t)d[7]<<24;
+				if((d[0]&0x01)&&size!=e->size)
+				{
+					code=CO_ABORT_LEN;
+					break;
+				}
+				if(e->size>CO_SDO_BUF)
+				{
+					code=CO_ABORT_MEMORY;
+					break;
+				}
+				co->sdo_state=CO_SDO_DOWN;
+				co->sdo_ent=e;
+				co->sdo_off=0;
+				co->sdo_toggle=0;
+				co->sdo_t=now;
+			}
+			f[0]=0x60;
+			co_sdo_reply(co,f);
+			return;
+		case 0:										//ض
+			if(co->sdo_state!=CO_SDO_DOWN)
+			{
+				code=CO_ABORT_CS;
+				break;
+			}
+			e=co->sdo_ent;
+			index=e->index;
+			sub=e->sub;
+			t=(d[0]>>4)&1;
+			if(t!=co->sdo_toggle)
+			{
+				code=CO_ABORT_TOGGLE;
+				break;
+			}
+			n=7-((d[0]>>1)&7);
+			if(co->sdo_off+n>e->size)
+			{
+				code=CO_ABORT_LEN_HIGH;
+				break;
+			}
+			memcpy(co->sdo_buf+co->sdo_off,d+1,n);
+			co->sdo_off+=n;
+			co->sdo_toggle^=1;
+			co->sdo_t=now;
+			if(d[0]&0x01)							//һ
+			{
+				if(co->sdo_off!=e->size)
+				{
+					code=CO_ABORT_LEN_LOW;
+					break;
+				}
+				code=co_store(co,e,co->sdo_buf);
+				if(code)break;
+				co->sdo_state=CO_SDO_IDLE;
+			}
+			memset(f,0,8);
+			f[0]=0x20|t<<4;
+			co_sdo_reply(co,f);
+			return;
+		case 2:										//ʼϴ
+			code=co_access(co,index,sub,CO_RO,&e);
+			if(code)break;
+			if(e->size<=4)
+			{
+				f[0]=0x43|(4-e->size)<<2;
+				memcpy(f+4,e->data,e->size);
+				co->sdo_state=CO_SDO_IDLE;
+			}
+			else
+			{
+				f[0]=0x41;
+				f[4]=(uint8_t)e->size;
+				f[5]=(uint8_t)(e->size>>8);
+				co->sdo_state=CO_SDO_UP;
+				co->sdo_ent=e;
+				co->sdo_off=0;
+				co->sdo_toggle=0;
+				co->sdo_t=now;
+			}
+			co_sdo_reply(co,f);
+			return;
+		case 3:										//ϴ
+			if(co->sdo_state!=CO_SDO_UP)
+			{
+				code=CO_ABORT_CS;
+				break;
+			}
+			e=co->sdo_ent;
+			index=e->index;
+			sub=e->sub;
+			t=(d[0]>>4)&1;
+			if(t!=co->sdo_toggle)
+			{
+				code=CO_ABORT_TOGGLE;
+				break;
+			}
+			n=e->size-co->sdo_off>7?7:(uint8_t)(e->size-co->sdo_off);
+			memset(f,0,8);
+			f[0]=t<<4|(7-n)<<1;
+			memcpy(f+1,(const uint8_t*)e->data+co->sdo_off,n);
+			co->sdo_off+=n;
+			co->sdo_toggle^=1;
+			co->sdo_t=now;
+			if(co->sdo_off>=e->size)
+			{
+				f[0]|=0x01;
+				co->sdo_state=CO_SDO_IDLE;
+			}
+			co_sdo_reply(co,f);
+			return;
+		case 4:										//ͻֹ
+			co->sdo_state=CO_SDO_IDLE;
+			return;
+		default:
+			code=CO_ABORT_CS;
+			break;
+	}
+	co_sdo_abort(co,index,sub,code);
+}
+
+//յһ֡ʱ
+//cob:11λ׼ID,չ֡Զ֡ɵ߹
+//now:ǰʱ(ms)
+//ֵ:1,Ǳڵ֡(NMTSYNCSDORPDOӵ),Ѵ;0,
+uint8_t co_input(_co_node *co,uint16_t cob,const uint8_t *data,uint8_t len,uint32_t now)
+{
+	const _co_rx *r;
+	_co_pdo *p;
+	_co_hbc *h;
+	uint8_t i,off,buf[8];
+	if(cob>0x7FF)return 0;
+	r=co_rx_find(co,cob);
+	if(r==NULL)return 0;
+	co->rx_frames++;
+	switch(r->kind)
+	{
+		case CO_RX_NMT:
+			if(len>=2&&(data[1]==0||data[1]==co->id))co_nmt(co,data[0]);
+			break;
+		case CO_RX_SYNC:
+			if(co->state!=CO_NMT_OPERATIONAL)break;
+			for(i=0;i<co->tpdo_num;i++)
+			{
+				p=&co->tp[i];
+				if(p->len==0||co->tpdo_cfg[i].type<1||co->tpdo_cfg[i].type>240)continue;
+				if(++p->sync<co->tpdo_cfg[i].type)continue;
+				p->sync=0;
+				co_pdo_pack(p,buf);
+				co_tpdo_send(co,i,buf,now);
+			}
+			break;
+		case CO_RX_SDO:
+			if(len>=8&&(co->state==CO_NMT_PREOP||co->state==CO_NMT_OPERATIONAL))co_sdo(co,data,now);
+			break;
+		case CO_RX_RPDO:
+			if(co->state!=CO_NMT_OPERATIONAL)break;
+			p=&co->rp[r->n];
+			if(len<p->len)
+			{
+				co->pdo_short++;
+				break;
+			}
+			for(i=0,off=0;off<p->len;i++)
+			{
+				memcpy(p->ent[i]->data,data+off,p->ent[i]->size);
+				off+=p->ent[i]->size;
+			}
+			if(co->rpdo)co->rpdo(co,r->n);
+			break;
+		case CO_RX_HB:
+			if(len<1)break;
+			h=&co->hbc[r->n];
+			h->t=now;
+			if(h->state!=(data[0]&0x7F))
+			{
+				h->state=data[0]&0x7F;
+				if(co->hb)co->hb(co,h->node,h->state);
+			}
+			break;
+	}
+	return 1;
+}
+
+//ġ¼TPDO,ߺSDOʱ
+//now:ǰʱ(ms)
+//ֵ:ٶmsҪٵһ
+uint32_t co_poll(_co_node *co,uint32_t now)
+{
+	uint32_t wait=CO_POLL_MAX,d,inh;
+	const _co_pdo_cfg *cfg;
+	_co_pdo *p;
+	_co_hbc *h;
+	uint8_t i,buf[8],due;
+	if(co->boot)
+	{
+		buf[0]=CO_NMT_BOOT;
+		if(co_send(co,0x700+co->id,buf,1))return 1;
+		co->boot=0;
+		co->hb_t=now;
+		co_state(co,co->autostart?CO_NMT_OPERATIONAL:CO_NMT_PREOP);
+	}
+	if(co->hb_time)
+	{
+		d=now-co->hb_t;
+		if(d>=co->hb_time)
+		{
+			buf[0]=co->state;
+			if(co_send(co,0x700+co->id,buf,1)==0)
+			{
+				co->hb_t=(d<2u*co->hb_time)?co->hb_t+co->hb_time:now;	//ۻ,̫ʱ¶
+				d=now-co->hb_t;
+			}
+			else d=co->hb_time-1;
+		}
+		if(co->hb_time-d<wait)wait=co->hb_time-d;
+	}
+	for(i=0;i<co->hbc_num;i++)
+	{
+		h=&co->hbc[i];
+		if(h->state==CO_HB_LOST||h->time==0)continue;
+		d=now-h->t;
+		if(d>=h->time)
+		{
+			h->state=CO_HB_LOST;
+			if(co->hb)co->hb(co,h->node,CO_HB_LOST);
+		}
+		else if(h->time-d<wait)wait=h->time-d;
+	}
+	if(co->sdo_state!=CO_SDO_IDLE&&now-co->sdo_t>=CO_SDO_TIMEOUT)co_sdo_abort(co,co->sdo_ent->index,co->sdo_ent->sub,CO_ABORT_TIMEOUT);
+	if(co->state!=CO_NMT_OPERATIONAL)return wait;
+	for(i=0;i<co->tpdo_num;i++)
+	{
+		p=&co->tp[i];
+		cfg=&co->tpdo_cfg[i];
+		if(p->len==0||cfg->type<CO_PDO_EVENT)continue;
+		co_pdo_pack(p,buf);
+		d=now-p->t;
+		due=p->pend||!p->sent||memcmp(buf,p->last,p->len)||(cfg->event&&d>=cfg->event);
+		if(due)
+		{
+			inh=(cfg->inhibit+9)/10;				//100usms,ȡ
+			if(p->sent&&d<inh)
+			{
+				if(inh-d<wait)wait=inh-d;
+			}
+			else if(co_tpdo_send(co,i,buf,now))wait=1;
+			else if(cfg->event&&cfg->event<wait)wait=cfg->event;
+		}
+		else if(cfg->event&&cfg->event-d<wait)wait=cfg->event-d;
+	}
+	return wait;
+}
@@ -0,0 +1,193 @@
+#ifndef _COCORE_H
+#define _COCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//CANopen-lite:ֵ䡢PDOSDONMTվ
+//ֻñ׼C,HALOSFDCAN,CAN֡sendص,յ֡co_input,ʱɵߴ
+//PCϰѼڵӵһϲ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ֵӦöconst(_co_entry),С,ÿָӦõı,
+//  CO_VAR/CO_STRڱʱ;SDOʱֲ,PDOӳco_initʱָ
+//COB-ID(ֻ11λ׼ID):
+//  NMT 0x000  SYNC 0x080  PDOͨŲָ(ϰTPDOn 0x180/0x280/..+ڵ,RPDOn 0x200/0x300/..+ڵ)
+//  SDO 0x600+ڵ,Ӧ0x580+ڵ   0x700+ڵ
+//յ֡COB-IDϣ(CO_HASH_SIZE,Ѱַ,װʲ1/4)ַ,PDOߵĸ޹
+//PDO:ӳڱʱȷ(_co_pdo_cfg.map),ӳλڶĴС
+//  COB-IDֹ͡ʱ䡢¼ʱSDO޸(0x1400~0x1BFF),޸ĺ½,Ϸʱָԭֵ
+//  TPDO0xFE/0xFF:ӳݱ仯(co_pollʱȽ)co_tpdo_event¼ʱʱ,
+//    η͵ļСڽֹʱ;1~240:ÿյnSYNCһ
+//  RPDOյֱдӳı,ٵrpdoص(ͬҲЧ)
+//SDO:,ֿ֧ٴ(<=4ֽ)ͷֶδ(CO_SDO_BUFֽ),ֿ֧鴫
+//NMT:ϵ/λĽԤ״̬,autostartʱֱӽ״̬;PDOֻڲ״̬շ
+//:hb_time(ms,ӳ䵽0x1017);߱hbc[]ڵ,״̬仯ʱhbص
+//ֽ,CANopenΪС,ֻСCPU
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CO_PDO_MAX				4		//TPDORPDO༸
+#define CO_PDO_MAP				8		//ÿPDOӳ伸
+#define CO_SDO_BUF				32		//SDOֶصĻ,Ķֻܿػϴ
+#define CO_SDO_TIMEOUT			1000	//SDOֶδһεĳʱ(ms)
+#define CO_RX_MAX				16		//ҪյCOB-ID༸(NMTSYNCSDORPDO)
+#define CO_HASH_SIZE			64		//COB-IDϣС,2,С4*CO_RX_MAX
+#define CO_POLL_MAX				10		//co_pollصȴʱ(ms),ҲǼTPDOݱ仯
+
+#if CO_HASH_SIZE<4*CO_RX_MAX||(CO_HASH_SIZE&(CO_HASH_SIZE-1))
+#error "CO_HASH_SIZE must be a power of 2 and at least 4*CO_RX_MAX"
+#endif
+
+//
+#define CO_RO					0x01	//ɶ
+#define CO_WO					0x02	//д
+#define CO_RW					0x03
+#define CO_MAP					0x04	//ӳ䵽PDO
+
+//NMT״̬,Ҳĵ
+#define CO_NMT_BOOT				0x00
+#define CO_NMT_STOPPED			0x04
+#define CO_NMT_OPERATIONAL		0x05
+#define CO_NMT_PREOP			0x7F
+#define CO_HB_LOST				0xFF	//hbص:ʱ;߻ûյʱҲ״̬
+
+//NMT
+#define CO_NMT_START			0x01
+#define CO_NMT_STOP				0x02
+#define CO_NMT_ENTER_PREOP		0x80
+#define CO_NMT_RESET_NODE		0x81
+#define CO_NMT_RESET_COMM		0x82
+
+//PDO
+#define CO_PDO_OFF				0x80000000	//COB-IDbit31:PDOЧ
+#define CO_PDO_EVENT			0xFE	//:¼
+#define CO_MAP_ENTRY(index,sub,bits)	(((uint32_t)(index)<<16)|((uint32_t)(sub)<<8)|(bits))
+
+//SDOֹ
+#define CO_ABORT_TOGGLE			0x05030000	//λûн
+#define CO_ABORT_TIMEOUT		0x05040000	//SDOʱ
+#define CO_ABORT_CS				0x05040001	//Ч
+#define CO_ABORT_MEMORY			0x05040005	//ڴ治(CO_SDO_BUF)
+#define CO_ABORT_WRITEONLY		0x06010001	//ֻд
+#define CO_ABORT_READONLY		0x06010002	//дֻ
+#define CO_ABORT_NOOBJ			0x06020000	//󲻴
+#define CO_ABORT_PARAM			0x06040043	//
+#define CO_ABORT_LEN			0x06070010	//ݳȲ
+#define CO_ABORT_LEN_HIGH		0x06070012	//̫
+#define CO_ABORT_LEN_LOW		0x06070013	//̫
+#define CO_ABORT_NOSUB			0x06090011	//
+
+//ֵһ
+typedef struct
+{
+	uint16_t index;
+	uint8_t sub;
+	uint8_t attr;				//CO_RO/CO_WO/CO_RW,ԻCO_MAP
+	uint16_t size;				//ֽ
+	void *data;					//Ӧõı
+}_co_entry;
+
+//ֵ:var
+#define CO_VAR(index,sub,attr,var)		{index,sub,attr,sizeof(var),(void*)&(var)}
+//ֵ:ַֻ(β0)
+#define CO_STR(index,sub,str)			{index,sub,CO_RO,sizeof(str)-1,(void*)(str)}
+
+//PDOͨźӳ,Ӧö,ԷŽֵ
+typedef struct
+{
+	uint32_t cob;				//COB-ID,CO_PDO_OFFʱPDOЧ
+	uint8_t type;				//:CO_PDO_EVENT/0xFF,1~240(ÿnSYNC)
+	uint16_t inhibit;			//TPDOֹʱ(100us),0
+	uint16_t event;				//TPDO¼ʱ(ms),0ر
+	uint8_t num;				//ӳ
+	uint32_t map[CO_PDO_MAP];	//ӳ:CO_MAP_ENTRY(,,λ)
+}_co_pdo_cfg;
+
+//,Ӧönodetime
+typedef struct
+{
+	uint8_t node;				//ӵĽڵ
+	uint16_t time;				//ʱʱ(ms)
+	uint8_t state;				//յ״̬,CO_HB_LOSTʾûյʱ
+	uint32_t t;					//յʱ
+}_co_hbc;
+
+//PDO״̬
+typedef struct
+{
+	const _co_entry *ent[CO_PDO_MAP];	//ӳĶ
+	uint8_t len;				//ݳ,0ʾPDOЧ
+	uint8_t sync;				//յSYNC
+	uint8_t pend;				//co_tpdo_event
+	uint8_t sent;				//״̬󷢹,lastЧ
+	uint32_t t;					//ϴη͵ʱ
+	uint8_t last[8];			//ϴη͵,ڼ仯
+}_co_pdo;
+
+//COB-IDַһ
+typedef struct
+{
+	uint16_t cob;
+	uint8_t kind;
+	uint8_t n;					//RPDOߵ
+}_co_rx;
+
+typedef struct _co_node
+{
+	//,ɵ
+	uint8_t id;					//ڵ,1~127
+	uint8_t autostart;			//1,ֱӽ״̬(ûNMTվʱ)
+	uint16_t hb_time;			//(ms),0
+	const _co_entry *od;		//ֵ,
+	uint16_t od_num;
+	_co_pdo_cfg *tpdo_cfg;		//TPDO,tpdo_num
+	uint8_t tpdo_num;
+	_co_pdo_cfg *rpdo_cfg;		//RPDO,rpdo_num
+	uint8_t rpdo_num;
+	_co_hbc *hbc;				//,hbc_num
+	uint8_t hbc_num;
+	uint8_t (*send)(struct _co_node *co,uint16_t cob,const uint8_t *data,uint8_t len);	//һ֡,0ɹ,0ͻ
+	void (*nmt)(struct _co_node *co,uint8_t state);						//NMT״̬ı,ΪNULL
+	void (*rpdo)(struct _co_node *co,uint8_t n);						//յnRPDO,д,ΪNULL
+	void (*write)(struct _co_node *co,const _co_entry *e);				//SDOд,ΪNULL
+	void (*hb)(struct _co_node *co,uint8_t node,uint8_t state);			//ڵ״̬ı,ΪNULL
+	void *arg;					//صõĲ
+
+	//NMT
+	uint8_t state;				//CO_NMT_xxx
+	uint8_t boot;				//Ĵ
+	uint8_t err;				//Ĵ(0x1001)
+	uint32_t hb_t;				//ϴηʱ
+
+	//PDO
+	_co_pdo tp[CO_PDO_MAX];		//TPDO
+	_co_pdo rp[CO_PDO_MAX];		//RPDO
+
+	//SDO
+	uint8_t sdo_state;
+	uint8_t sdo_toggle;			//Ĵλ
+	const _co_entry *sdo_ent;	//ڴĶ
+	uint16_t sdo_off;			//Ѵֽ
+	uint32_t sdo_t;				//һεʱ
+	uint8_t sdo_buf[CO_SDO_BUF];
+
+	//COB-IDַ
+	uint8_t rx_num;
+	_co_rx rx[CO_RX_MAX];
+	uint8_t hash[CO_HASH_SIZE];	//rx[]±+1,0Ϊ
+
+	//ͳ
+	uint32_t rx_frames;			//յıڵ֡
+	uint32_t tx_frames;			//֡
+	uint32_t tx_full;			//sendʧܵĴ(PDOԺط,SDOӦ)
+	uint32_t sdo_reqs;			//SDO
+	uint32_t sdo_aborts;		//SDOֹ
+	uint32_t pdo_short;			//̶̫RPDO
+}_co_node;
+
+uint8_t co_init(_co_node *co);												//ֵ,PDOӳ,ַ,0ɹ
+uint8_t co_input(_co_node *co,uint16_t cob,const uint8_t *data,uint8_t len,uint32_t now);	//յһ֡,1:Ǳڵ֡,Ѵ
+uint32_t co_poll(_co_node *co,uint32_t now);								////TPDO,鳬ʱ,´ٵõʱ(ms)
+void co_nmt(_co_node *co,uint8_t cs);										//ڱڵִNMT
+void co_tpdo_event(_co_node *co,uint8_t n);									//͵nTPDO(¼)
+const _co_entry *co_find(const _co_node *co,uint16_t index,uint8_t sub);	//Ҷ,NULLʾ
+#endif
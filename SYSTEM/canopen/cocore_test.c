@@ -0,0 +1,501 @@
+//////////////////////////////////////////////////////////////////////////////////
+//cocorePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/canopen SYSTEM/canopen/cocore_test.c SYSTEM/canopen/cocore.c
+//ڵһ(֡нڵco_input),ÿ1msһco_poll:
+//ĺTPDO(ݱ仯/ֹʱ/¼ʱ/SYNC)ԷRPDOSDOٺͷֶϴ/ءֹ롢
+//SDOPDOCOB-ID(ͻʱָ)NMTʱͻط;
+//һڵ֡(ȡSDO֡ʧ),֮SDOӦ
+//////////////////////////////////////////////////////////////////////////////////
+#include "cocore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(c)	do{if(!(c)){printf("cocore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define NODES		2
+#define QNUM		16384
+#define FUZZ_NUM	2000000
+
+//ϵһ֡
+typedef struct
+{
+	uint16_t cob;
+	uint8_t len;
+	uint8_t data[8];
+}_frame;
+
+static _co_node nd[NODES];
+static _frame bus_q[QNUM];				//֡,Ҳ߼¼
+static uint32_t bus_qh,bus_qt;
+static uint8_t bus_full;				//1,sendطͻ
+static uint32_t now;					//ǰʱ(ms)
+static _frame sdo_res;					//һSDOӦ
+static uint32_t sdo_got;				//SDOӦ
+
+//Ӧñ
+static uint8_t key[NODES],led[NODES],peer_key[NODES];
+static uint32_t up[NODES],peer_up[NODES];
+static uint8_t arr[NODES][20];
+static const uint8_t od_num1=1;
+static _co_pdo_cfg tcfg[NODES][2],rcfg[NODES][1];
+static _co_hbc hbc[NODES][1];
+static uint32_t rpdo_n[NODES],hb_n[NODES],write_n[NODES];
+static uint8_t hb_state[NODES];
+
+#define DEVICE_NAME		"STM32H7 CANopen-lite node"
+#define OD(k)	{\
+	CO_VAR(0x1001,0,CO_RO,nd[k].err),\
+	CO_STR(0x1008,0,DEVICE_NAME),\
+	CO_VAR(0x1017,0,CO_RW,nd[k].hb_time),\
+	CO_VAR(0x1018,0,CO_RO,od_num1),\
+	CO_VAR(0x1400,1,CO_RW,rcfg[k][0].cob),\
+	CO_VAR(0x1400,2,CO_RW,rcfg[k][0].type),\
+	CO_VAR(0x1800,1,CO_RW,tcfg[k][0].cob),\
+	CO_VAR(0x1800,2,CO_RW,tcfg[k][0].type),\
+	CO_VAR(0x1800,3,CO_RW,tcfg[k][0].inhibit),\
+	CO_VAR(0x1800,5,CO_RW,tcfg[k][0].event),\
+	CO_VAR(0x1801,1,CO_RW,tcfg[k][1].cob),\
+	CO_VAR(0x1801,2,CO_RW,tcfg[k][1].type),\
+	CO_VAR(0x2000,0,CO_RW|CO_MAP,key[k]),\
+	CO_VAR(0x2001,0,CO_RW|CO_MAP,led[k]),\
+	CO_VAR(0x2002,0,CO_RO|CO_MAP,up[k]),\
+	CO_VAR(0x2003,0,CO_RW,arr[k]),\
+	CO_VAR(0x2100,0,CO_WO|CO_MAP,peer_key[k]),\
+	CO_VAR(0x2101,0,CO_WO|CO_MAP,peer_up[k])}
+static const _co_entry od0[]=OD(0),od1[]=OD(1);
+
+static uint8_t bus_send(_co_node *co,uint16_t cob,const uint8_t *data,uint8_t len)
+{
+	_frame *f;
+	if(bus_full||bus_qh>=QNUM)return 1;
+	f=&bus_q[bus_qh++];
+	f->cob=cob;
+	f->len=len;
+	memcpy(f->data,data,len);
+	return 0;
+}
+
+//Ѷ֡нڵ
+static void deliver(void)
+{
+	_frame *f;
+	int i;
+	while(bus_qt<bus_qh)
+	{
+		f=&bus_q[bus_qt++];
+		if((f->cob&0x780)==0x580)
+		{
+			sdo_res=*f;
+			sdo_got++;
+		}
+		for(i=0;i<NODES;i++)co_input(&nd[i],f->cob,f->data,f->len,now);
+	}
+}
+
+//ms
+static void run(uint32_t ms)
+{
+	int i;
+	while(ms--)
+	{
+		now++;
+		for(i=0;i<NODES;i++)co_poll(&nd[i],now);
+		deliver();
+	}
+}
+
+//ⲿ(վ)һ֡
+static void inject(uint16_t cob,const uint8_t *data,uint8_t len)
+{
+	bus_send(NULL,cob,data,len);
+	deliver();
+}
+
+//fromʼcob֡
+static uint32_t count(uint16_t cob,uint32_t from)
+{
+	uint32_t i,n=0;
+	for(i=from;i<bus_qh;i++)if(bus_q[i].cob==cob)n++;
+	return n;
+}
+
+//SDOkڵ,1ʾһӦ
+static int sdo(int k,uint8_t cs,uint16_t index,uint8_t sub,uint32_t v)
+{
+	uint8_t d[8];
+	uint32_t n=sdo_got;
+	d[0]=cs;
+	d[1]=(uint8_t)index;
+	d[2]=(uint8_t)(index>>8);
+	d[3]=sub;
+	d[4]=(uint8_t)v;
+	d[5]=(uint8_t)(v>>8);
+	d[6]=(uint8_t)(v>>16);
+	d[7]=(uint8_t)(v>>24);
+	inject(0x600+nd[k].id,d,8);
+	return sdo_got==n+1;
+}
+
+//һSDOӦֹ,ֹʱΪ0
+static uint32_t abort_code(void)
+{
+	if(sdo_res.data[0]!=0x80)return 0;
+	return sdo_res.data[4]|sdo_res.data[5]<<8|sdo_res.data[6]<<16|(uint32_t)sdo_res.data[7]<<24;
+}
+
+static void rpdo_cb(_co_node *co,uint8_t n)
+{
+	rpdo_n[co-nd]++;
+}
+
+static void hb_cb(_co_node *co,uint8_t node,uint8_t state)
+{
+	hb_n[co-nd]++;
+	hb_state[co-nd]=state;
+}
+
+static void write_cb(_co_node *co,const _co_entry *e)
+{
+	write_n[co-nd]++;
+}
+
+static void pdo_cfg(_co_pdo_cfg *p,uint32_t cob,uint8_t type,uint16_t inhibit,uint16_t event)
+{
+	memset(p,0,sizeof(_co_pdo_cfg));
+	p->cob=cob;
+	p->type=type;
+	p->inhibit=inhibit;
+	p->event=event;
+}
+
+//ڵ12:TPDO1(key,up)¼,ֹʱ10ms,¼ʱ1s;TPDO2(led)ÿ2SYNC;
+//RPDO1նԷTPDO1;(250ms)
+static int test_boot(void)
+{
+	const _co_entry *ods[NODES]={od0,od1};
+	_co_node *c;
+	int k;
+	for(k=0;k<NODES;k++)
+	{
+		c=&nd[k];
+		c->id=k+1;
+		c->autostart=1;
+		c->hb_time=100;
+		c->od=ods[k];
+		c->od_num=sizeof(od0)/sizeof(od0[0]);
+		pdo_cfg(&tcfg[k][0],0x180+c->id,CO_PDO_EVENT,100,1000);
+		tcfg[k][0].num=2;
+		tcfg[k][0].map[0]=CO_MAP_ENTRY(0x2000,0,8);
+		tcfg[k][0].map[1]=CO_MAP_ENTRY(0x2002,0,32);
+		pdo_cfg(&tcfg[k][1],0x280+c->id,2,0,0);
+		tcfg[k][1].num=1;
+		tcfg[k][1].map[0]=CO_MAP_ENTRY(0x2001,0,8);
+		pdo_cfg(&rcfg[k][0],0x180+(NODES-k),CO_PDO_EVENT,0,0);
+		rcfg[k][0].num=2;
+		rcfg[k][0].map[0]=CO_MAP_ENTRY(0x2100,0,8);
+		rcfg[k][0].map[1]=CO_MAP_ENTRY(0x2101,0,32);
+		hbc[k][0].node=NODES-k;
+		hbc[k][0].time=250;
+		c->tpdo_cfg=tcfg[k];
+		c->tpdo_num=2;
+		c->rpdo_cfg=rcfg[k];
+		c->rpdo_num=1;
+		c->hbc=hbc[k];
+		c->hbc_num=1;
+		c->send=bus_send;
+		c->rpdo=rpdo_cb;
+		c->hb=hb_cb;
+		c->write=write_cb;
+		CHECK(co_init(c)==0);
+	}
+	run(1);
+	CHECK(count(0x701,0)==1&&count(0x702,0)==1&&bus_q[0].data[0]==CO_NMT_BOOT);	//
+	CHECK(nd[0].state==CO_NMT_OPERATIONAL&&nd[1].state==CO_NMT_OPERATIONAL);
+	CHECK(count(0x181,0)==1&&count(0x182,0)==1);									//״̬һTPDO
+	run(1000);
+	CHECK(count(0x701,0)==11);														//+10
+	CHECK(count(0x181,0)==2);														//¼ʱ
+	CHECK(hb_state[0]==CO_NMT_OPERATIONAL&&hb_state[1]==CO_NMT_OPERATIONAL);
+	return 0;
+}
+
+static int test_pdo(void)
+{
+	uint32_t m;
+	uint8_t z=0;
+	int i;
+	//ݱ仯
+	run(20);
+	m=bus_qh;
+	key[0]=7;
+	run(1);
+	CHECK(count(0x181,m)==1&&peer_key[1]==7);
+	//ֹʱ10ms
+	m=bus_qh;
+	key[0]=8;
+	run(1);
+	CHECK(count(0x181,m)==0);
+	run(9);
+	CHECK(count(0x181,m)==1&&peer_key[1]==8);
+	up[0]=1234;
+	run(12);
+	CHECK(peer_up[1]==1234);
+	//co_tpdo_event:ûҲ
+	m=bus_qh;
+	co_tpdo_event(&nd[0],0);
+	run(20);
+	CHECK(count(0x181,m)==1);
+	//ÿ2SYNCTPDO2
+	m=bus_qh;
+	for(i=0;i<6;i++)inject(0x080,&z,0);
+	CHECK(count(0x281,m)==3&&count(0x282,m)==3);
+	return 0;
+}
+
+//ٴֹ
+static int test_sdo_expedited(void)
+{
+	CHECK(sdo(0,0x40,0x2002,0,0)&&sdo_res.data[0]==0x43&&sdo_res.data[4]==(1234&0xFF)&&sdo_res.data[5]==(1234>>8));
+	CHECK(sdo(0,0x40,0x2000,0,0)&&sdo_res.data[0]==0x4F&&sdo_res.data[4]==8);
+	CHECK(sdo(1,0x2F,0x2001,0,0x5A)&&sdo_res.data[0]==0x60&&led[1]==0x5A&&write_n[1]==1);
+	CHECK(sdo(1,0x2B,0x2001,0,0x5A)&&abort_code()==CO_ABORT_LEN);
+	CHECK(sdo(1,0x2F,0x2002,0,1)&&abort_code()==CO_ABORT_READONLY);
+	CHECK(sdo(1,0x40,0x2100,0,0)&&abort_code()==CO_ABORT_WRITEONLY);
+	CHECK(sdo(1,0x40,0x3000,0,0)&&abort_code()==CO_ABORT_NOOBJ);
+	CHECK(sdo(1,0x40,0x1800,4,0)&&abort_code()==CO_ABORT_NOSUB);
+	CHECK(sdo(1,0x00,0x1800,4,0)&&abort_code()==CO_ABORT_CS);
+	CHECK(write_n[1]==1&&led[1]==0x5A);
+	return 0;
+}
+
+//ֶϴַ,ֶ20ֽ,λ,ʱ,ȳCO_SDO_BUF
+static int test_sdo_segmented(void)
+{
+	char s[64];
+	uint8_t src[20],d[8];
+	int n=0,t=0,c,i;
+	CHECK(sdo(0,0x40,0x1008,0,0)&&sdo_res.data[0]==0x41&&sdo_res.data[4]==sizeof(DEVICE_NAME)-1);
+	for(;;)
+	{
+		CHECK(sdo(0,0x60|t<<4,0,0,0));
+		CHECK((sdo_res.data[0]&0xE0)==0&&((sdo_res.data[0]>>4)&1)==t);
+		c=7-((sdo_res.data[0]>>1)&7);
+		CHECK(n+c<(int)sizeof(s));
+		memcpy(s+n,sdo_res.data+1,c);
+		n+=c;
+		t^=1;
+		if(sdo_res.data[0]&1)break;
+	}
+	s[n]=0;
+	CHECK(strcmp(s,DEVICE_NAME)==0);
+
+	for(i=0;i<20;i++)src[i]=(uint8_t)(i*3+1);
+	CHECK(sdo(1,0x21,0x2003,0,20)&&sdo_res.data[0]==0x60);
+	n=t=0;
+	while(n<20)
+	{
+		memset(d,0,8);
+		c=20-n>7?7:20-n;
+		d[0]=(uint8_t)(t<<4|(7-c)<<1|(n+c==20));
+		memcpy(d+1,src+n,c);
+		i=sdo_got;
+		inject(0x602,d,8);
+		CHECK(sdo_got==(uint32_t)i+1&&sdo_res.data[0]==(0x20|t<<4));
+		n+=c;
+		t^=1;
+	}
+	CHECK(memcmp(arr[1],src,20)==0);
+
+	CHECK(sdo(1,0x21,0x2003,0,20));
+	memset(d,0,8);
+	d[0]=0x10;														//һεĴλӦ0
+	inject(0x602,d,8);
+	CHECK(abort_code()==CO_ABORT_TOGGLE);
+	CHECK(sdo(1,0x21,0x2003,0,20));
+	n=sdo_got;
+	run(CO_SDO_TIMEOUT+1);
+	CHECK(sdo_got==(uint32_t)n+1&&abort_code()==CO_ABORT_TIMEOUT);
+	CHECK(sdo(1,0x21,0x2003,0,21)&&abort_code()==CO_ABORT_LEN);
+	CHECK(memcmp(arr[1],src,20)==0);
+	return 0;
+}
+
+//SDOTPDO/RPDOCOB-ID,ͱڵSDOͻʱָֹԭֵ
+static int test_remap(void)
+{
+	uint32_t m;
+	CHECK(sdo(0,0x23,0x1800,1,0x190)&&sdo_res.data[0]==0x60&&tcfg[0][0].cob==0x190);
+	m=rpdo_n[1];
+	key[0]=9;
+	run(20);
+	CHECK(rpdo_n[1]==m&&peer_key[1]==8&&count(0x190,0)>=1);						//Է0x181
+	CHECK(sdo(1,0x23,0x1400,1,0x190)&&sdo_res.data[0]==0x60);
+	key[0]=10;
+	run(20);
+	CHECK(peer_key[1]==10);
+	CHECK(sdo(1,0x23,0x1400,1,0x602)&&abort_code()==CO_ABORT_PARAM&&rcfg[1][0].cob==0x190);
+	key[0]=11;
+	run(20);
+	CHECK(peer_key[1]==11);
+	return 0;
+}
+
+//ֹͣ״̬PDOӦSDO,״̬;ͨŸλ·
+static int test_nmt(void)
+{
+	uint8_t d[8];
+	uint32_t m;
+	m=bus_qh;
+	d[0]=CO_NMT_STOP;
+	d[1]=1;
+	inject(0,d,2);
+	key[0]=12;
+	run(200);
+	CHECK(count(0x190,m)==0&&hb_state[1]==CO_NMT_STOPPED);
+	CHECK(sdo(0,0x40,0x2000,0,0)==0);
+	m=bus_qh;
+	d[0]=CO_NMT_START;
+	d[1]=0;															//0:нڵ
+	inject(0,d,2);
+	run(1);
+	CHECK(count(0x190,m)==1&&peer_key[1]==12);
+	m=bus_qh;
+	d[0]=CO_NMT_RESET_COMM;
+	d[1]=2;
+	inject(0,d,2);
+	run(1);
+	CHECK(count(0x702,m)==1&&bus_q[m+1].cob==0x702&&bus_q[m+1].data[0]==CO_NMT_BOOT);
+	CHECK(nd[1].state==CO_NMT_OPERATIONAL);
+	return 0;
+}
+
+//ʱͻָ,ͻʱPDOԺط,ֻڵCOB-ID
+static int test_hb(void)
+{
+	uint32_t e,n=0;
+	uint8_t z[8]={0};
+	int i;
+	run(150);
+	e=hb_n[1];
+	nd[0].hb_time=0;
+	run(400);
+	CHECK(hb_n[1]==e+1&&hb_state[1]==CO_HB_LOST);
+	nd[0].hb_time=100;
+	run(150);
+	CHECK(hb_state[1]==CO_NMT_OPERATIONAL);
+
+	bus_full=1;
+	key[0]=13;
+	run(5);
+	bus_full=0;
+	CHECK(nd[0].tx_full>0&&peer_key[1]!=13);
+	run(2);
+	CHECK(peer_key[1]==13);
+
+	for(i=0;i<0x800;i++)n+=co_input(&nd[0],(uint16_t)i,z,8,now);
+	CHECK(n==nd[0].rx_num);
+	CHECK(co_poll(&nd[0],now)<=CO_POLL_MAX);
+	return 0;
+}
+
+//֡:NMT/SYNC/SDO/RPDO//COB-ID,,SDOƫֶδ;send 1/5ʧ
+static uint8_t fz_a,fz_b[20];
+static uint32_t fz_u;
+static _co_pdo_cfg fz_t[1],fz_r[1];
+static _co_hbc fz_h[2]={{2,100},{3,50}};
+static _co_node fz;
+static const _co_entry fz_od[]=
+{
+	CO_STR(0x1008,0,"abcdefghijklmnopqrstuvwxyz0123456789"),
+	CO_VAR(0x1017,0,CO_RW,fz.hb_time),
+	CO_VAR(0x1400,1,CO_RW,fz_r[0].cob),
+	CO_VAR(0x1800,1,CO_RW,fz_t[0].cob),
+	CO_VAR(0x1800,3,CO_RW,fz_t[0].inhibit),
+	CO_VAR(0x2000,0,CO_RW|CO_MAP,fz_a),
+	CO_VAR(0x2001,0,CO_RW,fz_b),
+	CO_VAR(0x2002,0,CO_RW|CO_MAP,fz_u),
+};
+
+static uint8_t fz_send(_co_node *co,uint16_t cob,const uint8_t *data,uint8_t len)
+{
+	if(rand()%5==0)return 1;
+	if(cob==0x581)
+	{
+		sdo_res.cob=cob;
+		sdo_res.len=len;
+		memcpy(sdo_res.data,data,len);
+		sdo_got++;
+	}
+	return 0;
+}
+
+static int test_fuzz(void)
+{
+	static const uint16_t cobs[8]={0,0x80,0x601,0x201,0x702,0x703,0x181,0x123};
+	uint8_t d[8],*p;
+	uint32_t t=0,n;
+	long i;
+	int j;
+	srand(1);
+	pdo_cfg(&fz_t[0],0x181,CO_PDO_EVENT,10,50);
+	fz_t[0].num=2;
+	fz_t[0].map[0]=CO_MAP_ENTRY(0x2000,0,8);
+	fz_t[0].map[1]=CO_MAP_ENTRY(0x2002,0,32);
+	pdo_cfg(&fz_r[0],0x201,CO_PDO_EVENT,0,0);
+	fz_r[0].num=1;
+	fz_r[0].map[0]=CO_MAP_ENTRY(0x2000,0,8);
+	fz.id=1;
+	fz.hb_time=20;
+	fz.od=fz_od;
+	fz.od_num=sizeof(fz_od)/sizeof(fz_od[0]);
+	fz.tpdo_cfg=fz_t;
+	fz.tpdo_num=1;
+	fz.rpdo_cfg=fz_r;
+	fz.rpdo_num=1;
+	fz.hbc=fz_h;
+	fz.hbc_num=2;
+	fz.send=fz_send;
+	CHECK(co_init(&fz)==0);
+	for(i=0;i<FUZZ_NUM;i++)
+	{
+		for(j=0;j<8;j++)d[j]=(uint8_t)rand();
+		if(rand()%3==0)
+		{
+			d[1]=(rand()%2)?0x00:(uint8_t)(0x20+rand()%2);
+			d[2]=rand()%2?0x20:0x18;
+		}
+		if(rand()%4==0)d[0]&=0xF7;
+		co_input(&fz,cobs[rand()%8],d,(uint8_t)(rand()%9),t);
+		if(rand()%3==0)t+=rand()%30;
+		co_poll(&fz,t);
+		CHECK(fz.sdo_off<=CO_SDO_BUF||fz.sdo_ent==&fz_od[0]);
+		if(rand()%1000==0)fz_u++;
+	}
+	CHECK(fz.sdo_reqs>0&&fz.sdo_aborts>0&&fz.tx_full>0);
+
+	//֮SDOӦ
+	t+=CO_SDO_TIMEOUT+1;
+	co_poll(&fz,t);
+	co_nmt(&fz,CO_NMT_START);
+	memset(d,0,8);
+	d[0]=0x40;														//ϴ0x2002
+	d[1]=0x02;
+	d[2]=0x20;
+	for(j=0;j<20;j++)													//sendʧ,Լ
+	{
+		n=sdo_got;
+		co_input(&fz,0x601,d,8,t);
+		if(sdo_got!=n)break;
+	}
+	p=sdo_res.data;
+	CHECK(sdo_got==n+1&&p[0]==0x43&&p[1]==0x02&&p[2]==0x20);
+	CHECK((p[4]|p[5]<<8|p[6]<<16|(uint32_t)p[7]<<24)==fz_u);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_boot()||test_pdo()||test_sdo_expedited()||test_sdo_segmented()||test_remap()||test_nmt()||test_hb()||test_fuzz())return 1;
+	printf("cocore: ok (node1 rx %u tx %u, fuzz sdo %u abort %u)\n",nd[0].rx_frames,nd[0].tx_frames,fz.sdo_reqs,fz.sdo_aborts);
+	return 0;
+}
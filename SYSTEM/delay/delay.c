@@ -1,5 +1,6 @@
 #include "delay.h"
 #include "sys.h"
+#include "isrmon.h"
 ////////////////////////////////////////////////////////////////////////////////// 	 
 //ʹucos,ͷļ.
 #if SYSTEM_SUPPORT_OS
@@ -91,10 +92,12 @@ void delay_ostimedly(u32 ticks)
 //systickжϷ,ʹOSʱõ
 void SysTick_Handler(void)
 {	
+	ISRMON_TickEnter();						//ͳжϽӳ
     HAL_IncTick();
 	if(delay_osrunning==1)					//OSʼ,ִĵȴ
 	{
 		OSIntEnter();						//ж
+		ISRMON_TickOS();					//ͳƽĶ
 		OSTimeTick();       				//ucosʱӷ               
 		OSIntExit();       	 				//лж
 	}
@@ -0,0 +1,148 @@
+#include "gateway.h"
+#include "fdcan.h"
+#include "rs485.h"
+#include "modbus.h"
+#include "malloc.h"
+#include "stdio.h"
+#include "includes.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485<->CAN
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if GATEWAY_EN
+static _gw gateway;
+static u8 gateway_ok=0;
+static u32 gateway_us=0;		//ǰʱ(us)
+static u32 gateway_cyc=0;		//gateway_usӦDWT
+static u32 gateway_t0;			//ϴͳƵʱ(ms)
+static u32 gateway_frames0[GW_RULE_MAX];	//ϴͳʱֽ֡,
+static u32 gateway_bytes0[GW_RULE_MAX];
+static const char *const gateway_bus[GW_BUS_NUM]={"can","rs485"};
+
+//ǰʱ(us),DWTڼۼ,ٽ
+static u32 gateway_now(void)
+{
+	u32 k=SystemCoreClock/1000000;
+	u32 d=(DWT->CYCCNT-gateway_cyc)/k;
+	gateway_cyc+=d*k;
+	gateway_us+=d;
+	return gateway_us;
+}
+
+//һ֡Ŀߵ
+//ֵ:GW_SENT/GW_BUSY/GW_FAIL
+static u8 gateway_send(u8 bus,_gw_frame *f)
+{
+	if(bus==GW_BUS_CAN)
+	{
+		switch(FDCAN1_Send(f->id,f->flags,GW_DATA(f),(u8)f->len))
+		{
+			case 0:return GW_SENT;
+			case 1:return GW_BUSY;			//Ͷ
+			default:return GW_FAIL;
+		}
+	}
+	if(MODBUS_Pending())return GW_BUSY;	//ModbusվڵӦ
+	RS485_Send_Data(GW_DATA(f),(u8)f->len);
+	return GW_SENT;
+}
+
+//ʼת
+//rule:·ɱ,n:
+//ֵ:0,ɹ;1,ڴ治;2,·ɱ̫
+u8 GATEWAY_Init(const _gw_rule *rule,u8 n)
+{
+	u8 i;
+	if(n>GW_RULE_MAX)return 2;
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;	//DWTڼʱ
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;
+	gateway.pool=mymalloc(SRAM12,GATEWAY_POOL_NUM*sizeof(_gw_frame));
+	if(gateway.pool==NULL)return 1;
+	gateway.pool_num=GATEWAY_POOL_NUM;
+	gateway.rule=rule;
+	gateway.rule_num=n;
+	gateway.age=GATEWAY_AGE*1000;
+	gw_init(&gateway);
+	for(i=0;i<GW_RULE_MAX;i++)gateway_frames0[i]=gateway_bytes0[i]=0;
+	gateway_t0=OSTimeGet();
+	gateway_ok=1;
+	return 0;
+}
+
+//յһ֡ʱ(RS485CAN)
+//bus:Դ;id,flags:CAN֡IDͱ־FDCAN1_F_xxx,RS485֡Ϊ0
+//ֵ:1,ƥ·,תŶӻ;0,ûƥ,ߴ
+u8 GATEWAY_Input(u8 bus,u32 id,u8 flags,const u8 *data,u16 len)
+{
+	u8 res;
+	OS_CPU_SR cpu_sr=0;
+	if(!gateway_ok)return 0;
+	OS_ENTER_CRITICAL();
+	res=gw_input(&gateway,bus,id,flags,data,len,gateway_now());
+	OS_EXIT_CRITICAL();
+	if(res)GATEWAY_Poll(GW_BUS_CAN);		//CAN֡뷢Ͷ
+	return res;
+}
+
+//bus֡,ֱпջæ
+//GW_BUS_RS485ֻRS485
+//ֵ:ٶmsҪٵһ
+u32 GATEWAY_Poll(u8 bus)
+{
+	_gw_frame *f;
+	u8 res;
+	OS_CPU_SR cpu_sr=0;
+	if(!gateway_ok)return GATEWAY_POLL_MAX;
+	while(1)
+	{
+		OS_ENTER_CRITICAL();
+		f=gw_take(&gateway,bus,gateway_now());
+		OS_EXIT_CRITICAL();
+		if(f==NULL)break;					//п,һڷߵĶ֡
+		res=gateway_send(bus,f);
+		OS_ENTER_CRITICAL();
+		gw_done(&gateway,bus,res,gateway_now());
+		OS_EXIT_CRITICAL();
+		if(res==GW_BUSY)return 1;
+	}
+	return GATEWAY_POLL_MAX;
+}
+
+//ÿ·ɵͳ,Ϊϴƽֵ
+void GATEWAY_Report(void)
+{
+	const _gw_rule *r;
+	_gw_stat s;
+	u32 t,dt;
+	u8 i;
+	OS_CPU_SR cpu_sr=0;
+	if(!gateway_ok)
+	{
+		printf("gateway: not started\r\n");
+		return;
+	}
+	t=OSTimeGet();
+	dt=t-gateway_t0;
+	if(dt==0)dt=1;
+	printf("gateway: pool %u free %u min %u, queue can %u(max %u) rs485 %u(max %u), no route %u\r\n",
+		gateway.pool_num,gateway.free_num,gateway.free_min,gateway.qlen[GW_BUS_CAN],gateway.qmax[GW_BUS_CAN],
+		gateway.qlen[GW_BUS_RS485],gateway.qmax[GW_BUS_RS485],gateway.nomatch);
+	for(i=0;i<gateway.rule_num;i++)
+	{
+		r=&gateway.rule[i];
+		OS_ENTER_CRITICAL();
+		s=gateway.stat[i];
+		OS_EXIT_CRITICAL();
+		printf("route %u %s %#x/%#x -> %s x%u: %u frames %u bytes %u drops, %u fps %u B/s",
+			i,gateway_bus[r->src],r->match,r->mask,r->dst<GW_BUS_NUM?gateway_bus[r->dst]:"drop",r->xform,
+			s.frames,s.bytes,s.drops,(u32)((s.frames-gateway_frames0[i])*1000ull/dt),(u32)((s.bytes-gateway_bytes0[i])*1000ull/dt));
+		if(s.frames)printf(", latency %u/%u/%u us",s.lat_min,(u32)(s.lat_sum/s.frames),s.lat_max);
+		printf("\r\n");
+		gateway_frames0[i]=s.frames;
+		gateway_bytes0[i]=s.bytes;
+	}
+	gateway_t0=t;
+}
+#endif
@@ -0,0 +1,39 @@
+#ifndef _GATEWAY_H
+#define _GATEWAY_H
+#include "sys.h"
+#include "gwcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485<->CAN:·ɱRS485FDCAN1֮ת֡
+//·ƥ䡢任֡غͳgwcore.c,︺ʱ͵ߵ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//RS485CANͬʱ,԰յ֡GATEWAY_Input,ƥ·ɵ֡Ƶ֡غָŶ
+//CAN֡GATEWAY_InputFDCAN1Ͷ(κ񶼿),ʱ´GATEWAY_Poll
+//RS485ֻ֡RS485GATEWAY_Poll﷢(RS485_Send_DataûȡߵĽ֡,лҪȴ),
+//  ModbusվڵӦʱȲ
+//ʱ:GATEWAY_InputĿʱ(us,DWT);RS485_DE_MODEΪ0ʱͺлʱ
+//ע:·ɱҪModbusվַModbusվѯĴվַ,ƥ·ɵRS485֡ٽModbus
+//ʹ÷:
+//1,RS485_InitFDCAN1_Mode_Init֮GATEWAY_Init(·ɱ)
+//2,յ֡GATEWAY_Input(),0֡ûƥ·,ߴ
+//3,RS485CANѭGATEWAY_Poll(),ֵΪȴʱ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define GATEWAY_EN				1		//0,ر;1,
+#define GATEWAY_POOL_NUM		16		//֡֡(ÿ֡Լ280ֽ,SRAM1/2ڴط)
+#define GATEWAY_AGE				1000	//֡ڶʱ(ms),ʱ
+#define GATEWAY_POLL_MAX		10		//GATEWAY_Pollصȴʱ(ms)
+
+#if GATEWAY_EN
+u8 GATEWAY_Init(const _gw_rule *rule,u8 n);					//ʼת,0ɹ,1ڴ治,2·ɱ̫
+u8 GATEWAY_Input(u8 bus,u32 id,u8 flags,const u8 *data,u16 len);	//յһ֡,1:ƥ·,ת
+u32 GATEWAY_Poll(u8 bus);									//bus֡,´ٵõʱ(ms)
+void GATEWAY_Report(void);									//ÿ·ɵͳ
+#else
+#define GATEWAY_Init(rule,n)	0
+#define GATEWAY_Input(bus,id,flags,data,len)	0
+#define GATEWAY_Poll(bus)		GATEWAY_POLL_MAX
+#define GATEWAY_Report()
+#endif
+#endif
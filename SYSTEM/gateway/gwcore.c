@@ -0,0 +1,211 @@
+#include "gwcore.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//RS485<->CANغ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//״̬,֡
+//ֵ:0,ɹ;1,·ɱ̫
+uint8_t gw_init(_gw *g)
+{
+	uint8_t i;
+	g->free=NULL;
+	for(i=0;i<g->pool_num;i++)
+	{
+		g->pool[i].next=g->free;
+		g->free=&g->pool[i];
+	}
+	g->free_num=g->free_min=g->pool_num;
+	for(i=0;i<GW_BUS_NUM;i++)
+	{
+		g->head[i]=g->tail[i]=NULL;
+		g->busy[i]=g->qlen[i]=g->qmax[i]=0;
+	}
+	memset(g->stat,0,sizeof(g->stat));
+	for(i=0;i<GW_RULE_MAX;i++)g->stat[i].lat_min=0xFFFFFFFF;
+	g->nomatch=0;
+	return g->rule_num>GW_RULE_MAX;
+}
+
+//·ɱƥ
+//ֵ:,rule_numʾûƥ
+static uint8_t gw_match(const _gw *g,uint8_t src,uint32_t key)
+{
+	const _gw_rule *r;
+	uint8_t i;
+	for(i=0;i<g->rule_num;i++)
+	{
+		r=&g->rule[i];
+		if(r->src==src&&(key&r->mask)==(r->match&r->mask))break;
+	}
+	return i;
+}
+
+//֡任Ŀߵĸʽ,ֻͷ,ݲ
+//ֵ:0,ɹ;1,̫̻֡任̫
+static uint8_t gw_xform(const _gw_rule *r,_gw_frame *f)
+{
+	uint8_t *p;
+	uint32_t v;
+	if(r->dst==GW_BUS_CAN)
+	{
+		f->flags=r->flags;
+		switch(r->xform)
+		{
+			case GW_X_RAW:
+				f->id=r->arg;
+				break;
+			case GW_X_ADDR:
+				f->id=r->arg+GW_DATA(f)[0];
+				f->off++;
+				f->len--;
+				break;
+			case GW_X_TUNNEL:
+				if(f->len<5)return 1;
+				p=GW_DATA(f)+1;
+				v=(uint32_t)p[0]<<24|(uint32_t)p[1]<<16|(uint32_t)p[2]<<8|p[3];
+				f->id=v&0x1FFFFFFF;
+				if(v&0x80000000)f->flags|=GW_F_EXT;
+				f->off+=5;
+				f->len-=5;
+				break;
+		}
+		if(!(f->flags&GW_F_EXT))f->id&=0x7FF;
+		return f->len>((f->flags&GW_F_FD)?GW_CANFD_MAX:GW_CAN_MAX);
+	}
+	switch(r->xform)
+	{
+		case GW_X_ADDR:
+			f->off--;
+			f->len++;
+			GW_DATA(f)[0]=(uint8_t)(f->id-r->arg);
+			break;
+		case GW_X_TUNNEL:
+			f->off-=5;
+			f->len+=5;
+			p=GW_DATA(f);
+			v=f->id|((f->flags&GW_F_EXT)?0x80000000:0);
+			p[0]=(uint8_t)r->arg;
+			p[1]=(uint8_t)(v>>24);
+			p[2]=(uint8_t)(v>>16);
+			p[3]=(uint8_t)(v>>8);
+			p[4]=(uint8_t)v;
+			break;
+	}
+	return f->len>GW_DATA_MAX;
+}
+
+//յһ֡ʱ
+//src:Դ;id,flags:CAN֡IDͱ־(RS485֡)
+//data,len:֡,Ƶ֡غߵĻͿ
+//ֵ:1,ƥ˹,ѷĿߵĶл;0,ûƥ,ߴ
+uint8_t gw_input(_gw *g,uint8_t src,uint32_t id,uint8_t flags,const uint8_t *data,uint16_t len,uint32_t now)
+{
+	const _gw_rule *r;
+	_gw_frame *f;
+	uint8_t n;
+	if(src==GW_BUS_RS485&&len==0)return 0;
+	n=gw_match(g,src,src==GW_BUS_CAN?id:data[0]);
+	if(n>=g->rule_num)
+	{
+		g->nomatch++;
+		return 0;
+	}
+	r=&g->rule[n];
+	if(r->dst>=GW_BUS_NUM||r->dst==src)				//
+	{
+		g->stat[n].drops++;
+		return 1;
+	}
+	f=g->free;
+	if(f==NULL||len>GW_DATA_MAX)
+	{
+		g->stat[n].drops++;
+		return 1;
+	}
+	g->free=f->next;
+	g->free_num--;
+	if(g->free_num<g->free_min)g->free_min=g->free_num;
+	f->next=NULL;
+	f->id=id;
+	f->flags=flags;
+	f->t=now;
+	f->rule=n;
+	f->off=GW_HEAD;
+	f->len=len;
+	memcpy(GW_DATA(f),data,len);
+	if(gw_xform(r,f))
+	{
+		g->stat[n].drops++;
+		f->next=g->free;
+		g->free=f;
+		g->free_num++;
+		return 1;
+	}
+	if(g->tail[r->dst]==NULL)g->head[r->dst]=f;
+	else g->tail[r->dst]->next=f;
+	g->tail[r->dst]=f;
+	g->qlen[r->dst]++;
+	if(g->qlen[r->dst]>g->qmax[r->dst])g->qmax[r->dst]=g->qlen[r->dst];
+	return 1;
+}
+
+//Ӷȡһ֡Ż֡
+static void gw_pop(_gw *g,uint8_t bus)
+{
+	_gw_frame *f=g->head[bus];
+	g->head[bus]=f->next;
+	if(g->head[bus]==NULL)g->tail[bus]=NULL;
+	g->qlen[bus]--;
+	f->next=g->free;
+	g->free=f;
+	g->free_num++;
+}
+
+//ȡҪbusĶ֡,ڶﳬage֡
+//ֵ:Ҫ͵֡,gw_done;NULLʾпջһ֡ڷ
+_gw_frame *gw_take(_gw *g,uint8_t bus,uint32_t now)
+{
+	_gw_frame *f;
+	if(g->busy[bus])return NULL;
+	while((f=g->head[bus])!=NULL)
+	{
+		if(g->age==0||now-f->t<g->age)break;
+		g->stat[f->rule].drops++;
+		gw_pop(g,bus);
+	}
+	if(f!=NULL)g->busy[bus]=1;
+	return f;
+}
+
+//gw_takeȡ֡ͽ
+//res:GW_SENT,ѽ;GW_BUSY,æ,ڶ;GW_FAIL,
+void gw_done(_gw *g,uint8_t bus,uint8_t res,uint32_t now)
+{
+	_gw_frame *f=g->head[bus];
+	_gw_stat *s;
+	uint32_t lat;
+	if(!g->busy[bus]||f==NULL)return;
+	g->busy[bus]=0;
+	if(res==GW_BUSY)return;
+	s=&g->stat[f->rule];
+	if(res==GW_SENT)
+	{
+		lat=now-f->t;
+		s->frames++;
+		s->bytes+=f->len;
+		s->lat_sum+=lat;
+		if(lat<s->lat_min)s->lat_min=lat;
+		if(lat>s->lat_max)s->lat_max=lat;
+	}
+	else s->drops++;
+	gw_pop(g,bus);
+}
+
+//bus֡
+uint8_t gw_pending(const _gw *g,uint8_t bus)
+{
+	return g->qlen[bus];
+}
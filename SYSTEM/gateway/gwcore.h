@@ -0,0 +1,113 @@
+#ifndef _GWCORE_H
+#define _GWCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//RS485<->CANغ:·ɱƥ䡢֡任֡ءͶкÿ·ɵͳ
+//ֻñ׼C,HALOS,֡ķɵ(gw_take/gw_done),ʱɵߴ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//յ֡·ɱ˳ƥ,һƥĹĿߺͱ任,ûƥ֡
+//  CAN֡IDƥ,RS485֡õһֽ(ַ)ƥ:(key&mask)==(match&mask)
+//ƥ֡һε֡֡(_gw_frame),֮任ŶӡͶָֻ:
+//  ֡ǰGW_HEADֽڵĿռ,ӵַ/IDͷʱݲ,ֻofflen
+//ÿĿһȽȳ,gw_takeȡײæ,gw_done;ͬһͬʱֻһ֡ڷ,
+//֡ڶﳬage(ߵʱ䵥λ)ûͶ
+//ͳ:ÿ·תֽ֡,յĿʱ(С/ƽ/)
+//̰߳ȫ,ʹʱҪ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define GW_HEAD					8		//֡ǰĿռ,ͷ(GW_X_TUNNEL,5ֽ)
+#define GW_DATA_MAX				255		//֡󳤶(RS485һ֡255ֽ)
+#define GW_RULE_MAX				16		//·ɱ༸
+#define GW_CAN_MAX				8		//ͳCAN֡ݳ
+#define GW_CANFD_MAX			64		//CAN FD֡ݳ
+
+//
+#define GW_BUS_CAN				0
+#define GW_BUS_RS485			1
+#define GW_BUS_NUM				2
+#define GW_BUS_DROP				0xFF	//Ŀ:ƥ֡(ڷΧĹǰ)
+
+//CAN֡־,FDCAN1_F_xxxͬ
+#define GW_F_EXT				0x01	//չID
+#define GW_F_FD					0x04	//CAN FD֡
+#define GW_F_BRS				0x08	//CAN FD֡,ݶл
+
+//任,argΪĲ
+#define GW_X_RAW				0		//ݲ;CANʱIDΪarg
+#define GW_X_ADDR				1		//RS485һֽ(ַ)<->CAN ID=arg+ַ:CANʱȥַֽ,RS485ʱǰID-arg
+#define GW_X_TUNNEL				2		//RS485֡=(arg,1ֽ)+ID(4ֽ,,bit31Ϊչ֡)+,RS485CAN֡
+
+//gw_doneĽ
+#define GW_SENT					0		//ѽ
+#define GW_BUSY					1		//æ,ڶԺط
+#define GW_FAIL					2		//ʧ,
+
+//·ɹ
+typedef struct
+{
+	uint8_t src;				//ԴGW_BUS_xxx
+	uint8_t dst;				//ĿGW_BUS_xxxGW_BUS_DROP
+	uint8_t xform;				//任GW_X_xxx
+	uint8_t flags;				//CANʱ֡־GW_F_FD/GW_F_BRS(GW_X_TUNNELʱټԭ֡չ־)
+	uint32_t match;				//CAN IDRS485ַ
+	uint32_t mask;				//ƥ,0ƥȫ
+	uint32_t arg;				//任
+}_gw_rule;
+
+//֡֡
+typedef struct _gw_frame
+{
+	struct _gw_frame *next;
+	uint32_t id;				//CAN ID;RS485֡
+	uint32_t t;					//յʱ
+	uint16_t len;				//ݳ
+	uint8_t off;				//bufʼλ,յʱΪGW_HEAD
+	uint8_t flags;				//CAN֡־GW_F_xxx
+	uint8_t rule;				//ƥĹ
+	uint8_t buf[GW_HEAD+GW_DATA_MAX];
+}_gw_frame;
+#define GW_DATA(f)				((f)->buf+(f)->off)
+
+//ÿ·ɵͳ
+typedef struct
+{
+	uint32_t frames;			//ת֡
+	uint32_t bytes;				//תֽ(Ŀϵݳ)
+	uint32_t drops;				//֡:֡ؿա任̫ʱʧ
+	uint32_t lat_min;			//յʱ
+	uint32_t lat_max;
+	uint64_t lat_sum;
+}_gw_stat;
+
+typedef struct
+{
+	//,ɵ
+	const _gw_rule *rule;		//·ɱ
+	uint8_t rule_num;
+	_gw_frame *pool;			//֡,pool_num
+	uint8_t pool_num;
+	uint32_t age;				//֡ڶʱ,0
+
+	//֡غͶ
+	_gw_frame *free;
+	uint8_t free_num;
+	uint8_t free_min;			//֡Сֵ
+	_gw_frame *head[GW_BUS_NUM];
+	_gw_frame *tail[GW_BUS_NUM];
+	uint8_t busy[GW_BUS_NUM];	//׵֡ѱgw_takeȡ,ڷ
+	uint8_t qlen[GW_BUS_NUM];
+	uint8_t qmax[GW_BUS_NUM];	//гȵֵ
+
+	//ͳ
+	_gw_stat stat[GW_RULE_MAX];
+	uint32_t nomatch;			//ûƥ֡
+}_gw;
+
+uint8_t gw_init(_gw *g);														//״̬,֡,0ɹ,1·ɱ̫
+uint8_t gw_input(_gw *g,uint8_t src,uint32_t id,uint8_t flags,const uint8_t *data,uint16_t len,uint32_t now);	//յһ֡,1:ƥ˹(Ŷӻ)
+_gw_frame *gw_take(_gw *g,uint8_t bus,uint32_t now);							//ȡҪbusĶ֡,NULLʾûлڷ
+void gw_done(_gw *g,uint8_t bus,uint8_t res,uint32_t now);						//gw_takeȡ֡ͽ,resΪGW_SENT/GW_BUSY/GW_FAIL
+uint8_t gw_pending(const _gw *g,uint8_t bus);									//bus֡
+#endif
@@ -0,0 +1,182 @@
+//////////////////////////////////////////////////////////////////////////////////
+//gwcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/gateway SYSTEM/gateway/gwcore_test.c SYSTEM/gateway/gwcore.c
+//ַ任CAN֡RS485ءûƥ֡任̫
+//֡ͳʱæʱʱͳ;֡/ͽ,֡ʼbuf,֡زʧ
+//////////////////////////////////////////////////////////////////////////////////
+#include "gwcore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(c)	do{if(!(c)){printf("gwcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define POOL_NUM	4
+#define FUZZ_NUM	2000000
+
+static _gw g;
+static _gw_frame pool[POOL_NUM];
+static const _gw_rule rules[]=
+{
+	{GW_BUS_CAN,GW_BUS_DROP,GW_X_RAW,0,0x645,0x7FF,0},				//0:0x645
+	{GW_BUS_RS485,GW_BUS_CAN,GW_X_ADDR,0,0x40,0xF0,0x600},			//1:ַ0x40~0x4F->ID 0x640~0x64F
+	{GW_BUS_CAN,GW_BUS_RS485,GW_X_ADDR,0,0x6C0,0x7F0,0x680},		//2:ID 0x6C0~0x6CF->ַ0x40~0x4F
+	{GW_BUS_CAN,GW_BUS_RS485,GW_X_TUNNEL,0,0x500,0x700,0xFE},		//3:ID 0x500~0x5FF
+	{GW_BUS_RS485,GW_BUS_CAN,GW_X_TUNNEL,GW_F_FD,0xFE,0xFF,0xFE},	//4:֡->CAN FD֡
+	{GW_BUS_RS485,GW_BUS_CAN,GW_X_RAW,0,0x50,0xFF,0x123},			//5:ַ0x50->ID 0x123
+};
+
+static int test_addr(void)
+{
+	_gw_frame *f;
+	uint8_t d[3]={0x41,1,2};
+	g.rule=rules;
+	g.rule_num=sizeof(rules)/sizeof(rules[0]);
+	g.pool=pool;
+	g.pool_num=POOL_NUM;
+	g.age=100;
+	CHECK(gw_init(&g)==0);
+	CHECK(gw_input(&g,GW_BUS_RS485,0,0,d,3,10)==1);
+	f=gw_take(&g,GW_BUS_CAN,12);
+	CHECK(f!=NULL&&f->id==0x641&&f->len==2&&GW_DATA(f)[0]==1&&GW_DATA(f)[1]==2);
+	CHECK(gw_take(&g,GW_BUS_CAN,12)==NULL);								//ڷ
+	gw_done(&g,GW_BUS_CAN,GW_BUSY,12);
+	CHECK(gw_take(&g,GW_BUS_CAN,13)==f);
+	gw_done(&g,GW_BUS_CAN,GW_SENT,15);
+	CHECK(g.stat[1].frames==1&&g.stat[1].bytes==2&&g.stat[1].lat_max==5&&g.stat[1].lat_min==5&&g.free_num==POOL_NUM);
+
+	d[0]=9;
+	CHECK(gw_input(&g,GW_BUS_CAN,0x6C3,0,d,1,20)==1);
+	f=gw_take(&g,GW_BUS_RS485,20);
+	CHECK(f!=NULL&&f->len==2&&GW_DATA(f)[0]==0x43&&GW_DATA(f)[1]==9);
+	gw_done(&g,GW_BUS_RS485,GW_SENT,21);
+	return 0;
+}
+
+//ǰ,ûƥ֡,任̶̫̫֡
+static int test_drop(void)
+{
+	uint8_t d[16]={0};
+	CHECK(gw_input(&g,GW_BUS_CAN,0x645,0,d,1,20)==1&&g.stat[0].drops==1&&g.free_num==POOL_NUM);
+	CHECK(gw_input(&g,GW_BUS_CAN,0x12,0,d,1,20)==0&&g.nomatch==1);
+	d[0]=0x50;
+	CHECK(gw_input(&g,GW_BUS_RS485,0,0,d,9,60)==1&&g.stat[5].drops==1&&g.free_num==POOL_NUM);	//ͳCAN8ֽ
+	d[0]=0xFE;
+	CHECK(gw_input(&g,GW_BUS_RS485,0,0,d,3,60)==1&&g.free_num==POOL_NUM);
+	CHECK(gw_pending(&g,GW_BUS_CAN)==0&&gw_pending(&g,GW_BUS_RS485)==0);
+	return 0;
+}
+
+//CAN֡->RS485֡->CAN FD֡
+static int test_tunnel(void)
+{
+	_gw_frame *f;
+	uint8_t d[8],c[20];
+	int i;
+	for(i=0;i<8;i++)d[i]=(uint8_t)i;
+	CHECK(gw_input(&g,GW_BUS_CAN,0x5AB,0,d,8,30)==1);
+	f=gw_take(&g,GW_BUS_RS485,30);
+	CHECK(f!=NULL&&f->len==13&&GW_DATA(f)[0]==0xFE&&GW_DATA(f)[1]==0&&GW_DATA(f)[3]==0x05&&GW_DATA(f)[4]==0xAB);
+	CHECK(memcmp(GW_DATA(f)+5,d,8)==0);
+	memcpy(c,GW_DATA(f),13);
+	gw_done(&g,GW_BUS_RS485,GW_SENT,31);
+	CHECK(gw_input(&g,GW_BUS_RS485,0,0,c,13,40)==1);
+	f=gw_take(&g,GW_BUS_CAN,40);
+	CHECK(f!=NULL&&f->id==0x5AB&&f->len==8&&f->flags==GW_F_FD&&memcmp(GW_DATA(f),d,8)==0);
+	gw_done(&g,GW_BUS_CAN,GW_SENT,41);
+
+	CHECK(gw_input(&g,GW_BUS_CAN,0x500,GW_F_EXT,d,2,50)==1);				//չ֡:IDbit31
+	f=gw_take(&g,GW_BUS_RS485,50);
+	CHECK(f!=NULL&&GW_DATA(f)[1]==0x80&&f->len==7);
+	memcpy(c,GW_DATA(f),7);
+	gw_done(&g,GW_BUS_RS485,GW_SENT,50);
+	CHECK(gw_input(&g,GW_BUS_RS485,0,0,c,7,50)==1);
+	f=gw_take(&g,GW_BUS_CAN,50);
+	CHECK(f!=NULL&&f->id==0x500&&f->flags==(GW_F_FD|GW_F_EXT)&&f->len==2);
+	gw_done(&g,GW_BUS_CAN,GW_SENT,50);
+	return 0;
+}
+
+//֡ʱ֡;ﳬage֡gw_takeʱ
+static int test_pool(void)
+{
+	uint8_t d[3]={0x41,1,2};
+	uint32_t drops=g.stat[1].drops;
+	int i;
+	for(i=0;i<POOL_NUM+1;i++)gw_input(&g,GW_BUS_RS485,0,0,d,3,70);
+	CHECK(g.stat[1].drops==drops+1&&g.free_num==0&&g.free_min==0&&gw_pending(&g,GW_BUS_CAN)==POOL_NUM);
+	CHECK(gw_take(&g,GW_BUS_CAN,70+g.age+1)==NULL);
+	CHECK(g.free_num==POOL_NUM&&g.stat[1].drops==drops+1+POOL_NUM&&gw_pending(&g,GW_BUS_CAN)==0);
+	return 0;
+}
+
+//æʱ֡ڶ,˳򲻱;ʧܵ֡
+static int test_order(void)
+{
+	_gw_frame *f;
+	uint8_t d[1];
+	uint32_t drops=g.stat[1].drops;
+	int i;
+	for(i=0;i<3;i++)
+	{
+		d[0]=(uint8_t)(0x40+i);
+		CHECK(gw_input(&g,GW_BUS_RS485,0,0,d,1,200)==1);
+	}
+	f=gw_take(&g,GW_BUS_CAN,201);
+	CHECK(f!=NULL&&f->id==0x640);
+	gw_done(&g,GW_BUS_CAN,GW_SENT,201);
+	f=gw_take(&g,GW_BUS_CAN,201);
+	CHECK(f!=NULL&&f->id==0x641);
+	gw_done(&g,GW_BUS_CAN,GW_BUSY,201);
+	f=gw_take(&g,GW_BUS_CAN,202);
+	CHECK(f!=NULL&&f->id==0x641);
+	gw_done(&g,GW_BUS_CAN,GW_FAIL,202);
+	f=gw_take(&g,GW_BUS_CAN,203);
+	CHECK(f!=NULL&&f->id==0x642&&f->len==0);
+	gw_done(&g,GW_BUS_CAN,GW_SENT,203);
+	CHECK(g.stat[1].drops==drops+1&&g.free_num==POOL_NUM&&g.qmax[GW_BUS_CAN]==POOL_NUM);
+	return 0;
+}
+
+//֡ȡ֡ͷͽ(ûȡ֡ʱgw_done)
+static int test_fuzz(void)
+{
+	static const uint8_t addrs[3]={0x40,0x50,0xF0};					//0x5xֻ0x50ƥ,0xFxֻ0xFE
+	static const uint32_t ids[3]={0x600,0x500,0x000};
+	_gw_frame *f;
+	uint8_t d[GW_DATA_MAX];
+	uint32_t id;
+	long i;
+	int n,j;
+	srand(1);
+	for(i=0;i<FUZZ_NUM;i++)
+	{
+		n=rand()%300;
+		if(n>GW_DATA_MAX)n=GW_DATA_MAX;
+		for(j=0;j<8;j++)d[j]=(uint8_t)rand();
+		id=rand()&0x7FF;
+		if(rand()%2)												//һ֡ƥ
+		{
+			d[0]=addrs[rand()%3]|(rand()&0x0F);
+			id=ids[rand()%3]|(id&0xFF);
+		}
+		gw_input(&g,(uint8_t)(rand()%2),id,(uint8_t)(rand()&GW_F_EXT),d,(uint16_t)n,(uint32_t)i);
+		f=gw_take(&g,(uint8_t)(rand()%2),(uint32_t)i);
+		if(f!=NULL)
+		{
+			CHECK(f->off>=3&&f->off+f->len<=sizeof(f->buf));
+			CHECK(f->rule<g.rule_num&&rules[f->rule].dst!=GW_BUS_DROP);
+			gw_done(&g,GW_BUS_CAN,(uint8_t)(rand()%3),(uint32_t)i);
+			gw_done(&g,GW_BUS_RS485,(uint8_t)(rand()%3),(uint32_t)i);
+		}
+	}
+	CHECK(gw_pending(&g,GW_BUS_CAN)+gw_pending(&g,GW_BUS_RS485)+g.free_num==POOL_NUM);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_addr()||test_drop()||test_tunnel()||test_pool()||test_order()||test_fuzz())return 1;
+	printf("gwcore: ok (fuzz: %u frames to CAN, %u to RS485, %u no match)\n",
+		g.stat[1].frames+g.stat[4].frames+g.stat[5].frames,g.stat[2].frames+g.stat[3].frames,g.nomatch);
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "isotp.h"
+#include "w25qxx.h"
+#include "stdio.h"
+#include "includes.h"
+//////////////////////////////////////////////////////////////////////////////////
+//FDCAN1ϵISO-TP
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if ISOTP_EN
+static _tp_link *isotp_link[ISOTP_LINK_NUM];
+static u32 isotp_us=0;			//ǰʱ(us)
+static u32 isotp_cyc=0;			//isotp_usӦDWT
+static u32 isotp_stray=0;		//IDƥ䵫־֡
+
+//ǰʱ(us),DWTڼۼ,Լ10һ
+static u32 isotp_now(void)
+{
+	u32 k=SystemCoreClock/1000000;
+	u32 d=(DWT->CYCCNT-isotp_cyc)/k;
+	isotp_cyc+=d*k;
+	isotp_us+=d;
+	return isotp_us;
+}
+
+//sendص:FDCAN1FIFO
+static u8 isotp_can_send(_tp_link *l,const u8 *data,u8 len)
+{
+	return FDCAN1_Send(l->tx_id,l->flags,data,len);
+}
+
+//ע,sendΪNULLʱʹFDCAN1
+//l:,óԱ
+//ֵ:0,ɹ;1,ӱ
+u8 ISOTP_Open(_tp_link *l)
+{
+	u8 i;
+	OS_CPU_SR cpu_sr=0;
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;	//DWTڼʱ
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;
+	if(l->send==NULL)l->send=isotp_can_send;
+	tp_init(l);
+	OS_ENTER_CRITICAL();
+	for(i=0;i<ISOTP_LINK_NUM;i++)
+	{
+		if(isotp_link[i]==NULL||isotp_link[i]==l)
+		{
+			isotp_link[i]=l;
+			OS_EXIT_CRITICAL();
+			return 0;
+		}
+	}
+	OS_EXIT_CRITICAL();
+	return 1;
+}
+
+//ע
+void ISOTP_Close(_tp_link *l)
+{
+	u8 i;
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	for(i=0;i<ISOTP_LINK_NUM;i++)if(isotp_link[i]==l)isotp_link[i]=NULL;
+	OS_EXIT_CRITICAL();
+}
+
+//յһ֡ʱ(CAN)
+//frame:FDCAN1_Readյ֡
+//ֵ:1,עӵ֡,Ѵ;0,,ߴ
+u8 ISOTP_Input(const _fdcan_frame *frame)
+{
+	_tp_link *l;
+	u8 i;
+	for(i=0;i<ISOTP_LINK_NUM;i++)
+	{
+		l=isotp_link[i];
+		if(l==NULL||l->rx_id!=frame->id)continue;
+		if((l->flags&TP_F_EXT)!=(frame->flags&FDCAN1_F_EXT)||(frame->flags&FDCAN1_F_RTR))
+		{
+			isotp_stray++;
+			continue;
+		}
+		tp_input(l,frame->data,frame->len,isotp_now());
+		return 1;
+	}
+	return 0;
+}
+
+//֡֡,鳬ʱ,CANѭ
+//ֵ:ٶmsҪٵһ,ΪFDCAN1_Waitĵȴʱ
+u32 ISOTP_Poll(void)
+{
+	u32 now=isotp_now();
+	u32 wait=ISOTP_POLL_MAX*1000,t;
+	u8 i;
+	for(i=0;i<ISOTP_LINK_NUM;i++)
+	{
+		if(isotp_link[i]==NULL)continue;
+		t=tp_poll(isotp_link[i],now);
+		if(t<wait)wait=t;
+	}
+	wait/=1000;
+	return wait?wait:1;							//FIFO֡1msʱ1
+}
+
+//ʼһϢ
+//l:ע
+//len:Ϣ,readصtx_dataṩ
+//ֵ:0,ɹ;1,ڷ;2,Ϊ0
+u8 ISOTP_Send(_tp_link *l,u32 len)
+{
+	return tp_send(l,len,isotp_now());
+}
+
+//readص:W25QXXҪ͵
+//l->base:W25QXXʼַ
+u8 ISOTP_FlashRead(_tp_link *l,u32 off,u8 *buf,u16 len)
+{
+	W25QXX_Read(buf,l->base+off,len);
+	return 0;
+}
+
+//writeص:յдW25QXX
+//ݰ˳д,дÿ4KBĿͷʱ,ÿֻһ
+//(W25QXX_Writeÿһ鶼Ҫٲд,ݲ0XFFʱһҪ16)
+//l->base:W25QXXʼַ,4KB
+u8 ISOTP_FlashWrite(_tp_link *l,u32 off,const u8 *buf,u16 len)
+{
+	u32 addr=l->base+off;
+	u32 sec;
+	W25QXX_Lock();								//д֮䲻дW25QXX
+	for(sec=(addr+4095)/4096;sec*4096<addr+len;sec++)W25QXX_Erase_Sector(sec);	//һͷ
+	W25QXX_Write_NoCheck((u8*)buf,addr,len);
+	W25QXX_Unlock();
+	return 0;
+}
+
+//ÿӵͳ
+void ISOTP_Report(void)
+{
+	_tp_link *l;
+	u8 i;
+	printf("isotp: stray %u\r\n",isotp_stray);
+	for(i=0;i<ISOTP_LINK_NUM;i++)
+	{
+		l=isotp_link[i];
+		if(l==NULL)continue;
+		printf("isotp %#x->%#x dl %u bs %u stmin %#x: tx %u rx %u err %u, busy %u, tx %u/%u rx %u/%u bytes\r\n",
+			l->rx_id,l->tx_id,l->dl,l->bs,l->stmin,l->tx_msgs,l->rx_msgs,l->errs,tp_busy(l),
+			l->tx_off,l->tx_len,l->rx_off,l->rx_len);
+	}
+}
+#endif
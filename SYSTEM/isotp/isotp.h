@@ -0,0 +1,41 @@
+#ifndef _ISOTP_H
+#define _ISOTP_H
+#include "sys.h"
+#include "fdcan.h"
+#include "tpcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//FDCAN1ϵISO-TP
+//Эtpcore.c,︺ӽӵFDCAN1IDַյ֡ṩʱW25QXXдص
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ӿͬʱշ,ÿrx_id;ӵķ֡(dl)ͱ־(flags)ôͳCANCAN FD
+//ļֱӴW25QXX͡յֱдW25QXX(ISOTP_FlashRead/ISOTP_FlashWriteص),
+//ÿֻTP_CHUNKֽڵĻ;ISOTP_FlashWritebase4KB,յдĸͲĸ
+//շÿbs֡һ֡,дW25QXXʱ﷢ͷͣڿ߽ȴ,ᶪ֡
+//ʹ÷:
+//1,FDCAN1_Mode_Init֮_tp_link,ISOTP_Open()ע
+//2,CANѭ:FDCAN1_Wait(ISOTP_Poll());յ֡ȽISOTP_Input(),0֡ISO-TP֡
+//3,ISOTP_Send()ʼ,ɻʱӵdoneص
+//ʱDWTڼus,ISOTP_Pollÿ10Ҫһ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define ISOTP_EN				1		//0,ر;1,ISO-TP
+#define ISOTP_LINK_NUM			4		//ͬʱע
+#define ISOTP_POLL_MAX			10		//ISOTP_Pollصȴʱ(ms)
+
+#if ISOTP_EN
+u8 ISOTP_Open(_tp_link *l);							//ע,0ɹ,1ӱ
+void ISOTP_Close(_tp_link *l);						//ע,ڽеշ
+u8 ISOTP_Input(const _fdcan_frame *frame);			//յһ֡,1:עӵ֡,Ѵ
+u32 ISOTP_Poll(void);								//֡/֡鳬ʱ,´ٵõʱ(ms)
+u8 ISOTP_Send(_tp_link *l,u32 len);					//ʼ,0ɹ,1ڷ,2Ϊ0
+u8 ISOTP_FlashRead(_tp_link *l,u32 off,u8 *buf,u16 len);		//readص:W25QXXbase+off
+u8 ISOTP_FlashWrite(_tp_link *l,u32 off,const u8 *buf,u16 len);	//writeص:дW25QXXbase+off
+void ISOTP_Report(void);							//ÿӵͳ
+#else
+#define ISOTP_Input(frame)		0
+#define ISOTP_Poll()			ISOTP_POLL_MAX
+#define ISOTP_Report()
+#endif
+#endif
@@ -0,0 +1,415 @@
+#include "tpcore.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//ISO-TP(ISO 15765-2)
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//״̬
+#define TP_TX_IDLE				0
+#define TP_TX_SF				1		//֡
+#define TP_TX_FF				2		//֡
+#define TP_TX_WAIT_FC			3		//֡
+#define TP_TX_CF				4		//֡
+
+//״̬
+#define TP_RX_IDLE				0
+#define TP_RX_CF				1		//֡
+
+//CAN FD֡ݳ,8ֽʱЩ
+static const uint8_t tp_fd_len[7]={12,16,20,24,32,48,64};
+
+//״̬,ò,ڽеշֱӶ,ص
+void tp_init(_tp_link *l)
+{
+	l->tx_state=TP_TX_IDLE;
+	l->tx_flen=0;
+	l->rx_state=TP_RX_IDLE;
+	l->rx_fc=0;
+	l->tx_msgs=l->rx_msgs=l->errs=0;
+}
+
+//bit0:ڷ;bit1:ڽ
+uint8_t tp_busy(const _tp_link *l)
+{
+	return (l->tx_state!=TP_TX_IDLE)|((l->rx_state!=TP_RX_IDLE)<<1);
+}
+
+//һ֡:ͳ֡8ֽ,CAN FD֡DLCӦĳ
+//ֵ:ĳ
+static uint8_t tp_pad(const _tp_link *l,uint8_t *f,uint8_t len)
+{
+	uint8_t n=8,i;
+	if(len>8)
+	{
+		for(i=0;i<7;i++)if(tp_fd_len[i]>=len)break;
+		n=tp_fd_len[i];
+	}
+	memset(f+len,l->pad,n-len);
+	return n;
+}
+
+//STminתΪus
+static uint32_t tp_stmin_us(uint8_t st)
+{
+	if(st<=0x7F)return (uint32_t)st*1000;
+	if(st>=0xF1&&st<=0xF9)return (uint32_t)(st-0xF0)*100;
+	return 127000;					//ֵֵ
+}
+
+//ͽ
+static void tp_tx_end(_tp_link *l,uint8_t err)
+{
+	l->tx_state=TP_TX_IDLE;
+	l->tx_flen=0;
+	if(err)l->errs++;
+	else l->tx_msgs++;
+	if(l->done)l->done(l,TP_DIR_TX,err);
+}
+
+//ս
+static void tp_rx_end(_tp_link *l,uint8_t err)
+{
+	l->rx_state=TP_RX_IDLE;
+	if(err)l->errs++;
+	else l->rx_msgs++;
+	if(l->done)l->done(l,TP_DIR_RX,err);
+}
+
+//ȡnֽҪ͵,tx_bufʱreadصһ
+//ֵ:0ɹ,1ʧ
+static uint8_t tp_src(_tp_link *l,uint8_t *dst,uint32_t n)
+{
+	uint32_t c;
+	if(l->read==NULL)
+	{
+		memcpy(dst,l->tx_data+l->tx_off,n);
+		l->tx_off+=n;
+		return 0;
+	}
+	while(n)
+	{
+		if(l->tx_pos==l->tx_fill)
+		{
+			c=l->tx_len-l->tx_off;
+			if(c>TP_CHUNK)c=TP_CHUNK;
+			if(l->read(l,l->tx_off,l->tx_buf,(uint16_t)c))return 1;
+			l->tx_fill=(uint16_t)c;
+			l->tx_pos=0;
+		}
+		c=l->tx_fill-l->tx_pos;
+		if(c>n)c=n;
+		memcpy(dst,l->tx_buf+l->tx_pos,c);
+		l->tx_pos+=(uint16_t)c;
+		l->tx_off+=c;
+		dst+=c;
+		n-=c;
+	}
+	return 0;
+}
+
+//յ,rx_bufʱwriteصд
+//ֵ:0ɹ,1дʧ
+static uint8_t tp_sink(_tp_link *l,const uint8_t *src,uint32_t n)
+{
+	uint32_t c;
+	if(l->write==NULL)
+	{
+		memcpy(l->rx_data+l->rx_off,src,n);
+		l->rx_off+=n;
+		return 0;
+	}
+	while(n)
+	{
+		c=TP_CHUNK-l->rx_fill;
+		if(c>n)c=n;
+		memcpy(l->rx_buf+l->rx_fill,src,c);
+		l->rx_fill+=(uint16_t)c;
+		l->rx_off+=c;
+		src+=c;
+		n-=c;
+		if(l->rx_fill==TP_CHUNK)
+		{
+			if(l->write(l,l->rx_off-TP_CHUNK,l->rx_buf,TP_CHUNK))return 1;
+			l->rx_fill=0;
+		}
+	}
+	return 0;
+}
+
+//дrx_bufʣµ
+static uint8_t tp_flush(_tp_link *l)
+{
+	uint16_t n=l->rx_fill;
+	if(l->write==NULL||n==0)return 0;
+	l->rx_fill=0;
+	return l->write(l,l->rx_off-n,l->rx_buf,n);
+}
+
+//ʼһϢ,֡/֡Է
+//len:Ϣ,readصtx_dataṩ
+//now:ǰʱ(us)
+//ֵ:0ɹ;1ڷ;2Ϊ0
+uint8_t tp_send(_tp_link *l,uint32_t len,uint32_t now)
+{
+	uint8_t *f=l->tx_frame;
+	uint8_t h,n;
+	if(l->tx_state!=TP_TX_IDLE)return 1;
+	if(len==0)return 2;
+	l->tx_len=len;
+	l->tx_off=0;
+	l->tx_pos=l->tx_fill=0;
+	if(len<=7||(l->dl>8&&len<=(uint32_t)l->dl-2))	//֡
+	{
+		if(len<=7)
+		{
+			f[0]=(uint8_t)len;
+			h=1;
+		}else
+		{
+			f[0]=0;
+			f[1]=(uint8_t)len;
+			h=2;
+		}
+		l->tx_state=TP_TX_SF;
+	}else											//֡
+	{
+		if(len<=4095)
+		{
+			f[0]=0x10|(uint8_t)(len>>8);
+			f[1]=(uint8_t)len;
+			h=2;
+		}else
+		{
+			f[0]=0x10;
+			f[1]=0;
+			f[2]=(uint8_t)(len>>24);
+			f[3]=(uint8_t)(len>>16);
+			f[4]=(uint8_t)(len>>8);
+			f[5]=(uint8_t)len;
+			h=6;
+		}
+		l->tx_state=TP_TX_FF;
+	}
+	n=(l->tx_state==TP_TX_SF)?(uint8_t)len:l->dl-h;
+	if(tp_src(l,f+h,n))
+	{
+		tp_tx_end(l,TP_ERR_IO);
+		return 0;
+	}
+	l->tx_flen=tp_pad(l,f,h+n);
+	l->tx_sn=1;
+	l->tx_timer=now+TP_N_BS*1000;
+	tp_poll(l,now);
+	return 0;
+}
+
+//֡֡/֡͵ʱ֡,ͻʱ´
+static void tp_pump(_tp_link *l,uint32_t now)
+{
+	uint8_t fc[8];
+	uint32_t n;
+	if(l->rx_fc)
+	{
+		fc[0]=0x30|(l->rx_fc-1);
+		fc[1]=l->bs;
+		fc[2]=l->stmin;
+		if(l->send(l,fc,tp_pad(l,fc,3))==0)l->rx_fc=0;
+	}
+	while(1)
+	{
+		if(l->tx_flen)
+		{
+			if(l->send(l,l->tx_frame,l->tx_flen))return;
+			l->tx_flen=0;
+			if(l->tx_state==TP_TX_SF)
+			{
+				tp_tx_end(l,TP_OK);
+				return;
+			}
+			if(l->tx_state==TP_TX_FF)
+			{
+				l->tx_state=TP_TX_WAIT_FC;
+				l->tx_timer=now+TP_N_BS*1000;
+				return;
+			}
+			if(l->tx_off==l->tx_len)				//һ֡
+			{
+				tp_tx_end(l,TP_OK);
+				return;
+			}
+			l->tx_next=now+l->tx_st;
+			if(l->tx_bs&&++l->tx_cnt>=l->tx_bs)		//һ鷢,һ֡
+			{
+				l->tx_state=TP_TX_WAIT_FC;
+				l->tx_timer=now+TP_N_BS*1000;
+				return;
+			}
+		}
+		if(l->tx_state!=TP_TX_CF||(int32_t)(now-l->tx_next)<0)return;
+		n=l->tx_len-l->tx_off;
+		if(n>(uint32_t)l->dl-1)n=l->dl-1;
+		l->tx_frame[0]=0x20|l->tx_sn;
+		l->tx_sn=(l->tx_sn+1)&0x0F;
+		if(tp_src(l,l->tx_frame+1,n))
+		{
+			tp_tx_end(l,TP_ERR_IO);
+			return;
+		}
+		l->tx_flen=tp_pad(l,l->tx_frame,(uint8_t)(n+1));
+	}
+}
+
+//յ֡
+static void tp_rx_fc(_tp_link *l,const uint8_t *data,uint8_t len,uint32_t now)
+{
+	if(l->tx_state!=TP_TX_WAIT_FC||len<3)return;
+	switch(data[0]&0x0F)
+	{
+		case 0:								//
+			l->tx_bs=data[1];
+			l->tx_st=tp_stmin_us(data[2]);
+			l->tx_cnt=0;
+			l->tx_wft=0;
+			l->tx_next=now;
+			l->tx_state=TP_TX_CF;
+			break;
+		case 1:								//ȴ
+			if(++l->tx_wft>TP_WFT_MAX)tp_tx_end(l,TP_ERR_WFT);
+			else l->tx_timer=now+TP_N_BS*1000;
+			break;
+		case 2:								//
+			tp_tx_end(l,TP_ERR_OVFLW);
+			break;
+	}
+}
+
+//յ֡֡ʱʼ
+//n:Ϣ
+//data:֡
+//dn:֡ݳ
+//ֵ:0,ʼ;1,rx_max;2,дʧ,Ѿ
+static uint8_t tp_rx_start(_tp_link *l,uint32_t n,const uint8_t *data,uint8_t dn)
+{
+	if(l->rx_state!=TP_RX_IDLE)tp_rx_end(l,TP_ERR_ABORT);
+	if(l->rx_max&&n>l->rx_max)
+	{
+		l->errs++;
+		return 1;
+	}
+	l->rx_len=n;
+	l->rx_off=0;
+	l->rx_fill=0;
+	l->rx_state=TP_RX_CF;			//tp_rx_end
+	if(tp_sink(l,data,dn))
+	{
+		tp_rx_end(l,TP_ERR_IO);
+		return 2;
+	}
+	return 0;
+}
+
+//յһ֡
+//data:֡
+//len:֡
+//now:ǰʱ(us)
+void tp_input(_tp_link *l,const uint8_t *data,uint8_t len,uint32_t now)
+{
+	uint32_t n;
+	uint8_t h;
+	if(len<1)return;
+	switch(data[0]>>4)
+	{
+		case 0:								//֡
+			n=data[0]&0x0F;
+			h=1;
+			if(n==0)
+			{
+				if(len<2)return;
+				n=data[1];
+				h=2;
+			}
+			if(n==0||n>(uint32_t)len-h)return;
+			if(tp_rx_start(l,n,data+h,(uint8_t)n))return;
+			if(tp_flush(l))tp_rx_end(l,TP_ERR_IO);
+			else tp_rx_end(l,TP_OK);
+			break;
+		case 1:								//֡
+			if(len<8)return;
+			n=((uint32_t)(data[0]&0x0F)<<8)|data[1];
+			h=2;
+			if(n==0)
+			{
+				n=((uint32_t)data[2]<<24)|((uint32_t)data[3]<<16)|((uint32_t)data[4]<<8)|data[5];
+				h=6;
+			}
+			if(n<=(uint32_t)len-h)return;	//֡װϢ,Ϸ
+			switch(tp_rx_start(l,n,data+h,len-h))
+			{
+				case 1:l->rx_fc=3;break;	//
+				case 2:return;
+			}
+			if(l->rx_state!=TP_RX_CF)break;
+			l->rx_sn=1;
+			l->rx_cnt=0;
+			l->rx_fc=1;						//
+			l->rx_timer=now+TP_N_CR*1000;
+			break;
+		case 2:								//֡
+			if(l->rx_state!=TP_RX_CF)return;
+			if((data[0]&0x0F)!=l->rx_sn)
+			{
+				tp_rx_end(l,TP_ERR_SN);
+				return;
+			}
+			n=l->rx_len-l->rx_off;
+			if(n>(uint32_t)len-1)n=len-1;
+			if(tp_sink(l,data+1,n))
+			{
+				tp_rx_end(l,TP_ERR_IO);
+				return;
+			}
+			l->rx_sn=(l->rx_sn+1)&0x0F;
+			l->rx_timer=now+TP_N_CR*1000;
+			if(l->rx_off==l->rx_len)
+			{
+				if(tp_flush(l))tp_rx_end(l,TP_ERR_IO);
+				else tp_rx_end(l,TP_OK);
+			}else if(l->bs&&++l->rx_cnt>=l->bs)	//һ,֡
+			{
+				l->rx_cnt=0;
+				l->rx_fc=1;
+			}
+			break;
+		case 3:								//֡
+			tp_rx_fc(l,data,len,now);
+			break;
+	}
+	tp_pump(l,now);
+}
+
+//֡֡,鳬ʱ,յ֮֡Ϳʱѭ
+//now:ǰʱ(us)
+//ֵ:ٶusҪٵһ,0ʾ֡Ϊͻûз
+uint32_t tp_poll(_tp_link *l,uint32_t now)
+{
+	uint32_t wait=TP_N_CR*1000;
+	int32_t t;
+	if(l->tx_state==TP_TX_WAIT_FC&&(int32_t)(now-l->tx_timer)>=0)tp_tx_end(l,TP_ERR_TIMEOUT);
+	if(l->rx_state==TP_RX_CF&&(int32_t)(now-l->rx_timer)>=0)tp_rx_end(l,TP_ERR_TIMEOUT);
+	tp_pump(l,now);
+	if(l->tx_flen||l->rx_fc)return 0;
+	if(l->tx_state==TP_TX_CF)t=(int32_t)(l->tx_next-now);
+	else if(l->tx_state==TP_TX_WAIT_FC)t=(int32_t)(l->tx_timer-now);
+	else t=(int32_t)wait;
+	if(t<0)t=0;
+	if((uint32_t)t<wait)wait=t;
+	if(l->rx_state==TP_RX_CF)
+	{
+		t=(int32_t)(l->rx_timer-now);
+		if(t<0)t=0;
+		if((uint32_t)t<wait)wait=t;
+	}
+	return wait;
+}
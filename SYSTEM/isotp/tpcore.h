@@ -0,0 +1,102 @@
+#ifndef _TPCORE_H
+#define _TPCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//ISO-TP(ISO 15765-2):ֶΡ顢
+//ֻñ׼C,HALOSFDCAN,CAN֡sendص,յ֡tp_input,ʱɵߴ
+//PCϰӽһ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//֡ʽ(һֽڵĸ4λΪ):
+//SF ֡    0x0N ;CAN FD֡:0x00 (1) 
+//FF ֡    0x1N NN (12λ);4095ֽ:0x10 0x00 (4,) 
+//CF ֡  0x2N ,NΪ0~15ѭ,һCFΪ1
+//FC ֡  0x3S BS STmin,S:0,1ȴ,2
+//һ(_tp_link)ӦһCAN ID,ͬʱһϢһϢ,ӻӰ
+//ݲҪRAM:ʱÿreadصTP_CHUNKֽ,ʱÿTP_CHUNKֽڵwriteصд
+//read/writeΪNULLʱֱӶдtx_data/rx_data
+//////////////////////////////////////////////////////////////////////////////////
+
+#define TP_CHUNK				256		//read/writeصÿζдֽ
+#define TP_N_BS					1000	//ͷ֡ĳʱ(ms)
+#define TP_N_CR					1000	//շ֡ĳʱ(ms)
+#define TP_WFT_MAX				16		//յٸȴ֡
+
+//can֡־,FDCAN1_F_xxxͬ,sendصʹ
+#define TP_F_EXT				0x01	//չID
+#define TP_F_FD					0x04	//CAN FD֡
+#define TP_F_BRS				0x08	//CAN FD֡,ݶл
+
+//
+#define TP_OK					0
+#define TP_ERR_TIMEOUT			1		//֡֡ʱ
+#define TP_ERR_SN				2		//֡Ŵ
+#define TP_ERR_OVFLW			3		//շռ䲻(յ򷢳֡)
+#define TP_ERR_IO				4		//read/writeصʧ
+#define TP_ERR_WFT				5		//ȴ̫֡
+#define TP_ERR_ABORT			6		//յµ֡/֡,ǰһϢ
+
+#define TP_DIR_TX				0
+#define TP_DIR_RX				1
+
+typedef struct _tp_link
+{
+	//,ɵ
+	uint32_t tx_id;				//֡ID
+	uint32_t rx_id;				//յ֡ID
+	uint8_t flags;				//֡ı־TP_F_xxx
+	uint8_t dl;					//֡󳤶:8,ͳCAN;12~64,CAN FD
+	uint8_t bs;					//ʱҪĿС,0ֿ
+	uint8_t stmin;				//ʱҪ֡,0~127ms,0xF1~0xF9Ϊ100~900us
+	uint8_t pad;				//ֽ,ͳ֡8ֽ,CAN FD֡DLCӦĳ
+	uint32_t rx_max;			//յֽ,ʱ֡;0
+	uint8_t (*send)(struct _tp_link *l,const uint8_t *data,uint8_t len);	//һ֡,0ɹ,0ͻ(Ժ)
+	uint8_t (*read)(struct _tp_link *l,uint32_t off,uint8_t *buf,uint16_t len);		//Ҫ͵,0ɹ
+	uint8_t (*write)(struct _tp_link *l,uint32_t off,const uint8_t *buf,uint16_t len);	//дյ,0ɹ
+	void (*done)(struct _tp_link *l,uint8_t dir,uint8_t err);	///ɻ
+	const uint8_t *tx_data;		//readΪNULLʱҪ͵
+	uint8_t *rx_data;			//writeΪNULLʱջ,СΪrx_max
+	uint32_t base;				//read/writeصõʼַ
+	void *arg;					//صõĲ
+
+	//״̬
+	uint8_t tx_state;
+	uint8_t tx_sn;				//һ֡
+	uint8_t tx_bs;				//ԷҪĿС
+	uint8_t tx_cnt;				//ѷ֡
+	uint8_t tx_wft;				//յĵȴ֡
+	uint8_t tx_flen;			//֡ĳ,0ʾû
+	uint32_t tx_len;			//Ϣ
+	uint32_t tx_off;			//ѾŽֽ֡
+	uint32_t tx_st;				//ԷҪ֡(us)
+	uint32_t tx_next;			//һ֡緢ʱ(us)
+	uint32_t tx_timer;			//ʱʱ(us)
+	uint16_t tx_pos;			//tx_bufһҪֽ
+	uint16_t tx_fill;			//tx_bufֽ
+	uint8_t tx_frame[64];		//֡(ͻʱ´)
+	uint8_t tx_buf[TP_CHUNK];
+
+	//״̬
+	uint8_t rx_state;
+	uint8_t rx_sn;				//֡
+	uint8_t rx_cnt;				//յ֡
+	uint8_t rx_fc;				//Ҫ֡:0,û;ΪFS+1
+	uint32_t rx_len;			//Ϣ
+	uint32_t rx_off;			//յֽ
+	uint32_t rx_timer;			//ʱʱ(us)
+	uint16_t rx_fill;			//rx_bufֽ
+	uint8_t rx_buf[TP_CHUNK];
+
+	//ͳ
+	uint32_t tx_msgs;			//Ϣ
+	uint32_t rx_msgs;			//Ϣ
+	uint32_t errs;				//Ϣ
+}_tp_link;
+
+void tp_init(_tp_link *l);												//״̬,ò
+uint8_t tp_send(_tp_link *l,uint32_t len,uint32_t now);					//ʼһϢ,0ɹ,1ڷ
+void tp_input(_tp_link *l,const uint8_t *data,uint8_t len,uint32_t now);	//յһ֡(IDΪrx_id)
+uint32_t tp_poll(_tp_link *l,uint32_t now);								//֡/֡,鳬ʱ,´ٵõʱ(us)
+uint8_t tp_busy(const _tp_link *l);										//bit0:ڷ;bit1:ڽ
+#endif
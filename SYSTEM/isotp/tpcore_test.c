@@ -0,0 +1,257 @@
+//////////////////////////////////////////////////////////////////////////////////
+//tpcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/isotp SYSTEM/isotp/tpcore_test.c SYSTEM/isotp/tpcore.c
+//ӽһ(sendص֡Էtp_input),ÿ50usһtp_poll:
+//ͳ֡100KB(4ֽڳȵ֡)CAN FD֡70KBͬʱ˫򴫡֡RAMշһ֡(Ŵ)
+//֡/֡ʱͻʱ
+//////////////////////////////////////////////////////////////////////////////////
+#include "tpcore.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(c)	do{if(!(c)){printf("tpcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define QNUM		4096
+
+//ϵһ֡
+typedef struct
+{
+	_tp_link *dst;
+	uint8_t data[64];
+	uint8_t len;
+}_frame;
+
+static _tp_link L[4];					//L[0]<->L[1]ͳ֡,L[2]<->L[3]CAN FD֡
+static _frame bus_q[QNUM];
+static uint32_t bus_qh,bus_qt;
+static uint32_t bus_cap=QNUM;			//ͻܷŵ֡
+static uint32_t bus_frames;				//֡
+static uint32_t drop_cf;				//ڼ֡(ֻ֡),0
+static uint8_t mute[4];					//1,ӷ֡
+static uint8_t no_cf;					//1,֡
+static uint32_t now;					//ǰʱ(us)
+static uint32_t got[4],bad[4],msg0[4];	//дֽ,ݴֽ,ǰϢʼʱgot
+static uint8_t ok[4][2],err[4][2];		//ɵϢ,Ϣ
+static uint8_t code[4][2];				//һεĴ
+static uint32_t err_t[4][2];			//һγʱ
+
+static _tp_link *peer(_tp_link *l)
+{
+	return &L[(l-L)^1];
+}
+
+static uint8_t bus_send(_tp_link *l,const uint8_t *data,uint8_t len)
+{
+	_frame *f;
+	if(bus_qh-bus_qt>=bus_cap)return 1;
+	if(len!=8&&len!=12&&len!=16&&len!=20&&len!=24&&len!=32&&len!=48&&len!=64)return 0;	//Ȳ,ᱻյ
+	if(len>(l->dl>8?l->dl:8))return 0;
+	bus_frames++;
+	if(mute[l-L]||((data[0]>>4)==2&&(no_cf||bus_frames==drop_cf)))return 0;
+	f=&bus_q[bus_qh++%QNUM];
+	f->dst=peer(l);
+	memcpy(f->data,data,len);
+	f->len=len;
+	return 0;
+}
+
+//Ҫ͵:(off*7+base)
+static uint8_t src_read(_tp_link *l,uint32_t off,uint8_t *buf,uint16_t len)
+{
+	uint16_t i;
+	if(len>TP_CHUNK)return 1;
+	for(i=0;i<len;i++)buf[i]=(uint8_t)((off+i)*7+l->base);
+	return 0;
+}
+
+static uint8_t dst_write(_tp_link *l,uint32_t off,const uint8_t *buf,uint16_t len)
+{
+	uint16_t i;
+	int k=l-L;
+	if(off!=got[k]-msg0[k])bad[k]++;						//˳д
+	for(i=0;i<len;i++)if(buf[i]!=(uint8_t)((off+i)*7+peer(l)->base))bad[k]++;
+	got[k]+=len;
+	return 0;
+}
+
+static void done(_tp_link *l,uint8_t dir,uint8_t e)
+{
+	int k=l-L;
+	if(e)
+	{
+		err[k][dir]++;
+		code[k][dir]=e;
+		err_t[k][dir]=now;
+	}
+	else ok[k][dir]++;
+	if(dir==TP_DIR_RX)msg0[k]=got[k];
+}
+
+//us΢:ÿ50usཻ3֡,ٵÿӵtp_poll
+static void run(uint32_t us)
+{
+	uint32_t end=now+us;
+	_frame *f;
+	int i,n;
+	while((int32_t)(now-end)<0)
+	{
+		for(n=0;n<3&&bus_qt!=bus_qh;n++)
+		{
+			f=&bus_q[bus_qt++%QNUM];
+			tp_input(f->dst,f->data,f->len,now);
+		}
+		for(i=0;i<4;i++)tp_poll(&L[i],now);
+		now+=50;
+	}
+}
+
+static void setup(int k,uint32_t tx,uint32_t rx,uint8_t dl,uint8_t bs,uint8_t st,uint8_t base)
+{
+	memset(&L[k],0,sizeof(_tp_link));
+	L[k].tx_id=tx;
+	L[k].rx_id=rx;
+	L[k].flags=dl>8?TP_F_FD|TP_F_BRS:0;
+	L[k].dl=dl;
+	L[k].bs=bs;
+	L[k].stmin=st;
+	L[k].pad=0xCC;
+	L[k].send=bus_send;
+	L[k].read=src_read;
+	L[k].write=dst_write;
+	L[k].done=done;
+	L[k].base=base;
+	tp_init(&L[k]);
+}
+
+//100KBͳ֡(С8),ͬʱCAN FD˫:70KB(STmin 200us)3000ֽ(С4)
+static int test_bulk(void)
+{
+	uint32_t t0=now;
+	setup(0,0x700,0x708,8,8,0,1);
+	setup(1,0x708,0x700,8,8,0,2);
+	setup(2,0x710,0x718,64,0,0xF2,3);
+	setup(3,0x718,0x710,64,4,0,4);
+	CHECK(tp_send(&L[0],100000,now)==0);
+	CHECK(tp_send(&L[0],5,now)==1);								//һͬʱֻһϢ
+	CHECK(tp_send(&L[2],70000,now)==0);
+	CHECK(tp_send(&L[3],3000,now)==0);
+	run(1000);
+	CHECK(tp_busy(&L[0])==1&&tp_busy(&L[1])==2);
+	run(60000000);
+	CHECK(got[1]==100000&&ok[1][TP_DIR_RX]==1&&ok[0][TP_DIR_TX]==1&&bad[1]==0);
+	CHECK(got[3]==70000&&ok[3][TP_DIR_RX]==1&&bad[3]==0);
+	CHECK(got[2]==3000&&ok[2][TP_DIR_RX]==1&&bad[2]==0);
+	CHECK(err_t[3][TP_DIR_RX]==0&&L[0].errs+L[1].errs+L[2].errs+L[3].errs==0);
+	CHECK(tp_busy(&L[0])==0&&tp_busy(&L[1])==0);
+	CHECK(now-t0>(70000/63)*200);								//STmin:֮֡200us
+
+	//֡:ͳ֡5ֽ,CAN FD 40ֽ(0x00 )
+	CHECK(tp_send(&L[0],5,now)==0&&tp_send(&L[2],40,now)==0);
+	run(10000);
+	CHECK(got[1]==100005&&got[3]==70040&&ok[1][TP_DIR_RX]==2&&ok[3][TP_DIR_RX]==2&&bad[1]+bad[3]==0);
+	return 0;
+}
+
+//read/writeΪNULLʱֱӶдtx_data/rx_data,rx_max֡
+static int test_ram(void)
+{
+	static uint8_t src[200],ram[100];
+	int i;
+	for(i=0;i<200;i++)src[i]=(uint8_t)i;
+	setup(0,0x700,0x708,8,8,0,1);
+	setup(1,0x708,0x700,8,8,0,2);
+	L[0].read=NULL;
+	L[0].tx_data=src;
+	L[1].write=NULL;
+	L[1].rx_data=ram;
+	L[1].rx_max=100;
+	memset(ok,0,sizeof(ok));
+	memset(err,0,sizeof(err));
+	CHECK(tp_send(&L[0],100,now)==0);
+	run(100000);
+	CHECK(ok[1][TP_DIR_RX]==1&&memcmp(ram,src,100)==0);
+	CHECK(tp_send(&L[0],200,now)==0);
+	run(100000);
+	CHECK(err[0][TP_DIR_TX]==1&&code[0][TP_DIR_TX]==TP_ERR_OVFLW&&ok[1][TP_DIR_RX]==1);
+	CHECK(tp_busy(&L[0])==0&&tp_busy(&L[1])==0);
+	return 0;
+}
+
+//һ֡:շŴ;ͷһ֡ʱ
+static int test_sn(void)
+{
+	setup(0,0x700,0x708,8,8,0,1);
+	setup(1,0x708,0x700,8,8,0,2);
+	memset(ok,0,sizeof(ok));
+	memset(err,0,sizeof(err));
+	got[1]=msg0[1]=0;
+	bus_frames=0;
+	drop_cf=5;
+	CHECK(tp_send(&L[0],1000,now)==0);
+	run(3000000);
+	drop_cf=0;
+	CHECK(err[1][TP_DIR_RX]==1&&code[1][TP_DIR_RX]==TP_ERR_SN);
+	CHECK(err[0][TP_DIR_TX]==1&&code[0][TP_DIR_TX]==TP_ERR_TIMEOUT);
+	CHECK(got[1]<1000&&bad[1]==0);								//ǰдǶԵ
+
+	//ӻ
+	got[1]=msg0[1]=0;
+	CHECK(tp_send(&L[0],1000,now)==0);
+	run(100000);
+	CHECK(ok[1][TP_DIR_RX]==1&&got[1]==1000&&bad[1]==0);
+	return 0;
+}
+
+//ʱ:շ֡,ͷTP_N_BS;֡,շTP_N_CR
+static int test_timeout(void)
+{
+	uint32_t t0;
+	setup(0,0x700,0x708,8,0,0,1);
+	setup(1,0x708,0x700,8,0,0,2);
+	memset(err,0,sizeof(err));
+	mute[1]=1;
+	t0=now;
+	CHECK(tp_send(&L[0],1000,now)==0);
+	run(TP_N_BS*1000+10000);
+	mute[1]=0;
+	CHECK(err[0][TP_DIR_TX]==1&&code[0][TP_DIR_TX]==TP_ERR_TIMEOUT);
+	CHECK(err_t[0][TP_DIR_TX]-t0>=TP_N_BS*1000&&err_t[0][TP_DIR_TX]-t0<=TP_N_BS*1000+1000);
+	CHECK(err[1][TP_DIR_RX]==1&&code[1][TP_DIR_RX]==TP_ERR_TIMEOUT);	//֮֡û֡
+	CHECK(tp_busy(&L[0])==0&&tp_busy(&L[1])==0);
+
+	//֡:ͷ(ֿ),շ֡ʱ
+	setup(0,0x700,0x708,8,0,0,1);
+	setup(1,0x708,0x700,8,0,0,2);
+	memset(ok,0,sizeof(ok));
+	memset(err,0,sizeof(err));
+	no_cf=1;
+	t0=now;
+	CHECK(tp_send(&L[0],1000,now)==0);
+	run(TP_N_CR*1000+10000);
+	no_cf=0;
+	CHECK(ok[0][TP_DIR_TX]==1);
+	CHECK(err[1][TP_DIR_RX]==1&&code[1][TP_DIR_RX]==TP_ERR_TIMEOUT);
+	CHECK(err_t[1][TP_DIR_RX]-t0>=TP_N_CR*1000&&err_t[1][TP_DIR_RX]-t0<=TP_N_CR*1000+1000);
+	return 0;
+}
+
+//ͻֻܷ1֡:sendط0ʱ´tp_poll
+static int test_busy(void)
+{
+	setup(0,0x700,0x708,8,8,0,1);
+	setup(1,0x708,0x700,8,8,0,2);
+	memset(ok,0,sizeof(ok));
+	got[1]=msg0[1]=0;
+	bus_cap=1;
+	CHECK(tp_send(&L[0],5000,now)==0);
+	run(5000000);
+	bus_cap=QNUM;
+	CHECK(ok[0][TP_DIR_TX]==1&&ok[1][TP_DIR_RX]==1&&got[1]==5000&&bad[1]==0);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_bulk()||test_ram()||test_sn()||test_timeout()||test_busy())return 1;
+	printf("tpcore: ok\n");
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include "isrmon.h"
+#include "usart.h"
+#include "includes.h"
+#include <cpu_core.h>
+//////////////////////////////////////////////////////////////////////////////////	 
+//жӳ/ͳ
+//DWTڼͳSysTickжϽӳ١OSĶ,
+//uC/OS-IIٽ(OS_EXIT_CRITICALô)uC-CPUжʱ
+//:2026/10/19
+//汾V1.0
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#if ISRMON_EN
+static _isrmon_stat isrmon_entry;	//SysTickжϽӳ
+static _isrmon_stat isrmon_jitter;	//OSTimeTickڶ
+static u32 isrmon_last=0;			//һOSTimeTickʱCYCCNT
+static u8 isrmon_first=1;			//1,ûһεʱ
+
+//¼һβ
+//cyc:ӳ(CPU)
+static void isrmon_add(_isrmon_stat *st,u32 cyc)
+{
+	u32 bin;
+	if(cyc<32)bin=0;
+	else 
+	{
+		bin=32-__CLZ(cyc)-5;		//2ݷֵ,32~63Ϊ1
+		if(bin>=ISRMON_HIST_NUM)bin=ISRMON_HIST_NUM-1;
+	}
+	st->hist[bin]++;
+	st->cnt++;
+	if(cyc>st->max)st->max=cyc;
+}
+
+//DWTڼ,ʼuC-CPU(жʱͳƺʱ)
+//ʱӳʼ֮,uC-CPUҪȡںƵ
+void ISRMON_Init(void)
+{
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;	//ʹDWT
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;				//CYCCNT,
+	CPU_Init();
+	ISRMON_Reset();
+}
+
+//SysTickжڵ
+//SysTickΪݼ,0ʱװLOADж,LOAD-VALǴӼ0жϾ
+void ISRMON_TickEnter(void)
+{
+	isrmon_add(&isrmon_entry,SysTick->LOAD-SysTick->VAL);
+}
+
+//OSTimeTick֮ǰ,ͳνֵ֮(LOAD+1)ƫ
+void ISRMON_TickOS(void)
+{
+	u32 now=DWT->CYCCNT;
+	u32 period,nominal;
+	if(isrmon_first==0)
+	{
+		period=now-isrmon_last;
+		nominal=SysTick->LOAD+1;
+		isrmon_add(&isrmon_jitter,period>nominal?period-nominal:nominal-period);
+	}
+	isrmon_first=0;
+	isrmon_last=now;
+}
+
+//ͳƽ
+void ISRMON_Reset(void)
+{
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	memset(&isrmon_entry,0,sizeof(isrmon_entry));
+	memset(&isrmon_jitter,0,sizeof(isrmon_jitter));
+	isrmon_first=1;
+	OS_EXIT_CRITICAL();
+#if OS_INT_DIS_MEAS_EN > 0u
+	OS_CPU_IntDisMeasInit();
+#endif
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+	CPU_IntDisMeasMaxCurReset();
+#endif
+}
+
+//ȡͳƽ
+//entry:SysTickжϽӳ,jitter:OSĶ,ҪĴNULL
+void ISRMON_Get(_isrmon_stat *entry,_isrmon_stat *jitter)
+{
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	if(entry)*entry=isrmon_entry;
+	if(jitter)*jitter=isrmon_jitter;
+	OS_EXIT_CRITICAL();
+}
+
+//һͳ
+static void isrmon_print(const char *name,_isrmon_stat *st)
+{
+	u8 i;
+	_isrmon_stat tmp;
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	tmp=*st;						//һ,ӡбжϸд
+	OS_EXIT_CRITICAL();
+	printf("%s: cnt %u max %u cyc\r\n",name,tmp.cnt,tmp.max);
+	printf("   <%u",32u);
+	for(i=1;i<ISRMON_HIST_NUM-1;i++)printf("  <%u",32u<<i);
+	printf("  >=%u\r\n",32u<<(ISRMON_HIST_NUM-2));
+	for(i=0;i<ISRMON_HIST_NUM;i++)printf(" %6u",tmp.hist[i]);
+	printf("\r\n");
+}
+
+//ͨͳƽ
+void ISRMON_Report(void)
+{
+#if OS_INT_DIS_MEAS_EN > 0u
+	u32 i,n;
+	const char *name,*p;
+	OS_CPU_INT_DIS_SITE site;
+	OS_CPU_SR cpu_sr=0;
+#endif
+	printf("isr monitor (%u MHz):\r\n",SystemCoreClock/1000000);
+	isrmon_print("systick entry latency",&isrmon_entry);
+	isrmon_print("os tick jitter",&isrmon_jitter);
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+	printf("CPU_CRITICAL int disabled: max %u cur max %u cyc\r\n",CPU_IntDisMeasMaxGet(),CPU_IntDisMeasMaxCurGet());
+#endif
+#if OS_INT_DIS_MEAS_EN > 0u
+	printf("OS_ENTER_CRITICAL int disabled: max %u cyc, lost %u\r\n",OS_CPU_IntDisMaxCnts,OS_CPU_IntDisSiteOvf);
+	n=OS_CPU_IntDisSiteNbr;
+	for(i=0;i<n;i++)
+	{
+		OS_ENTER_CRITICAL();
+		site=OS_CPU_IntDisSiteTbl[i];
+		OS_EXIT_CRITICAL();
+		name=site.FileName;			//ֻʾļ,ȥ·
+		for(p=site.FileName;*p;p++)if(*p=='\\'||*p=='/')name=p+1;
+		printf("  %-16s %5u %10u %8u cyc\r\n",name,site.Line,site.Ctr,site.MaxCnts);
+	}
+#endif
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef _ISRMON_H
+#define _ISRMON_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////	 
+//жӳ/ͳ
+//DWTڼͳSysTickжϽӳ١OSĶ,
+//uC/OS-IIٽ(OS_EXIT_CRITICALô)uC-CPUжʱ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ʹ÷:
+//1,ʱӳʼɺISRMON_Init()
+//2,SysTick_HandlerڵISRMON_TickEnter(),OSTimeTick()֮ǰISRMON_TickOS()
+//3,ҪʱISRMON_Report()ͨͳƽ("stats"),ISRMON_Reset()
+//λΪCPU,400Mhz1us=400
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#define ISRMON_EN				1		//0,ر;1,жӳͳ
+#define ISRMON_HIST_NUM			8		//ֱͼ:<32,<64,...,<2048,>=2048
+
+//һӳͳ
+typedef struct
+{
+	u32 cnt;						//
+	u32 max;						//ֵ(CPU)
+	u32 hist[ISRMON_HIST_NUM];		//ֱͼ,iΪ[32<<(i-1),32<<i)
+}_isrmon_stat;
+
+#if ISRMON_EN
+void ISRMON_Init(void);					//DWT,ʼuC-CPUжͳ
+void ISRMON_TickEnter(void);			//SysTickж,ͳƽӳ
+void ISRMON_TickOS(void);				//OSTimeTick֮ǰ,ͳƽĶ
+void ISRMON_Report(void);				//ͳƽ
+void ISRMON_Reset(void);				//ͳƽ
+void ISRMON_Get(_isrmon_stat *entry,_isrmon_stat *jitter);	//ȡͳƽ
+#else
+#define ISRMON_Init()
+#define ISRMON_TickEnter()
+#define ISRMON_TickOS()
+#define ISRMON_Report()
+#define ISRMON_Reset()
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////////
+//жӳ/ͳƵPC,Keil,TOOLS/hosttest.sh:
+//gcc -ITOOLS/host -ISYSTEM/isrmon SYSTEM/isrmon/isrmon_test.c SYSTEM/isrmon/isrmon.c TOOLS/host/os_host.c
+//DWT/SysTickTOOLS/host/sys.hı,ɲ:SysTick->VALģӳ,DWT->CYCCNT+=nģ⾭n
+//ӳٺͽĶֱͼ/ֵٽôͳ(Ƕס),Ͱͬı
+//////////////////////////////////////////////////////////////////////////////////
+#include "isrmon.h"
+#include "includes.h"
+#include <stdio.h>
+
+#define CHECK(c) do{if(!(c)){printf("isrmon: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+
+#define TICK			400000u		//1ms,LOAD=TICK-1
+
+//ģһSysTickж:һνĺ󾭹period,жlatency
+static void tick(u32 period,u32 latency)
+{
+	DWT->CYCCNT+=period;
+	SysTick->VAL=SysTick->LOAD-latency;
+	ISRMON_TickEnter();
+	ISRMON_TickOS();
+}
+
+//ٽ,жcyc;nest!=0ʱһ(ʱ)
+static void crit_a(u32 cyc,u8 nest)
+{
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	DWT->CYCCNT+=cyc/2;
+	if(nest)
+	{
+		OS_CPU_SR cpu_sr=0;
+		OS_ENTER_CRITICAL();
+		DWT->CYCCNT+=10;
+		OS_EXIT_CRITICAL();
+	}
+	DWT->CYCCNT+=cyc-cyc/2-(nest?10:0);
+	OS_EXIT_CRITICAL();
+}
+
+static void crit_b(u32 cyc)
+{
+	OS_CPU_SR cpu_sr=0;
+	OS_ENTER_CRITICAL();
+	DWT->CYCCNT+=cyc;
+	OS_EXIT_CRITICAL();
+}
+
+static int test_tick(void)
+{
+	_isrmon_stat e,j;
+	u32 i;
+	SysTick->LOAD=TICK-1;
+	DWT->CYCCNT=0xFFFF0000u;					//;
+	ISRMON_Init();
+	CHECK(DWT->CTRL&DWT_CTRL_CYCCNTENA_Msk);
+	CHECK(CoreDebug->DEMCR&CoreDebug_DEMCR_TRCENA_Msk);
+	for(i=0;i<1000;i++)tick(TICK,12);			//ûж
+	tick(TICK+40,40);							//40ڽ
+	tick(TICK-40,12);							//һڶ40
+	tick(TICK+5000,5000);						//ߵ
+	ISRMON_Get(&e,&j);
+	CHECK(e.cnt==1003&&e.max==5000);
+	CHECK(e.hist[0]==1001&&e.hist[1]==1&&e.hist[ISRMON_HIST_NUM-1]==1);
+	CHECK(j.cnt==1002&&j.max==5000);			//һνֻ¼ʱ
+	CHECK(j.hist[0]==999&&j.hist[1]==2&&j.hist[ISRMON_HIST_NUM-1]==1);
+	ISRMON_Reset();
+	ISRMON_Get(&e,NULL);
+	CHECK(e.cnt==0&&e.max==0&&e.hist[0]==0);
+	tick(TICK*3,0);								//ResetһνĲ㶶
+	ISRMON_Get(NULL,&j);
+	CHECK(j.cnt==0);
+	return 0;
+}
+
+static int test_crit(void)
+{
+	u32 i;
+	ISRMON_Reset();
+	for(i=0;i<5;i++)crit_a(100+i,0);
+	crit_a(900,1);								//Ƕ:ֻ
+	crit_b(300);
+	CHECK(OS_CPU_IntDisSiteNbr==2);				//ڲOS_EXIT_CRITICAL¼
+	CHECK(OS_CPU_IntDisMaxCnts==900);
+	CHECK(OS_CPU_IntDisSiteTbl[0].Ctr==6&&OS_CPU_IntDisSiteTbl[0].MaxCnts==900);
+	CHECK(OS_CPU_IntDisSiteTbl[1].Ctr==1&&OS_CPU_IntDisSiteTbl[1].MaxCnts==300);
+	CHECK(OS_CPU_IntDisSiteTbl[0].Line!=OS_CPU_IntDisSiteTbl[1].Line);
+	CHECK(OS_CPU_IntDisSiteOvf==0);
+	return 0;
+}
+
+//µĵôֻ
+static int test_full(void)
+{
+	ISRMON_Reset();
+	OS_CPU_IntDisSiteNbr=OS_CPU_INT_DIS_MEAS_SITE_NBR;	//װ
+	crit_b(5000);
+	CHECK(OS_CPU_IntDisSiteOvf==1);
+	CHECK(OS_CPU_IntDisMaxCnts==5000);
+	ISRMON_Reset();
+	CHECK(OS_CPU_IntDisSiteNbr==0&&OS_CPU_IntDisSiteOvf==0&&OS_CPU_IntDisMaxCnts==0);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_tick()||test_crit()||test_full())return 1;
+	ISRMON_Reset();
+	tick(TICK,12);
+	tick(TICK+70,70);
+	crit_a(200,1);
+	crit_b(3000);
+	ISRMON_Report();
+	printf("isrmon: ok (entry latency, tick jitter, critical sections by site)\n");
+	return 0;
+}
@@ -0,0 +1,174 @@
+#include "log.h"
+#include "usart.h"
+#include <lib_str.h>
+//////////////////////////////////////////////////////////////////////////////////	 
+//ʽ
+//ʽṩĻ,ʹö,ָʽʹuC-LIBStr_FmtNbr_Int32U/S
+//:2026/10/19
+//汾V1.0
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#define LOG_NBR_WIDTH_MAX		16		//
+
+//ʼ
+//buf:
+//size:С,Ϊ1(Žβ'\0')
+void log_init(_log_buf *lb,char *buf,u16 size)
+{
+	lb->buf=buf;
+	lb->size=size;
+	lb->len=0;
+	if(size)buf[0]='\0';
+}
+
+//׷һַ,ʱ
+void log_char(_log_buf *lb,char c)
+{
+	if(lb->len+1>=lb->size)return;
+	lb->buf[lb->len++]=c;
+	lb->buf[lb->len]='\0';
+}
+
+//׷ַ
+void log_str(_log_buf *lb,const char *s)
+{
+	if(s==0)s="(null)";
+	while(*s&&lb->len+1<lb->size)lb->buf[lb->len++]=*s++;
+	if(lb->size)lb->buf[lb->len]='\0';
+}
+
+//ʽֲ׷
+//is_signed:1,vals32
+//base:1016
+//width:С,0ʾ
+//pad:ַ,' ''0'
+//lower:1,ʮСдĸ
+static void log_nbr(_log_buf *lb,u32 val,u8 is_signed,u8 base,u8 width,char pad,u8 lower)
+{
+	char tmp[LOG_NBR_WIDTH_MAX+2];
+	CPU_CHAR *p=0;
+	if(width>LOG_NBR_WIDTH_MAX)width=LOG_NBR_WIDTH_MAX;
+	if(width)							//Ȳ,ЧλʱNULL
+	{
+		if(is_signed)p=Str_FmtNbr_Int32S((s32)val,width,base,pad,lower,DEF_YES,tmp);
+		else p=Str_FmtNbr_Int32U(val,width,base,pad,lower,DEF_YES,tmp);
+	}
+	if(p==0)							//,ֻЧλ
+	{
+		if(is_signed)p=Str_FmtNbr_Int32S((s32)val,DEF_INT_32U_NBR_DIG_MAX+1,base,'\0',lower,DEF_YES,tmp);
+		else p=Str_FmtNbr_Int32U(val,DEF_INT_32U_NBR_DIG_MAX,base,'\0',lower,DEF_YES,tmp);
+	}
+	log_str(lb,tmp);
+}
+
+//׷޷ʮ
+void log_u32(_log_buf *lb,u32 val,u8 width,char pad)
+{
+	log_nbr(lb,val,0,10,width,pad,0);
+}
+
+//׷зʮ
+void log_s32(_log_buf *lb,s32 val,u8 width,char pad)
+{
+	log_nbr(lb,(u32)val,1,10,width,pad,0);
+}
+
+//׷ʮ(д,'0')
+void log_hex(_log_buf *lb,u32 val,u8 width)
+{
+	log_nbr(lb,val,0,16,width,'0',0);
+}
+
+//ʽ׷
+//ֵ:еܳ
+u16 log_vprintf(_log_buf *lb,const char *fmt,va_list ap)
+{
+	u8 width;
+	char pad;
+	while(*fmt)
+	{
+		if(*fmt!='%')
+		{
+			log_char(lb,*fmt++);
+			continue;
+		}
+		fmt++;
+		pad=' ';
+		width=0;
+		if(*fmt=='0')
+		{
+			pad='0';
+			fmt++;
+		}
+		while(*fmt>='0'&&*fmt<='9')width=width*10+(*fmt++-'0');
+		if(*fmt=='l')fmt++;
+		switch(*fmt)
+		{
+			case 'd':
+			case 'i':log_nbr(lb,(u32)va_arg(ap,s32),1,10,width,pad,0);break;
+			case 'u':log_nbr(lb,va_arg(ap,u32),0,10,width,pad,0);break;
+			case 'x':log_nbr(lb,va_arg(ap,u32),0,16,width,pad,1);break;
+			case 'X':log_nbr(lb,va_arg(ap,u32),0,16,width,pad,0);break;
+			case 's':log_str(lb,va_arg(ap,const char*));break;
+			case 'c':log_char(lb,(char)va_arg(ap,int));break;
+			case '%':log_char(lb,'%');break;
+			case '\0':return lb->len;		//ʽ'%'β
+			default:						//ֵ֧ĸʽԭ
+				log_char(lb,'%');
+				log_char(lb,*fmt);
+				break;
+		}
+		fmt++;
+	}
+	return lb->len;
+}
+
+//ʽbuf
+//buf:
+//size:С
+//ֵ:ʽĳ(β'\0')
+u16 log_printf(char *buf,u16 size,const char *fmt,...)
+{
+	_log_buf lb;
+	va_list ap;
+	log_init(&lb,buf,size);
+	va_start(ap,fmt);
+	log_vprintf(&lb,fmt,ap);
+	va_end(ap);
+	return lb.len;
+}
+
+//д봮1ͻ,д,
+void log_send(const char *buf,u16 len)
+{
+	usart_write((const u8*)buf,len);
+}
+
+#if LOG_BENCH_EN
+#define LOG_BENCH_NUM			1000	//ÿԵĵô
+
+//ʽٶȲ,DWT,ΪÿεõCPU
+void log_bench(void)
+{
+	static char buf[64];				//̬,ռջ
+	u32 i,t0;
+	u32 cyc_sprintf,cyc_log,cyc_str,cyc_fmt;
+	t0=DWT->CYCCNT;
+	for(i=0;i<LOG_BENCH_NUM;i++)sprintf(buf,"t=%u v=%d id=%08X",i*7919,((s32)i-500)*1000,i);
+	cyc_sprintf=DWT->CYCCNT-t0;
+	t0=DWT->CYCCNT;
+	for(i=0;i<LOG_BENCH_NUM;i++)log_printf(buf,sizeof(buf),"t=%u v=%d id=%08X",i*7919,((s32)i-500)*1000,i);
+	cyc_log=DWT->CYCCNT-t0;
+	t0=DWT->CYCCNT;
+	for(i=0;i<LOG_BENCH_NUM;i++)sprintf(buf,"%u",i*7919);
+	cyc_str=DWT->CYCCNT-t0;
+	t0=DWT->CYCCNT;
+	for(i=0;i<LOG_BENCH_NUM;i++)Str_FmtNbr_Int32U(i*7919,DEF_INT_32U_NBR_DIG_MAX,10,'\0',DEF_NO,DEF_YES,buf);
+	cyc_fmt=DWT->CYCCNT-t0;
+	printf("fmt bench (cyc/call):\r\n");
+	printf("  sprintf line       %6u\r\n",cyc_sprintf/LOG_BENCH_NUM);
+	printf("  log_printf line    %6u\r\n",cyc_log/LOG_BENCH_NUM);
+	printf("  sprintf %%u         %6u\r\n",cyc_str/LOG_BENCH_NUM);
+	printf("  Str_FmtNbr_Int32U  %6u\r\n",cyc_fmt/LOG_BENCH_NUM);
+}
+#endif
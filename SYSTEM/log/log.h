@@ -0,0 +1,42 @@
+#ifndef _LOG_H
+#define _LOG_H
+#include "sys.h"
+#include <stdarg.h>
+//////////////////////////////////////////////////////////////////////////////////	 
+//ʽ
+//ʽṩĻ,ʹö,ָʽʹuC-LIBStr_FmtNbr_Int32U/S
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ʹ÷:
+//1,log_printf(buf,sizeof(buf),"t=%u id=%08X\r\n",t,id)ʽbuf,س
+//  ֧%d %i %u %x %X %s %c %%,ֿɴȺ'0'(%5d,%08X),'l'η
+//2,Բÿɱ:log_init(),εlog_str/log_u32/log_s32/log_hex
+//3,ʱض,'\0'β
+//4,log_send()Ѹʽд봮1ͻ()
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#define LOG_BENCH_EN			1		//0,ر;1,ʽٶȲ("bench")
+
+//
+typedef struct
+{
+	char *buf;				//,ɵṩ
+	u16 size;				//С(β'\0')
+	u16 len;				//д볤(β'\0')
+}_log_buf;
+
+void log_init(_log_buf *lb,char *buf,u16 size);
+void log_char(_log_buf *lb,char c);
+void log_str(_log_buf *lb,const char *s);
+void log_u32(_log_buf *lb,u32 val,u8 width,char pad);
+void log_s32(_log_buf *lb,s32 val,u8 width,char pad);
+void log_hex(_log_buf *lb,u32 val,u8 width);
+u16 log_vprintf(_log_buf *lb,const char *fmt,va_list ap);
+u16 log_printf(char *buf,u16 size,const char *fmt,...);
+void log_send(const char *buf,u16 len);
+#if LOG_BENCH_EN
+void log_bench(void);
+#endif
+
+#endif
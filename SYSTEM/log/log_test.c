@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////////
+//log_printfPC,Keil,TOOLS/hosttest.sh:
+//gcc -ITOOLS/host -ISYSTEM/log <uC-LIBͷļĿ¼> SYSTEM/log/log_test.c SYSTEM/log/log.c lib_str.c lib_ascii.c
+//CsnprintfȽ:ֿ/롢Сض;"bench"ʱȽٶ
+//////////////////////////////////////////////////////////////////////////////////
+#include "log.h"
+#include "usart.h"
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+static char sent[64];							//log_sendд
+static u16 sent_len;
+
+//洮1
+void usart_write(const u8 *buf,u16 len)
+{
+	memcpy(sent,buf,len);
+	sent_len=len;
+}
+
+//snprintfһʽ
+static int check(const char *a,const char *b,const char *fmt)
+{
+	if(strcmp(a,b)==0)return 0;
+	printf("log: FAILED fmt \"%s\": \"%s\" != \"%s\"\n",fmt,a,b);
+	return 1;
+}
+
+static int test_printf(void)
+{
+	static const char *f0="t=%u v=%d id=%08X";
+	static const char *f1="%5d|%05d|%x|%3X|%s|%c|%%|%lu";
+	static const char *f2="%1u %0d %12d %i";
+	char a[64],b[64];
+	int i;
+	u32 u;
+	for(i=-300000;i<300000;i+=7)
+	{
+		u=(u32)i*2654435761u;
+		log_printf(a,64,f0,u,i,u);
+		snprintf(b,64,f0,u,i,u);
+		if(check(a,b,f0))return 1;
+		log_printf(a,64,f1,i%100000,i%1000,u,u&0xff,"ab",'z',u);
+		snprintf(b,64,f1,i%100000,i%1000,u,u&0xff,"ab",'z',(unsigned long)u);
+		if(check(a,b,f1))return 1;
+		log_printf(a,64,f2,u,i,i*7000,-i);
+		snprintf(b,64,f2,u,i,i*7000,-i);
+		if(check(a,b,f2))return 1;
+		log_printf(a,10,f0,u,i,u);				//ض
+		snprintf(b,10,f0,u,i,u);
+		if(check(a,b,f0))return 1;
+	}
+	log_printf(a,64,"%d %5d %011d",(s32)0x80000000,(s32)0x80000000,(s32)0x80000000);
+	snprintf(b,64,"%d %5d %011d",(int)0x80000000,(int)0x80000000,(int)0x80000000);
+	if(check(a,b,"%d %5d %011d"))return 1;
+	if(log_printf(a,1,"%u",123)!=0||a[0]!='\0')return check(a,"","size 1");
+	log_printf(a,64,"%s|%q|%",(char*)0);		//ָ롢ֵ֧ĸʽβ'%'
+	if(check(a,"(null)|%q|","%s|%q|%"))return 1;
+	return 0;
+}
+
+static int test_append(void)
+{
+	_log_buf lb;
+	char a[32];
+	log_init(&lb,a,sizeof(a));
+	log_str(&lb,"id=");
+	log_hex(&lb,0xBEEF,8);
+	log_char(&lb,' ');
+	log_u32(&lb,42,5,' ');
+	log_s32(&lb,-7,3,'0');
+	if(check(a,"id=0000BEEF    42-07","append"))return 1;
+	log_send(a,lb.len);
+	if(sent_len!=lb.len||memcmp(sent,a,sent_len))return check("log_send","","log_send");
+	return 0;
+}
+
+//snprintfȽٶ,Ϊÿεõns
+static void bench(void)
+{
+	static const char *f="t=%u v=%d id=%08X";
+	char buf[64];
+	u32 i,n=2000000,sink=0;
+	double t_log,t_lib;
+	clock_t t0;
+	t0=clock();
+	for(i=0;i<n;i++)sink+=log_printf(buf,sizeof(buf),f,i*7919,((s32)i-500)*1000,i);
+	t_log=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	t0=clock();
+	for(i=0;i<n;i++)sink+=snprintf(buf,sizeof(buf),f,i*7919,((s32)i-500)*1000,i);
+	t_lib=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	printf("log bench (ns/call): log_printf %.1f, snprintf %.1f (%u)\n",t_log*1e9/n,t_lib*1e9/n,sink&1);
+}
+
+int main(int argc,char **argv)
+{
+	if(test_printf()||test_append())return 1;
+	printf("log: ok\n");
+	if(argc>1&&strcmp(argv[1],"bench")==0)bench();
+	return 0;
+}
@@ -0,0 +1,270 @@
+#include "memmon.h"
+#include "malloc.h"
+#include "usart.h"
+//////////////////////////////////////////////////////////////////////////////////
+//ڴʹͳ
+//ALIENTEK malloc6ڴ(bank)uC-LIBڴ(Mem_Seg)/̬ڴ(Mem_Pool)/
+//̬ڴ(Mem_DynPool)Ǽǵͬһű,ͳһáֵƬ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if MEMMON_EN
+#define MEMMON_TYPE_SEG			0		//uC-LIBڴ
+#define MEMMON_TYPE_POOL		1		//uC-LIB̬ڴ
+#define MEMMON_TYPE_DYNPOOL		2		//uC-LIB̬ڴ
+
+//һǼǵuC-LIBڴ/ڴ
+typedef struct
+{
+	const char *name;
+	u8 type;
+	void *obj;						//MEM_SEG/MEM_POOL/MEM_DYN_POOLָ
+	u32 peak;						//ֵֽ(ͳʱ)
+}_memmon_reg;
+
+//һ
+typedef struct
+{
+	const char *name;
+	const char *type;
+	u32 base;						//ʼַ,MEMMON_NOADDRʾ(̬ڴ)
+	u32 size;						//(ֽ),0ʾ
+	u32 used;						//(ֽ)
+	u32 peak;						//ֵ(ֽ)
+	u16 frag;						//Ƭ(0.1%)
+}_memmon_info;
+
+#define MEMMON_NOADDR		0xFFFFFFFF							//ûй̶ַ,ʱ
+#define MEMMON_INFO_NUM		(SRAMBANK+3+MEMMON_ENTRY_NUM*2)	//mallocڴ++ڴ+ڴ
+
+static _memmon_reg memmon_reg[MEMMON_ENTRY_NUM];
+static u8 memmon_regnum=0;
+static _memmon_info memmon_info[MEMMON_INFO_NUM];	//ջֻ512ֽ,ھ̬
+static u8 memmon_infonum;
+
+static const char *const memmon_bankname[SRAMBANK]={"SRAMIN","SRAMEX","SRAM12","SRAM4","SRAMDTCM","SRAMITCM"};
+
+extern MEM_SEG *Mem_SegHeadPtr;		//lib_mem.cеڴͷ
+#if (LIB_MEM_CFG_HEAP_SIZE > 0u)
+extern MEM_SEG Mem_SegHeap;			//lib_mem.cеĶڴ
+#endif
+
+#if MEMMON_MAP_EN
+//KeilĬϷɢļ(δָscatterļ)ɵ
+extern u32 Image$$ER_IROM1$$Base;
+extern u32 Image$$ER_IROM1$$Limit;
+extern u32 Image$$RW_IRAM1$$Base;
+extern u32 Image$$RW_IRAM1$$ZI$$Limit;
+extern u32 Image$$RW_IRAM2$$Base;
+extern u32 Image$$RW_IRAM2$$ZI$$Limit;
+#endif
+
+//ʼ,uC-LIBǼǱ
+//mallocڴع̶ͳ,ҪǼ
+void MEMMON_Init(void)
+{
+	memmon_regnum=0;
+}
+
+//Ǽһ
+//ֵ:0,ɹ;1,ǼǱ
+static u8 memmon_reg_add(const char *name,u8 type,void *obj)
+{
+	u8 i;
+	for(i=0;i<memmon_regnum;i++)
+	{
+		if(memmon_reg[i].obj==obj)			//ѾǼǹ,ֻ
+		{
+			memmon_reg[i].name=name;
+			return 0;
+		}
+	}
+	if(memmon_regnum>=MEMMON_ENTRY_NUM)return 1;
+	memmon_reg[memmon_regnum].name=name;
+	memmon_reg[memmon_regnum].type=type;
+	memmon_reg[memmon_regnum].obj=obj;
+	memmon_reg[memmon_regnum].peak=0;
+	memmon_regnum++;
+	return 0;
+}
+
+//uC-LIBڴ,ڴβǼҲͳ
+//ֵ:0,ɹ;1,ǼǱ
+u8 MEMMON_RegSeg(const char *name,MEM_SEG *seg)
+{
+	return memmon_reg_add(name,MEMMON_TYPE_SEG,seg);
+}
+
+//ǼuC-LIB̬ڴ(Mem_PoolCreate)
+//ֵ:0,ɹ;1,ǼǱ
+u8 MEMMON_RegPool(const char *name,MEM_POOL *pool)
+{
+	return memmon_reg_add(name,MEMMON_TYPE_POOL,pool);
+}
+
+//ǼuC-LIB̬ڴ(Mem_DynPoolCreate)
+//ֵ:0,ɹ;1,ǼǱ
+u8 MEMMON_RegDynPool(const char *name,MEM_DYN_POOL *pool)
+{
+	return memmon_reg_add(name,MEMMON_TYPE_DYNPOOL,pool);
+}
+
+//һ
+static _memmon_info *memmon_info_add(const char *name,const char *type,u32 base,u32 size)
+{
+	_memmon_info *info;
+	if(memmon_infonum>=MEMMON_INFO_NUM)return NULL;
+	info=&memmon_info[memmon_infonum++];
+	info->name=name;
+	info->type=type;
+	info->base=base;
+	info->size=size;
+	info->used=0;
+	info->peak=0;
+	info->frag=0;
+	return info;
+}
+
+//ҵǼ
+static _memmon_reg *memmon_reg_find(void *obj)
+{
+	u8 i;
+	for(i=0;i<memmon_regnum;i++)if(memmon_reg[i].obj==obj)return &memmon_reg[i];
+	return NULL;
+}
+
+//ռmallocڴ
+static void memmon_collect_bank(void)
+{
+	_memmon_info *info;
+	u32 free,maxfree;
+	u8 i;
+	for(i=0;i<SRAMBANK;i++)
+	{
+		info=memmon_info_add(memmon_bankname[i],mallco_dev.memrdy[i]?"bank":"bank(off)",(u32)mallco_dev.membase[i],memtblsize[i]*memblksize[i]);
+		if(info==NULL||!mallco_dev.memrdy[i])continue;	//δʼڴ(SDRAMδʼ)ܶڴ
+		info->used=memused[i]*memblksize[i];
+		info->peak=mempeak[i]*memblksize[i];
+		free=memtblsize[i]-memused[i];
+		maxfree=my_mem_maxfree(i);
+		if(free)info->frag=1000-maxfree*1000/free;
+	}
+}
+
+//ռuC-LIBڴ,ֱӱ
+static void memmon_collect_seg(void)
+{
+	_memmon_info *info;
+	_memmon_reg *reg;
+	MEM_SEG *seg;
+	MEM_SEG_INFO seginfo;
+	LIB_ERR err;
+	const char *name;
+	for(seg=Mem_SegHeadPtr;seg!=NULL;seg=seg->NextPtr)
+	{
+		reg=memmon_reg_find(seg);
+		if(reg!=NULL)name=reg->name;
+#if (LIB_MEM_CFG_HEAP_SIZE > 0u)
+		else if(seg==&Mem_SegHeap)name="Mem_Heap";
+#endif
+		else name="Mem_Seg";
+		Mem_SegRemSizeGet(seg,1,&seginfo,&err);
+		info=memmon_info_add(name,"seg",seginfo.AddrBase,seginfo.TotalSize);
+		if(info==NULL)return;
+		info->used=seginfo.UsedSize;
+		info->peak=seginfo.UsedSize;		//ڴֻ䲻ͷ,üֵ
+	}
+}
+
+//ռǼǵuC-LIBڴ,ֵ
+static void memmon_collect_pool(void)
+{
+	_memmon_info *info;
+	MEM_POOL *pool;
+	MEM_DYN_POOL *dynpool;
+	u8 i;
+	for(i=0;i<memmon_regnum;i++)
+	{
+		if(memmon_reg[i].type==MEMMON_TYPE_POOL)
+		{
+			pool=(MEM_POOL*)memmon_reg[i].obj;
+			info=memmon_info_add(memmon_reg[i].name,"pool",(u32)pool->PoolAddrStart,pool->BlkNbr*pool->BlkSize);
+			if(info==NULL)return;
+			info->used=(pool->BlkNbr-pool->BlkFreeTblIx)*pool->BlkSize;
+		}else if(memmon_reg[i].type==MEMMON_TYPE_DYNPOOL)
+		{
+			dynpool=(MEM_DYN_POOL*)memmon_reg[i].obj;
+			info=memmon_info_add(memmon_reg[i].name,"dynpool",MEMMON_NOADDR,dynpool->BlkQtyMax*dynpool->BlkSize);
+			if(info==NULL)return;
+			info->used=dynpool->BlkAllocCnt*dynpool->BlkSize;	//ʱuC-LIBͳѷ,Ϊ0
+		}else continue;
+		if(info->used>memmon_reg[i].peak)memmon_reg[i].peak=info->used;
+		info->peak=memmon_reg[i].peak;
+	}
+}
+
+//ռ,=BaseZIν
+static void memmon_collect_link(void)
+{
+#if MEMMON_MAP_EN
+	_memmon_info *info;
+	info=memmon_info_add("ER_IROM1","link",(u32)&Image$$ER_IROM1$$Base,MEMMON_IROM1_SIZE);
+	if(info!=NULL)info->used=info->peak=(u32)&Image$$ER_IROM1$$Limit-info->base;
+	info=memmon_info_add("RW_IRAM1","link",(u32)&Image$$RW_IRAM1$$Base,MEMMON_IRAM1_SIZE);
+	if(info!=NULL)info->used=info->peak=(u32)&Image$$RW_IRAM1$$ZI$$Limit-info->base;
+	info=memmon_info_add("RW_IRAM2","link",(u32)&Image$$RW_IRAM2$$Base,MEMMON_IRAM2_SIZE);
+	if(info!=NULL)info->used=info->peak=(u32)&Image$$RW_IRAM2$$ZI$$Limit-info->base;
+#endif
+}
+
+//ռĸ
+static void memmon_print(void)
+{
+	_memmon_info *info;
+	u8 i;
+	printf("  %-10s %-9s %-10s %-10s %9s %9s %9s %5s\r\n","name","type","base","end","size","used","peak","frag");
+	for(i=0;i<memmon_infonum;i++)
+	{
+		info=&memmon_info[i];
+		printf("  %-10s %-9s ",info->name,info->type);
+		if(info->base!=MEMMON_NOADDR)printf("0x%08X ",info->base);
+		else printf("%-10s ","-");
+		if(info->base!=MEMMON_NOADDR&&info->size)printf("0x%08X ",info->base+info->size-1);
+		else printf("%-10s ","-");
+		printf("%9u %9u %9u %3u.%u%%\r\n",info->size,info->used,info->peak,info->frag/10,info->frag%10);
+	}
+}
+
+//ַ˳ڴ沼(mapļ),
+//ʱһ,ڼAXI/DTCM/SRAM1~4/SDRAMеķֲ
+void MEMMON_Map(void)
+{
+	_memmon_info tmp;
+	u8 i,j;
+	memmon_infonum=0;
+	memmon_collect_link();
+	memmon_collect_bank();
+	memmon_collect_seg();
+	memmon_collect_pool();
+	for(i=1;i<memmon_infonum;i++)			//,ʼַС
+	{
+		tmp=memmon_info[i];
+		for(j=i;j>0&&memmon_info[j-1].base>tmp.base;j--)memmon_info[j]=memmon_info[j-1];
+		memmon_info[j]=tmp;
+	}
+	printf("memory map:\r\n");
+	memmon_print();
+}
+
+//ڴʹ,mallocڴءuC-LIBڴΡuC-LIBڴص˳
+void MEMMON_Report(void)
+{
+	memmon_infonum=0;
+	memmon_collect_bank();
+	memmon_collect_seg();
+	memmon_collect_pool();
+	printf("memory usage:\r\n");
+	memmon_print();
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef _MEMMON_H
+#define _MEMMON_H
+#include "sys.h"
+#include <lib_mem.h>
+//////////////////////////////////////////////////////////////////////////////////	 
+//ڴʹͳ
+//ALIENTEK malloc6ڴ(bank)uC-LIBڴ(Mem_Seg)/̬ڴ(Mem_Pool)/
+//̬ڴ(Mem_DynPool)Ǽǵͬһű,ͳһáֵƬ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ʹ÷:
+//1,Mem_Init()֮MEMMON_Init(),mallocڴغuC-LIBڴ(Ӷҳ)ҪǼ
+//2,ӦôuC-LIBڴMEMMON_RegPool()/MEMMON_RegDynPool()Ǽ,ڴοMEMMON_RegSeg()
+//3,ʱMEMMON_Map()ַ˳mapļڴ沼
+//4,ҪʱMEMMON_Report()ͳƽ("mem")
+//Ƭ=1-/ܿ,λ0.1%;mallocڴطֵʱ,uC-LIBڴطֵÿͳʱ
+////////////////////////////////////////////////////////////////////////////////// 	
+
+#define MEMMON_EN				1		//0,ر;1,ڴʹͳ
+#define MEMMON_ENTRY_NUM		12		//ǼǵuC-LIBڴ/ڴظ
+#define MEMMON_MAP_EN			1		//0,;1,MEMMON_Map()KeilĬϷɢصER_IROM1/RW_IRAM1/RW_IRAM2
+
+#define MEMMON_IROM1_SIZE		0x200000	//ƬFLASHС,͹Targetһ
+#define MEMMON_IRAM1_SIZE		0x20000		//IRAM1(DTCM)С
+#define MEMMON_IRAM2_SIZE		0x80000		//IRAM2(AXI SRAM)С
+
+#if MEMMON_EN
+void MEMMON_Init(void);										//ʼ,յǼǱ
+u8 MEMMON_RegSeg(const char *name,MEM_SEG *seg);			//uC-LIBڴ
+u8 MEMMON_RegPool(const char *name,MEM_POOL *pool);			//ǼuC-LIB̬ڴ
+u8 MEMMON_RegDynPool(const char *name,MEM_DYN_POOL *pool);	//ǼuC-LIB̬ڴ
+void MEMMON_Map(void);										//ַ˳ڴ沼
+void MEMMON_Report(void);									//ڴʹ
+#else
+#define MEMMON_Init()
+#define MEMMON_RegSeg(name,seg)			0
+#define MEMMON_RegPool(name,pool)		0
+#define MEMMON_RegDynPool(name,pool)	0
+#define MEMMON_Map()
+#define MEMMON_Report()
+#endif
+
+#endif
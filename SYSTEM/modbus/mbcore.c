@@ -0,0 +1,337 @@
+#include "mbcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//Modbus RTUЭ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+//CRC16(ʽ0xA001,ֵ0xFFFF),ÿֽڲһα
+static const uint16_t mb_crc_tab[256]=
+{
+	0x0000,0xC0C1,0xC181,0x0140,0xC301,0x03C0,0x0280,0xC241,
+	0xC601,0x06C0,0x0780,0xC741,0x0500,0xC5C1,0xC481,0x0440,
+	0xCC01,0x0CC0,0x0D80,0xCD41,0x0F00,0xCFC1,0xCE81,0x0E40,
+	0x0A00,0xCAC1,0xCB81,0x0B40,0xC901,0x09C0,0x0880,0xC841,
+	0xD801,0x18C0,0x1980,0xD941,0x1B00,0xDBC1,0xDA81,0x1A40,
+	0x1E00,0xDEC1,0xDF81,0x1F40,0xDD01,0x1DC0,0x1C80,0xDC41,
+	0x1400,0xD4C1,0xD581,0x1540,0xD701,0x17C0,0x1680,0xD641,
+	0xD201,0x12C0,0x1380,0xD341,0x1100,0xD1C1,0xD081,0x1040,
+	0xF001,0x30C0,0x3180,0xF141,0x3300,0xF3C1,0xF281,0x3240,
+	0x3600,0xF6C1,0xF781,0x3740,0xF501,0x35C0,0x3480,0xF441,
+	0x3C00,0xFCC1,0xFD81,0x3D40,0xFF01,0x3FC0,0x3E80,0xFE41,
+	0xFA01,0x3AC0,0x3B80,0xFB41,0x3900,0xF9C1,0xF881,0x3840,
+	0x2800,0xE8C1,0xE981,0x2940,0xEB01,0x2BC0,0x2A80,0xEA41,
+	0xEE01,0x2EC0,0x2F80,0xEF41,0x2D00,0xEDC1,0xEC81,0x2C40,
+	0xE401,0x24C0,0x2580,0xE541,0x2700,0xE7C1,0xE681,0x2640,
+	0x2200,0xE2C1,0xE381,0x2340,0xE101,0x21C0,0x2080,0xE041,
+	0xA001,0x60C0,0x6180,0xA141,0x6300,0xA3C1,0xA281,0x6240,
+	0x6600,0xA6C1,0xA781,0x6740,0xA501,0x65C0,0x6480,0xA441,
+	0x6C00,0xACC1,0xAD81,0x6D40,0xAF01,0x6FC0,0x6E80,0xAE41,
+	0xAA01,0x6AC0,0x6B80,0xAB41,0x6900,0xA9C1,0xA881,0x6840,
+	0x7800,0xB8C1,0xB981,0x7940,0xBB01,0x7BC0,0x7A80,0xBA41,
+	0xBE01,0x7EC0,0x7F80,0xBF41,0x7D00,0xBDC1,0xBC81,0x7C40,
+	0xB401,0x74C0,0x7580,0xB541,0x7700,0xB7C1,0xB681,0x7640,
+	0x7200,0xB2C1,0xB381,0x7340,0xB101,0x71C0,0x7080,0xB041,
+	0x5000,0x90C1,0x9181,0x5140,0x9301,0x53C0,0x5280,0x9241,
+	0x9601,0x56C0,0x5780,0x9741,0x5500,0x95C1,0x9481,0x5440,
+	0x9C01,0x5CC0,0x5D80,0x9D41,0x5F00,0x9FC1,0x9E81,0x5E40,
+	0x5A00,0x9AC1,0x9B81,0x5B40,0x9901,0x59C0,0x5880,0x9841,
+	0x8801,0x48C0,0x4980,0x8941,0x4B00,0x8BC1,0x8A81,0x4A40,
+	0x4E00,0x8EC1,0x8F81,0x4F40,0x8D01,0x4DC0,0x4C80,0x8C41,
+	0x4400,0x84C1,0x8581,0x4540,0x8701,0x47C0,0x4680,0x8641,
+	0x8201,0x42C0,0x4380,0x8341,0x4100,0x81C1,0x8081,0x4040
+};
+
+//CRC16,ԴCRC֡Ϊ0
+//buf:
+//len:
+//ֵ:CRC,ʱֽǰ
+uint16_t mb_crc16(const uint8_t *buf,uint16_t len)
+{
+	uint16_t crc=0xFFFF;
+	while(len--)crc=(crc>>8)^mb_crc_tab[(crc^*buf++)&0xFF];
+	return crc;
+}
+
+//3.5ַľĬʱ,ÿַ11λ(ʼλ+8λ+У/ڶֹͣλ+ֹͣλ)
+//ʸ19200ʱЭ涨̶Ϊ1.75ms
+//baud:
+//ֵ:λ
+uint16_t mb_t35_bits(uint32_t baud)
+{
+	if(baud>19200)return (uint16_t)((baud*7+3999)/4000);	//1.75ms
+	return 39;												//3.5*11=38.5
+}
+
+static uint16_t mb_get16(const uint8_t *p)
+{
+	return (uint16_t)(p[0]<<8|p[1]);
+}
+
+static void mb_put16(uint8_t *p,uint16_t v)
+{
+	p[0]=v>>8;
+	p[1]=v&0xFF;
+}
+
+//֡βCRC
+//ֵ:CRCĳ
+static uint16_t mb_put_crc(uint8_t *buf,uint16_t len)
+{
+	uint16_t crc=mb_crc16(buf,len);
+	buf[len]=crc&0xFF;
+	buf[len+1]=crc>>8;
+	return len+2;
+}
+
+//λĵiλ
+static uint8_t mb_get_bit(const uint8_t *bits,uint16_t i)
+{
+	return (bits[i>>3]>>(i&7))&1;
+}
+
+static void mb_set_bit(uint8_t *bits,uint16_t i,uint8_t v)
+{
+	if(v)bits[i>>3]|=1<<(i&7);
+	else bits[i>>3]&=~(1<<(i&7));
+}
+
+//ڼĴҰ[addr,addr+num)һ,һζдܿ
+//ֵ:ҵĶ,NULLʾַڱ
+static const _mb_map *mb_find(const _mb_map *map,uint8_t n,uint8_t type,uint16_t addr,uint16_t num)
+{
+	uint8_t i;
+	for(i=0;i<n;i++)
+	{
+		if(map[i].type!=type||addr<map[i].start)continue;
+		if((uint32_t)addr+num<=(uint32_t)map[i].start+map[i].num)return &map[i];
+	}
+	return 0;
+}
+
+//ִһ,Ӧݲ(rsp+2ʼ)
+//req:,CRC
+//len:󳤶,CRC
+//rlen:Ӧ𳤶,CRC
+//ֵ:0,ɹ;,쳣
+static uint8_t mb_exec(const _mb_map *map,uint8_t n,const uint8_t *req,uint16_t len,uint8_t *rsp,uint16_t *rlen)
+{
+	const _mb_map *m;
+	uint8_t fc=req[1];
+	uint16_t addr,num,i,off,bc;
+	uint16_t *reg;
+	uint8_t *bit;
+	if(len<6)												//̫,֧ʱݷǷӦ
+	{
+		if((fc>=MB_FC_READ_COILS&&fc<=MB_FC_WRITE_REG)||fc==MB_FC_WRITE_COILS||fc==MB_FC_WRITE_REGS)return MB_EX_VALUE;
+		return MB_EX_FUNCTION;
+	}
+	addr=mb_get16(req+2);
+	num=mb_get16(req+4);
+	switch(fc)
+	{
+		case MB_FC_READ_COILS:
+		case MB_FC_READ_DISCRETE:
+			if(len!=6||num==0||num>MB_READ_BITS_MAX)return MB_EX_VALUE;
+			m=mb_find(map,n,fc==MB_FC_READ_COILS?MB_COIL:MB_DISCRETE,addr,num);
+			if(m==0)return MB_EX_ADDRESS;
+			bit=(uint8_t*)m->data;
+			off=addr-m->start;
+			bc=(num+7)/8;
+			rsp[2]=(uint8_t)bc;
+			for(i=0;i<bc;i++)rsp[3+i]=0;
+			for(i=0;i<num;i++)if(mb_get_bit(bit,off+i))rsp[3+(i>>3)]|=1<<(i&7);
+			*rlen=3+bc;
+			return 0;
+		case MB_FC_READ_HOLDING:
+		case MB_FC_READ_INPUT:
+			if(len!=6||num==0||num>MB_READ_REGS_MAX)return MB_EX_VALUE;
+			m=mb_find(map,n,fc==MB_FC_READ_HOLDING?MB_HOLDING:MB_INPUT,addr,num);
+			if(m==0)return MB_EX_ADDRESS;
+			reg=(uint16_t*)m->data+(addr-m->start);
+			rsp[2]=(uint8_t)(num*2);
+			for(i=0;i<num;i++)mb_put16(rsp+3+i*2,reg[i]);
+			*rlen=3+num*2;
+			return 0;
+		case MB_FC_WRITE_COIL:
+			if(len!=6||(num!=0xFF00&&num!=0))return MB_EX_VALUE;
+			m=mb_find(map,n,MB_COIL,addr,1);
+			if(m==0)return MB_EX_ADDRESS;
+			mb_set_bit((uint8_t*)m->data,addr-m->start,num!=0);
+			if(m->write&&m->write(addr,1))return MB_EX_FAILURE;
+			for(i=2;i<6;i++)rsp[i]=req[i];			//ԭ
+			*rlen=6;
+			return 0;
+		case MB_FC_WRITE_REG:
+			if(len!=6)return MB_EX_VALUE;
+			m=mb_find(map,n,MB_HOLDING,addr,1);
+			if(m==0)return MB_EX_ADDRESS;
+			((uint16_t*)m->data)[addr-m->start]=num;
+			if(m->write&&m->write(addr,1))return MB_EX_FAILURE;
+			for(i=2;i<6;i++)rsp[i]=req[i];
+			*rlen=6;
+			return 0;
+		case MB_FC_WRITE_COILS:
+			bc=(num+7)/8;
+			if(len<7||num==0||num>MB_WRITE_BITS_MAX||req[6]!=bc||len!=7+bc)return MB_EX_VALUE;
+			m=mb_find(map,n,MB_COIL,addr,num);
+			if(m==0)return MB_EX_ADDRESS;
+			off=addr-m->start;
+			for(i=0;i<num;i++)mb_set_bit((uint8_t*)m->data,off+i,mb_get_bit(req+7,i));
+			if(m->write&&m->write(addr,num))return MB_EX_FAILURE;
+			for(i=2;i<6;i++)rsp[i]=req[i];			//صַ
+			*rlen=6;
+			return 0;
+		case MB_FC_WRITE_REGS:
+			if(len<7||num==0||num>MB_WRITE_REGS_MAX||req[6]!=num*2||len!=7+num*2)return MB_EX_VALUE;
+			m=mb_find(map,n,MB_HOLDING,addr,num);
+			if(m==0)return MB_EX_ADDRESS;
+			reg=(uint16_t*)m->data+(addr-m->start);
+			for(i=0;i<num;i++)reg[i]=mb_get16(req+7+i*2);
+			if(m->write&&m->write(addr,num))return MB_EX_FAILURE;
+			for(i=2;i<6;i++)rsp[i]=req[i];
+			*rlen=6;
+			return 0;
+	}
+	return MB_EX_FUNCTION;
+}
+
+//վһ
+//map:Ĵ
+//n:Ĵ
+//addr:վַ(1~247)
+//req:յ֡(CRC)
+//len:֡
+//rsp:Ӧ𻺳,MB_ADU_MAXֽ
+//ֵ:Ӧ𳤶(CRC),0ʾӦ(CRC󡢲ǷվĻǹ㲥)
+uint16_t mb_slave(const _mb_map *map,uint8_t n,uint8_t addr,const uint8_t *req,uint16_t len,uint8_t *rsp)
+{
+	uint16_t rlen=0;
+	uint8_t ex;
+	if(len<4||mb_crc16(req,len)!=0)return 0;
+	if(req[0]!=addr&&req[0]!=0)return 0;
+	if(req[0]==0&&req[1]!=MB_FC_WRITE_COIL&&req[1]!=MB_FC_WRITE_REG&&req[1]!=MB_FC_WRITE_COILS&&req[1]!=MB_FC_WRITE_REGS)return 0;//㲥ֻд
+	rsp[0]=addr;
+	rsp[1]=req[1];
+	ex=mb_exec(map,n,req,len-2,rsp,&rlen);
+	if(req[0]==0)return 0;					//㲥Ӧ
+	if(ex)
+	{
+		rsp[1]=req[1]|0x80;
+		rsp[2]=ex;
+		rlen=3;
+	}
+	return mb_put_crc(rsp,rlen);
+}
+
+//ɶ
+//buf:󻺳,8ֽ
+//slave:վַ
+//fc:MB_FC_READ_COILS/MB_FC_READ_DISCRETE/MB_FC_READ_HOLDING/MB_FC_READ_INPUT
+//addr:ʼַ
+//num:
+//ֵ:󳤶(CRC)
+uint16_t mb_req_read(uint8_t *buf,uint8_t slave,uint8_t fc,uint16_t addr,uint16_t num)
+{
+	buf[0]=slave;
+	buf[1]=fc;
+	mb_put16(buf+2,addr);
+	mb_put16(buf+4,num);
+	return mb_put_crc(buf,6);
+}
+
+//дȦ/Ĵ
+//fc:MB_FC_WRITE_COIL(val0ΪON)/MB_FC_WRITE_REG
+//ֵ:󳤶(CRC)
+uint16_t mb_req_write1(uint8_t *buf,uint8_t slave,uint8_t fc,uint16_t addr,uint16_t val)
+{
+	if(fc==MB_FC_WRITE_COIL&&val)val=0xFF00;
+	return mb_req_read(buf,slave,fc,addr,val);	//ʽͬ
+}
+
+//дĴ
+//buf:󻺳,9+num*2ֽ
+//num:Ĵ,1~MB_WRITE_REGS_MAX
+//ֵ:󳤶(CRC)
+uint16_t mb_req_write_regs(uint8_t *buf,uint8_t slave,uint16_t addr,uint16_t num,const uint16_t *val)
+{
+	uint16_t i;
+	buf[0]=slave;
+	buf[1]=MB_FC_WRITE_REGS;
+	mb_put16(buf+2,addr);
+	mb_put16(buf+4,num);
+	buf[6]=(uint8_t)(num*2);
+	for(i=0;i<num;i++)mb_put16(buf+7+i*2,val[i]);
+	return mb_put_crc(buf,7+num*2);
+}
+
+//дȦ
+//bits:Ȧֵ,ÿֽ8λ,λǰ
+//num:Ȧ,1~MB_WRITE_BITS_MAX
+//ֵ:󳤶(CRC)
+uint16_t mb_req_write_coils(uint8_t *buf,uint8_t slave,uint16_t addr,uint16_t num,const uint8_t *bits)
+{
+	uint16_t i,bc=(num+7)/8;
+	buf[0]=slave;
+	buf[1]=MB_FC_WRITE_COILS;
+	mb_put16(buf+2,addr);
+	mb_put16(buf+4,num);
+	buf[6]=(uint8_t)bc;
+	for(i=0;i<bc;i++)buf[7+i]=bits[i];
+	if(num&7)buf[6+bc]&=(1<<(num&7))-1;		//λ0
+	return mb_put_crc(buf,7+bc);
+}
+
+//Ӧ
+//req:
+//rsp:յӦ(CRC)
+//len:Ӧ𳤶
+//ֵ:0,ȷ;1~0xFF,վص쳣;MB_ERR_CRC/MB_ERR_FRAME
+uint16_t mb_rsp_check(const uint8_t *req,const uint8_t *rsp,uint16_t len)
+{
+	uint16_t num=mb_get16(req+4);
+	if(len<5||mb_crc16(rsp,len)!=0)return MB_ERR_CRC;
+	if(rsp[0]!=req[0])return MB_ERR_FRAME;
+	if(rsp[1]==(req[1]|0x80))return len==5&&rsp[2]?rsp[2]:MB_ERR_FRAME;
+	if(rsp[1]!=req[1])return MB_ERR_FRAME;
+	switch(req[1])
+	{
+		case MB_FC_READ_COILS:
+		case MB_FC_READ_DISCRETE:
+			num=(num+7)/8;
+			break;
+		case MB_FC_READ_HOLDING:
+		case MB_FC_READ_INPUT:
+			num*=2;
+			break;
+		default:									//д,ӦΪַ(ֵ)
+			if(len!=8||mb_get16(rsp+2)!=mb_get16(req+2)||mb_get16(rsp+4)!=mb_get16(req+4))return MB_ERR_FRAME;
+			return 0;
+	}
+	if(rsp[2]!=num||len!=5+num)return MB_ERR_FRAME;
+	return 0;
+}
+
+//ȡ/ĴӦ,ӦҪȾmb_rsp_check
+//val:Ĵֵ
+//num:ȡĸ
+//ֵ:ȡĸ
+uint16_t mb_rsp_regs(const uint8_t *rsp,uint16_t *val,uint16_t num)
+{
+	uint16_t i;
+	if(num>rsp[2]/2)num=rsp[2]/2;
+	for(i=0;i<num;i++)val[i]=mb_get16(rsp+3+i*2);
+	return num;
+}
+
+//ȡȦ/ɢӦ,ӦҪȾmb_rsp_check
+//bits:λֵ,ÿֽ8λ,λǰ
+//num:ȡλ
+//ֵ:ȡλ
+uint16_t mb_rsp_bits(const uint8_t *rsp,uint8_t *bits,uint16_t num)
+{
+	uint16_t i;
+	if(num>rsp[2]*8)num=rsp[2]*8;
+	for(i=0;i<num;i++)mb_set_bit(bits,i,mb_get_bit(rsp+3,i));
+	return num;
+}
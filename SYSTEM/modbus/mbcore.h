@@ -0,0 +1,68 @@
+#ifndef _MBCORE_H
+#define _MBCORE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//Modbus RTUЭ:CRC16롢Ӧ顢վĴַ
+//ֻñ׼C,HALOSʹ,PCϰվʹվһ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ADUʽ:վַ(1) (1) (n) CRC16(2,ֽǰ);ֶֽζǴ
+//ֵ֧Ĺ:01Ȧ 02ɢ 03ּĴ 04Ĵ
+//             05дȦ 06дĴ 0FдȦ 10дĴ
+//վ:Ĵ_mb_mapÿһεַ,mb_slave()󡢶дĴӦ
+//վ:mb_req_xxx(),mb_rsp_check()Ӧ,mb_rsp_regs()/mb_rsp_bits()ȡ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MB_ADU_MAX				256		//ADU󳤶
+#define MB_READ_REGS_MAX		125		//һļĴ
+#define MB_READ_BITS_MAX		2000	//һȦ/ɢ
+#define MB_WRITE_REGS_MAX		123		//һдļĴ
+#define MB_WRITE_BITS_MAX		1968	//һдȦ
+
+//
+#define MB_FC_READ_COILS		0x01
+#define MB_FC_READ_DISCRETE		0x02
+#define MB_FC_READ_HOLDING		0x03
+#define MB_FC_READ_INPUT		0x04
+#define MB_FC_WRITE_COIL		0x05
+#define MB_FC_WRITE_REG			0x06
+#define MB_FC_WRITE_COILS		0x0F
+#define MB_FC_WRITE_REGS		0x10
+
+//쳣(վ),ԼվӦʱĴ
+#define MB_EX_FUNCTION			0x01	//ֵ֧Ĺ
+#define MB_EX_ADDRESS			0x02	//ַڼĴ
+#define MB_EX_VALUE				0x03	//ֵǷ
+#define MB_EX_FAILURE			0x04	//дصʧ
+#define MB_ERR_CRC				0x100	//CRC򳤶̫
+#define MB_ERR_FRAME			0x101	//վַ򳤶Ⱥ󲻷
+#define MB_ERR_TIMEOUT			0x102	//Ӧʱ(շʹ)
+
+//Ĵ
+#define MB_COIL					0		//Ȧ,ɶдλ
+#define MB_DISCRETE				1		//ɢ,ֻλ
+#define MB_HOLDING				2		//ּĴ,ɶд
+#define MB_INPUT				3		//Ĵ,ֻ
+
+//Ĵһ
+typedef struct
+{
+	uint8_t type;				//ĴMB_xxx
+	uint16_t start;				//ʼַ
+	uint16_t num;				//
+	void *data;					//Ĵ:uint16_t;Ȧ/ɢ:uint8_t,ÿֽ8λ,λǰ
+	uint8_t (*write)(uint16_t addr,uint16_t num);	//дص(ַΪڵľԵַ),ط0ʱӦMB_EX_FAILURE;NULLص
+}_mb_map;
+
+uint16_t mb_crc16(const uint8_t *buf,uint16_t len);		//CRC16
+uint16_t mb_t35_bits(uint32_t baud);					//3.5ַľĬʱ(λ)
+uint16_t mb_slave(const _mb_map *map,uint8_t n,uint8_t addr,const uint8_t *req,uint16_t len,uint8_t *rsp);	//վһ
+uint16_t mb_req_read(uint8_t *buf,uint8_t slave,uint8_t fc,uint16_t addr,uint16_t num);	//ɶ
+uint16_t mb_req_write1(uint8_t *buf,uint8_t slave,uint8_t fc,uint16_t addr,uint16_t val);	//дȦ/Ĵ
+uint16_t mb_req_write_regs(uint8_t *buf,uint8_t slave,uint16_t addr,uint16_t num,const uint16_t *val);	//дĴ
+uint16_t mb_req_write_coils(uint8_t *buf,uint8_t slave,uint16_t addr,uint16_t num,const uint8_t *bits);	//дȦ
+uint16_t mb_rsp_check(const uint8_t *req,const uint8_t *rsp,uint16_t len);	//Ӧ,0ȷ
+uint16_t mb_rsp_regs(const uint8_t *rsp,uint16_t *val,uint16_t num);		//ȡĴӦ
+uint16_t mb_rsp_bits(const uint8_t *rsp,uint8_t *bits,uint16_t num);		//ȡȦӦ
+#endif
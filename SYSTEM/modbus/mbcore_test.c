@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////////
+//mbcorePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/modbus SYSTEM/modbus/mbcore_test.c SYSTEM/modbus/mbcore.c
+//վɵֱӽվ,վӦ:8롢쳣롢㲥վCRC;
+//CRC16λȽ;"bench"ʱCRC16ٶ
+//////////////////////////////////////////////////////////////////////////////////
+#include "mbcore.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(c)	do{if(!(c)){printf("mbcore: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define SLAVE		7
+
+static uint16_t hold[10]={1,2,3,4,5,6,7,8,9,10};
+static uint16_t inp[4]={100,200,300,400};
+static uint8_t coils[2]={0x05,0};
+static uint8_t disc[1]={0x0A};
+static int wr_cnt;								//дصյļĴ
+
+//ּĴдص,ַ109дʧ
+static uint8_t hold_write(uint16_t addr,uint16_t num)
+{
+	wr_cnt+=num;
+	return addr==109;
+}
+
+static const _mb_map map[]=
+{
+	{MB_HOLDING,100,10,hold,hold_write},
+	{MB_INPUT,0,4,inp,0},
+	{MB_COIL,0,16,coils,0},
+	{MB_DISCRETE,0,8,disc,0},
+};
+
+//󽻸վSLAVE,Ӧ𳤶
+static uint16_t link(const uint8_t *req,uint16_t n,uint8_t *rsp)
+{
+	return mb_slave(map,4,SLAVE,req,n,rsp);
+}
+
+//λCRC16
+static uint16_t crc16_bit(const uint8_t *buf,uint16_t len)
+{
+	uint16_t crc=0xFFFF;
+	uint8_t i;
+	while(len--)
+	{
+		crc^=*buf++;
+		for(i=0;i<8;i++)crc=(crc&1)?(crc>>1)^0xA001:crc>>1;
+	}
+	return crc;
+}
+
+static int test_crc(void)
+{
+	uint8_t buf[256];
+	uint16_t n,i,crc;
+	CHECK(mb_req_read(buf,1,MB_FC_READ_HOLDING,0,10)==8);
+	CHECK(buf[6]==0xC5&&buf[7]==0xCD);			//01 03 00 00 00 0A C5 CD
+	CHECK(mb_crc16(buf,8)==0);					//CRC֡Ϊ0
+	srand(1);
+	for(n=0;n<=256;n++)
+	{
+		for(i=0;i<n;i++)buf[i]=(uint8_t)rand();
+		crc=mb_crc16(buf,n);
+		CHECK(crc==crc16_bit(buf,n));
+	}
+	CHECK(mb_t35_bits(9600)==39&&mb_t35_bits(19200)==39);
+	CHECK(mb_t35_bits(115200)==202);			//1.75ms
+	return 0;
+}
+
+static int test_master_slave(void)
+{
+	uint8_t q[MB_ADU_MAX],r[MB_ADU_MAX],bits[4];
+	uint16_t n,m,v[16];
+	static const uint16_t w[3]={11,12,13};
+
+	n=mb_req_read(q,SLAVE,MB_FC_READ_HOLDING,102,3);
+	m=link(q,n,r);
+	CHECK(mb_rsp_check(q,r,m)==0);
+	CHECK(mb_rsp_regs(r,v,16)==3&&v[0]==3&&v[2]==5);
+	n=mb_req_read(q,SLAVE,MB_FC_READ_INPUT,1,3);
+	m=link(q,n,r);
+	CHECK(mb_rsp_check(q,r,m)==0&&mb_rsp_regs(r,v,3)==3&&v[2]==400);
+	n=mb_req_read(q,SLAVE,MB_FC_READ_INPUT,2,3);	//Ĵ
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==MB_EX_ADDRESS);
+	n=mb_req_read(q,SLAVE,0x2B,2,3);				//ֵ֧Ĺ
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==MB_EX_FUNCTION);
+	n=mb_req_read(q,SLAVE,MB_FC_READ_HOLDING,100,126);	//125
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==MB_EX_VALUE);
+
+	n=mb_req_read(q,SLAVE,MB_FC_READ_COILS,0,10);
+	m=link(q,n,r);
+	CHECK(mb_rsp_check(q,r,m)==0);
+	memset(bits,0,sizeof(bits));
+	mb_rsp_bits(r,bits,10);
+	CHECK(bits[0]==0x05&&bits[1]==0);
+	n=mb_req_read(q,SLAVE,MB_FC_READ_DISCRETE,1,3);	//ӵ1λʼ:0x0A>>1
+	m=link(q,n,r);
+	CHECK(mb_rsp_check(q,r,m)==0&&r[3]==0x05);
+
+	n=mb_req_write1(q,SLAVE,MB_FC_WRITE_COIL,9,1);
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==0&&coils[1]==0x02);
+	n=mb_req_write1(q,SLAVE,MB_FC_WRITE_REG,100,0x1234);
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==0&&hold[0]==0x1234&&wr_cnt==1);
+	n=mb_req_write_regs(q,SLAVE,105,3,w);
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==0&&hold[5]==11&&hold[7]==13&&wr_cnt==4);
+	n=mb_req_write1(q,SLAVE,MB_FC_WRITE_REG,109,1);	//дصʧ
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==MB_EX_FAILURE);
+	bits[0]=0xFF;
+	bits[1]=0xFF;
+	n=mb_req_write_coils(q,SLAVE,2,10,bits);		//Ȧ2~11
+	CHECK(mb_rsp_check(q,r,link(q,n,r))==0&&coils[0]==0xFD&&coils[1]==0x0F);
+
+	n=mb_req_read(q,SLAVE+1,MB_FC_READ_HOLDING,100,1);	//վӦ
+	CHECK(link(q,n,r)==0);
+	n=mb_req_write1(q,0,MB_FC_WRITE_REG,101,77);	//㲥ִеӦ
+	CHECK(link(q,n,r)==0&&hold[1]==77);
+	n=mb_req_read(q,SLAVE,MB_FC_READ_HOLDING,100,1);
+	q[3]^=1;										//CRC,Ӧ
+	CHECK(link(q,n,r)==0);
+	q[3]^=1;
+	m=link(q,n,r);
+	r[3]^=0x40;										//ӦCRC
+	CHECK(mb_rsp_check(q,r,m)==MB_ERR_CRC);
+	CHECK(mb_rsp_check(q,r,3)==MB_ERR_CRC);			//̫
+	r[3]^=0x40;
+	q[0]=SLAVE+1;									//ӦĴվַ󲻷
+	CHECK(mb_rsp_check(q,r,m)==MB_ERR_FRAME);
+	return 0;
+}
+
+//CRC16ٶ,ΪMB/s
+static void bench(void)
+{
+	static uint8_t buf[256];
+	uint32_t i,n=400000,sink=0;
+	clock_t t0;
+	double t_tab,t_bit;
+	for(i=0;i<sizeof(buf);i++)buf[i]=(uint8_t)(i*7);
+	t0=clock();
+	for(i=0;i<n;i++)sink+=mb_crc16(buf,sizeof(buf));
+	t_tab=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	t0=clock();
+	for(i=0;i<n;i++)sink+=crc16_bit(buf,sizeof(buf));
+	t_bit=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	printf("mbcore bench: crc16 table %.0f MB/s, bitwise %.0f MB/s (%u)\n",
+		n*sizeof(buf)/t_tab/1e6,n*sizeof(buf)/t_bit/1e6,sink&1);
+}
+
+int main(int argc,char **argv)
+{
+	if(test_crc()||test_master_slave())return 1;
+	printf("mbcore: ok\n");
+	if(argc>1&&strcmp(argv[1],"bench")==0)bench();
+	return 0;
+}
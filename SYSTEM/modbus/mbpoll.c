@@ -0,0 +1,201 @@
+#include "mbpoll.h"
+#include "stdio.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485վѯ(Modbusվ)
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if MBPOLL_EN
+static _mbpoll_node *mbpoll_table=NULL;
+static u8 mbpoll_n=0;
+static u32 mbpoll_now;			//һMBPOLL_Runʱ(ms)
+static u32 mbpoll_start;		//ʼͳƵʱ(ms)
+static u32 mbpoll_win;			//ǰͳƴڿʼʱ(ms)
+static u32 mbpoll_win_busy;		//ǰ߱ռõʱ(us)
+static u32 mbpoll_busy_ms;		//֮ǰд߱ռõʱ(ms)
+static u8 mbpoll_util;			//һڵռ(%)
+static u8 mbpoll_util_max;		//ռֵ(%)
+
+static void mbpoll_fill(void);
+
+//ѯ
+//table:ѯ,ɵ߷,״̬Ա
+//n:
+//now:ǰʱ(ms)
+void MBPOLL_Init(_mbpoll_node *table,u8 n,u32 now)
+{
+	_mbpoll_node *p;
+	u8 i;
+	for(i=0;i<n;i++)
+	{
+		p=&table[i];
+		if(p->period==0)p->period=1;
+		p->busy=0;
+		p->fail=0;
+		p->offline=0;
+		p->cur_period=p->period;
+		p->cur_timeout=p->timeout?p->timeout:MODBUS_TIMEOUT;
+		p->due=now;
+		p->polls=p->ok=p->timeouts=p->err=p->late=p->lag_max=0;
+		p->rtt_last=p->rtt_max=p->rtt_sum=0;
+		p->rtt_min=0xFFFFFFFF;
+	}
+	mbpoll_table=table;
+	mbpoll_n=n;
+	mbpoll_now=mbpoll_start=mbpoll_win=now;
+	mbpoll_win_busy=mbpoll_busy_ms=0;
+	mbpoll_util=mbpoll_util_max=0;
+}
+
+//Ӧںͳʱ
+static void mbpoll_adapt(_mbpoll_node *p,u16 err)
+{
+	u32 tmo;
+	u16 max=p->timeout?p->timeout:MODBUS_TIMEOUT;
+	if(err==MB_ERR_TIMEOUT)
+	{
+		p->timeouts++;
+		p->cur_timeout=max;			//ʱû趨ĳʱ,Ӧʱ̫
+		if(p->fail<0xFF)p->fail++;
+		if(p->fail>=MBPOLL_FAIL_MAX)
+		{
+			p->offline=1;
+			if(p->cur_period<MBPOLL_PERIOD_MAX/2)p->cur_period*=2;
+			else if(p->cur_period<MBPOLL_PERIOD_MAX)p->cur_period=MBPOLL_PERIOD_MAX;
+		}
+		return;
+	}
+	if(err>=MB_ERR_CRC)p->err++;	//лӦ,и,
+	else
+	{
+		p->ok++;
+		p->fail=0;
+		if(p->offline)
+		{
+			p->offline=0;
+			p->cur_period=p->period;
+			p->due=mbpoll_now+p->period;
+		}
+		p->rtt_last=p->req.rtt;
+		p->rtt_sum+=p->req.rtt;
+		if(p->req.rtt<p->rtt_min)p->rtt_min=p->req.rtt;
+		if(p->req.rtt>p->rtt_max)p->rtt_max=p->req.rtt;
+		tmo=p->rtt_max*MBPOLL_TMO_K/1000+1;
+		if(tmo<MBPOLL_TMO_MIN)tmo=MBPOLL_TMO_MIN;
+		if(tmo>max)tmo=max;
+		p->cur_timeout=tmo;
+	}
+}
+
+//MODBUSɵĻص,MODBUS_Input/MODBUS_Poll
+static void mbpoll_done(_modbus_req *req,u16 err)
+{
+	_mbpoll_node *p=(_mbpoll_node*)req->arg;
+	p->busy=0;
+	mbpoll_win_busy+=req->rtt?req->rtt:(u32)req->timeout*1000;	//ʱʱ߱ռʱʱ
+	mbpoll_adapt(p,err);
+	if(p->done)p->done(p,err);
+	mbpoll_fill();					//ϲһ,MODBUSǰõű
+}
+
+//ѡһҪĽڵ:ѵڵȼߵ,ͬȼ
+static _mbpoll_node *mbpoll_pick(void)
+{
+	_mbpoll_node *p,*best=NULL;
+	u8 i;
+	for(i=0;i<mbpoll_n;i++)
+	{
+		p=&mbpoll_table[i];
+		if(p->busy||(s32)(mbpoll_now-p->due)<0)continue;
+		if(best==NULL||p->prio<best->prio||(p->prio==best->prio&&(s32)(p->due-best->due)<0))best=p;
+	}
+	return best;
+}
+
+//ѵڵ󽻸MODBUS,ֱMBPOLL_DEPTHMODBUS
+static void mbpoll_fill(void)
+{
+	_mbpoll_node *p;
+	u32 lag;
+	while(MODBUS_Pending()<MBPOLL_DEPTH)
+	{
+		p=mbpoll_pick();
+		if(p==NULL)break;
+		p->req.slave=p->slave;
+		p->req.fc=p->fc;
+		p->req.addr=p->addr;
+		p->req.num=p->num;
+		p->req.data=p->data;
+		p->req.timeout=p->cur_timeout;
+		p->req.done=mbpoll_done;
+		p->req.arg=p;
+		lag=mbpoll_now-p->due;
+		if(lag>p->lag_max)p->lag_max=lag;
+		p->due+=p->cur_period;
+		if((s32)(mbpoll_now-p->due)>=0)		//,
+		{
+			p->late+=(mbpoll_now-p->due)/p->cur_period+1;
+			p->due=mbpoll_now+p->cur_period;
+		}
+		if(MODBUS_Submit(&p->req))			//бռ,߽ڵ
+		{
+			p->err++;
+			break;
+		}
+		p->busy=1;
+		p->polls++;
+	}
+}
+
+//ڵ,RS485ѭ
+//now:ǰʱ(ms)
+//ֵ:ٶmsҪٵһ
+u32 MBPOLL_Run(u32 now)
+{
+	_mbpoll_node *p;
+	u32 el,u,wait=MODBUS_POLL_MAX;
+	s32 left;
+	u8 i;
+	mbpoll_now=now;
+	el=now-mbpoll_win;
+	if(el>=1000)							//ÿһռ
+	{
+		u=mbpoll_win_busy/(el*10);
+		mbpoll_util=u>100?100:u;
+		if(mbpoll_util>mbpoll_util_max)mbpoll_util_max=mbpoll_util;
+		mbpoll_busy_ms+=mbpoll_win_busy/1000;
+		mbpoll_win_busy=0;
+		mbpoll_win=now;
+	}
+	mbpoll_fill();
+	for(i=0;i<mbpoll_n;i++)
+	{
+		p=&mbpoll_table[i];
+		if(p->busy)continue;
+		left=(s32)(p->due-now);
+		if(left<0)left=0;
+		if((u32)left<wait)wait=left;
+	}
+	return wait;
+}
+
+//ռʺÿڵͳ
+void MBPOLL_Report(void)
+{
+	_mbpoll_node *p;
+	u32 el=(mbpoll_now-mbpoll_start)/100;
+	u8 i;
+	if(el==0)el=1;
+	printf("mbpoll: %u nodes, bus busy %u%% (last 1s), %u%% avg, %u%% max\r\n",mbpoll_n,mbpoll_util,
+		mbpoll_busy_ms/el,mbpoll_util_max);
+	for(i=0;i<mbpoll_n;i++)
+	{
+		p=&mbpoll_table[i];
+		printf("mbpoll slave %u: %s period %u/%u ms prio %u tmo %u ms, poll %u ok %u timeout %u err %u late %u lag %u ms, rtt last %u min %u avg %u max %u us\r\n",
+			p->slave,p->offline?"offline":"online",p->cur_period,p->period,p->prio,p->cur_timeout,
+			p->polls,p->ok,p->timeouts,p->err,p->late,p->lag_max,
+			p->rtt_last,p->ok?p->rtt_min:0,p->ok?p->rtt_sum/p->ok:0,p->rtt_max);
+	}
+}
+#endif
@@ -0,0 +1,77 @@
+#ifndef _MBPOLL_H
+#define _MBPOLL_H
+#include "sys.h"
+#include "modbus.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485վѯ(Modbusվ)
+//ѯԵضдվ,ͨMODBUS_Submit
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//ѯ:ÿվһ(_mbpoll_node),ָڡȼͳʱ
+//:ڵĽڵȷȼߵ,ͬȼȷ;
+//     ɵĻصѡύһ,MODBUS,ֻ֮3.5ַľĬ;
+//     ÿζһʱѡ,ȼĽڵһڽе
+//Ӧ:
+//1,Ӧʱʱ̵ʱMBPOLL_TMO_K(ڵ趨ĳʱ),֡ʱռ
+//2,MBPOLL_FAIL_MAXγʱΪ,֮ÿγʱڼӱ,MBPOLL_PERIOD_MAX,
+//  Ӧָԭںͳʱ
+//3,æʱȼ͵Ľڵ,ڲ,late
+//ͳ:ռ(1ƽ)ÿڵʱ䡢ʱʹڴ
+//OS,ǰʱɵߴ,PCϽģĴվ
+//ʹ÷:
+//1,MODBUS_Init֮MBPOLL_Init(ѯ,,ǰʱ)
+//2,RS485ѭMBPOLL_Run(OSTimeGet()),MODBUS_Poll֮ǰ
+//  ֵMODBUS_PollķֵȡСΪRS485_Waitĵȴʱ
+//3,ѯֻRS485,ڵdoneصҲ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MBPOLL_EN				MODBUS_EN	//0,ر;1,ѯ
+#define MBPOLL_DEPTH			1		//ͬʱMODBUS,1ʱڵĸȼڵҪύ
+#define MBPOLL_FAIL_MAX			3		//ʱٴΪ
+#define MBPOLL_PERIOD_MAX		10000	//߽ڵѯ(ms)
+#define MBPOLL_TMO_MIN			5		//Ӧʱ(ms)
+#define MBPOLL_TMO_K			3		//ӦʱΪʱı
+
+//ѯһ,ǰĳԱɵ,MBPOLLʹ(ʼΪ0)
+typedef struct _mbpoll_node
+{
+	u8 slave;					//վַ,1~247
+	u8 fc;						//MB_FC_xxx
+	u16 addr;					//ʼַ
+	u16 num;					//;дȦ/ĴʱΪдֵ
+	void *data;					//ĽҪд,_modbus_req
+	u16 period;					//ѯ(ms),01
+	u8 prio;					//ȼ,0
+	u16 timeout;				//Ӧʱ(ms),0ʹMODBUS_TIMEOUT
+	void (*done)(struct _mbpoll_node *node,u16 err);	//ÿѯɵĻص,NULLص
+
+	_modbus_req req;			//MODBUS
+	u8 busy;					//û
+	u8 fail;					//ʱ
+	u8 offline;					//1,
+	u16 cur_period;				//ǰ(ms),ʱӳ
+	u16 cur_timeout;			//ǰʱ(ms),ʱ
+	u32 due;					//´ѯʱ(ms)
+	u32 polls;					//
+	u32 ok;						//ȷӦ(쳣Ӧ)
+	u32 timeouts;				//ʱ
+	u32 err;					//CRCӦ𲻷
+	u32 late;					//
+	u32 lag_max;				//Ԥʱֵ(ms)
+	u32 rtt_last;				//һʱ(us)
+	u32 rtt_min;				//Сʱ(us)
+	u32 rtt_max;				//ʱ(us)
+	u32 rtt_sum;				//ʱܺ(us),ƽ
+}_mbpoll_node;
+
+#if MBPOLL_EN
+void MBPOLL_Init(_mbpoll_node *table,u8 n,u32 now);	//ѯ,нڵ
+u32 MBPOLL_Run(u32 now);								//ڵ,ٶmsٵ
+void MBPOLL_Report(void);								//ռʺÿڵͳ
+#else
+#define MBPOLL_Init(table,n,now)
+#define MBPOLL_Run(now)			MODBUS_POLL_MAX
+#define MBPOLL_Report()
+#endif
+#endif
@@ -0,0 +1,306 @@
+#define _DEFAULT_SOURCE
+//////////////////////////////////////////////////////////////////////////////////
+//mbpoll.cPC,Keil,TOOLS/hosttest.sh:
+//gcc -ITOOLS/host -ISYSTEM/modbus -ISYSTEM/serial -IHARDWARE/RS485 SYSTEM/modbus/mbpoll_test.c SYSTEM/modbus/mbpoll.c
+//    SYSTEM/modbus/modbus.c SYSTEM/modbus/mbcore.c HARDWARE/RS485/rs485.c SYSTEM/serial/serial_host.c
+//    SYSTEM/serial/rxline.c TOOLS/host/os_host.c -pthread
+//վmbpoll.c+modbus.c+rs485.c,2serial_host.cpty,ѭrs485_taskͬ
+//ģվ̴߳ptyһ,֡֡(rxlineճʱ),ÿվʱһʱmb_slaveӦ,
+//վ4ʼʱӦ,ָ֮
+//:ȼߵĽڵ㰴ѯӦʱߺڼӱָصԭڡռͳ
+//////////////////////////////////////////////////////////////////////////////////
+#include "mbpoll.h"
+#include "modbus.h"
+#include "rs485.h"
+#include "serial.h"
+#include "rxline.h"
+#include "pcf8574.h"
+#include "includes.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+
+#define CHECK(c)	do{if(!(c)){printf("mbpoll: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define BAUD		19200
+#define SIM_GAP		2000						//ģվ֡(us),serial_host.cСͬ
+#define SIM_CHR		573							//19200һַʱ(us)
+
+//RS485PCF8574P6(RS485_DE_MODEΪ0),ﲻ
+u8 PCF8574_Init(void)
+{
+	return 0;
+}
+
+void PCF8574_WriteBit(u8 bit,u8 sta)
+{
+	(void)bit;
+	(void)sta;
+}
+
+//PCʱƽDWT->CYCCNT(400MHz),modbus.cʱ
+static void tick(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	DWT->CYCCNT=(u32)((uint64_t)ts.tv_sec*400000000u+ts.tv_nsec/10*4);
+}
+
+static u32 now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (u32)((uint64_t)ts.tv_sec*1000000u+ts.tv_nsec/1000);
+}
+
+///////////////////////////////////ģվ////////////////////////////////////////
+
+//ÿվıּĴ0~3ֵǴվַ
+typedef struct
+{
+	u8 addr;
+	u16 delay;									//յӦʱ(us)
+	volatile u8 alive;							//0,Ӧ
+	u16 hold[4];
+	_mb_map map;
+}_sim_slave;
+
+static _sim_slave sim[]=
+{
+	{5,1000,1},
+	{2,5000,1},
+	{3,15000,1},
+	{4,2000,0},
+};
+#define SIM_N		(sizeof(sim)/sizeof(sim[0]))
+
+static int sim_fd;
+static u32 sim_rq;								//ģվյ
+
+//վ߳:֡,ҵַӦĴվ,ʱӦ
+static void *sim_thread(void *arg)
+{
+	static u8 line[4*MB_ADU_MAX];
+	static u16 line_len[4];
+	_rxline rx;
+	struct pollfd pfd;
+	u8 buf[MB_ADU_MAX],rsp[MB_ADU_MAX];
+	u8 *f;
+	u16 len,n;
+	s32 left;
+	int r,ms;
+	u8 i;
+	(void)arg;
+	rxline_init(&rx,RXLINE_MODE_IDLE,line,line_len,4,MB_ADU_MAX);
+	rxline_set_gap(&rx,SIM_GAP,SIM_CHR);
+	pfd.fd=sim_fd;
+	pfd.events=POLLIN;
+	while(1)
+	{
+		ms=-1;
+		if(rx.wait)
+		{
+			left=(s32)(rx.last+rx.gap-now_us());
+			ms=left>0?(left+999)/1000:0;
+		}
+		r=poll(&pfd,1,ms);
+		if(r>0)
+		{
+			r=read(sim_fd,buf,sizeof(buf));
+			if(r<=0)return NULL;
+			rxline_put_at(&rx,buf,r,now_us());
+		}else rxline_poll(&rx,now_us());
+		while((f=rxline_peek(&rx,RXLINE_TEXT,&len))!=NULL)
+		{
+			sim_rq++;
+			for(i=0;i<SIM_N;i++)
+			{
+				if(f[0]!=sim[i].addr||!sim[i].alive)continue;
+				n=mb_slave(&sim[i].map,1,sim[i].addr,f,len,rsp);
+				usleep(sim[i].delay);
+				if(n&&write(sim_fd,rsp,n)!=n)return NULL;
+			}
+			rxline_pop(&rx,RXLINE_TEXT);
+		}
+	}
+}
+
+/////////////////////////////////////վ//////////////////////////////////////////
+
+static u16 val[SIM_N][4];
+static u32 done_n[SIM_N];						//ɻصĴ
+static u32 done_bad[SIM_N];						//ʱĴ
+
+//ѯ:ַ5ȼߡ;ַ4ʼʱ
+static _mbpoll_node node[SIM_N]=
+{
+	{5,MB_FC_READ_HOLDING,0,4,val[0],20,0,50},
+	{2,MB_FC_READ_HOLDING,0,4,val[1],30,1,50},
+	{3,MB_FC_READ_HOLDING,0,4,val[2],100,2,80},
+	{4,MB_FC_READ_HOLDING,0,4,val[3],50,3,20},
+};
+
+static void node_done(_mbpoll_node *p,u16 err)
+{
+	u8 i=p-node;
+	done_n[i]++;
+	if(err&&err!=MB_ERR_TIMEOUT)done_bad[i]++;
+}
+
+//rs485_taskһѭ
+static void rs485_loop(void)
+{
+	u8 buf[256];
+	u8 len;
+	u32 wait,t;
+	tick();
+	wait=MBPOLL_Run(OSTimeGet());
+	t=MODBUS_Poll();
+	if(t<wait)wait=t;
+	RS485_Wait(wait);
+	tick();
+	RS485_Receive_Data(buf,&len);
+	if(len)MODBUS_Input(buf,len);
+}
+
+//ѭms,ߵcond(p)
+static void run(u32 ms,int (*cond)(void))
+{
+	u32 t=OSTimeGet();
+	while(OSTimeGet()-t<ms&&(cond==NULL||!cond()))rs485_loop();
+}
+
+//Ӧʱ:ʱMBPOLL_TMO_K,MBPOLL_TMO_MIN趨ĳʱ֮
+static u32 tmo_expect(_mbpoll_node *p)
+{
+	u32 t=p->rtt_max*MBPOLL_TMO_K/1000+1;
+	if(t<MBPOLL_TMO_MIN)t=MBPOLL_TMO_MIN;
+	if(t>p->timeout)t=p->timeout;
+	return t;
+}
+
+//MBPOLL_Report
+static char *report(void)
+{
+	static char buf[4096];
+	int p[2],out;
+	ssize_t n;
+	fflush(stdout);
+	if(pipe(p))return "";
+	out=dup(1);
+	dup2(p[1],1);
+	MBPOLL_Report();
+	fflush(stdout);
+	dup2(out,1);
+	close(out);
+	close(p[1]);
+	n=read(p[0],buf,sizeof(buf)-1);
+	close(p[0]);
+	buf[n>0?n:0]=0;
+	return buf;
+}
+
+//ߵĽڵ:ѯ,ûгʱ,ȷ,ʱ̵ʱļ
+static int test_online(void)
+{
+	_mbpoll_node *p;
+	u8 i;
+	run(1500,NULL);
+	for(i=0;i<3;i++)
+	{
+		p=&node[i];
+		CHECK(!p->offline&&p->timeouts==0&&p->err==0&&done_bad[i]==0);
+		CHECK(p->ok>0&&val[i][0]==p->slave&&val[i][3]==p->slave);
+		CHECK(p->rtt_min>=sim[i].delay&&p->rtt_max<p->timeout*1000u);
+		CHECK(p->cur_timeout==tmo_expect(p)&&p->cur_timeout<p->timeout);
+	}
+	p=&node[0];
+	CHECK(p->polls>=1500/20*4/5);				//ȼ,
+	CHECK(p->lag_max<=node[3].timeout+node[2].timeout);	//һڽе
+	CHECK(node[2].polls>=1500/100*4/5);			//ȼ͵߽ڵҲѯ
+	return 0;
+}
+
+//ߵĽڵ:ʱڼӱ,ʱԶڰԭѯĴ
+static int test_offline(void)
+{
+	_mbpoll_node *p=&node[3];
+	CHECK(p->offline&&p->ok==0&&p->fail>=MBPOLL_FAIL_MAX);
+	CHECK(p->cur_period>=8*p->period&&p->cur_period<=MBPOLL_PERIOD_MAX);
+	CHECK(p->timeouts>=MBPOLL_FAIL_MAX&&p->timeouts<=8);
+	CHECK(done_n[3]==p->timeouts&&done_bad[3]==0);
+	CHECK(p->cur_timeout==p->timeout);			//ʱû趨ĳʱ
+	return 0;
+}
+
+static int node4_online(void)
+{
+	return node[3].ok>0;
+}
+
+//ָ:վʼӦصԭ,ʱҲӦ
+static int test_recover(void)
+{
+	_mbpoll_node *p=&node[3];
+	u32 ok;
+	sim[3].alive=1;
+	run(p->cur_period+500,node4_online);
+	CHECK(p->ok>0&&!p->offline&&p->fail==0);
+	CHECK(p->cur_period==p->period);
+	ok=p->ok;
+	run(500,NULL);
+	CHECK(!p->offline&&p->ok>=ok+500/50*3/5&&done_bad[3]==0);
+	CHECK(p->cur_timeout==tmo_expect(p)&&val[3][0]==4);
+	CHECK(node[0].timeouts==0&&node[1].timeouts==0&&node[2].timeouts==0);
+	return 0;
+}
+
+//ͳ:ڵ,ռںΧ
+static int test_report(void)
+{
+	unsigned n,last,avg,max,poll;
+	char *s=report();
+	char *p;
+	CHECK(sscanf(s,"mbpoll: %u nodes, bus busy %u%% (last 1s), %u%% avg, %u%% max",&n,&last,&avg,&max)==4);
+	CHECK(n==SIM_N&&avg>=10&&avg<=100&&last>=10&&max>=last&&max<=100);
+	p=strstr(s,"mbpoll slave 4: online period 50/50");
+	CHECK(p&&(p=strstr(p,"ms, poll "))!=NULL&&sscanf(p,"ms, poll %u",&poll)==1&&poll==node[3].polls);
+	return 0;
+}
+
+int main(void)
+{
+	pthread_t th;
+	u32 rq;
+	int ret;
+	u8 i;
+	for(i=0;i<SIM_N;i++)
+	{
+		sim[i].hold[0]=sim[i].hold[1]=sim[i].hold[2]=sim[i].hold[3]=sim[i].addr;
+		sim[i].map.type=MB_HOLDING;
+		sim[i].map.start=0;
+		sim[i].map.num=4;
+		sim[i].map.data=sim[i].hold;
+		node[i].done=node_done;
+	}
+	RS485_Init(BAUD);
+	MODBUS_Init(BAUD);
+	sim_fd=open(SERIAL_HostPath(SERIAL2),O_RDWR|O_NOCTTY);
+	if(sim_fd<0)return 1;
+	pthread_create(&th,NULL,sim_thread,NULL);
+	MBPOLL_Init(node,SIM_N,OSTimeGet());
+	ret=test_online()||test_offline()||test_recover()||test_report();
+	if(ret)
+	{
+		MBPOLL_Report();
+		return 1;
+	}
+	rq=0;
+	for(i=0;i<SIM_N;i++)rq+=node[i].polls;
+	printf("mbpoll: ok (4 simulated slaves on a pty at %u baud, %u polls, %u requests on the bus, slave 4 offline %u timeouts then back)\n",
+		BAUD,rq,sim_rq,node[3].timeouts);
+	return 0;
+}
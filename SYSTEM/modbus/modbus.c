@@ -0,0 +1,302 @@
+#include "modbus.h"
+#include "rs485.h"
+#include "serial.h"
+#include "string.h"
+#include "stdio.h"
+#include "includes.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485ϵModbus RTUվ/վ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if MODBUS_EN
+#define MODBUS_QUEUE_MASK		(MODBUS_QUEUE_NUM-1)
+
+//ÿվվͳ
+typedef struct
+{
+	u8 addr;					//վַ,0ʾ
+	u32 req;					//
+	u32 ok;						//ȷӦ
+	u32 ex;						//쳣Ӧ
+	u32 timeout;				//ʱ
+	u32 err;					//CRCӦ𲻷
+	u32 tx;						//ֽ
+	u32 rx;						//յֽ
+	u32 rtt_last;				//һʱ(us)
+	u32 rtt_max;				//ʱ(us)
+	u32 rtt_sum;				//ʱܺ(us),ƽ
+}_modbus_stat;
+
+static _modbus_req *modbus_queue[MODBUS_QUEUE_NUM];	//ȴ͵
+static u8 modbus_head=0;		//Ѽ(ɼ)
+static u8 modbus_tail=0;		//ȡ(ɼ)
+static _modbus_req *modbus_cur=NULL;	//ڵӦ
+static _modbus_req *modbus_next=NULL;	//Ѿáһ͵
+static u8 modbus_adu[2][MB_ADU_MAX];	//󻺳,һڽе,һǰõһ
+static u16 modbus_adu_len[2];
+static u8 modbus_adu_cur=0;		//modbus_curʹõĻ
+static u32 modbus_t0;			//modbus_curʼʱDWT
+static u32 modbus_deadline;		//modbus_curʱOS
+static u32 modbus_baud=9600;
+static u32 modbus_start;		//ʼͳƵOS
+
+static u8 modbus_addr=0;		//վַ,0ʾΪվ
+static const _mb_map *modbus_map;
+static u8 modbus_map_n;
+static u8 modbus_rsp[MB_ADU_MAX];	//վӦ
+static u32 modbus_sl_req=0;		//վ
+static u32 modbus_sl_ex=0;		//վص쳣Ӧ
+static u32 modbus_crc=0;		//յCRC֡
+static u32 modbus_stray=0;		//ûڵȵӦ(ٵӦվ֡)
+
+static _modbus_stat modbus_stat[MODBUS_STAT_NUM];
+
+//ʼ,ô2ĽճʱΪ3.5ַ
+//baud:RS485Ĳ,RS485_Initͬ
+void MODBUS_Init(u32 baud)
+{
+	modbus_baud=baud;
+	modbus_start=OSTimeGet();
+	SERIAL_SetRxTimeout(SERIAL2,mb_t35_bits(baud));
+}
+
+//ΪվӦ
+//addr:վַ,1~247;0,Ϊվ
+//map:Ĵ,Ӧڼ䲻ͷ
+//n:Ĵ
+void MODBUS_Slave(u8 addr,const _mb_map *map,u8 n)
+{
+	modbus_map=map;
+	modbus_map_n=n;
+	modbus_addr=addr;
+}
+
+//ȡվͳ
+//ֵ:ͳ,NULLʾͳƱ˻ǹ㲥
+static _modbus_stat *modbus_stat_get(u8 addr)
+{
+	u8 i;
+	if(addr==0)return NULL;
+	for(i=0;i<MODBUS_STAT_NUM;i++)
+	{
+		if(modbus_stat[i].addr==addr)return &modbus_stat[i];
+		if(modbus_stat[i].addr==0)
+		{
+			modbus_stat[i].addr=addr;
+			return &modbus_stat[i];
+		}
+	}
+	return NULL;
+}
+
+//վ,,ʱreq->done
+//req:,ǰ޸Ļͷ
+//ֵ:0,ɹ;1,;2,
+u8 MODBUS_Submit(_modbus_req *req)
+{
+	u16 max;
+	OS_CPU_SR cpu_sr=0;
+	switch(req->fc)
+	{
+		case MB_FC_READ_COILS:
+		case MB_FC_READ_DISCRETE:	max=MB_READ_BITS_MAX;break;
+		case MB_FC_READ_HOLDING:
+		case MB_FC_READ_INPUT:		max=MB_READ_REGS_MAX;break;
+		case MB_FC_WRITE_COIL:
+		case MB_FC_WRITE_REG:		max=0xFFFF;break;
+		case MB_FC_WRITE_COILS:		max=MB_WRITE_BITS_MAX;break;
+		case MB_FC_WRITE_REGS:		max=MB_WRITE_REGS_MAX;break;
+		default:return 2;
+	}
+	if(req->slave>247||(req->num==0&&req->fc!=MB_FC_WRITE_COIL&&req->fc!=MB_FC_WRITE_REG)||req->num>max)return 2;
+	if(req->slave==0&&req->fc<=MB_FC_READ_INPUT)return 2;	//㲥ֻд
+	OS_ENTER_CRITICAL();
+	if((u8)(modbus_head-modbus_tail)>=MODBUS_QUEUE_NUM)
+	{
+		OS_EXIT_CRITICAL();
+		return 1;
+	}
+	req->err=0;
+	req->rtt=0;
+	modbus_queue[modbus_head&MODBUS_QUEUE_MASK]=req;
+	modbus_head++;
+	OS_EXIT_CRITICAL();
+	return 0;
+}
+
+//ŶӺڽеվ
+u8 MODBUS_Pending(void)
+{
+	return (u8)(modbus_head-modbus_tail)+(modbus_cur!=NULL)+(modbus_next!=NULL);
+}
+
+//Ӷȡһ,뵽еĻ
+static void modbus_prepare(void)
+{
+	_modbus_req *r;
+	u8 *buf=modbus_adu[modbus_adu_cur^1];
+	u16 len;
+	OS_CPU_SR cpu_sr=0;
+	if(modbus_next!=NULL)return;
+	OS_ENTER_CRITICAL();
+	if(modbus_head==modbus_tail)
+	{
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	r=modbus_queue[modbus_tail&MODBUS_QUEUE_MASK];
+	modbus_tail++;
+	OS_EXIT_CRITICAL();
+	switch(r->fc)
+	{
+		case MB_FC_WRITE_COIL:
+		case MB_FC_WRITE_REG:	len=mb_req_write1(buf,r->slave,r->fc,r->addr,r->num);break;
+		case MB_FC_WRITE_COILS:	len=mb_req_write_coils(buf,r->slave,r->addr,r->num,(u8*)r->data);break;
+		case MB_FC_WRITE_REGS:	len=mb_req_write_regs(buf,r->slave,r->addr,r->num,(u16*)r->data);break;
+		default:				len=mb_req_read(buf,r->slave,r->fc,r->addr,r->num);break;
+	}
+	modbus_adu_len[modbus_adu_cur^1]=len;
+	modbus_next=r;
+}
+
+//ûڽеʱһ,ǰһ
+static void modbus_send(void)
+{
+	_modbus_req *r;
+	_modbus_stat *s;
+	u16 len;
+	if(modbus_cur!=NULL)return;
+	modbus_prepare();
+	if(modbus_next==NULL)return;
+	r=modbus_next;
+	modbus_next=NULL;
+	modbus_adu_cur^=1;
+	modbus_cur=r;
+	len=modbus_adu_len[modbus_adu_cur];
+	s=modbus_stat_get(r->slave);
+	if(s!=NULL)
+	{
+		s->req++;
+		s->tx+=len;
+	}
+	modbus_t0=DWT->CYCCNT;
+	RS485_Send_Data(modbus_adu[modbus_adu_cur],(u8)len);
+	modbus_deadline=OSTimeGet()+len*11*1000/modbus_baud+1;		//ݻڷʱʼƳʱ
+	if(r->slave==0)modbus_deadline+=MODBUS_BCAST_DELAY;
+	else modbus_deadline+=r->timeout?r->timeout:MODBUS_TIMEOUT;
+	modbus_prepare();
+}
+
+//ڽе,صһ
+//err:
+static void modbus_done(u16 err)
+{
+	_modbus_req *r=modbus_cur;
+	_modbus_stat *s=modbus_stat_get(r->slave);
+	if(s!=NULL)
+	{
+		if(err==0)
+		{
+			s->ok++;
+			s->rtt_last=r->rtt;
+			s->rtt_sum+=r->rtt;
+			if(r->rtt>s->rtt_max)s->rtt_max=r->rtt;
+		}else if(err==MB_ERR_TIMEOUT)s->timeout++;
+		else if(err>=MB_ERR_CRC)s->err++;
+		else s->ex++;
+	}
+	r->err=err;
+	modbus_cur=NULL;
+	if(r->done)r->done(r,err);
+	modbus_send();
+}
+
+//վյӦ
+static void modbus_response(u8 *frame,u16 len)
+{
+	_modbus_req *r=modbus_cur;
+	_modbus_stat *s=modbus_stat_get(r->slave);
+	u16 err;
+	r->rtt=(DWT->CYCCNT-modbus_t0)/(SystemCoreClock/1000000);
+	if(s!=NULL)s->rx+=len;
+	err=mb_rsp_check(modbus_adu[modbus_adu_cur],frame,len);
+	if(err==0&&r->data!=NULL)
+	{
+		if(r->fc==MB_FC_READ_HOLDING||r->fc==MB_FC_READ_INPUT)mb_rsp_regs(frame,(u16*)r->data,r->num);
+		else if(r->fc==MB_FC_READ_COILS||r->fc==MB_FC_READ_DISCRETE)mb_rsp_bits(frame,(u8*)r->data,r->num);
+	}
+	modbus_done(err);
+}
+
+//յһ֡ʱ(RS485)
+//ڵӦʱΪӦ;ΪվӦ
+//frame:֡(CRC)
+//len:֡
+//ֵ:1,Modbus֡,Ѵ;0,(4ֽ),ߴ
+u8 MODBUS_Input(u8 *frame,u16 len)
+{
+	u16 rlen;
+	if(len<4)return 0;
+	if(modbus_cur!=NULL&&modbus_cur->slave)
+	{
+		modbus_response(frame,len);
+		return 1;
+	}
+	if(mb_crc16(frame,len)!=0)
+	{
+		modbus_crc++;
+		return 1;
+	}
+	if(modbus_addr==0)
+	{
+		modbus_stray++;
+		return 1;
+	}
+	rlen=mb_slave(modbus_map,modbus_map_n,modbus_addr,frame,len,modbus_rsp);
+	if(frame[0]==modbus_addr||frame[0]==0)modbus_sl_req++;
+	if(rlen)
+	{
+		if(modbus_rsp[1]&0x80)modbus_sl_ex++;
+		RS485_Send_Data(modbus_rsp,(u8)rlen);
+	}
+	return 1;
+}
+
+//Ŷӵ,Ӧʱ,RS485ѭ
+//ֵ:ٶmsҪٵһ,ΪRS485_Waitĵȴʱ
+u32 MODBUS_Poll(void)
+{
+	s32 left;
+	if(modbus_cur!=NULL&&(s32)(OSTimeGet()-modbus_deadline)>=0)
+	{
+		modbus_done(modbus_cur->slave?MB_ERR_TIMEOUT:0);	//㲥ûӦ,ȴʱ䵽
+	}
+	modbus_send();
+	if(modbus_cur==NULL)return MODBUS_POLL_MAX;
+	left=(s32)(modbus_deadline-OSTimeGet());
+	if(left<1)left=1;
+	if(left>MODBUS_POLL_MAX)left=MODBUS_POLL_MAX;
+	return left;
+}
+
+//ͳ:վյ쳣Ӧ,Լվÿվֽʱ
+void MODBUS_Report(void)
+{
+	_modbus_stat *s;
+	u32 sec=(OSTimeGet()-modbus_start)/1000;
+	u8 i;
+	if(sec==0)sec=1;
+	printf("modbus: %u baud t3.5 %u bits, slave addr %u req %u ex %u, crc err %u stray %u\r\n",modbus_baud,
+		mb_t35_bits(modbus_baud),modbus_addr,modbus_sl_req,modbus_sl_ex,modbus_crc,modbus_stray);
+	for(i=0;i<MODBUS_STAT_NUM;i++)
+	{
+		s=&modbus_stat[i];
+		if(s->addr==0)break;
+		printf("modbus slave %u: req %u ok %u ex %u timeout %u err %u, %u B/s, rtt last %u avg %u max %u us\r\n",
+			s->addr,s->req,s->ok,s->ex,s->timeout,s->err,(s->tx+s->rx)/sec,
+			s->rtt_last,s->ok?s->rtt_sum/s->ok:0,s->rtt_max);
+	}
+}
+#endif
@@ -0,0 +1,57 @@
+#ifndef _MODBUS_H
+#define _MODBUS_H
+#include "sys.h"
+#include "mbcore.h"
+//////////////////////////////////////////////////////////////////////////////////
+//RS485ϵModbus RTUվ/վ
+//Эmbcore.c,︺շСʱͳ
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//֡:ôڽճʱ(RTOR)3.5ַľĬ,֡MODBUS_Input
+//վ:MODBUS_Submit(),һǰ,
+//     յӦ(ʱ)һ,л,ֻ֮3.5ַľĬ
+//վ:MODBUS_Slave()ָվַͼĴ(_mb_map),յվʱֱӦ
+//ʹ÷:
+//1,RS485_Init֮MODBUS_Init()
+//2,RS485ѭ:RS485_Wait(MODBUS_Poll());յ֡MODBUS_Input(),0֡Modbus֡
+//3,ҪʱMODBUS_Report()ÿվͳ("modbus")
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MODBUS_EN				1		//0,ر;1,Modbus RTU
+#define MODBUS_QUEUE_NUM		8		//վ,2
+#define MODBUS_TIMEOUT			100		//ĬӦʱ(ms)
+#define MODBUS_BCAST_DELAY		5		//㲥󷢳ȴվʱ(ms)
+#define MODBUS_STAT_NUM			16		//ͳƵĴվ
+#define MODBUS_POLL_MAX			10		//MODBUS_Pollصȴʱ(ms)
+
+//վ,ɵ߷,MODBUS_Submitɻص֮䲻޸
+typedef struct _modbus_req
+{
+	u8 slave;					//վַ,0Ϊ㲥(ֻд)
+	u8 fc;						//MB_FC_xxx
+	u16 addr;					//ʼַ
+	u16 num;					//;дȦ/ĴʱΪдֵ
+	void *data;					//:,ĴΪu16,ȦΪλ;д:Ҫд;д:
+	u16 timeout;				//Ӧʱ(ms),0ʹMODBUS_TIMEOUT
+	void (*done)(struct _modbus_req *req,u16 err);	//ɻص,MODBUS_Input/MODBUS_Poll,ڻصύ
+	void *arg;					//صõĲ
+	u16 err;					//:0,ɹ;1~0xFF,վص쳣;MB_ERR_xxx
+	u32 rtt;					//ӿʼ͵յӦʱ(us)
+}_modbus_req;
+
+#if MODBUS_EN
+void MODBUS_Init(u32 baud);									//3.5ַ֡
+void MODBUS_Slave(u8 addr,const _mb_map *map,u8 n);			//ΪվӦ,addrΪ0ʱӦ
+u8 MODBUS_Submit(_modbus_req *req);							//վ,0ɹ,1
+u8 MODBUS_Input(u8 *frame,u16 len);							//յһ֡,1:Modbus֡,Ѵ
+u32 MODBUS_Poll(void);										//󡢼鳬ʱ,´ٵõʱ(ms)
+u8 MODBUS_Pending(void);									//ŶӺڽеվ
+void MODBUS_Report(void);									//ͳ
+#else
+#define MODBUS_Init(baud)
+#define MODBUS_Input(frame,len)	0
+#define MODBUS_Poll()			MODBUS_POLL_MAX
+#define MODBUS_Report()
+#endif
+#endif
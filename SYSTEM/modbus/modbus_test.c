@@ -0,0 +1,366 @@
+#define _DEFAULT_SOURCE
+//////////////////////////////////////////////////////////////////////////////////
+//modbus.cPC,Keil,TOOLS/hosttest.sh:
+//gcc -ITOOLS/host -ISYSTEM/modbus -ISYSTEM/serial -IHARDWARE/RS485 SYSTEM/modbus/modbus_test.c SYSTEM/modbus/modbus.c
+//    SYSTEM/modbus/mbcore.c HARDWARE/RS485/rs485.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c TOOLS/host/os_host.c -pthread
+//̸һmodbus.c+rs485.c,2serial_host.cpty,Գpty֮ת,൱һRS485
+//ӽǴվ(ַSLAVE),վ,ѭrs485_taskͬ:RS485_Wait(MODBUS_Poll()),յ֡MODBUS_Input
+//:(˳)8롢쳣Ӧ𡢹㲥Ӧʱ˫(Ӧ𲻵MODBUS_Poll
+//Ҳᷢһ)ÿվͳơMODBUS_InputԶ֡/CRC/ڵȵ֡Ĵ
+//////////////////////////////////////////////////////////////////////////////////
+#include "modbus.h"
+#include "rs485.h"
+#include "serial.h"
+#include "pcf8574.h"
+#include "includes.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#define CHECK(c)	do{if(!(c)){printf("modbus: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define BAUD		19200
+#define SLAVE		17
+#define ABSENT		18							//ûվ
+
+static u32 dir_tx,dir_rx;						//RS485л/յĴ
+static u32 stray;								//MODBUS_Input֡
+
+//RS485PCF8574P6(RS485_DE_MODEΪ0),ֻ
+u8 PCF8574_Init(void)
+{
+	return 0;
+}
+
+void PCF8574_WriteBit(u8 bit,u8 sta)
+{
+	if(bit!=RS485_RE_IO)return;
+	if(sta)dir_tx++;
+	else dir_rx++;
+}
+
+//PCʱƽDWT->CYCCNT(400MHz),modbus.cʱ
+static void tick(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	DWT->CYCCNT=(u32)((uint64_t)ts.tv_sec*400000000u+ts.tv_nsec/10*4);
+}
+
+//rs485_taskһѭ
+static void rs485_loop(void)
+{
+	u8 buf[256];
+	u8 len;
+	tick();
+	RS485_Wait(MODBUS_Poll());
+	tick();
+	RS485_Receive_Data(buf,&len);
+	if(len&&!MODBUS_Input(buf,len))stray++;
+}
+
+/////////////////////////////////////վ//////////////////////////////////////////
+
+static u16 sl_hold[10];
+static u16 sl_input[4]={100,200,300,400};
+static u8 sl_coils[2];
+static u8 sl_disc[1]={0xA5};
+
+//ּĴдص,Ĵ9дʧ
+static u8 sl_write(u16 addr,u16 num)
+{
+	return addr+num>9;
+}
+
+static const _mb_map sl_map[]=
+{
+	{MB_HOLDING,0,10,sl_hold,sl_write},
+	{MB_INPUT,100,4,sl_input,0},
+	{MB_COIL,0,16,sl_coils,0},
+	{MB_DISCRETE,0,8,sl_disc,0},
+};
+
+//ӽ:һpty豸,׼رʱͳƲ˳
+static void slave(void)
+{
+	struct pollfd p;
+	u8 i;
+	for(i=0;i<10;i++)sl_hold[i]=1000+i;
+	RS485_Init(BAUD);
+	MODBUS_Init(BAUD);
+	MODBUS_Slave(SLAVE,sl_map,4);
+	printf("%s\n",SERIAL_HostPath(SERIAL2));
+	fflush(stdout);
+	p.fd=0;
+	p.events=POLLIN;
+	while(poll(&p,1,0)==0)rs485_loop();
+	MODBUS_Report();
+	fflush(stdout);
+	exit(0);
+}
+
+/////////////////////////////////////վ//////////////////////////////////////////
+
+static int bus_fd[2];							//վʹվptyĴӶ
+static int done_n;								//ɵ
+static _modbus_req *done_log[16];				//˳
+
+//pty֮ת߳,argΪԴ±
+static void *bus_thread(void *arg)
+{
+	int i=(int)(intptr_t)arg;
+	u8 buf[256];
+	ssize_t n;
+	while((n=read(bus_fd[i],buf,sizeof(buf)))>0)
+	{
+		if(write(bus_fd[i^1],buf,n)!=n)break;
+	}
+	return NULL;
+}
+
+static void done(_modbus_req *r,u16 err)
+{
+	(void)err;
+	if(done_n<16)done_log[done_n]=r;
+	done_n++;
+}
+
+static void req(_modbus_req *r,u8 slave,u8 fc,u16 addr,u16 num,void *data)
+{
+	memset(r,0,sizeof(*r));
+	r->slave=slave;
+	r->fc=fc;
+	r->addr=addr;
+	r->num=num;
+	r->data=data;
+	r->done=done;
+}
+
+//ѭn,ms
+static int wait_done(int n,u32 ms)
+{
+	u32 t=OSTimeGet();
+	while(done_n<n&&OSTimeGet()-t<ms)rs485_loop();
+	return done_n>=n;
+}
+
+//MODBUS_Report
+static char *report(void)
+{
+	static char buf[4096];
+	int p[2],out;
+	ssize_t n;
+	fflush(stdout);
+	if(pipe(p))return "";
+	out=dup(1);
+	dup2(p[1],1);
+	MODBUS_Report();
+	fflush(stdout);
+	dup2(out,1);
+	close(out);
+	close(p[1]);
+	n=read(p[0],buf,sizeof(buf)-1);
+	close(p[0]);
+	buf[n>0?n:0]=0;
+	return buf;
+}
+
+//8,
+static int test_fc(void)
+{
+	static _modbus_req r[9];
+	u16 hold[10],regs[2]={7,8},in[4];
+	u8 coils[2],wcoils[1]={0x0B},disc[1];
+	int i;
+	done_n=0;
+	req(&r[0],SLAVE,MB_FC_READ_HOLDING,0,10,hold);
+	req(&r[1],SLAVE,MB_FC_WRITE_REGS,2,2,regs);
+	req(&r[2],SLAVE,MB_FC_WRITE_REG,4,0x1234,NULL);
+	req(&r[3],SLAVE,MB_FC_READ_HOLDING,0,5,hold+5);		//ǰ5hold[5..9]
+	req(&r[4],SLAVE,MB_FC_WRITE_COIL,3,0xFF00,NULL);
+	req(&r[5],SLAVE,MB_FC_WRITE_COILS,8,4,wcoils);
+	req(&r[6],SLAVE,MB_FC_READ_COILS,0,16,coils);
+	req(&r[7],SLAVE,MB_FC_READ_DISCRETE,0,8,disc);
+	for(i=0;i<8;i++)CHECK(MODBUS_Submit(&r[i])==0);
+	req(&r[8],SLAVE,MB_FC_READ_INPUT,100,4,in);
+	CHECK(MODBUS_Submit(&r[8])==1);				//
+	CHECK(MODBUS_Pending()==8);
+	req(&r[8],0,MB_FC_READ_INPUT,100,4,in);
+	CHECK(MODBUS_Submit(&r[8])==2);				//㲥ܶ
+	CHECK(wait_done(8,2000));
+	for(i=0;i<8;i++)CHECK(done_log[i]==&r[i]&&r[i].err==0);
+	CHECK(hold[0]==1000&&hold[4]==1004);
+	CHECK(hold[5]==1000&&hold[7]==7&&hold[8]==8&&hold[9]==0x1234);
+	CHECK(coils[0]==0x08&&coils[1]==0x0B);
+	CHECK(disc[0]==0xA5);
+	req(&r[8],SLAVE,MB_FC_READ_INPUT,100,4,in);
+	CHECK(MODBUS_Submit(&r[8])==0&&wait_done(9,1000));
+	CHECK(r[8].err==0&&in[0]==100&&in[3]==400&&r[8].rtt>0);
+	return 0;
+}
+
+//쳣Ӧ𡢳ʱ㲥
+static int test_error(void)
+{
+	static _modbus_req r[5];
+	u16 hold[1];
+	u32 t,left;
+	done_n=0;
+	req(&r[0],SLAVE,MB_FC_READ_HOLDING,50,1,hold);
+	req(&r[1],SLAVE,MB_FC_WRITE_REG,9,1,NULL);		//дصʧ
+	CHECK(MODBUS_Submit(&r[0])==0&&MODBUS_Submit(&r[1])==0&&wait_done(2,1000));
+	CHECK(r[0].err==MB_EX_ADDRESS&&r[1].err==MB_EX_FAILURE);
+
+	req(&r[2],ABSENT,MB_FC_READ_HOLDING,0,1,hold);
+	r[2].timeout=50;
+	CHECK(MODBUS_Submit(&r[2])==0);
+	t=OSTimeGet();
+	left=MODBUS_Poll();							//,ֵʣʱ
+	CHECK(left>=1&&left<=MODBUS_POLL_MAX);
+	CHECK(wait_done(3,1000));
+	t=OSTimeGet()-t;
+	CHECK(r[2].err==MB_ERR_TIMEOUT&&t>=50&&t<150);
+
+	req(&r[3],0,MB_FC_WRITE_REG,5,0x55,NULL);		//㲥,ûӦ,MODBUS_BCAST_DELAY
+	req(&r[4],SLAVE,MB_FC_READ_HOLDING,5,1,hold);
+	CHECK(MODBUS_Submit(&r[3])==0&&MODBUS_Submit(&r[4])==0&&wait_done(5,1000));
+	CHECK(r[3].err==0&&r[4].err==0&&hold[0]==0x55);
+	return 0;
+}
+
+//˫:һMODBUS_Poll,ֻ֮Ӧ,һMODBUS_Input
+static int test_pipeline(void)
+{
+	static _modbus_req r[4];
+	u16 hold[4][2];
+	u8 buf[256];
+	u8 len;
+	u32 t;
+	int i;
+	done_n=0;
+	for(i=0;i<4;i++)
+	{
+		req(&r[i],SLAVE,MB_FC_READ_HOLDING,i,2,hold[i]);
+		CHECK(MODBUS_Submit(&r[i])==0);
+	}
+	tick();
+	MODBUS_Poll();
+	CHECK(MODBUS_Pending()==4);					//1ڵӦ,1Ѿ,2ڶ
+	t=OSTimeGet();
+	while(done_n<4&&OSTimeGet()-t<1000)
+	{
+		if(!RS485_Wait(10))continue;
+		tick();
+		RS485_Receive_Data(buf,&len);
+		if(len)MODBUS_Input(buf,len);
+	}
+	CHECK(done_n==4&&MODBUS_Pending()==0);
+	for(i=0;i<4;i++)CHECK(r[i].err==0&&done_log[i]==&r[i]);
+	CHECK(hold[0][0]==1000&&hold[1][1]==7&&hold[3][1]==0x1234);
+	return 0;
+}
+
+//MODBUS_Input:֡,ûڵӦʱCRCͷվӦ
+static int test_input(void)
+{
+	u8 bad[8]={SLAVE,3,0,0,0,1,0,0};
+	u8 ok[7]={SLAVE,3,2,0,1};
+	u16 crc;
+	unsigned n;
+	char *s;
+	CHECK(MODBUS_Input(bad,3)==0);
+	CHECK(MODBUS_Input(bad,8)==1);
+	crc=mb_crc16(ok,5);
+	ok[5]=crc&0xFF;
+	ok[6]=crc>>8;
+	CHECK(MODBUS_Input(ok,7)==1);
+	s=strstr(report(),"crc err");
+	CHECK(s&&sscanf(s,"crc err %u",&n)==1&&n==1);
+	s=strstr(s,"stray");
+	CHECK(s&&sscanf(s,"stray %u",&n)==1&&n==1);
+	if(write(bus_fd[1],bad,8)!=8)return 1;		//վյCRC
+	return 0;
+}
+
+//վÿվͳ
+static int test_stat(void)
+{
+	unsigned rq,ok,ex,to,err,bps,last,avg,max;
+	char *s=report();
+	char *p=strstr(s,"modbus slave 17:");
+	CHECK(p&&sscanf(p,"modbus slave 17: req %u ok %u ex %u timeout %u err %u, %u B/s, rtt last %u avg %u max %u us",
+		&rq,&ok,&ex,&to,&err,&bps,&last,&avg,&max)==9);
+	CHECK(rq==16&&ok==14&&ex==2&&to==0&&err==0);
+	CHECK(bps>0&&last>0&&avg>0&&max>=avg&&avg<100000);
+	p=strstr(s,"modbus slave 18:");
+	CHECK(p&&sscanf(p,"modbus slave 18: req %u ok %u ex %u timeout %u",&rq,&ok,&ex,&to)==4);
+	CHECK(rq==1&&ok==0&&to==1);
+	CHECK(strstr(s,"modbus slave 0:")==NULL);	//㲥ͳ
+	CHECK(dir_tx==18&&dir_rx==dir_tx+1);		//ÿη(ʱ͹㲥)лһη,RS485_InitΪһ
+	return 0;
+}
+
+//վͳ:㲥,CRCӦ
+static int test_slave(FILE *in)
+{
+	char line[256];
+	unsigned addr,rq,ex,crc;
+	int found=0;
+	while(fgets(line,sizeof(line),in))
+	{
+		if(strstr(line,"slave addr")==NULL)continue;
+		CHECK(sscanf(strstr(line,"slave addr"),"slave addr %u req %u ex %u, crc err %u",&addr,&rq,&ex,&crc)==4);
+		CHECK(addr==SLAVE&&rq==17&&ex==2&&crc==1);
+		found=1;
+	}
+	CHECK(found);
+	return 0;
+}
+
+int main(void)
+{
+	int out[2],in[2],ret,status;
+	char path[64];
+	pthread_t th;
+	FILE *f;
+	pid_t pid;
+	if(pipe(out)||pipe(in))return 1;
+	pid=fork();
+	if(pid==0)
+	{
+		dup2(out[1],1);
+		dup2(in[0],0);
+		close(out[0]);
+		close(in[1]);
+		slave();
+	}
+	close(out[1]);
+	close(in[0]);
+	f=fdopen(out[0],"r");
+	if(pid<0||fgets(path,sizeof(path),f)==NULL)
+	{
+		printf("modbus: FAILED to start the slave\n");
+		return 1;
+	}
+	path[strcspn(path,"\n")]=0;
+	RS485_Init(BAUD);
+	MODBUS_Init(BAUD);
+	bus_fd[0]=open(SERIAL_HostPath(SERIAL2),O_RDWR|O_NOCTTY);
+	bus_fd[1]=open(path,O_RDWR|O_NOCTTY);
+	if(bus_fd[0]<0||bus_fd[1]<0)return 1;
+	pthread_create(&th,NULL,bus_thread,(void*)0);
+	pthread_create(&th,NULL,bus_thread,(void*)1);
+	ret=test_fc()||test_error()||test_pipeline()||test_input()||test_stat();
+	usleep(50000);								//ȴվһ֡
+	close(in[1]);								//վͳƺ˳
+	if(!ret)ret=test_slave(f);
+	waitpid(pid,&status,0);
+	if(ret)return 1;
+	printf("modbus: ok (master and slave over a pty bus at %u baud, %u requests)\n",BAUD,dir_tx);
+	return 0;
+}
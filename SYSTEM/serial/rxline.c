@@ -0,0 +1,273 @@
+#include "rxline.h"
+//////////////////////////////////////////////////////////////////////////////////
+//ڽշ֡
+//:2026/10/19
+//汾V1.3
+//////////////////////////////////////////////////////////////////////////////////
+
+//ʼһ
+static void rxline_q_init(_rxline_q *q,uint8_t *buf,uint16_t *len,uint8_t num,uint16_t size)
+{
+	q->buf=buf;
+	q->len=len;
+	q->size=size;
+	q->num=num;
+	q->head=0;
+	q->tail=0;
+	q->over=0;
+	q->drop=0;
+}
+
+//ʼ
+//mode:֡ʽ,RXLINE_MODE_LINE/RXLINE_MODE_IDLE/RXLINE_MODE_LEN
+//buf:л,num*sizeֽ
+//len:гȱ,num
+//num:,2(1~128),ʱŲλ
+//size:ÿ󳤶
+void rxline_init(_rxline *r,uint8_t mode,uint8_t *buf,uint16_t *len,uint8_t num,uint16_t size)
+{
+	rxline_q_init(&r->q[RXLINE_TEXT],buf,len,num,size);
+	rxline_q_init(&r->q[RXLINE_BIN],0,0,0,0);
+	r->cur=0;
+	r->mode=mode;
+	r->bin=0;
+	r->skip=0;
+	r->need=0;
+	r->wait=0;
+	r->chr=0;
+	r->gap=0;
+	r->last=0;
+}
+
+//ָ֡,֮0x00ʼݰ֡,ͬrxline_init
+void rxline_init_bin(_rxline *r,uint8_t *buf,uint16_t *len,uint8_t num,uint16_t size)
+{
+	rxline_q_init(&r->q[RXLINE_BIN],buf,len,num,size);
+}
+
+//һ,
+static void rxline_done(_rxline *r,_rxline_q *q)
+{
+	q->len[q->head%q->num]=r->cur;
+	r->cur=0;
+	q->head++;									//дƶhead
+}
+
+//βĿ
+static uint8_t *rxline_tail(_rxline_q *q)
+{
+	return q->buf+(uint16_t)(q->head%q->num)*q->size;
+}
+
+//Ƿ
+static uint8_t rxline_full(_rxline_q *q)
+{
+	return (uint8_t)(q->head-q->tail)>=q->num;
+}
+
+//з֡,һֽ
+//ֵ:1,һ
+static uint8_t rxline_put_line(_rxline *r,uint8_t c)
+{
+	_rxline_q *q;
+	uint8_t *line;
+	uint8_t done=0;
+	if(c==0&&r->q[RXLINE_BIN].num)				//֡Ŀʼ
+	{
+		if(r->bin&&r->cur&&!r->skip)			//֡
+		{
+			rxline_done(r,&r->q[RXLINE_BIN]);
+			done=1;
+			r->bin=0;
+		}else if(r->bin&&r->skip)r->bin=0;		//֡
+		else r->bin=1;							//֡ʼ,ûı
+		r->cur=0;
+		r->skip=0;
+		return done;
+	}
+	q=&r->q[r->bin];
+	if(r->skip)									//,β
+	{
+		if(!r->bin&&c=='\n')r->skip=0;
+		return 0;
+	}
+	if(r->cur==0&&rxline_full(q))				//µһ,
+	{
+		q->drop++;
+		if(r->bin||c!='\n')r->skip=1;
+		return 0;
+	}
+	line=rxline_tail(q);
+	if(!r->bin&&c=='\n')						//һн
+	{
+		if(r->cur&&line[r->cur-1]=='\r')r->cur--;
+		rxline_done(r,q);
+		return 1;
+	}
+	if(r->cur<q->size)line[r->cur++]=c;
+	else										//̫,ж
+	{
+		q->over++;
+		r->cur=0;
+		r->skip=1;
+	}
+	return 0;
+}
+
+//з֡,һֽ,֡rxline_idle
+static void rxline_put_idle(_rxline *r,uint8_t c)
+{
+	_rxline_q *q=&r->q[RXLINE_TEXT];
+	if(r->skip)return;
+	if(r->cur==0&&rxline_full(q))
+	{
+		q->drop++;
+		r->skip=1;
+		return;
+	}
+	if(r->cur<q->size)rxline_tail(q)[r->cur++]=c;
+	else
+	{
+		q->over++;
+		r->cur=0;
+		r->skip=1;
+	}
+}
+
+//ǰ׺֡,һֽ
+//ֵ:1,һ֡
+static uint8_t rxline_put_len(_rxline *r,uint8_t c)
+{
+	_rxline_q *q=&r->q[RXLINE_TEXT];
+	if(r->need==0)								//ֽ
+	{
+		if(c==0)return 0;
+		r->need=c;
+		r->cur=0;
+		r->skip=0;
+		if(c>q->size)
+		{
+			q->over++;
+			r->skip=1;
+		}else if(rxline_full(q))
+		{
+			q->drop++;
+			r->skip=1;
+		}
+		return 0;
+	}
+	if(!r->skip)rxline_tail(q)[r->cur++]=c;
+	if(--r->need)return 0;
+	if(r->skip)
+	{
+		r->skip=0;
+		return 0;
+	}
+	rxline_done(r,q);
+	return 1;
+}
+
+//յ,ֱƴβĿ,⿽
+//data:
+//n:
+//ֵ:ɵ(ıкͶ֡)
+uint8_t rxline_put(_rxline *r,const uint8_t *data,uint16_t n)
+{
+	uint8_t done=0;
+	switch(r->mode)
+	{
+		case RXLINE_MODE_LINE:
+			while(n--)done+=rxline_put_line(r,*data++);
+			break;
+		case RXLINE_MODE_IDLE:
+			while(n--)rxline_put_idle(r,*data++);
+			break;
+		case RXLINE_MODE_LEN:
+			while(n--)done+=rxline_put_len(r,*data++);
+			break;
+	}
+	return done;
+}
+
+//߿,з֡ʱǰ֡,ǰ׺֡ʱû֡
+//ֵ:ɵ
+uint8_t rxline_idle(_rxline *r)
+{
+	if(r->mode==RXLINE_MODE_IDLE)
+	{
+		if(r->cur&&!r->skip)
+		{
+			rxline_done(r,&r->q[RXLINE_TEXT]);
+			return 1;
+		}
+		r->cur=0;
+		r->skip=0;
+	}else if(r->mode==RXLINE_MODE_LEN&&r->need)
+	{
+		if(!r->skip)r->q[RXLINE_TEXT].over++;	//֡
+		r->need=0;
+		r->cur=0;
+		r->skip=0;
+	}
+	return 0;
+}
+
+//ճʱ,ʱ̵ĵλɵ߾(λʱ䡢΢),rxline_put_at/rxline_pollһ
+//gap:֡,һֽڽ󳬹gapûֽʱһ֡;0,
+//chr:һֽڵʱ
+void rxline_set_gap(_rxline *r,uint32_t gap,uint16_t chr)
+{
+	r->gap=gap;
+	r->chr=chr;
+}
+
+//յݲʱ,nֽյ
+//t:һֽڽʱ,һֽt-n*chrʼ
+//ֵ:ɵ,һݼgapһ֡
+uint8_t rxline_put_at(_rxline *r,const uint8_t *data,uint16_t n,uint32_t t)
+{
+	uint8_t done=0;
+	if(n==0)return 0;
+	if(r->gap&&r->wait&&(int32_t)(t-(uint32_t)n*r->chr-r->last)>=(int32_t)r->gap)
+		done=rxline_idle(r);					//rxline_pollûмʱ,Ƚһ֡
+	r->last=t;
+	r->wait=r->gap!=0;
+	return done+rxline_put(r,data,n);
+}
+
+//ճʱ,൱ڽճʱж
+//now:ǰʱ
+//ֵ:ɵ
+uint8_t rxline_poll(_rxline *r,uint32_t now)
+{
+	if(!r->wait||(int32_t)(now-r->last)<(int32_t)r->gap)return 0;
+	r->wait=0;
+	return rxline_idle(r);
+}
+
+//ȡһ
+//type:RXLINE_TEXT,ı(/ȷ֡֡);RXLINE_BIN,֡
+//len:г
+//ֵ:,NULLʾû
+uint8_t *rxline_peek(_rxline *r,uint8_t type,uint16_t *len)
+{
+	_rxline_q *q=&r->q[type];
+	uint8_t i;
+	if(q->head==q->tail)return 0;
+	i=q->tail%q->num;
+	*len=q->len[i];
+	return q->buf+(uint16_t)i*q->size;
+}
+
+//ͷһ,ͷźrxline_peekصָ벻
+void rxline_pop(_rxline *r,uint8_t type)
+{
+	_rxline_q *q=&r->q[type];
+	if(q->head!=q->tail)q->tail++;
+}
+
+//Ŷе
+uint8_t rxline_count(_rxline *r,uint8_t type)
+{
+	return (uint8_t)(r->q[type].head-r->q[type].tail);
+}
@@ -0,0 +1,77 @@
+#ifndef _RXLINE_H
+#define _RXLINE_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//ڽշ֡
+//ѽյֽг/֡,,ͬʱŶӶ
+//ֻñ׼C,HALOS,PCϱ
+//:2026/10/19
+//汾V1.3
+//********************************************************************************
+//ʹ÷:
+//1,rxline_init()ָ֡ʽл(num*sizeֽ)гȱ(num)
+//2,жrxline_put()յ,߿ʱrxline_idle()
+//3,rxline_peek()ȡһ,rxline_pop()ͷ
+//(ж)(),Ҫж
+//֡ʽ:
+//RXLINE_MODE_LINE,'\n',β"\r\n"'\n'г
+//RXLINE_MODE_IDLE,߿(rxline_idle)ʱһ֡,ʺRS485Ȱʱ֡
+//RXLINE_MODE_LEN,һֽΪݳ(1~255),ֽڲ;ʱû֡
+//sizeкͶʱյж
+//ճʱ:ûӲճʱ(PCģ)ʱ,rxline_set_gap()֡,
+//ʱrxline_put_at()ʱ,ʱrxline_poll(),ûֽʱrxline_idle()һһ֡
+//********************************************************************************
+//V1.1 20261019
+//Ӷ֡:rxline_init_bin()֮,0x00ʼ0x00(COBS,мû0x00)
+//Ϊһ֡뵥֡,ıлһ;0x00ͬ
+//V1.2 20261019
+//ļƵSYSTEM/serial,ӿз֡ͳǰ׺֡,rxline_initmode
+//V1.3 20261019
+//ճʱ:rxline_set_gap()/rxline_put_at()/rxline_poll()
+//////////////////////////////////////////////////////////////////////////////////
+
+#define RXLINE_TEXT				0		//ıж(/ȷ֡֡)
+#define RXLINE_BIN				1		//֡
+
+#define RXLINE_MODE_LINE		0		//'\n'
+#define RXLINE_MODE_IDLE		1		//߿з֡
+#define RXLINE_MODE_LEN			2		//ǰ׺֡
+
+//һ
+typedef struct
+{
+	uint8_t *buf;				//,num*sizeֽ
+	uint16_t *len;				//ÿеĳ
+	uint16_t size;				//ÿ󳤶
+	uint8_t num;				//,2,128;0ʾʹ
+	volatile uint8_t head;		//ɵ(ɼ,ֻ޸)
+	volatile uint8_t tail;		//ͷŵ(ɼ,ֻ޸)
+	uint32_t over;				//
+	uint32_t drop;				//
+}_rxline_q;
+
+typedef struct
+{
+	_rxline_q q[2];				//ıж,֡
+	uint16_t cur;				//ڽյеĳ
+	uint8_t mode;				//֡ʽ
+	uint8_t bin;				//1,ڽն֡
+	uint8_t skip;				//1,β(ıΪ'\n',֡Ϊ0x00)Ϊֹ
+	uint8_t need;				//ǰ׺֡:ǰֽ֡
+	uint8_t wait;				//ճʱ:1,յ,ûгʱ
+	uint16_t chr;				//ճʱ:һֽڵʱ
+	uint32_t gap;				//ճʱ:֡,0ʾ
+	uint32_t last;				//ճʱ:һֽڽʱ
+}_rxline;
+
+void rxline_init(_rxline *r,uint8_t mode,uint8_t *buf,uint16_t *len,uint8_t num,uint16_t size);	//ʼ
+void rxline_init_bin(_rxline *r,uint8_t *buf,uint16_t *len,uint8_t num,uint16_t size);	//ָ֡,ֻڰз֡
+uint8_t rxline_put(_rxline *r,const uint8_t *data,uint16_t n);		//,ɵ
+uint8_t rxline_idle(_rxline *r);									//߿,ɵ
+void rxline_set_gap(_rxline *r,uint32_t gap,uint16_t chr);			//ճʱ
+uint8_t rxline_put_at(_rxline *r,const uint8_t *data,uint16_t n,uint32_t t);	//ݲʱ
+uint8_t rxline_poll(_rxline *r,uint32_t now);						//ճʱ,ɵ
+uint8_t *rxline_peek(_rxline *r,uint8_t type,uint16_t *len);		//ȡһ,NULLʾû
+void rxline_pop(_rxline *r,uint8_t type);							//ͷһ
+uint8_t rxline_count(_rxline *r,uint8_t type);						//Ŷе
+#endif
@@ -0,0 +1,175 @@
+//////////////////////////////////////////////////////////////////////////////////
+//rxlinePC,Keil,TOOLS/hosttest.sh:
+//gcc -ISYSTEM/serial SYSTEM/serial/rxline_test.c SYSTEM/serial/rxline.c
+//ַ֡ʽ֡С/ơճʱ(ϳɵֽʱ);
+//"bench"ʱⰴз֡ٶ
+//////////////////////////////////////////////////////////////////////////////////
+#include "rxline.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(c)	do{if(!(c)){printf("rxline: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define PUT(s)		rxline_put(&r,(const uint8_t*)(s),sizeof(s)-1)
+
+static _rxline r;
+static uint8_t buf[8*64],bbuf[2*6];
+static uint16_t len[8],blen[2];
+
+//ȡһвsȽ,Ȼͷ
+static int pop_is(uint8_t type,const char *s,uint16_t n)
+{
+	uint16_t l;
+	uint8_t *p=rxline_peek(&r,type,&l);
+	if(p==0||l!=n||memcmp(p,s,n))return 0;
+	rxline_pop(&r,type);
+	return 1;
+}
+
+//з֡
+static int test_line(void)
+{
+	char s[8];
+	int i;
+	rxline_init(&r,RXLINE_MODE_LINE,buf,len,4,8);
+	CHECK(PUT("ab\r\ncd\nxyz")==2);
+	CHECK(pop_is(RXLINE_TEXT,"ab",2));
+	CHECK(pop_is(RXLINE_TEXT,"cd",2));
+	CHECK(rxline_peek(&r,RXLINE_TEXT,len)==0);
+	CHECK(PUT("\r\n")==1);					//յ
+	CHECK(pop_is(RXLINE_TEXT,"xyz",3));
+	CHECK(PUT("123456789\nok\n")==1);		//ж
+	CHECK(r.q[RXLINE_TEXT].over==1);
+	CHECK(pop_is(RXLINE_TEXT,"ok",2));
+	CHECK(PUT("a\0b\n")==1);				//ûж֡ʱ0x00ͨ
+	CHECK(pop_is(RXLINE_TEXT,"a\0b",3));
+	CHECK(PUT("\n")==1&&pop_is(RXLINE_TEXT,"",0));	//
+	for(i=0;i<6;i++)PUT("L\n");				//,2
+	CHECK(rxline_count(&r,RXLINE_TEXT)==4&&r.q[RXLINE_TEXT].drop==2);
+	for(i=0;i<1000;i++)						//head/tail
+	{
+		rxline_pop(&r,RXLINE_TEXT);
+		sprintf(s,"%d\n",i);
+		rxline_put(&r,(uint8_t*)s,strlen(s));
+	}
+	for(i=996;i<1000;i++)
+	{
+		sprintf(s,"%d",i);
+		CHECK(pop_is(RXLINE_TEXT,s,strlen(s)));
+	}
+	rxline_pop(&r,RXLINE_TEXT);				//նpopЧ
+	CHECK(rxline_count(&r,RXLINE_TEXT)==0);
+	return 0;
+}
+
+//з֡+֡
+static int test_bin(void)
+{
+	rxline_init(&r,RXLINE_MODE_LINE,buf,len,4,8);
+	rxline_init_bin(&r,bbuf,blen,2,6);
+	CHECK(PUT("te\0a\nb\0st\n")==2);		//֡ı,֡ڵ'\n'
+	CHECK(pop_is(RXLINE_BIN,"a\nb",3));
+	CHECK(pop_is(RXLINE_TEXT,"st",2));
+	CHECK(PUT("\0\0\0xy\0")==1);			//0x00ͬ
+	CHECK(pop_is(RXLINE_BIN,"xy",2));
+	CHECK(PUT("\0toolong!\0\0ok\0")==1&&r.q[RXLINE_BIN].over==1);
+	CHECK(pop_is(RXLINE_BIN,"ok",2));
+	CHECK(PUT("\0a\0\0b\0\0c\0")==2&&r.q[RXLINE_BIN].drop==1);
+	CHECK(pop_is(RXLINE_BIN,"a",1));
+	CHECK(pop_is(RXLINE_BIN,"b",1));
+	CHECK(rxline_count(&r,RXLINE_BIN)==0&&rxline_count(&r,RXLINE_TEXT)==0);
+	return 0;
+}
+
+//з֡ͳǰ׺֡
+static int test_idle_len(void)
+{
+	rxline_init(&r,RXLINE_MODE_IDLE,buf,len,4,8);
+	CHECK(PUT("ab\ncd")==0);
+	CHECK(rxline_idle(&r)==1&&rxline_idle(&r)==0);
+	CHECK(pop_is(RXLINE_TEXT,"ab\ncd",5));
+	PUT("123456789");						//֡,һ֡
+	CHECK(rxline_idle(&r)==0&&r.q[RXLINE_TEXT].over==1);
+	PUT("x");
+	CHECK(rxline_idle(&r)==1&&pop_is(RXLINE_TEXT,"x",1));
+	PUT("a");rxline_idle(&r);PUT("b");rxline_idle(&r);
+	PUT("c");rxline_idle(&r);PUT("d");rxline_idle(&r);
+	PUT("e");rxline_idle(&r);				//
+	CHECK(rxline_count(&r,RXLINE_TEXT)==4&&r.q[RXLINE_TEXT].drop==1);
+
+	rxline_init(&r,RXLINE_MODE_LEN,buf,len,4,8);
+	CHECK(PUT("\3abc\0\2xy")==2);			//Ϊ0ֽں
+	CHECK(pop_is(RXLINE_TEXT,"abc",3));
+	CHECK(pop_is(RXLINE_TEXT,"xy",2));
+	CHECK(PUT("\x09" "123456789" "\1z")==1&&r.q[RXLINE_TEXT].over==1);
+	CHECK(pop_is(RXLINE_TEXT,"z",1));
+	CHECK(PUT("\5ab")==0);					//ûͿ,
+	rxline_idle(&r);
+	CHECK(r.q[RXLINE_TEXT].over==2);
+	CHECK(PUT("\1k")==1&&pop_is(RXLINE_TEXT,"k",1));
+	return 0;
+}
+
+//ʱֽ,ʱ̵ĵλΪλ(һֽ10λ),iֽڵֹͣλt[i]
+static void feed(const uint8_t *d,const uint16_t *t,int n)
+{
+	int i;
+	for(i=0;i<n;i++)rxline_put_at(&r,&d[i],1,t[i]);
+}
+
+//ճʱ֡(RS485_RX_GAP)
+static int test_rto(void)
+{
+	static const uint8_t d[]={1,2,3,4,5,6};
+	static const uint16_t t1[]={10,20,30,60,70,80};		//34ֽ֮20λ
+	static const uint16_t t2[]={10,24,38,52,66,80};		//ֽ֮4λ
+	rxline_init(&r,RXLINE_MODE_IDLE,buf,len,8,64);
+	rxline_set_gap(&r,5,10);				//ʱ5λ:ֳ֡
+	feed(d,t1,6);
+	CHECK(rxline_count(&r,RXLINE_TEXT)==1);
+	CHECK(rxline_poll(&r,84)==0);			//һֽ֮󻹲5λ
+	CHECK(rxline_poll(&r,85)==1&&rxline_poll(&r,200)==0);
+	CHECK(pop_is(RXLINE_TEXT,"\1\2\3",3));
+	CHECK(pop_is(RXLINE_TEXT,"\4\5\6",3));
+	rxline_set_gap(&r,35,10);				//MODBUS 3.5ַ:һ֡
+	feed(d,t1,6);
+	CHECK(rxline_poll(&r,114)==0&&rxline_poll(&r,115)==1);
+	CHECK(pop_is(RXLINE_TEXT,"\1\2\3\4\5\6",6));
+	rxline_set_gap(&r,5,10);				//Сڳʱļ֡
+	feed(d,t2,6);
+	CHECK(rxline_poll(&r,100)==1);
+	CHECK(pop_is(RXLINE_TEXT,"\1\2\3\4\5\6",6));
+	CHECK(rxline_put_at(&r,d,3,0xFFFFFFF0u)==0);	//ʱ̻,һֽ
+	CHECK(rxline_put_at(&r,d+3,3,0xFFFFFFF0u+35)==1);	//4ֽ5λ֮ſʼ
+	CHECK(rxline_put_at(&r,d,1,0xFFFFFFF0u+45)==0&&rxline_poll(&r,0xFFFFFFF0u+50)==1);
+	CHECK(pop_is(RXLINE_TEXT,"\1\2\3",3));
+	CHECK(pop_is(RXLINE_TEXT,"\4\5\6\1",4));
+	return 0;
+}
+
+//з֡ٶ,ÿ64ֽ(DMA봫һ),ΪMB/s
+static void bench(void)
+{
+	static uint8_t in[64];
+	uint32_t i,n=2000000,lines=0;
+	clock_t t0;
+	double t;
+	for(i=0;i<sizeof(in);i++)in[i]=(i%32==31)?'\n':'a'+i%26;
+	rxline_init(&r,RXLINE_MODE_LINE,buf,len,8,64);
+	t0=clock();
+	for(i=0;i<n;i++)
+	{
+		lines+=rxline_put(&r,in,sizeof(in));
+		while(rxline_count(&r,RXLINE_TEXT))rxline_pop(&r,RXLINE_TEXT);
+	}
+	t=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	printf("rxline bench: line mode %.0f MB/s (%u lines)\n",n*sizeof(in)/t/1e6,lines);
+}
+
+int main(int argc,char **argv)
+{
+	if(test_line()||test_bin()||test_idle_len()||test_rto())return 1;
+	printf("rxline: ok\n");
+	if(argc>1&&strcmp(argv[1],"bench")==0)bench();
+	return 0;
+}
@@ -0,0 +1,654 @@
+#include "serial.h"
+#include "delay.h"
+#include "string.h"
+#include "stdio.h"
+#if SYSTEM_SUPPORT_OS
+#include "includes.h"					//os ʹ
+#endif
+//////////////////////////////////////////////////////////////////////////////////
+//ͨô
+//:2026/10/19
+//汾V1.2
+//////////////////////////////////////////////////////////////////////////////////
+
+#if SYSTEM_SUPPORT_OS
+#define SERIAL_SR_ALLOC()		OS_CPU_SR cpu_sr=0
+#define SERIAL_ENTER_CRITICAL()	OS_ENTER_CRITICAL()
+#define SERIAL_EXIT_CRITICAL()	OS_EXIT_CRITICAL()
+#else
+#define SERIAL_SR_ALLOC()		u32 primask
+#define SERIAL_ENTER_CRITICAL()	{primask=__get_PRIMASK();__disable_irq();}
+#define SERIAL_EXIT_CRITICAL()	__set_PRIMASK(primask)
+#endif
+
+//SRAM3շ,
+#define SERIAL_SRAM3			0x30040000
+#define SERIAL1_TX_ADDR			SERIAL_SRAM3
+#define SERIAL1_RX_ADDR			(SERIAL1_TX_ADDR+SERIAL1_TX_LEN)
+#define SERIAL2_TX_ADDR			(SERIAL1_RX_ADDR+SERIAL1_RX_DMA_LEN)
+#define SERIAL2_RX_ADDR			(SERIAL2_TX_ADDR+SERIAL2_TX_LEN)
+#if SERIAL2_RX_ADDR+SERIAL2_RX_DMA_LEN>SERIAL_SRAM3+0x8000
+#error "շSRAM3"
+#endif
+
+//D-CacheΪ͸дģʽ,DMAͶ,ҪCache;ǰЧӦCache
+__align(32) u8 serial1_tx_buf[SERIAL1_TX_LEN] __attribute__((at(SERIAL1_TX_ADDR)));
+__align(32) u8 serial1_rx_dma[SERIAL1_RX_DMA_LEN] __attribute__((at(SERIAL1_RX_ADDR)));
+__align(32) u8 serial2_tx_buf[SERIAL2_TX_LEN] __attribute__((at(SERIAL2_TX_ADDR)));
+__align(32) u8 serial2_rx_dma[SERIAL2_RX_DMA_LEN] __attribute__((at(SERIAL2_RX_ADDR)));
+
+//֡
+static u8 serial1_rx_buf[SERIAL1_RX_NUM][SERIAL1_RX_LEN];
+static u16 serial1_rx_len[SERIAL1_RX_NUM];
+#if SERIAL1_BIN_NUM
+static u8 serial1_bin_buf[SERIAL1_BIN_NUM][SERIAL1_BIN_LEN];
+static u16 serial1_bin_len[SERIAL1_BIN_NUM];
+#endif
+static u8 serial2_rx_buf[SERIAL2_RX_NUM][SERIAL2_RX_LEN];
+static u16 serial2_rx_len[SERIAL2_RX_NUM];
+
+//ÿڹ̶Դ
+typedef struct
+{
+	USART_TypeDef *uart;		//
+	IRQn_Type irq;				//ж
+	GPIO_TypeDef *gpio;			//TX/RXڶ˿
+	u32 pins;					//TX/RX
+	u8 af;						//Ÿù
+	DMA_Stream_TypeDef *txdma;	//DMA
+	u32 txreq;					//DMA
+	IRQn_Type txirq;			//DMAж
+	DMA_Stream_TypeDef *rxdma;	//DMA
+	u32 rxreq;					//DMA
+	IRQn_Type rxirq;			//DMAж
+	u8 *txbuf;					//ͻλ
+	u16 txlen;					//ͻλС
+	u8 *rxdma_buf;				//DMAѭջ
+	u16 rxdma_len;				//DMAѭջС
+	u8 mode;					//֡ʽ
+	u8 *rxbuf;					//֡
+	u16 *rxlen;
+	u8 rxnum;
+	u16 rxsize;
+	u8 *binbuf;					//֡,ֻڰз֡
+	u16 *binlen;
+	u8 binnum;
+	u16 binsize;
+}_serial_cfg;
+
+static const _serial_cfg serial_cfg[SERIAL_NUM]=
+{
+	{USART1,USART1_IRQn,GPIOA,GPIO_PIN_9|GPIO_PIN_10,GPIO_AF7_USART1,
+	 DMA2_Stream7,DMA_REQUEST_USART1_TX,DMA2_Stream7_IRQn,DMA2_Stream2,DMA_REQUEST_USART1_RX,DMA2_Stream2_IRQn,
+	 serial1_tx_buf,SERIAL1_TX_LEN,serial1_rx_dma,SERIAL1_RX_DMA_LEN,
+	 SERIAL1_RX_MODE,serial1_rx_buf[0],serial1_rx_len,SERIAL1_RX_NUM,SERIAL1_RX_LEN,
+#if SERIAL1_BIN_NUM
+	 serial1_bin_buf[0],serial1_bin_len,SERIAL1_BIN_NUM,SERIAL1_BIN_LEN},
+#else
+	 0,0,0,0},
+#endif
+	{USART2,USART2_IRQn,GPIOA,GPIO_PIN_2|GPIO_PIN_3,GPIO_AF7_USART2,
+	 DMA1_Stream1,DMA_REQUEST_USART2_TX,DMA1_Stream1_IRQn,DMA1_Stream0,DMA_REQUEST_USART2_RX,DMA1_Stream0_IRQn,
+	 serial2_tx_buf,SERIAL2_TX_LEN,serial2_rx_dma,SERIAL2_RX_DMA_LEN,
+	 SERIAL2_RX_MODE,serial2_rx_buf[0],serial2_rx_len,SERIAL2_RX_NUM,SERIAL2_RX_LEN,
+	 0,0,0,0},
+};
+
+//ÿʱ״̬
+//ͻλ˳Ϊ:tx_out->[DMAڷ]->tx_rd->[ȴ]->tx_wr->[]
+//DMAѭдջ,rx_rd֮ǰѾ֡
+typedef struct
+{
+	UART_HandleTypeDef huart;	//HAL
+	DMA_HandleTypeDef hdmatx;	//DMA
+	DMA_HandleTypeDef hdmarx;	//DMA
+	volatile u16 tx_out;		//DMAڷ͵ʼλ,tx_rdʱDMA
+	volatile u16 tx_rd;			//һνDMA͵ʼλ
+	volatile u16 tx_wr;			//дλ
+	u16 tx_peak;				//ͻʹ(ֽ)
+	u32 tx_drop;				//򻺳ֽ
+	u8 tx_busy;					//1,(ӿʼ͵ȫ)
+	void (*dir)(u8 tx);			//շص,Ϳʼʱdir(1),ȫʱdir(0),ڹжʱ
+	u16 rx_rd;					//һҪλ
+	u32 rx_err;					//ճ(//֡)
+	u32 rx_rto;					//ճʱ(λ),0ʾÿжϽһ֡
+	_rxline rx;					//֡
+#if SYSTEM_SUPPORT_OS
+	OS_EVENT *sem;				//յ֡ʱ͵ź,һSERIAL_Waitʱ
+#endif
+}_serial_dev;
+
+static _serial_dev serial_dev[SERIAL_NUM];
+
+//HALҴں
+//ֵ:ں,SERIAL_NUMʾǱĴ
+static u8 serial_port(UART_HandleTypeDef *huart)
+{
+	u8 i;
+	for(i=0;i<SERIAL_NUM;i++)if(huart==&serial_dev[i].huart)break;
+	return i;
+}
+
+//DMA͵ȴ͵,ڹжʱ
+//һֻ͵ĩβ,Ʋڷж
+static void serial_tx_start(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	const _serial_cfg *c=&serial_cfg[port];
+	u16 len;
+	if(d->tx_out!=d->tx_rd||d->tx_rd==d->tx_wr)return;	//DMAڷͻû
+	if(d->tx_wr>d->tx_rd)len=d->tx_wr-d->tx_rd;
+	else len=c->txlen-d->tx_rd;
+	if(!d->tx_busy&&d->dir)d->dir(1);				//еͷٷһֽ
+	if(HAL_UART_Transmit_DMA(&d->huart,&c->txbuf[d->tx_rd],len)!=HAL_OK)//δʼ,´дʱ
+	{
+		if(!d->tx_busy&&d->dir)d->dir(0);
+		return;
+	}
+	d->tx_busy=1;
+	d->tx_rd=(d->tx_rd+len)&(c->txlen-1);
+}
+
+//DMAͽ,ʣµ,ȫʱлؽշ,ڹжʱ
+static void serial_tx_next(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	d->tx_out=d->tx_rd;
+	serial_tx_start(port);
+	if(d->tx_out==d->tx_rd&&d->tx_busy)				//û
+	{
+		d->tx_busy=0;
+		if(d->dir)d->dir(0);
+	}
+}
+
+//д뷢ͻ,ȴ,жﶼԵ
+//port:ں
+//buf:
+//len:
+//ֵ:дֽ,ʱĲּtx_drop
+u16 SERIAL_Write(u8 port,const u8 *buf,u16 len)
+{
+	_serial_dev *d=&serial_dev[port];
+	const _serial_cfg *c=&serial_cfg[port];
+	u16 mask=c->txlen-1;
+	u16 used,free,n;
+	SERIAL_SR_ALLOC();
+	SERIAL_ENTER_CRITICAL();
+	used=(d->tx_wr-d->tx_out)&mask;
+	free=mask-used;
+	if(len>free)
+	{
+#if SERIAL_TX_TRUNC
+		d->tx_drop+=len-free;
+		len=free;
+#else
+		d->tx_drop+=len;
+		len=0;
+#endif
+	}
+	n=c->txlen-d->tx_wr;			//ĩβĿռ
+	if(n>len)n=len;
+	memcpy(&c->txbuf[d->tx_wr],buf,n);
+	memcpy(c->txbuf,buf+n,len-n);
+	d->tx_wr=(d->tx_wr+len)&mask;
+	used+=len;
+	if(used>d->tx_peak)d->tx_peak=used;
+	serial_tx_start(port);
+	SERIAL_EXIT_CRITICAL();
+	return len;
+}
+
+//ͻʣռ(ֽ),Ҫдֲ뱻ʱȵȿռ㹻
+u16 SERIAL_TxFree(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	u16 mask=serial_cfg[port].txlen-1;
+	return mask-((d->tx_wr-d->tx_out)&mask);
+}
+
+//ȴͻȫ(һֽڵֹͣλҲ)
+//port:ں
+//timeout:ʱʱ(ms),SERIAL_FOREVERһֱȴ
+//ֵ:0,;1,ʱ
+u8 SERIAL_Flush(u8 port,u32 timeout)
+{
+	_serial_dev *d=&serial_dev[port];
+	u32 t=0;
+	while(d->tx_out!=d->tx_wr||d->huart.gState!=HAL_UART_STATE_READY)
+	{
+		if(timeout!=SERIAL_FOREVER&&t++>=timeout)return 1;
+		delay_ms(1);
+	}
+	while(__HAL_UART_GET_FLAG(&d->huart,UART_FLAG_TC)==RESET);	//һֽڷ
+	return 0;
+}
+
+//л,ȷͻȫл,³ʼDMA
+//USART1ʱԴΪĬϵPCLK2,USART2ΪPCLK1
+//port:ں
+//bound:µĲ
+void SERIAL_SetBaud(u8 port,u32 bound)
+{
+	_serial_dev *d=&serial_dev[port];
+	u32 clk;
+	SERIAL_Flush(port,SERIAL_FOREVER);
+	if(d->huart.Instance==USART1)clk=HAL_RCC_GetPCLK2Freq();
+	else clk=HAL_RCC_GetPCLK1Freq();
+	__HAL_UART_DISABLE(&d->huart);
+	d->huart.Init.BaudRate=bound;
+	d->huart.Instance->BRR=(clk+bound/2)/bound;		//16
+	__HAL_UART_ENABLE(&d->huart);
+}
+
+//ͷʼDMAѭ,򿪿ж
+static void serial_rx_start(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	d->rx_rd=0;
+	HAL_UART_Receive_DMA(&d->huart,serial_cfg[port].rxdma_buf,serial_cfg[port].rxdma_len);
+	if(d->rx_rto)SET_BIT(d->huart.Instance->CR1,USART_CR1_RTOIE);	//ճʱж
+	else __HAL_UART_ENABLE_IT(&d->huart,UART_IT_IDLE);
+}
+
+//DMA[start,end)ݽ֡
+//ֵ:ɵ֡
+static u8 serial_rx_feed(u8 port,u16 start,u16 end)
+{
+	u8 *buf=serial_cfg[port].rxdma_buf;
+	u32 addr=(u32)&buf[start]&~31;					//Cacheж
+	SCB_InvalidateDCache_by_Addr((u32*)addr,(u32)&buf[end]-addr);
+	return rxline_put(&serial_dev[port].rx,&buf[start],end-start);
+}
+
+//DMAյ,ڿжϡDMA/ȫж(ͬһڵ⼸жȼͬ,)
+//idle:1,߿,з֡ʱǰ֡
+static void serial_rx_process(u8 port,u8 idle)
+{
+	_serial_dev *d=&serial_dev[port];
+	u16 size=serial_cfg[port].rxdma_len;
+	u16 wr;
+	u8 done=0;
+	wr=size-__HAL_DMA_GET_COUNTER(&d->hdmarx);		//DMAдλ
+	if(wr>=size)wr=0;
+	if(wr<d->rx_rd)									//,ȴĩβ
+	{
+		done+=serial_rx_feed(port,d->rx_rd,size);
+		d->rx_rd=0;
+	}
+	if(wr>d->rx_rd)done+=serial_rx_feed(port,d->rx_rd,wr);
+	d->rx_rd=wr;
+	if(idle)done+=rxline_idle(&d->rx);
+#if SYSTEM_SUPPORT_OS
+	if(done&&d->sem!=NULL)OSSemPost(d->sem);		//SERIAL_Read
+#endif
+}
+
+//ȡյһ֡
+//port:ں
+//type:RXLINE_TEXT,ı(/ȷ֡֡);RXLINE_BIN,֡
+//len:֡(ıвз)
+//ֵ:֡,NULLʾûյ֡
+u8 *SERIAL_Peek(u8 port,u8 type,u16 *len)
+{
+	return rxline_peek(&serial_dev[port].rx,type,len);
+}
+
+//ͷSERIAL_Peekȡ֡,֮һܱ֡ȡ
+//ͬһ֡ʱֻͷһ
+//frame:SERIAL_Peekķֵ
+void SERIAL_Pop(u8 port,u8 type,u8 *frame)
+{
+	_rxline *r=&serial_dev[port].rx;
+	u16 len;
+	SERIAL_SR_ALLOC();
+	SERIAL_ENTER_CRITICAL();
+	if(rxline_peek(r,type,&len)==frame)rxline_pop(r,type);
+	SERIAL_EXIT_CRITICAL();
+}
+
+//յûȡߵ֡(֡)
+void SERIAL_RxClear(u8 port)
+{
+	_rxline *r=&serial_dev[port].rx;
+	SERIAL_SR_ALLOC();
+	SERIAL_ENTER_CRITICAL();
+	while(rxline_count(r,RXLINE_TEXT))rxline_pop(r,RXLINE_TEXT);
+	SERIAL_EXIT_CRITICAL();
+}
+
+//ȴյһ֡(ıл/ʱ/ȷ֡֡),ȡ
+//OSʱźϵȴ,ռCPU;ÿ1msѯһ
+//port:ں
+//timeout:ʱʱ(ms,OS_TICKS_PER_SECΪ1000,ڽ),0ȴ,SERIAL_FOREVERһֱȴ
+//ֵ:1,֡;0,ʱ
+u8 SERIAL_Wait(u8 port,u32 timeout)
+{
+	_serial_dev *d=&serial_dev[port];
+	u32 t=0;
+#if SYSTEM_SUPPORT_OS
+	u32 start;
+	u8 err;
+	SERIAL_SR_ALLOC();
+	if(OSRunning&&d->sem==NULL)
+	{
+		SERIAL_ENTER_CRITICAL();
+		if(d->sem==NULL)d->sem=OSSemCreate(0);
+		SERIAL_EXIT_CRITICAL();
+	}
+	start=OSTimeGet();
+#endif
+	while(rxline_count(&d->rx,RXLINE_TEXT)==0)
+	{
+#if SYSTEM_SUPPORT_OS
+		if(OSRunning&&d->sem!=NULL)
+		{
+			t=OSTimeGet()-start;
+			if(timeout==SERIAL_FOREVER)OSSemPend(d->sem,0,&err);
+			else if(t<timeout)OSSemPend(d->sem,timeout-t,&err);
+			else return 0;
+			continue;
+		}
+#endif
+		if(timeout!=SERIAL_FOREVER&&t++>=timeout)return 0;
+		delay_ms(1);
+	}
+	return 1;
+}
+
+//ȴյһ֡,ȡͷ
+//port:ں
+//buf:֡,sizeĲֶ
+//size:bufС
+//timeout:ʱʱ(ms),ͬSERIAL_Wait
+//ֵ:֡,0ʾʱ(з֡ʱҲ0,ҪʱSERIAL_Peek)
+u16 SERIAL_Read(u8 port,u8 *buf,u16 size,u32 timeout)
+{
+	u8 *frame;
+	u16 len;
+	if(!SERIAL_Wait(port,timeout))return 0;
+	frame=SERIAL_Peek(port,RXLINE_TEXT,&len);
+	if(frame==NULL)return 0;						//ȡ
+	if(len>size)len=size;
+	memcpy(buf,frame,len);
+	SERIAL_Pop(port,RXLINE_TEXT,frame);
+	return len;
+}
+
+//շͳ
+void SERIAL_Stat(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	_rxline_q *q=&d->rx.q[RXLINE_TEXT];
+	printf("serial%u tx: size %u peak %u drop %u\r\n",port+1,serial_cfg[port].txlen,d->tx_peak,d->tx_drop);
+	printf("serial%u rx: dma %u frames %u over %u drop %u err %u\r\n",port+1,serial_cfg[port].rxdma_len,
+		rxline_count(&d->rx,RXLINE_TEXT),q->over,q->drop,d->rx_err);
+	q=&d->rx.q[RXLINE_BIN];
+	if(q->num)printf("serial%u rx: bin %u over %u drop %u\r\n",port+1,rxline_count(&d->rx,RXLINE_BIN),q->over,q->drop);
+}
+
+//ȡHAL
+UART_HandleTypeDef *SERIAL_Handle(u8 port)
+{
+	return &serial_dev[port].huart;
+}
+
+//ӲDE(RS485ʹ),DEŸߵƽЧ,ʱɴԶ,Ҫл
+//DEŵĸùɵ(USART2ΪPA1 AF7)
+//port:ں
+//assert:һʼλ֮ǰǰʹDEʱ,λ1/16λʱ(16),0~31
+//deassert:һֹͣλ֮󱣳DEʱ,λͬ,0~31
+void SERIAL_SetDE(u8 port,u8 assert,u8 deassert)
+{
+	_serial_dev *d=&serial_dev[port];
+	USART_TypeDef *u=d->huart.Instance;
+	SERIAL_Flush(port,SERIAL_FOREVER);
+	__HAL_UART_DISABLE(&d->huart);					//DEAT/DEDT/DEMֻUE=0ʱ޸
+	u->CR1=(u->CR1&~(USART_CR1_DEAT|USART_CR1_DEDT))|((u32)(assert&31)<<USART_CR1_DEAT_Pos)|((u32)(deassert&31)<<USART_CR1_DEDT_Pos);
+	u->CR3=(u->CR3&~USART_CR3_DEP)|USART_CR3_DEM;
+	__HAL_UART_ENABLE(&d->huart);
+}
+
+//շص
+//Ϳʼ(һֽڽDMA֮ǰ)ʱdir(1),ͻȫ(һֹͣλ)ʱdir(0)
+//صڹжʱ,dir(0)ڷж,ܵȴ,ʺֱӲGPIO
+//port:ں
+//dir:ص,NULLȡ
+void SERIAL_SetDir(u8 port,void (*dir)(u8 tx))
+{
+	SERIAL_SR_ALLOC();
+	SERIAL_ENTER_CRITICAL();
+	serial_dev[port].dir=dir;
+	SERIAL_EXIT_CRITICAL();
+}
+
+//ýճʱ,ڰʱ֡(RXLINE_MODE_IDLE)
+//ж߿1ַʱһ֡,ͷֽ֮м϶ʱһ֡ᱻ
+//ճʱһֹͣλ֮bitsλʱûյݲŽһ֡,Modbus RTU3.5ַΪ35λ
+//port:ں
+//bits:ʱλ,1~0xFFFFFF;0,Ļÿж
+void SERIAL_SetRxTimeout(u8 port,u32 bits)
+{
+	_serial_dev *d=&serial_dev[port];
+	USART_TypeDef *u=d->huart.Instance;
+	SERIAL_SR_ALLOC();
+	SERIAL_ENTER_CRITICAL();
+	d->rx_rto=bits&USART_RTOR_RTO;
+	if(d->rx_rto)
+	{
+		u->RTOR=(u->RTOR&~USART_RTOR_RTO)|d->rx_rto;
+		__HAL_UART_DISABLE_IT(&d->huart,UART_IT_IDLE);
+		SET_BIT(u->CR2,USART_CR2_RTOEN);			//RTOENUE=1ʱ޸
+		u->ICR=USART_ICR_RTOCF;
+		SET_BIT(u->CR1,USART_CR1_RTOIE);
+	}else
+	{
+		CLEAR_BIT(u->CR1,USART_CR1_RTOIE);
+		CLEAR_BIT(u->CR2,USART_CR2_RTOEN);
+		__HAL_UART_CLEAR_IDLEFLAG(&d->huart);
+		__HAL_UART_ENABLE_IT(&d->huart,UART_IT_IDLE);
+	}
+	SERIAL_EXIT_CRITICAL();
+}
+
+//ʼ,8λ,1ֹͣλ,У,DMAѭպͿж
+//port:ں
+//bound:
+void SERIAL_Init(u8 port,u32 bound)
+{
+	_serial_dev *d=&serial_dev[port];
+	const _serial_cfg *c=&serial_cfg[port];
+	rxline_init(&d->rx,c->mode,c->rxbuf,c->rxlen,c->rxnum,c->rxsize);
+	if(c->binnum)rxline_init_bin(&d->rx,c->binbuf,c->binlen,c->binnum,c->binsize);
+	d->huart.Instance=c->uart;
+	d->huart.Init.BaudRate=bound;					//
+	d->huart.Init.WordLength=UART_WORDLENGTH_8B;	//ֳΪ8λݸʽ
+	d->huart.Init.StopBits=UART_STOPBITS_1;			//һֹͣλ
+	d->huart.Init.Parity=UART_PARITY_NONE;			//żУλ
+	d->huart.Init.HwFlowCtl=UART_HWCONTROL_NONE;	//Ӳ
+	d->huart.Init.Mode=UART_MODE_TX_RX;				//շģʽ
+	HAL_UART_Init(&d->huart);						//HAL_UART_MspInit
+	serial_rx_start(port);							//DMAѭպͿж
+}
+
+//UARTײʼ,ʱʹ,,DMA,ж
+//˺ᱻHAL_UART_Init()
+//huart:ھ
+void HAL_UART_MspInit(UART_HandleTypeDef *huart)
+{
+	GPIO_InitTypeDef GPIO_Initure;
+	u8 port=serial_port(huart);
+	_serial_dev *d;
+	const _serial_cfg *c;
+	if(port>=SERIAL_NUM)return;
+	d=&serial_dev[port];
+	c=&serial_cfg[port];
+
+	__HAL_RCC_GPIOA_CLK_ENABLE();					//ڵŶGPIOA
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	if(c->uart==USART1)__HAL_RCC_USART1_CLK_ENABLE();
+	else __HAL_RCC_USART2_CLK_ENABLE();
+
+	GPIO_Initure.Pin=c->pins;
+	GPIO_Initure.Mode=GPIO_MODE_AF_PP;				//
+	GPIO_Initure.Pull=GPIO_PULLUP;					//
+	GPIO_Initure.Speed=GPIO_SPEED_FREQ_HIGH;		//
+	GPIO_Initure.Alternate=c->af;
+	HAL_GPIO_Init(c->gpio,&GPIO_Initure);
+
+	d->hdmatx.Instance=c->txdma;
+	d->hdmatx.Init.Request=c->txreq;
+	d->hdmatx.Init.Direction=DMA_MEMORY_TO_PERIPH;	//洢
+	d->hdmatx.Init.PeriphInc=DMA_PINC_DISABLE;		//ַ
+	d->hdmatx.Init.MemInc=DMA_MINC_ENABLE;			//洢ַ
+	d->hdmatx.Init.PeriphDataAlignment=DMA_PDATAALIGN_BYTE;
+	d->hdmatx.Init.MemDataAlignment=DMA_MDATAALIGN_BYTE;
+	d->hdmatx.Init.Mode=DMA_NORMAL;					//ͨģʽ,ÿηڻصһ
+	d->hdmatx.Init.Priority=DMA_PRIORITY_LOW;
+	d->hdmatx.Init.FIFOMode=DMA_FIFOMODE_DISABLE;
+	HAL_DMA_DeInit(&d->hdmatx);
+	HAL_DMA_Init(&d->hdmatx);
+	__HAL_LINKDMA(huart,hdmatx,d->hdmatx);
+
+	d->hdmarx.Instance=c->rxdma;
+	d->hdmarx.Init.Request=c->rxreq;
+	d->hdmarx.Init.Direction=DMA_PERIPH_TO_MEMORY;	//赽洢
+	d->hdmarx.Init.PeriphInc=DMA_PINC_DISABLE;
+	d->hdmarx.Init.MemInc=DMA_MINC_ENABLE;
+	d->hdmarx.Init.PeriphDataAlignment=DMA_PDATAALIGN_BYTE;
+	d->hdmarx.Init.MemDataAlignment=DMA_MDATAALIGN_BYTE;
+	d->hdmarx.Init.Mode=DMA_CIRCULAR;				//ѭģʽ,һֱղֹͣ
+	d->hdmarx.Init.Priority=DMA_PRIORITY_HIGH;		//ڷ
+	d->hdmarx.Init.FIFOMode=DMA_FIFOMODE_DISABLE;
+	HAL_DMA_DeInit(&d->hdmarx);
+	HAL_DMA_Init(&d->hdmarx);
+	__HAL_LINKDMA(huart,hdmarx,d->hdmarx);
+
+	//ͬһڵжȼͬ,ռ
+	HAL_NVIC_SetPriority(c->txirq,3,3);				//ռȼ3ȼ3
+	HAL_NVIC_EnableIRQ(c->txirq);
+	HAL_NVIC_SetPriority(c->rxirq,3,3);
+	HAL_NVIC_EnableIRQ(c->rxirq);
+	HAL_NVIC_SetPriority(c->irq,3,3);
+	HAL_NVIC_EnableIRQ(c->irq);						//DMAҪõڵķж
+}
+
+//DMA(һֽڷ)ص,ʣµ
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	u8 port=serial_port(huart);
+	SERIAL_SR_ALLOC();
+	if(port>=SERIAL_NUM)return;
+	SERIAL_ENTER_CRITICAL();
+	serial_tx_next(port);
+	SERIAL_EXIT_CRITICAL();
+}
+
+//DMAյһ
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+	u8 port=serial_port(huart);
+	if(port<SERIAL_NUM)serial_rx_process(port,0);
+}
+
+//DMAյĩβ,ѭģʽ»Զͷ
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+	u8 port=serial_port(huart);
+	if(port<SERIAL_NUM)serial_rx_process(port,0);
+}
+
+//ճ(//֡)ʱHALֹͣDMA,յݺ¿
+//DMAͳʱHAL,ڷ͵,ͺ
+//HAL_UART_Transmit_DMAʱǹжϵ,ﲻ
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	u8 port=serial_port(huart);
+	_serial_dev *d;
+	SERIAL_SR_ALLOC();
+	if(port>=SERIAL_NUM)return;
+	d=&serial_dev[port];
+	d->rx_err++;
+	if(huart->RxState==HAL_UART_STATE_READY)
+	{
+		serial_rx_process(port,1);					//֡,н
+		serial_rx_start(port);
+	}
+	SERIAL_ENTER_CRITICAL();
+	if(huart->gState==HAL_UART_STATE_READY&&d->tx_out!=d->tx_rd)serial_tx_next(port);
+	SERIAL_EXIT_CRITICAL();
+}
+
+//жϹ
+static void serial_irq(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+	OSIntEnter();
+#endif
+	if(d->rx_rto)
+	{
+		if(__HAL_UART_GET_FLAG(&d->huart,UART_FLAG_RTOF)!=RESET)	//ճʱ,һ֡
+		{
+			__HAL_UART_CLEAR_FLAG(&d->huart,UART_CLEAR_RTOF);	//HALⲻRTOF,
+			serial_rx_process(port,1);
+		}
+	}else if(__HAL_UART_GET_FLAG(&d->huart,UART_FLAG_IDLE)!=RESET)	//߿,һ֡
+	{
+		__HAL_UART_CLEAR_IDLEFLAG(&d->huart);
+		serial_rx_process(port,1);
+	}
+	HAL_UART_IRQHandler(&d->huart);					//HALжϴú
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+	OSIntExit();
+#endif
+}
+
+//DMAжϹ
+static void serial_dma_irq(DMA_HandleTypeDef *hdma)
+{
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+	OSIntEnter();
+#endif
+	HAL_DMA_IRQHandler(hdma);
+#if SYSTEM_SUPPORT_OS	 	//ʹOS
+	OSIntExit();
+#endif
+}
+
+//1жϷ
+void USART1_IRQHandler(void)
+{
+	serial_irq(SERIAL1);
+}
+
+//2жϷ
+void USART2_IRQHandler(void)
+{
+	serial_irq(SERIAL2);
+}
+
+//DMA27жϷ(1)
+void DMA2_Stream7_IRQHandler(void)
+{
+	serial_dma_irq(&serial_dev[SERIAL1].hdmatx);
+}
+
+//DMA22жϷ(1)
+void DMA2_Stream2_IRQHandler(void)
+{
+	serial_dma_irq(&serial_dev[SERIAL1].hdmarx);
+}
+
+//DMA11жϷ(2)
+void DMA1_Stream1_IRQHandler(void)
+{
+	serial_dma_irq(&serial_dev[SERIAL2].hdmatx);
+}
+
+//DMA10жϷ(2)
+void DMA1_Stream0_IRQHandler(void)
+{
+	serial_dma_irq(&serial_dev[SERIAL2].hdmarx);
+}
@@ -0,0 +1,70 @@
+#ifndef _SERIAL_H
+#define _SERIAL_H
+#include "sys.h"
+#include "rxline.h"
+//////////////////////////////////////////////////////////////////////////////////
+//ͨô
+//ÿһʵ,һDMAͻλһDMAѭջһ֡
+//1(printf/)ʹ2(RS485)һ״
+//:2026/10/19
+//汾V1.2
+//********************************************************************************
+//:SERIAL_Write()д뷢ͻλ,DMAں̨,жﶼԵ
+//:DMAѭ,жϺDMA/ȫжݽrxline֡
+//     ֡ʽrxline.h:/м/ǰ׺
+//ȡ:SERIAL_Read()ȴһ֡,ʱ,ȴڼźϲռCPU
+//     ҲSERIAL_Peek()ȡֱ֡Ӵ,SERIAL_Pop()ͷ
+//Դ:
+//SERIAL1,USART1 PA9/PA10,DMA2_Stream7,DMA2_Stream2,з֡+֡
+//SERIAL2,USART2 PA2/PA3,DMA1_Stream1,DMA1_Stream0,з֡
+//DMA1/DMA2ܷDTCM,շηSRAM3(0x30040000ʼ)
+//PCserial_host.cserial.c,ÿһLinuxαն,PCϲ
+//********************************************************************************
+//V1.1 20261019
+//SERIAL_SetDE(),ʹôӲDEſRS485շ,DEǰ/Ӻʱ
+//SERIAL_SetDir(),Ϳʼȫ(һֹͣλ)ʱص,GPIOշ
+//V1.2 20261019
+//SERIAL_SetRxTimeout(),ôӲճʱ(RTOR)жϽһ֡,֡Ϊλ
+//SERIAL_Wait(),ֻȴյһ֡,ȡ
+//////////////////////////////////////////////////////////////////////////////////
+
+#define SERIAL1					0		//USART1
+#define SERIAL2					1		//USART2(RS485)
+#define SERIAL_NUM				2		//ڸ
+
+#define SERIAL_TX_TRUNC			0		//ͻռ䲻ʱ:0,ζ(֤);1,ֻдŵµĲ
+#define SERIAL_FOREVER			0xFFFFFFFF	//SERIAL_Read/SERIAL_Flushһֱȴ
+
+//1
+#define SERIAL1_TX_LEN			4096	//ͻλС,2
+#define SERIAL1_RX_DMA_LEN		1024	//DMAѭջС,32ı
+#define SERIAL1_RX_MODE			RXLINE_MODE_LINE	//֡ʽ
+#define SERIAL1_RX_NUM			4		//֡,2
+#define SERIAL1_RX_LEN			200		//һ֡(һ)󳤶
+#define SERIAL1_BIN_NUM			8		//֡,2;0,ն֡
+#define SERIAL1_BIN_LEN			280		//֡󳤶(COBS)
+
+//2
+#define SERIAL2_TX_LEN			1024
+#define SERIAL2_RX_DMA_LEN		512
+#define SERIAL2_RX_MODE			RXLINE_MODE_IDLE
+#define SERIAL2_RX_NUM			8
+#define SERIAL2_RX_LEN			256		//Modbus RTUһ֡256ֽ
+
+void SERIAL_Init(u8 port,u32 bound);					//ʼ,DMA
+u16 SERIAL_Write(u8 port,const u8 *buf,u16 len);		//д뷢ͻ,ȴ
+u16 SERIAL_TxFree(u8 port);								//ͻʣռ
+u8 SERIAL_Flush(u8 port,u32 timeout);					//ȴͻȫ
+void SERIAL_SetBaud(u8 port,u32 bound);					//л
+u8 SERIAL_Wait(u8 port,u32 timeout);					//ȴյһ֡,ȡ
+u16 SERIAL_Read(u8 port,u8 *buf,u16 size,u32 timeout);	//ȴյһ֡ȡ
+u8 *SERIAL_Peek(u8 port,u8 type,u16 *len);				//ȡյһ֡,NULLʾû
+void SERIAL_Pop(u8 port,u8 type,u8 *frame);				//ͷSERIAL_Peekȡ֡
+void SERIAL_RxClear(u8 port);							//յ֡
+void SERIAL_Stat(u8 port);								//շͳ
+UART_HandleTypeDef *SERIAL_Handle(u8 port);				//ȡHAL
+void SERIAL_SetDE(u8 port,u8 assert,u8 deassert);		//ӲDE
+void SERIAL_SetDir(u8 port,void (*dir)(u8 tx));			//շص
+void SERIAL_SetRxTimeout(u8 port,u32 bits);				//ýճʱ,0ʹÿж
+const char *SERIAL_HostPath(u8 port);					//ptyӶ豸,ֻPC汾(serial_host.c)
+#endif
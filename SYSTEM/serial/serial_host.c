@@ -0,0 +1,342 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include "serial.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+//////////////////////////////////////////////////////////////////////////////////
+//ͨôPC汾(Linuxαն),Keil,PCϱʱserial.c
+//ӿںserial.hͬ,ÿһpty:
+//SERIAL_HostPath()شӶ豸(/dev/pts/N),(xfer.pyն)USBת
+//:̰߳˶ݽrxline,rxlineճʱ֡:һַʱ(SERIAL_SetRxTimeout
+//     λ)ûʱһ֡,൱ڰϵDMA+/ճʱж;PCȾ,SERIAL_HOST_GAP_MIN
+//:ֱд,дȥĲּtx_drop;ûDMA,SERIAL_TxFreeǷ,SERIAL_Flush
+//     صдǰ
+//ûHAL:SERIAL_HandleNULL,SERIAL_SetDEκ
+//:2026/10/19
+//汾V1.1
+//////////////////////////////////////////////////////////////////////////////////
+
+#define SERIAL_HOST_GAP_MIN		2		//̿ʱ(ms)
+
+//֡,serial.cͬ
+static u8 serial1_rx_buf[SERIAL1_RX_NUM][SERIAL1_RX_LEN];
+static u16 serial1_rx_len[SERIAL1_RX_NUM];
+#if SERIAL1_BIN_NUM
+static u8 serial1_bin_buf[SERIAL1_BIN_NUM][SERIAL1_BIN_LEN];
+static u16 serial1_bin_len[SERIAL1_BIN_NUM];
+#endif
+static u8 serial2_rx_buf[SERIAL2_RX_NUM][SERIAL2_RX_LEN];
+static u16 serial2_rx_len[SERIAL2_RX_NUM];
+
+//ÿڹ̶Դ
+typedef struct
+{
+	u16 txlen;					//ͻС(ֻSERIAL_TxFree)
+	u8 mode;					//֡ʽ
+	u8 *rxbuf;					//֡
+	u16 *rxlen;
+	u8 rxnum;
+	u16 rxsize;
+	u8 *binbuf;					//֡,ֻڰз֡
+	u16 *binlen;
+	u8 binnum;
+	u16 binsize;
+}_serial_cfg;
+
+static const _serial_cfg serial_cfg[SERIAL_NUM]=
+{
+	{SERIAL1_TX_LEN,SERIAL1_RX_MODE,serial1_rx_buf[0],serial1_rx_len,SERIAL1_RX_NUM,SERIAL1_RX_LEN,
+#if SERIAL1_BIN_NUM
+	 serial1_bin_buf[0],serial1_bin_len,SERIAL1_BIN_NUM,SERIAL1_BIN_LEN},
+#else
+	 0,0,0,0},
+#endif
+	{SERIAL2_TX_LEN,SERIAL2_RX_MODE,serial2_rx_buf[0],serial2_rx_len,SERIAL2_RX_NUM,SERIAL2_RX_LEN,
+	 0,0,0,0},
+};
+
+//ÿʱ״̬
+typedef struct
+{
+	int fd;						//pty,-1ʾûгʼ
+	int slave;					//ptyӶ,һֱ,ⲿرմӶ˺˲
+	char path[64];				//Ӷ豸
+	pthread_t thread;			//߳
+	pthread_mutex_t lock;		//ж
+	pthread_cond_t cond;		//յ֡ʱ֪ͨSERIAL_Wait
+	u32 baud;					//,ڼ֡
+	u16 tx_peak;				//һдֽ
+	u32 tx_drop;				//дȥֽ
+	void (*dir)(u8 tx);			//շص
+	u32 rx_err;					//ճ(˳)
+	u32 rx_rto;					//ճʱ(λ),0ʾ1ַһ֡
+	_rxline rx;					//֡
+}_serial_dev;
+
+static _serial_dev serial_dev[SERIAL_NUM]={{-1,-1},{-1,-1}};
+
+//ǰʱ(us),ճʱʱ䵥λ
+static u32 serial_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (u32)((uint64_t)ts.tv_sec*1000000+ts.tv_nsec/1000);
+}
+
+//ʺͽճʱλrxline֡,ʱѼ
+static void serial_set_gap(_serial_dev *d)
+{
+	u32 bits=d->rx_rto?d->rx_rto:10;
+	u32 gap=(u32)(((uint64_t)bits*1000000+d->baud-1)/d->baud);
+	if(gap<SERIAL_HOST_GAP_MIN*1000)gap=SERIAL_HOST_GAP_MIN*1000;
+	rxline_set_gap(&d->rx,gap,(u16)((10*1000000+d->baud-1)/d->baud));
+}
+
+//߳,൱DMAպͿ/ճʱж
+static void *serial_rx_thread(void *arg)
+{
+	_serial_dev *d=&serial_dev[(uintptr_t)arg];
+	struct pollfd pfd;
+	u8 buf[256];
+	u8 done,err;
+	int n,ms;
+	s32 left;
+	pfd.fd=d->fd;
+	pfd.events=POLLIN;
+	while(1)
+	{
+		pthread_mutex_lock(&d->lock);
+		ms=-1;
+		if(d->rx.wait)							//յ,ȵ֡
+		{
+			left=(s32)(d->rx.last+d->rx.gap-serial_us());
+			ms=left>0?(left+999)/1000:0;
+		}
+		pthread_mutex_unlock(&d->lock);
+		n=poll(&pfd,1,ms);
+		if(n<0&&errno==EINTR)continue;
+		pthread_mutex_lock(&d->lock);
+		err=0;
+		if(n>0)
+		{
+			n=read(d->fd,buf,sizeof(buf));
+			if(n>0)done=rxline_put_at(&d->rx,buf,n,serial_us());
+			else
+			{
+				d->rx_err++;
+				done=0;
+				err=1;
+			}
+		}else done=rxline_poll(&d->rx,serial_us());	//֡,һ֡
+		if(done)pthread_cond_broadcast(&d->cond);
+		pthread_mutex_unlock(&d->lock);
+		if(err)usleep(1000);					//ʱҪת
+	}
+	return NULL;
+}
+
+//ʼ:pty,ӶΪԭʼģʽ,߳
+//port:ں
+//bound:,ֻڼʱ
+void SERIAL_Init(u8 port,u32 bound)
+{
+	_serial_dev *d=&serial_dev[port];
+	const _serial_cfg *c=&serial_cfg[port];
+	struct termios tio;
+	rxline_init(&d->rx,c->mode,c->rxbuf,c->rxlen,c->rxnum,c->rxsize);
+	if(c->binnum)rxline_init_bin(&d->rx,c->binbuf,c->binlen,c->binnum,c->binsize);
+	d->baud=bound;
+	serial_set_gap(d);
+	if(d->fd>=0)return;							//ٴγʼֻն
+	d->fd=posix_openpt(O_RDWR|O_NOCTTY);
+	if(d->fd<0||grantpt(d->fd)||unlockpt(d->fd)||ptsname(d->fd)==NULL)
+	{
+		perror("serial: pty");
+		exit(1);
+	}
+	snprintf(d->path,sizeof(d->path),"%s",ptsname(d->fd));
+	d->slave=open(d->path,O_RDWR|O_NOCTTY);
+	tcgetattr(d->slave,&tio);
+	cfmakeraw(&tio);
+	tcsetattr(d->slave,TCSANOW,&tio);
+	fcntl(d->fd,F_SETFL,fcntl(d->fd,F_GETFL)|O_NONBLOCK);
+	pthread_mutex_init(&d->lock,NULL);
+	pthread_cond_init(&d->cond,NULL);
+	pthread_create(&d->thread,NULL,serial_rx_thread,(void*)(uintptr_t)port);
+}
+
+//ptyӶ豸,ֻPC汾
+const char *SERIAL_HostPath(u8 port)
+{
+	return serial_dev[port].path;
+}
+
+//дpty,дȥĲֶ
+//ֵ:дֽ
+u16 SERIAL_Write(u8 port,const u8 *buf,u16 len)
+{
+	_serial_dev *d=&serial_dev[port];
+	ssize_t n;
+	pthread_mutex_lock(&d->lock);
+	if(d->dir)d->dir(1);
+	n=write(d->fd,buf,len);
+	if(n<0)n=0;
+	if(n<len)
+	{
+#if SERIAL_TX_TRUNC
+		d->tx_drop+=len-n;
+#else
+		d->tx_drop+=len;						//ζѾдĲ,ֻ
+#endif
+	}
+	if(len>d->tx_peak)d->tx_peak=len;
+	if(d->dir)d->dir(0);
+	pthread_mutex_unlock(&d->lock);
+	return (u16)n;
+}
+
+//ͻʣռ,PCֱӽں,Ƿ
+u16 SERIAL_TxFree(u8 port)
+{
+	return serial_cfg[port].txlen-1;
+}
+
+//ȴ,PCдʱѾں,
+u8 SERIAL_Flush(u8 port,u32 timeout)
+{
+	(void)port;
+	(void)timeout;
+	return 0;
+}
+
+//л,ֻӰ֡
+void SERIAL_SetBaud(u8 port,u32 bound)
+{
+	_serial_dev *d=&serial_dev[port];
+	pthread_mutex_lock(&d->lock);
+	d->baud=bound;
+	serial_set_gap(d);
+	pthread_mutex_unlock(&d->lock);
+}
+
+//ȴյһ֡,ȡ,ͷֵͬserial.c
+u8 SERIAL_Wait(u8 port,u32 timeout)
+{
+	_serial_dev *d=&serial_dev[port];
+	struct timespec ts;
+	u8 ret;
+	clock_gettime(CLOCK_REALTIME,&ts);
+	if(timeout!=SERIAL_FOREVER)
+	{
+		ts.tv_sec+=timeout/1000;
+		ts.tv_nsec+=(long)(timeout%1000)*1000000;
+		if(ts.tv_nsec>=1000000000)
+		{
+			ts.tv_sec++;
+			ts.tv_nsec-=1000000000;
+		}
+	}
+	pthread_mutex_lock(&d->lock);
+	while(rxline_count(&d->rx,RXLINE_TEXT)==0)
+	{
+		if(timeout==SERIAL_FOREVER)pthread_cond_wait(&d->cond,&d->lock);
+		else if(pthread_cond_timedwait(&d->cond,&d->lock,&ts)==ETIMEDOUT)break;
+	}
+	ret=rxline_count(&d->rx,RXLINE_TEXT)!=0;
+	pthread_mutex_unlock(&d->lock);
+	return ret;
+}
+
+//ȴյһ֡,ȡͷ,ͷֵͬserial.c
+u16 SERIAL_Read(u8 port,u8 *buf,u16 size,u32 timeout)
+{
+	u8 *frame;
+	u16 len;
+	if(!SERIAL_Wait(port,timeout))return 0;
+	frame=SERIAL_Peek(port,RXLINE_TEXT,&len);
+	if(frame==NULL)return 0;
+	if(len>size)len=size;
+	memcpy(buf,frame,len);
+	SERIAL_Pop(port,RXLINE_TEXT,frame);
+	return len;
+}
+
+//ȡյһ֡
+u8 *SERIAL_Peek(u8 port,u8 type,u16 *len)
+{
+	return rxline_peek(&serial_dev[port].rx,type,len);
+}
+
+//ͷSERIAL_Peekȡ֡
+void SERIAL_Pop(u8 port,u8 type,u8 *frame)
+{
+	_serial_dev *d=&serial_dev[port];
+	u16 len;
+	pthread_mutex_lock(&d->lock);
+	if(rxline_peek(&d->rx,type,&len)==frame)rxline_pop(&d->rx,type);
+	pthread_mutex_unlock(&d->lock);
+}
+
+//յûȡߵ֡(֡)
+void SERIAL_RxClear(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	pthread_mutex_lock(&d->lock);
+	while(rxline_count(&d->rx,RXLINE_TEXT))rxline_pop(&d->rx,RXLINE_TEXT);
+	pthread_mutex_unlock(&d->lock);
+}
+
+//շͳ
+void SERIAL_Stat(u8 port)
+{
+	_serial_dev *d=&serial_dev[port];
+	_rxline_q *q=&d->rx.q[RXLINE_TEXT];
+	printf("serial%u tx: pty %s baud %u peak %u drop %u\r\n",port+1,d->path,d->baud,d->tx_peak,d->tx_drop);
+	printf("serial%u rx: frames %u over %u drop %u err %u\r\n",port+1,
+		rxline_count(&d->rx,RXLINE_TEXT),q->over,q->drop,d->rx_err);
+	q=&d->rx.q[RXLINE_BIN];
+	if(q->num)printf("serial%u rx: bin %u over %u drop %u\r\n",port+1,rxline_count(&d->rx,RXLINE_BIN),q->over,q->drop);
+}
+
+//PCûHAL
+UART_HandleTypeDef *SERIAL_Handle(u8 port)
+{
+	(void)port;
+	return NULL;
+}
+
+//PCûDE
+void SERIAL_SetDE(u8 port,u8 assert,u8 deassert)
+{
+	(void)port;
+	(void)assert;
+	(void)deassert;
+}
+
+//շص,дptyǰ
+void SERIAL_SetDir(u8 port,void (*dir)(u8 tx))
+{
+	_serial_dev *d=&serial_dev[port];
+	pthread_mutex_lock(&d->lock);
+	d->dir=dir;
+	pthread_mutex_unlock(&d->lock);
+}
+
+//ýճʱλ,0Ϊ1ַ
+void SERIAL_SetRxTimeout(u8 port,u32 bits)
+{
+	_serial_dev *d=&serial_dev[port];
+	pthread_mutex_lock(&d->lock);
+	d->rx_rto=bits&0xFFFFFF;
+	serial_set_gap(d);
+	pthread_mutex_unlock(&d->lock);
+}
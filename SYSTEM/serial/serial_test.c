@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////////
+//PC,Keil,TOOLS/hosttest.sh:
+//gcc -ITOOLS/host -ISYSTEM/serial SYSTEM/serial/serial_test.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c -pthread
+//serial_host.cѴڻLinuxαն,Գ򿪴Ӷ,USBתһշ:
+//1з֡+֡,ͺͷص,2з֡(ֽڼСһַʱ䲻֡,ʱ֡)
+//Ͱճʱ֡(Сڳʱ֡)
+//////////////////////////////////////////////////////////////////////////////////
+#include "serial.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+
+#define CHECK(c)	do{if(!(c)){printf("serial: FAILED line %d: %s\n",__LINE__,#c);return 1;}}while(0)
+#define SEND(fd,s)	write(fd,s,sizeof(s)-1)
+
+static u8 dir_log[8];							//صĲ
+static u8 dir_n;
+
+static void dir(u8 tx)
+{
+	if(dir_n<sizeof(dir_log))dir_log[dir_n++]=tx;
+}
+
+//fdnֽ,ʱ1s
+static int recv_all(int fd,u8 *buf,int n)
+{
+	struct pollfd pfd;
+	int got=0,r;
+	pfd.fd=fd;
+	pfd.events=POLLIN;
+	while(got<n&&poll(&pfd,1,1000)>0)
+	{
+		r=read(fd,buf+got,n-got);
+		if(r<=0)break;
+		got+=r;
+	}
+	return got;
+}
+
+//1:з֡,֡,
+static int test_line(void)
+{
+	u8 buf[64];
+	u8 *frm;
+	u16 len;
+	int fd;
+	SERIAL_Init(SERIAL1,115200);
+	fd=open(SERIAL_HostPath(SERIAL1),O_RDWR|O_NOCTTY);
+	CHECK(fd>=0);
+	CHECK(SERIAL_Wait(SERIAL1,0)==0);			//û,ȴ
+	CHECK(SERIAL_Read(SERIAL1,buf,sizeof(buf),0)==0);
+	CHECK(SERIAL_Read(SERIAL1,buf,sizeof(buf),20)==0);
+	SEND(fd,"hello\r\nwor");
+	CHECK(SERIAL_Read(SERIAL1,buf,sizeof(buf),1000)==5&&memcmp(buf,"hello",5)==0);
+	SEND(fd,"ld\n");						//յ
+	CHECK(SERIAL_Read(SERIAL1,buf,sizeof(buf),1000)==5&&memcmp(buf,"world",5)==0);
+	SEND(fd,"\0abc\0");					//֡ı
+	SEND(fd,"end\n");
+	CHECK(SERIAL_Read(SERIAL1,buf,sizeof(buf),1000)==3);
+	frm=SERIAL_Peek(SERIAL1,RXLINE_BIN,&len);
+	CHECK(frm&&len==3&&memcmp(frm,"abc",3)==0);
+	SERIAL_Pop(SERIAL1,RXLINE_BIN,frm);
+	CHECK(SERIAL_Peek(SERIAL1,RXLINE_BIN,&len)==NULL);
+
+	SERIAL_SetDir(SERIAL1,dir);
+	CHECK(SERIAL_Write(SERIAL1,(const u8*)"pong\r\n",6)==6);
+	CHECK(recv_all(fd,buf,6)==6&&memcmp(buf,"pong\r\n",6)==0);
+	CHECK(dir_n==2&&dir_log[0]==1&&dir_log[1]==0);
+	SERIAL_SetDir(SERIAL1,NULL);
+	close(fd);
+	return 0;
+}
+
+//2:з֡,1200һַԼ9ms
+static int test_idle(void)
+{
+	u8 buf[64];
+	u16 len;
+	int fd;
+	SERIAL_Init(SERIAL2,1200);
+	fd=open(SERIAL_HostPath(SERIAL2),O_RDWR|O_NOCTTY);
+	CHECK(fd>=0);
+	SEND(fd,"\1\3\0");
+	usleep(3000);								//Сһַʱ,ͬһ֡
+	SEND(fd,"\0\0\2");
+	usleep(150000);								//,һ֡
+	SEND(fd,"\1\6");
+	CHECK(SERIAL_Read(SERIAL2,buf,sizeof(buf),1000)==6&&memcmp(buf,"\1\3\0\0\0\2",6)==0);
+	CHECK(SERIAL_Read(SERIAL2,buf,sizeof(buf),1000)==2&&memcmp(buf,"\1\6",2)==0);
+	SEND(fd,"abc");
+	CHECK(SERIAL_Wait(SERIAL2,1000)==1);
+	CHECK(SERIAL_Peek(SERIAL2,RXLINE_TEXT,&len)!=NULL&&len==3);
+	SERIAL_RxClear(SERIAL2);
+	CHECK(SERIAL_Wait(SERIAL2,0)==0);
+	close(fd);
+	return 0;
+}
+
+//2:ճʱ֡,120035λԼ29ms
+static int test_rto(void)
+{
+	u8 buf[64];
+	int fd;
+	SERIAL_SetRxTimeout(SERIAL2,35);
+	fd=open(SERIAL_HostPath(SERIAL2),O_RDWR|O_NOCTTY);
+	CHECK(fd>=0);
+	SEND(fd,"\1\3\0");
+	usleep(15000);								//һַʱ,Сڳʱ,ͬһ֡
+	SEND(fd,"\0\0\2");
+	usleep(150000);								//ڳʱ,һ֡
+	SEND(fd,"\1\6");
+	CHECK(SERIAL_Read(SERIAL2,buf,sizeof(buf),1000)==6&&memcmp(buf,"\1\3\0\0\0\2",6)==0);
+	CHECK(SERIAL_Read(SERIAL2,buf,sizeof(buf),1000)==2&&memcmp(buf,"\1\6",2)==0);
+	SERIAL_SetRxTimeout(SERIAL2,0);
+	close(fd);
+	return 0;
+}
+
+int main(void)
+{
+	if(test_line()||test_idle()||test_rto())return 1;
+	printf("serial: ok (pty %s %s)\n",SERIAL_HostPath(SERIAL1),SERIAL_HostPath(SERIAL2));
+	return 0;
+}
@@ -17,7 +17,60 @@
 //All rights reserved
 //********************************************************************************
 //V1.0޸˵ 
+//V1.1 20261019
+//printfΪ:д뷢ͻλ,DMA2_Stream7ں̨
+//printf('\n'β)д뻺,
+//ոΪDMA2_Stream2ѭ,жϺDMA/ȫжݽrxlineз֡,
+//ÿֽڽһж,߲Ҳ
+//0x00ʼͽĶ֡(COBS)뵥֡,xferƴЭʹ
+//usart_set_baud(),л
+//V1.2 20261019
+//ͻλDMAѭաжϺHALصƵSYSTEM/serial/serial.c,1ΪеSERIAL1ʵ
 ////////////////////////////////////////////////////////////////////////////////// 	  
+#if SYSTEM_SUPPORT_OS
+#define USART_SR_ALLOC()		OS_CPU_SR cpu_sr=0
+#define USART_ENTER_CRITICAL()	OS_ENTER_CRITICAL()
+#define USART_EXIT_CRITICAL()	OS_EXIT_CRITICAL()
+#else
+#define USART_SR_ALLOC()		u32 primask
+#define USART_ENTER_CRITICAL()	{primask=__get_PRIMASK();__disable_irq();}
+#define USART_EXIT_CRITICAL()	__set_PRIMASK(primask)
+#endif
+
+//л,ÿƴһд뷢ͻ
+typedef struct
+{
+	u8 owner;						//0,;,ռõȼ+1
+	u8 len;							//ƴӵֽ
+	u8 buf[USART_LINE_LEN];
+}_usart_line;
+static _usart_line usart_line[USART_LINE_NUM];
+
+#if SYSTEM_SUPPORT_OS
+//ȡǰл
+//owner:ȼ+1
+//ֵ:л,NULLʾл嶼ռ
+static _usart_line *usart_line_get(u8 owner)
+{
+	_usart_line *line=NULL;
+	u8 i;
+	USART_SR_ALLOC();
+	for(i=0;i<USART_LINE_NUM;i++)if(usart_line[i].owner==owner)return &usart_line[i];//ֻбԼл
+	USART_ENTER_CRITICAL();
+	for(i=0;i<USART_LINE_NUM;i++)
+	{
+		if(usart_line[i].owner==0)
+		{
+			usart_line[i].owner=owner;
+			usart_line[i].len=0;
+			line=&usart_line[i];
+			break;
+		}
+	}
+	USART_EXIT_CRITICAL();
+	return line;
+}
+#endif
 //´,֧printf,Ҫѡuse MicroLIB	  
 //#define PUTCHAR_PROTOTYPE int fputc(int ch, FILE *f)	
 #if 1
@@ -35,132 +88,41 @@ void _sys_exit(int x)
 	x = x; 
 } 
 //ضfputc 
+//ƴл,'\n'лʱд뷢ͻ
+//жOSǰлʱֱд뷢ͻ
+//ע:˰кһֱ'\n',һֱռһл
 int fputc(int ch, FILE *f)
 { 	
-	while((USART1->ISR&0X40)==0);//ѭ,ֱ   
-	USART1->TDR=(u8)ch;      
+	u8 c=(u8)ch;
+#if SYSTEM_SUPPORT_OS
+	_usart_line *line;
+	if(OSRunning&&OSIntNesting==0)
+	{
+		line=usart_line_get(OSPrioCur+1);
+		if(line!=NULL)
+		{
+			line->buf[line->len++]=c;
+			if(c=='\n'||line->len>=USART_LINE_LEN)
+			{
+				usart_write(line->buf,line->len);
+				line->len=0;
+				line->owner=0;		//ͷл
+			}
+			return ch;
+		}
+	}
+#endif
+	usart_write(&c,1);
 	return ch;
 }
 #endif 
 
-#if EN_USART1_RX   //ʹ˽
-//1жϷ
-//ע,ȡUSARTx->SRܱĪĴ   	
-u8 USART_RX_BUF[USART_REC_LEN];     //ջ,USART_REC_LENֽ.
-//״̬
-//bit15	ɱ־
-//bit14	յ0x0d
-//bit13~0	յЧֽĿ
-u16 USART_RX_STA=0;       //״̬	
-
-u8 aRxBuffer[RXBUFFERSIZE];//HALʹõĴڽջ
-UART_HandleTypeDef UART1_Handler; //UART
-
 //ʼIO 1 
 //bound:
 void uart_init(u32 bound)
 {	
-	//UART ʼ
-	UART1_Handler.Instance=USART1;					    //USART1
-	UART1_Handler.Init.BaudRate=bound;				    //
-	UART1_Handler.Init.WordLength=UART_WORDLENGTH_8B;   //ֳΪ8λݸʽ
-	UART1_Handler.Init.StopBits=UART_STOPBITS_1;	    //һֹͣλ
-	UART1_Handler.Init.Parity=UART_PARITY_NONE;		    //żУλ
-	UART1_Handler.Init.HwFlowCtl=UART_HWCONTROL_NONE;   //Ӳ
-	UART1_Handler.Init.Mode=UART_MODE_TX_RX;		    //շģʽ
-	HAL_UART_Init(&UART1_Handler);					    //HAL_UART_Init()ʹUART1
-	
-	HAL_UART_Receive_IT(&UART1_Handler, (u8 *)aRxBuffer, RXBUFFERSIZE);//úῪжϣ־λUART_IT_RXNEýջԼջ
-  
-}
-
-//UARTײʼʱʹܣãж
-//˺ᱻHAL_UART_Init()
-//huart:ھ
-
-void HAL_UART_MspInit(UART_HandleTypeDef *huart)
-{
-    //GPIO˿
-	GPIO_InitTypeDef GPIO_Initure;
-	
-	if(huart->Instance==USART1)//Ǵ1д1 MSPʼ
-	{
-		__HAL_RCC_GPIOA_CLK_ENABLE();			//ʹGPIOAʱ
-		__HAL_RCC_USART1_CLK_ENABLE();			//ʹUSART1ʱ
-	
-		GPIO_Initure.Pin=GPIO_PIN_9;			//PA9
-		GPIO_Initure.Mode=GPIO_MODE_AF_PP;		//
-		GPIO_Initure.Pull=GPIO_PULLUP;			//
-		GPIO_Initure.Speed=GPIO_SPEED_FREQ_HIGH;//
-		GPIO_Initure.Alternate=GPIO_AF7_USART1;	//ΪUSART1
-		HAL_GPIO_Init(GPIOA,&GPIO_Initure);	   	//ʼPA9
-
-		GPIO_Initure.Pin=GPIO_PIN_10;			//PA10
-		HAL_GPIO_Init(GPIOA,&GPIO_Initure);	   	//ʼPA10
-		
-#if EN_USART1_RX
-		HAL_NVIC_EnableIRQ(USART1_IRQn);				//ʹUSART1жͨ
-		HAL_NVIC_SetPriority(USART1_IRQn,3,3);			//ռȼ3ȼ3
-#endif	
-	}
-
-}
-
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
-{
-	if(huart->Instance==USART1)//Ǵ1
-	{
-		if((USART_RX_STA&0x8000)==0)//δ
-		{
-			if(USART_RX_STA&0x4000)//յ0x0d
-			{
-				if(aRxBuffer[0]!=0x0a)USART_RX_STA=0;//մ,¿ʼ
-				else USART_RX_STA|=0x8000;	// 
-			}
-			else //ûյ0X0D
-			{	
-				if(aRxBuffer[0]==0x0d)USART_RX_STA|=0x4000;
-				else
-				{
-					USART_RX_BUF[USART_RX_STA&0X3FFF]=aRxBuffer[0] ;
-					USART_RX_STA++;
-					if(USART_RX_STA>(USART_REC_LEN-1))USART_RX_STA=0;//ݴ,¿ʼ	  
-				}		 
-			}
-		}
-
-	}
+	SERIAL_Init(SERIAL1,bound);						//з֡,DMAѭպͿж
 }
- 
-//1жϷ
-void USART1_IRQHandler(void)                	
-{ 
-	u32 timeout=0;
-    u32 maxDelay=0x1FFFF;
-#if SYSTEM_SUPPORT_OS	 	//ʹOS
-	OSIntEnter();    
-#endif
-	
-	HAL_UART_IRQHandler(&UART1_Handler);	//HALжϴú
-	
-	timeout=0;
-    while (HAL_UART_GetState(&UART1_Handler)!=HAL_UART_STATE_READY)//ȴ
-	{
-        timeout++;////ʱ
-        if(timeout>maxDelay) break;		
-	}
-     
-	timeout=0;
-	while(HAL_UART_Receive_IT(&UART1_Handler,(u8 *)aRxBuffer, RXBUFFERSIZE)!=HAL_OK)//һδ֮¿жϲRxXferCountΪ1
-	{
-        timeout++; //ʱ
-        if(timeout>maxDelay) break;	
-	}
-#if SYSTEM_SUPPORT_OS	 	//ʹOS
-	OSIntExit();  											 
-#endif
-} 
-#endif	
 
 /*ֱӰжϿ߼джϷڲ*/
 /*
@@ -2,6 +2,7 @@
 #define _USART_H
 #include "sys.h"
 #include "stdio.h"	
+#include "serial.h"
 //////////////////////////////////////////////////////////////////////////////////	 
 //ֻѧϰʹãδɣκ;
 //ALIENTEK STM32H7
@@ -15,17 +16,30 @@
 //All rights reserved
 //********************************************************************************
 //V1.0޸˵ 
+//V1.1 20261019
+//printfΪ:д뷢ͻλ,DMA2_Stream7ں̨
+//printf('\n'β)д뻺,
+//ոΪDMAѭ+ж,յݰзж,ŶӶ
+//USART_RX_BUF/USART_RX_STAΪusart_rx_peek()/usart_rx_pop()
+//0x00ʼͽĶ֡뵥֡,usart_rx_frame()/usart_rx_frame_pop()ȡ
+//V1.2 20261019
+//շDMAжƵͨôSYSTEM/serial/serial.c(SERIAL1),ֻprintfԭĽӿ
 ////////////////////////////////////////////////////////////////////////////////// 	
-#define USART_REC_LEN  			200  	//ֽ 200
-#define EN_USART1_RX 			1		//ʹܣ1/ֹ01
-	  	
-extern u8  USART_RX_BUF[USART_REC_LEN]; //ջ,USART_REC_LENֽ.ĩֽΪз 
-extern u16 USART_RX_STA;         		//״̬	
-extern UART_HandleTypeDef UART1_Handler; //UART
+#define USART_REC_LEN  			SERIAL1_RX_LEN	//һֽ 200
+#define USART_RX_FRAME_NUM		SERIAL1_BIN_NUM	//֡
+#define USART_RX_FRAME_LEN		SERIAL1_BIN_LEN	//֡󳤶(COBS)
 
-#define RXBUFFERSIZE   1 //С
-extern u8 aRxBuffer[RXBUFFERSIZE];//HALUSARTBuffer
+#define USART_LINE_NUM			4		//л,ͬʱôƴһ,ֱд
+#define USART_LINE_LEN			128		//лС,ʱȰƴõĲд
+
+//1ԭĽӿ,ֱӶӦSERIAL1
+#define usart_write(buf,len)	SERIAL_Write(SERIAL1,buf,len)		//д뷢ͻ,ȴ
+#define usart_tx_free()			SERIAL_TxFree(SERIAL1)				//ͻʣռ
+#define usart_set_baud(bound)	SERIAL_SetBaud(SERIAL1,bound)		//л
+#define usart_rx_peek(len)		SERIAL_Peek(SERIAL1,RXLINE_TEXT,len)	//ȡյһ(з),NULLʾû
+#define usart_rx_pop(line)		SERIAL_Pop(SERIAL1,RXLINE_TEXT,line)	//ͷusart_rx_peekȡ
+#define usart_rx_frame(len)		SERIAL_Peek(SERIAL1,RXLINE_BIN,len)	//ȡյĶ֡,NULLʾû
+#define usart_rx_frame_pop(frm)	SERIAL_Pop(SERIAL1,RXLINE_BIN,frm)	//ͷusart_rx_frameȡ֡
 
-//봮жϽգ벻Ҫעº궨
 void uart_init(u32 bound);
 #endif
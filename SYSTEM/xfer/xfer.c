@@ -0,0 +1,325 @@
+#include "xfer.h"
+#include "usart.h"
+#include "delay.h"
+#include "24cxx.h"
+#include "w25qxx.h"
+#include "string.h"
+//////////////////////////////////////////////////////////////////////////////////
+//1ƴЭ
+//:2026/10/19
+//汾V1.0
+//////////////////////////////////////////////////////////////////////////////////
+
+#if XFER_EN
+#if XFER_WINDOW>USART_RX_FRAME_NUM
+#error "XFER_WINDOWܳUSART_RX_FRAME_NUM,򴰿ڵ֡ᱻ"
+#endif
+
+#define XFER_VERSION			1
+#define XFER_FLASH_SIZE			(32*1024*1024)				//W25Q256
+#define XFER_EEPROM_SIZE		(EE_TYPE+1)					//AT24C02
+#define XFER_RAW_MAX			(XFER_DATA_MAX+15)			//cmd seq dev addr len  crc,
+#define XFER_ENC_MAX			(XFER_RAW_MAX+XFER_RAW_MAX/254+3)	//COBSټǰ0x00
+
+#if USART_RX_FRAME_LEN<XFER_ENC_MAX-2
+#error "USART_RX_FRAME_LEN̫С,ŲXFER_DATA_MAX֡"
+#endif
+
+static u8 xfer_rx[USART_RX_FRAME_LEN];		//Ľ֡
+static u8 xfer_tx[XFER_RAW_MAX];			//֡,ݴxfer_tx+2ʼ
+static u8 xfer_enc[XFER_ENC_MAX];			//ķ֡
+#define XFER_TXDATA				(xfer_tx+2)
+
+static u8 xfer_seq=0;						//һWRITE
+static u8 xfer_unack=0;						//д뻹ûACK֡
+static u8 xfer_naked=0;						//1,Ѿxfer_seqعNAK,ط
+static u8 xfer_rd_dev;						//ڽеĶ:
+static u32 xfer_rd_addr;					//ڽеĶ:ַ
+static u32 xfer_rd_len=0;					//ڽеĶ:ʣ೤,0ʾû
+static u8 xfer_rd_seq;						//ڽеĶ:DATA֡
+
+static u32 xfer_rx_cnt=0;					//յ֡
+static u32 xfer_err_cnt=0;					//CRC/ʽ֡
+static u32 xfer_nak_cnt=0;					//NAK
+static u32 xfer_wr_bytes=0;					//дֽ
+static u32 xfer_rd_bytes=0;					//ֽ
+
+//С˶д
+static u32 xfer_get32(const u8 *p)
+{
+	return (u32)p[0]|((u32)p[1]<<8)|((u32)p[2]<<16)|((u32)p[3]<<24);
+}
+
+static void xfer_put32(u8 *p,u32 v)
+{
+	p[0]=(u8)v;
+	p[1]=(u8)(v>>8);
+	p[2]=(u8)(v>>16);
+	p[3]=(u8)(v>>24);
+}
+
+//ʼӲCRCԪ:ʽ0x04C11DB7,ֵ0xFFFFFFFF
+void XFER_Init(void)
+{
+#if XFER_HWCRC
+	__HAL_RCC_CRC_CLK_ENABLE();
+	CRC->POL=0x04C11DB7;
+	CRC->INIT=0xFFFFFFFF;
+#endif
+}
+
+//CRC32,zlibcrc32ͬ
+//Ӳʱ밴ֽλתλת,ȡ;ֻXFER_Pollʹ,Ҫ
+u32 XFER_Crc32(const u8 *buf,u32 len)
+{
+#if XFER_HWCRC
+	CRC->CR=CRC_CR_REV_IN_0|CRC_CR_REV_OUT|CRC_CR_RESET;	//32λʽ,ֽڷת
+	while(len>=4)											//Ȱд,ֽȼ
+	{
+		CRC->DR=((u32)buf[0]<<24)|((u32)buf[1]<<16)|((u32)buf[2]<<8)|buf[3];
+		buf+=4;
+		len-=4;
+	}
+	while(len--)*(__IO u8*)&CRC->DR=*buf++;
+	return ~CRC->DR;
+#else
+	u32 crc=0xFFFFFFFF;
+	u8 i;
+	while(len--)
+	{
+		crc^=*buf++;
+		for(i=0;i<8;i++)crc=(crc>>1)^(0xEDB88320&(0-(crc&1)));
+	}
+	return ~crc;
+#endif
+}
+
+//COBS,û0x00
+//src:ԭʼ
+//len:ԭʼ
+//dst:,len+len/254+1ֽ
+//ֵ:󳤶
+u16 XFER_CobsEncode(const u8 *src,u16 len,u8 *dst)
+{
+	u16 rd=0,wr=1,code_pos=0;
+	u8 code=1;
+	while(rd<len)
+	{
+		if(src[rd]==0)						//0x00ǰĿ鳤ȴ
+		{
+			dst[code_pos]=code;
+			code_pos=wr++;
+			code=1;
+		}else
+		{
+			dst[wr++]=src[rd];
+			if(++code==0xFF)				//254ֽ
+			{
+				dst[code_pos]=code;
+				code_pos=wr++;
+				code=1;
+			}
+		}
+		rd++;
+	}
+	dst[code_pos]=code;
+	return wr;
+}
+
+//COBS,ԭؽ(dst=src)
+//src:,ǰ0x00
+//len:󳤶
+//dst:,lenֽ
+//ֵ:󳤶,0ʾʽ
+u16 XFER_CobsDecode(const u8 *src,u16 len,u8 *dst)
+{
+	u16 rd=0,wr=0;
+	u8 code,i;
+	while(rd<len)
+	{
+		code=src[rd++];
+		if(code==0)return 0;
+		for(i=1;i<code;i++)
+		{
+			if(rd>=len)return 0;			//鳤ȳ֡
+			dst[wr++]=src[rd++];
+		}
+		if(code!=0xFF&&rd<len)dst[wr++]=0;	//һû0x00
+	}
+	return wr;
+}
+
+//һ֡,ѾXFER_TXDATA,ȷͻռ㹻֡д
+//cmd:
+//seq:
+//len:ݳ
+//ֵ:0,ɹ;1,ʱ,֡ûз
+static u8 xfer_send(u8 cmd,u8 seq,u16 len)
+{
+	u16 n,t=0;
+	xfer_tx[0]=cmd;
+	xfer_tx[1]=seq;
+	xfer_put32(xfer_tx+2+len,XFER_Crc32(xfer_tx,len+2));
+	xfer_enc[0]=0;
+	n=XFER_CobsEncode(xfer_tx,len+6,xfer_enc+1)+1;
+	xfer_enc[n++]=0;
+	while(usart_tx_free()<n)
+	{
+		if(t++>=XFER_TX_TIMEOUT)return 1;
+		delay_ms(1);
+	}
+	usart_write(xfer_enc,n);
+	return 0;
+}
+
+//ۼACK
+static void xfer_ack(u8 seq)
+{
+	XFER_TXDATA[0]=xfer_seq;
+	xfer_send(XFER_CMD_ACK,seq,1);
+	xfer_unack=0;
+}
+
+//NAK,CRCͶ֡ͬһֻһ,ⴰں֡ط
+static void xfer_nak(u8 seq,u8 err)
+{
+	if(err==XFER_ERR_CRC||err==XFER_ERR_SEQ)
+	{
+		if(xfer_naked)return;
+		xfer_naked=1;
+	}
+	if(xfer_unack)xfer_ack(seq);			//ȷѾд֡
+	XFER_TXDATA[0]=xfer_seq;
+	XFER_TXDATA[1]=err;
+	xfer_send(XFER_CMD_NAK,seq,2);
+	xfer_nak_cnt++;
+}
+
+//͵ַΧ
+//ֵ:0,ȷ;1,
+static u8 xfer_check(u8 dev,u32 addr,u32 len)
+{
+	u32 size;
+	if(dev==XFER_DEV_EEPROM)size=XFER_EEPROM_SIZE;
+	else if(dev==XFER_DEV_FLASH)size=XFER_FLASH_SIZE;
+	else return 1;
+	return addr>size||len>size-addr;
+}
+
+//һ֡
+static void xfer_handle(const u8 *frm,u16 len)
+{
+	u8 cmd,seq,dev;
+	u8 *d;
+	u32 addr;
+	u16 n;
+	xfer_rx_cnt++;
+	n=XFER_CobsDecode(frm,len,xfer_rx);
+	if(n<6||XFER_Crc32(xfer_rx,n-4)!=xfer_get32(xfer_rx+n-4))	//Ų,ŻNAK
+	{
+		xfer_err_cnt++;
+		xfer_nak(xfer_seq,XFER_ERR_CRC);
+		return;
+	}
+	cmd=xfer_rx[0];
+	seq=xfer_rx[1];
+	d=xfer_rx+2;
+	n-=6;
+	switch(cmd)
+	{
+		case XFER_CMD_PING:
+			xfer_seq=0;
+			xfer_unack=0;
+			xfer_naked=0;
+			xfer_rd_len=0;
+			XFER_TXDATA[0]=XFER_VERSION;
+			XFER_TXDATA[1]=XFER_WINDOW;
+			XFER_TXDATA[2]=(u8)XFER_DATA_MAX;
+			XFER_TXDATA[3]=(u8)(XFER_DATA_MAX>>8);
+			xfer_send(XFER_CMD_PONG,seq,4);
+			break;
+		case XFER_CMD_WRITE:
+			if(seq!=xfer_seq)						//طľ֡м䶪֡
+			{
+				xfer_nak(seq,XFER_ERR_SEQ);
+				break;
+			}
+			if(n<5||xfer_check(d[0],xfer_get32(d+1),n-5))
+			{
+				xfer_nak(seq,XFER_ERR_ARG);
+				break;
+			}
+			dev=d[0];
+			addr=xfer_get32(d+1);
+			if(dev==XFER_DEV_EEPROM)AT24CXX_Write(addr,d+5,n-5);
+			else W25QXX_Write(d+5,addr,n-5);
+			xfer_wr_bytes+=n-5;
+			xfer_seq++;
+			xfer_naked=0;
+			if(++xfer_unack>=XFER_ACK_EVERY)xfer_ack(seq);
+			break;
+		case XFER_CMD_READ:
+			if(n<9||xfer_check(d[0],xfer_get32(d+1),xfer_get32(d+5)))
+			{
+				xfer_nak(seq,XFER_ERR_ARG);
+				break;
+			}
+			xfer_rd_dev=d[0];						//XFER_Pollֶη
+			xfer_rd_addr=xfer_get32(d+1);
+			xfer_rd_len=xfer_get32(d+5);
+			xfer_rd_seq=0;
+			if(xfer_rd_len==0)xfer_ack(seq);		//ûDATAɷ,ACK,õȵʱ
+			break;
+		case XFER_CMD_BAUD:
+			if(n<4)
+			{
+				xfer_nak(seq,XFER_ERR_ARG);
+				break;
+			}
+			xfer_ack(seq);
+			usart_set_baud(xfer_get32(d));			//ACKл
+			break;
+		default:
+			xfer_nak(seq,XFER_ERR_CMD);
+			break;
+	}
+}
+
+//Ͷ,ͻŵ¶֡ͷ֡,ȴ
+static void xfer_read_poll(void)
+{
+	u16 n;
+	while(xfer_rd_len&&usart_tx_free()>=XFER_ENC_MAX)
+	{
+		n=xfer_rd_len>XFER_DATA_MAX?XFER_DATA_MAX:xfer_rd_len;
+		xfer_put32(XFER_TXDATA,xfer_rd_addr);
+		if(xfer_rd_dev==XFER_DEV_EEPROM)AT24CXX_Read(xfer_rd_addr,XFER_TXDATA+4,n);
+		else W25QXX_Read(XFER_TXDATA+4,xfer_rd_addr,n);
+		xfer_send(XFER_CMD_DATA,xfer_rd_seq++,n+4);
+		xfer_rd_addr+=n;
+		xfer_rd_len-=n;
+		xfer_rd_bytes+=n;
+	}
+}
+
+//յж֡,ٷͶ
+//ֻһ
+void XFER_Poll(void)
+{
+	u8 *frm;
+	u16 len;
+	while((frm=usart_rx_frame(&len))!=NULL)
+	{
+		xfer_handle(frm,len);
+		usart_rx_frame_pop(frm);
+	}
+	if(xfer_unack)xfer_ack(xfer_seq-1);		//д,ȷʣµ֡
+	xfer_read_poll();
+}
+
+//ͳ
+void XFER_Report(void)
+{
+	printf("xfer: rx %u err %u nak %u write %u read %u\r\n",xfer_rx_cnt,xfer_err_cnt,xfer_nak_cnt,xfer_wr_bytes,xfer_rd_bytes);
+}
+#endif
@@ -0,0 +1,67 @@
+#ifndef _XFER_H
+#define _XFER_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////
+//1ƴЭ
+//дW25Q256AT24C02,printfıô1
+//֡COBS,ǰһ0x00;֡Ϊcmd(1) seq(1) data(n) crc32(4)
+//CRC32zlibcrc32ͬ,ӲCRCԪ;ֶֽξΪС
+//дʱXFER_WINDOW֡Ӧ,豸д,ÿXFER_ACK_EVERY֡һۼACK
+//:2026/10/19
+//汾V1.0
+//********************************************************************************
+//(->豸):
+//PING  0x01 data:                     ӦPONG 0x81 data:汾(1) (1) ÿ֡(2)
+//                                       ͬʱWRITE,ֹͣڽеĶ
+//WRITE 0x02 data:dev(1) addr(4)     seq0ʼ֡1,ӦACK/NAK
+//READ  0x03 data:dev(1) addr(4) len(4)  ӦDATA 0x83 data:addr(4) ,seq0ʼ֡1
+//                                       lenΪ0ʱӦACK,ûDATA
+//BAUD  0x04 data:baud(4)                ӦACK,Ӧл
+//Ӧ(豸->):
+//ACK   0x90 data:һWRITE(1)
+//NAK   0x91 data:һWRITE(1) (1),ſʼط
+//ʹ÷:
+//1,uart_init֮XFER_Init()
+//2,ڵXFER_Poll(),յĶ֡,ֶηͶ
+//˹߼TOOLS/xfer.py
+//////////////////////////////////////////////////////////////////////////////////
+
+#define XFER_EN					1		//0,ر;1,ƴЭ
+#ifndef XFER_HWCRC
+#define XFER_HWCRC				1		//0,CRC32;1,ӲCRCԪ(PCϱʱ-DXFER_HWCRC=0)
+#endif
+#define XFER_DATA_MAX			256		//ÿ֡
+#define XFER_WINDOW				8		//͵WRITE֡,USART_RX_FRAME_NUM
+#define XFER_ACK_EVERY			4		//ÿд֡һACK,֡дʱҲACK
+#define XFER_TX_TIMEOUT			100		//ȷͻռĳʱʱ(ms)
+
+#define XFER_DEV_EEPROM			0		//AT24C02
+#define XFER_DEV_FLASH			1		//W25Q256
+
+#define XFER_CMD_PING			0x01
+#define XFER_CMD_WRITE			0x02
+#define XFER_CMD_READ			0x03
+#define XFER_CMD_BAUD			0x04
+#define XFER_CMD_PONG			0x81
+#define XFER_CMD_DATA			0x83
+#define XFER_CMD_ACK			0x90
+#define XFER_CMD_NAK			0x91
+
+#define XFER_ERR_CRC			1		//CRC֡ʽ
+#define XFER_ERR_SEQ			2		//Ų(֡)
+#define XFER_ERR_CMD			3		//ֵ֧
+#define XFER_ERR_ARG			4		//ŴַԽ,Ӧط
+
+#if XFER_EN
+void XFER_Init(void);					//ʼCRCԪ
+void XFER_Poll(void);					//յ֡,Ͷ
+void XFER_Report(void);					//ͳ
+u16 XFER_CobsEncode(const u8 *src,u16 len,u8 *dst);	//COBS
+u16 XFER_CobsDecode(const u8 *src,u16 len,u8 *dst);	//COBS,0ʾʽ
+u32 XFER_Crc32(const u8 *buf,u32 len);				//CRC32
+#else
+#define XFER_Init()
+#define XFER_Poll()
+#define XFER_Report()
+#endif
+#endif
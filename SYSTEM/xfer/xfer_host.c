@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////////
+//PCxfer.c,Keil,TOOLS/hosttest.sh,TOOLS/xfer_sim.py:
+//gcc -DXFER_HWCRC=0 -ISYSTEM/usart -ISYSTEM/serial -ISYSTEM/delay -ITOOLS/host -ISYSTEM/xfer SYSTEM/xfer/xfer_host.c
+//    SYSTEM/xfer/xfer.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c -pthread
+//1pty(serial_host.c),һpty豸;AT24C02W25Q256ڴ,ʼΪ0xFF
+//main_taskһѭXFER_Poll();׼رʱͳ(1ǰ)˳
+//////////////////////////////////////////////////////////////////////////////////
+#include "xfer.h"
+#include "usart.h"
+#include "delay.h"
+#include "24cxx.h"
+#include "w25qxx.h"
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+
+static u8 host_eeprom[EE_TYPE+1];
+static u8 host_flash[32*1024*1024];			//W25Q256
+
+void AT24CXX_Write(u16 WriteAddr,u8 *pBuffer,u16 NumToWrite)
+{
+	memcpy(host_eeprom+WriteAddr,pBuffer,NumToWrite);
+}
+
+void AT24CXX_Read(u16 ReadAddr,u8 *pBuffer,u16 NumToRead)
+{
+	memcpy(pBuffer,host_eeprom+ReadAddr,NumToRead);
+}
+
+//ϵW25QXX_WriteȲд,ԭд
+void W25QXX_Write(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite)
+{
+	memcpy(host_flash+WriteAddr,pBuffer,NumByteToWrite);
+}
+
+void W25QXX_Read(u8* pBuffer,u32 ReadAddr,u16 NumByteToRead)
+{
+	memcpy(pBuffer,host_flash+ReadAddr,NumByteToRead);
+}
+
+void delay_ms(u16 nms)
+{
+	usleep(nms*1000);
+}
+
+//׼ر(ļβ)ʱ1
+static int host_stdin_closed(void)
+{
+	struct pollfd p;
+	char c;
+	p.fd=0;
+	p.events=POLLIN;
+	if(poll(&p,1,0)<=0)return 0;
+	return read(0,&c,1)<=0;
+}
+
+int main(void)
+{
+	memset(host_eeprom,0xFF,sizeof(host_eeprom));
+	memset(host_flash,0xFF,sizeof(host_flash));
+	SERIAL_Init(SERIAL1,115200);				//̴߳DMAͿж
+	XFER_Init();
+	printf("%s\n",SERIAL_HostPath(SERIAL1));
+	fflush(stdout);
+	while(!host_stdin_closed())
+	{
+		XFER_Poll();
+		usleep(1000);
+	}
+	XFER_Report();
+	SERIAL_Stat(SERIAL1);
+	return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef _24CXX_H
+#define _24CXX_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱHARDWARE/24CXX/24cxx.h
+//ûIIC,ɲԳڴʵ(SYSTEM/xfer/xfer_host.c)
+//////////////////////////////////////////////////////////////////////////////////
+
+#define AT24C02		255
+#define EE_TYPE AT24C02
+
+void AT24CXX_Write(u16 WriteAddr,u8 *pBuffer,u16 NumToWrite);	//ַָʼдָȵ
+void AT24CXX_Read(u16 ReadAddr,u8 *pBuffer,u16 NumToRead);   	//ַָʼָȵ
+#endif
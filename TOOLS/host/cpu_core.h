@@ -0,0 +1,10 @@
+#ifndef _CPU_CORE_H
+#define _CPU_CORE_H
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱuC-CPUcpu_core.h
+//ûжCPU_CFG_INT_DIS_MEAS_EN,uC-CPUĹжͳƲ;CPU_InitʲôҲ(os_host.c)
+//////////////////////////////////////////////////////////////////////////////////
+
+void CPU_Init(void);
+
+#endif
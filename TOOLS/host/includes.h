@@ -0,0 +1,41 @@
+#ifndef _INCLUDES_H
+#define _INCLUDES_H
+#include "sys.h"
+#include <string.h>
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱUCOSIIincludes.h
+//ֻٽôͳƹжʱ(OS_INT_DIS_MEAS_EN)OSTimeGet,RealViewֲ(os_cpu.h)Ľӿͬ,
+//ʵos_host.c:ûĹж,ʱDWT->CYCCNT(ɲԳƽ);OSTimeGetPCĵʱ(ms)
+//////////////////////////////////////////////////////////////////////////////////
+
+#define OS_INT_DIS_MEAS_EN				1u
+#define OS_CPU_INT_DIS_MEAS_SITE_NBR	8u
+#define OS_TICKS_PER_SEC				1000u	//Ͱһ1msһ
+
+typedef uint32_t INT32U;
+typedef INT32U OS_CPU_SR;
+
+#define OS_ENTER_CRITICAL()		{cpu_sr=OS_CPU_SR_Save();OS_CPU_IntDisMeasStart(cpu_sr);}
+#define OS_EXIT_CRITICAL()		{OS_CPU_IntDisMeasStop(cpu_sr,__FILE__,__LINE__);OS_CPU_SR_Restore(cpu_sr);}
+
+typedef struct os_cpu_int_dis_site
+{
+	const char *FileName;		//OS_EXIT_CRITICAL()ڵļ
+	INT32U Line;				//OS_EXIT_CRITICAL()ڵ
+	INT32U Ctr;					//ôͳƵĴ
+	INT32U MaxCnts;				//жʱ(DWT)
+}OS_CPU_INT_DIS_SITE;
+
+extern OS_CPU_INT_DIS_SITE OS_CPU_IntDisSiteTbl[OS_CPU_INT_DIS_MEAS_SITE_NBR];
+extern INT32U OS_CPU_IntDisSiteNbr;
+extern INT32U OS_CPU_IntDisSiteOvf;
+extern INT32U OS_CPU_IntDisMaxCnts;
+
+OS_CPU_SR OS_CPU_SR_Save(void);
+void OS_CPU_SR_Restore(OS_CPU_SR cpu_sr);
+void OS_CPU_IntDisMeasInit(void);
+void OS_CPU_IntDisMeasStart(OS_CPU_SR cpu_sr);
+void OS_CPU_IntDisMeasStop(OS_CPU_SR cpu_sr,const char *p_file,INT32U line);
+INT32U OSTimeGet(void);
+
+#endif
@@ -0,0 +1,88 @@
+#include "includes.h"
+#include "cpu_core.h"
+#include <time.h>
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱuC/OS-II RealViewֲٽ͹жʱͳ
+//PRIMASKֻһ;Ƕ׵ٽʱ,ֻͳ(os_cpu_c.cͬ)
+//OSTimeGetPCĵʱ(ms),ڰļƳʱģ(SYSTEM/modbus/modbus.c)
+//////////////////////////////////////////////////////////////////////////////////
+
+OS_CPU_INT_DIS_SITE OS_CPU_IntDisSiteTbl[OS_CPU_INT_DIS_MEAS_SITE_NBR];
+INT32U OS_CPU_IntDisSiteNbr;
+INT32U OS_CPU_IntDisSiteOvf;
+INT32U OS_CPU_IntDisMaxCnts;
+static INT32U os_host_start;		//ٽʱCYCCNT
+static OS_CPU_SR os_host_primask;	//1,"ж"
+
+OS_CPU_SR OS_CPU_SR_Save(void)
+{
+	OS_CPU_SR sr=os_host_primask;
+	os_host_primask=1;
+	return sr;
+}
+
+void OS_CPU_SR_Restore(OS_CPU_SR cpu_sr)
+{
+	os_host_primask=cpu_sr;
+}
+
+void OS_CPU_IntDisMeasInit(void)
+{
+	OS_CPU_SR cpu_sr;
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;
+	cpu_sr=OS_CPU_SR_Save();			//OS_ENTER_CRITICAL(),ͳԼ
+	memset(OS_CPU_IntDisSiteTbl,0,sizeof(OS_CPU_IntDisSiteTbl));
+	OS_CPU_IntDisSiteNbr=0;
+	OS_CPU_IntDisSiteOvf=0;
+	OS_CPU_IntDisMaxCnts=0;
+	os_host_start=DWT->CYCCNT;
+	OS_CPU_SR_Restore(cpu_sr);
+}
+
+void OS_CPU_IntDisMeasStart(OS_CPU_SR cpu_sr)
+{
+	if((cpu_sr&1)==0)os_host_start=DWT->CYCCNT;
+}
+
+//ô(ļָк)¼ʱ,µĵôֵֻܵ
+void OS_CPU_IntDisMeasStop(OS_CPU_SR cpu_sr,const char *p_file,INT32U line)
+{
+	INT32U cnts,i;
+	OS_CPU_INT_DIS_SITE *p;
+	if(cpu_sr&1)return;
+	cnts=DWT->CYCCNT-os_host_start;
+	if(cnts>OS_CPU_IntDisMaxCnts)OS_CPU_IntDisMaxCnts=cnts;
+	for(i=0;i<OS_CPU_IntDisSiteNbr;i++)
+	{
+		p=&OS_CPU_IntDisSiteTbl[i];
+		if(p->Line==line&&p->FileName==p_file)break;
+	}
+	if(i==OS_CPU_IntDisSiteNbr)
+	{
+		if(i>=OS_CPU_INT_DIS_MEAS_SITE_NBR)
+		{
+			OS_CPU_IntDisSiteOvf++;
+			return;
+		}
+		OS_CPU_IntDisSiteTbl[i].FileName=p_file;
+		OS_CPU_IntDisSiteTbl[i].Line=line;
+		OS_CPU_IntDisSiteNbr++;
+	}
+	p=&OS_CPU_IntDisSiteTbl[i];
+	p->Ctr++;
+	if(cnts>p->MaxCnts)p->MaxCnts=cnts;
+}
+
+//ǰ,1msһ
+INT32U OSTimeGet(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (INT32U)(ts.tv_sec*1000+ts.tv_nsec/1000000);
+}
+
+//uC-CPU:PCûҪʼ
+void CPU_Init(void)
+{
+}
@@ -0,0 +1,13 @@
+#ifndef __PCF8574_H
+#define __PCF8574_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱHARDWARE/PCF8574/pcf8574.h
+//ûIIC,ɲԳʵ(SYSTEM/modbus/modbus_test.c¼RS485շ)
+//////////////////////////////////////////////////////////////////////////////////
+
+#define RS485_RE_IO     6    	//RS485_RE		P6
+
+u8 PCF8574_Init(void);
+void PCF8574_WriteBit(u8 bit,u8 sta);
+#endif
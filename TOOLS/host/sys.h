@@ -0,0 +1,53 @@
+#ifndef _SYS_H
+#define _SYS_H
+#include <stdint.h>
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱSYSTEM/sys/sys.h
+//ֻṩӲģ(isrmon/log)õͺͺ,HAL
+//////////////////////////////////////////////////////////////////////////////////
+
+#define SYSTEM_SUPPORT_OS		0		//PCûOS
+
+typedef int32_t  s32;
+typedef int16_t s16;
+typedef int8_t  s8;
+typedef uint32_t  u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+typedef volatile uint32_t  vu32;
+typedef volatile uint16_t vu16;
+typedef volatile uint8_t  vu8;
+
+//ں:ֻмĴ,Լ,ɲԳ(DWT->CYCCNT+=nģ⾭n)
+//,ļͬһ
+typedef struct
+{
+	volatile u32 CTRL;
+	volatile u32 CYCCNT;
+}_host_dwt;
+typedef struct
+{
+	volatile u32 DEMCR;
+}_host_coredebug;
+typedef struct
+{
+	volatile u32 CTRL;
+	volatile u32 LOAD;
+	volatile u32 VAL;
+}_host_systick;
+__attribute__((weak)) _host_dwt host_dwt;
+__attribute__((weak)) _host_coredebug host_coredebug;
+__attribute__((weak)) _host_systick host_systick;
+#define DWT						(&host_dwt)
+#define CoreDebug				(&host_coredebug)
+#define SysTick					(&host_systick)
+#define DWT_CTRL_CYCCNTENA_Msk	1u
+#define CoreDebug_DEMCR_TRCENA_Msk	(1u<<24)
+
+#define __CLZ(x)				((u32)((x)?__builtin_clz(x):32))
+#define SystemCoreClock			400000000u	//Ͱһ400MHz
+
+//HALĴھ,PCָֻ
+typedef struct _host_uart UART_HandleTypeDef;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef _USART_H
+#define _USART_H
+#include "sys.h"
+#include "stdio.h"
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱSYSTEM/usart/usart.h
+//printfֱն,1ɲԳʵ
+//////////////////////////////////////////////////////////////////////////////////
+
+void usart_write(const u8 *buf,u16 len);	//д봮1ͻ,Գʵ
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef __W25QXX_H
+#define __W25QXX_H
+#include "sys.h"
+//////////////////////////////////////////////////////////////////////////////////
+//PCϱ(TOOLS/hosttest.sh)ʱHARDWARE/W25QXX/w25qxx.h
+//ûQSPI,ɲԳڴʵ(SYSTEM/xfer/xfer_host.c)
+//////////////////////////////////////////////////////////////////////////////////
+
+#define W25Q256 0XEF18
+
+void W25QXX_Read(u8* pBuffer,u32 ReadAddr,u16 NumByteToRead);   //ȡflash
+void W25QXX_Write(u8* pBuffer,u32 WriteAddr,u16 NumByteToWrite);//дflash
+#endif
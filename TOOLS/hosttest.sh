@@ -0,0 +1,94 @@
+#!/bin/sh
+# 在PC上用gcc编译运行纯C模块的测试,不需要开发板,Keil工程不包含这些文件
+# 用法:
+#   TOOLS/hosttest.sh          编译运行全部测试,有一个失败返回1
+#   TOOLS/hosttest.sh bench    测试之后再运行性能测试(同一个模块的优化前/后两个版本)
+# 环境变量: CC(默认gcc) OUT(可执行文件目录,默认/tmp/hosttest)
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-gcc}
+OUT=${OUT:-/tmp/hosttest}
+mkdir -p "$OUT" || exit 1
+LIB="-IUCOSII/uC-LIB -IUCOSII/uC-CPU -IUCOSII/uC-CPU/ARM-Cortex-M4/RealView -IUCOSII/uCOS-CONFIG"
+STR="UCOSII/uC-LIB/lib_str.c UCOSII/uC-LIB/lib_ascii.c"
+# lib_mem用Posix/GNU主机移植(64位地址,临界区是互斥锁,独占读写用版本号模拟)
+MEM="-pthread -IUCOSII/uC-LIB -IUCOSII/uC-CPU -IUCOSII/uC-CPU/Posix/GNU -IUCOSII/uCOS-CONFIG -DLIB_MEM_CFG_OPTIMIZE_ASM_EN=DEF_DISABLED
+	UCOSII/uC-LIB/lib_mem.c $STR UCOSII/uC-LIB/Ports/Posix/GNU/lib_mem_c.c UCOSII/uC-CPU/Posix/GNU/cpu_c.c"
+MATH="-IUCOSII/uC-LIB -IUCOSII/uC-CPU -IUCOSII/uC-CPU/Posix/GNU -IUCOSII/uCOS-CONFIG
+	UCOSII/uC-LIB/lib_math.c UCOSII/uC-CPU/Posix/GNU/cpu_c.c -pthread -lm"
+HOST="-ITOOLS/host"		# 代替sys.h/usart.h/includes.h,不依赖HAL的模块用
+FAIL=0
+
+# 只编译: build 名字 编译参数...
+build()
+{
+	name=$1
+	shift
+	$CC -O2 -o "$OUT/$name" "$@" && return 0
+	echo "$name: BUILD FAILED"
+	FAIL=1
+	return 1
+}
+
+# 编译并运行: run 名字 编译参数...
+run()
+{
+	build "$@" || return
+	if ! "$OUT/$1"; then
+		echo "$1: FAILED"
+		FAIL=1
+	fi
+}
+
+# uC-LIB(Micrium代码,关掉警告)
+run lib_str_test -w $LIB UCOSII/uC-LIB/lib_str_test.c $STR
+run lib_str_test_byte -w $LIB -DLIB_STR_CFG_OPTIMIZE_WORD_EN=DEF_DISABLED -DLIB_STR_CFG_FMT_FAST_EN=DEF_DISABLED UCOSII/uC-LIB/lib_str_test.c $STR
+run lib_mem_test -w $MEM UCOSII/uC-LIB/lib_mem_test.c
+run lib_mem_test_crit -w $MEM -DLIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN=DEF_DISABLED UCOSII/uC-LIB/lib_mem_test.c
+run lib_math_test -w UCOSII/uC-LIB/lib_math_test.c $MATH
+run lib_math_test_c -w -DLIB_MATH_CFG_OPTIMIZE_DSP_EN=DEF_DISABLED UCOSII/uC-LIB/lib_math_test.c $MATH
+
+# SYSTEM
+run log_test -w $HOST $LIB -ISYSTEM/log SYSTEM/log/log_test.c SYSTEM/log/log.c $STR
+run rxline_test -Wall -ISYSTEM/serial SYSTEM/serial/rxline_test.c SYSTEM/serial/rxline.c
+run serial_test -Wall $HOST -ISYSTEM/serial SYSTEM/serial/serial_test.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c -pthread
+run isrmon_test -Wall $HOST -ISYSTEM/isrmon SYSTEM/isrmon/isrmon_test.c SYSTEM/isrmon/isrmon.c TOOLS/host/os_host.c
+run mbcore_test -Wall -ISYSTEM/modbus SYSTEM/modbus/mbcore_test.c SYSTEM/modbus/mbcore.c
+run modbus_test -Wall $HOST -ISYSTEM/modbus -ISYSTEM/serial -IHARDWARE/RS485 SYSTEM/modbus/modbus_test.c SYSTEM/modbus/modbus.c \
+	SYSTEM/modbus/mbcore.c HARDWARE/RS485/rs485.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c TOOLS/host/os_host.c -pthread
+run mbpoll_test -Wall $HOST -ISYSTEM/modbus -ISYSTEM/serial -IHARDWARE/RS485 SYSTEM/modbus/mbpoll_test.c SYSTEM/modbus/mbpoll.c \
+	SYSTEM/modbus/modbus.c SYSTEM/modbus/mbcore.c HARDWARE/RS485/rs485.c SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c TOOLS/host/os_host.c -pthread
+
+run tpcore_test -Wall -ISYSTEM/isotp SYSTEM/isotp/tpcore_test.c SYSTEM/isotp/tpcore.c
+run clcore_test -Wall -ISYSTEM/canlog SYSTEM/canlog/clcore_test.c SYSTEM/canlog/clcore.c
+run cocore_test -Wall -ISYSTEM/canopen SYSTEM/canopen/cocore_test.c SYSTEM/canopen/cocore.c
+run gwcore_test -Wall -ISYSTEM/gateway SYSTEM/gateway/gwcore_test.c SYSTEM/gateway/gwcore.c
+
+# HARDWARE
+run fdcore_test -Wall -IHARDWARE/FDCAN HARDWARE/FDCAN/fdcore_test.c HARDWARE/FDCAN/fdcore.c
+run btcore_test -Wall -IHARDWARE/FDCAN HARDWARE/FDCAN/btcore_test.c HARDWARE/FDCAN/btcore.c
+run ldcore_test -Wall -IHARDWARE/FDCAN HARDWARE/FDCAN/ldcore_test.c HARDWARE/FDCAN/ldcore.c
+
+# xfer.c在PC上运行(串口1换成serial_host.c的pty),xfer.py通过注入丢帧的pty读写
+if build xfer_host -Wall -DXFER_HWCRC=0 -ISYSTEM/usart -ISYSTEM/serial -ISYSTEM/delay $HOST -ISYSTEM/xfer SYSTEM/xfer/xfer_host.c SYSTEM/xfer/xfer.c \
+	SYSTEM/serial/serial_host.c SYSTEM/serial/rxline.c -pthread; then
+	if python3 -c "import serial" 2>/dev/null; then
+		python3 TOOLS/xfer_sim.py "$OUT/xfer_host" --test || { echo "xfer_sim: FAILED"; FAIL=1; }
+	else
+		echo "xfer_sim: skipped (需要python3和pyserial)"
+	fi
+fi
+
+if [ "$1" = bench ]; then
+	run lib_str_bench -w $LIB UCOSII/uC-LIB/lib_str_bench.c $STR
+	run lib_str_bench_byte -w $LIB -DLIB_STR_CFG_OPTIMIZE_WORD_EN=DEF_DISABLED -DLIB_STR_CFG_FMT_FAST_EN=DEF_DISABLED UCOSII/uC-LIB/lib_str_bench.c $STR
+	run lib_mem_bench -w $MEM UCOSII/uC-LIB/lib_mem_bench.c
+	run lib_mem_bench_crit -w $MEM -DLIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN=DEF_DISABLED UCOSII/uC-LIB/lib_mem_bench.c
+	run lib_math_bench -w UCOSII/uC-LIB/lib_math_bench.c $MATH
+	run btcore_bench -Wall -IHARDWARE/FDCAN HARDWARE/FDCAN/btcore_bench.c HARDWARE/FDCAN/btcore.c
+	"$OUT/log_test" bench | tail -1
+	"$OUT/rxline_test" bench | tail -1
+	"$OUT/mbcore_test" bench | tail -1
+fi
+
+[ $FAIL = 0 ] && echo "hosttest: all passed"
+exit $FAIL
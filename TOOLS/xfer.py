@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# 串口1二进制传输协议(SYSTEM/xfer)的主机端工具
+# 用法:
+#   xfer.py /dev/ttyUSB0 ping
+#   xfer.py /dev/ttyUSB0 read  flash 0x1000 65536 out.bin
+#   xfer.py /dev/ttyUSB0 write eeprom 0 in.bin
+#   xfer.py /dev/ttyUSB0 --baud 921600 read flash 0 1048576 out.bin
+# 需要pyserial;端口也可以是pty等任何pyserial能打开的设备
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+CMD_PING, CMD_WRITE, CMD_READ, CMD_BAUD = 0x01, 0x02, 0x03, 0x04
+CMD_PONG, CMD_DATA, CMD_ACK, CMD_NAK = 0x81, 0x83, 0x90, 0x91
+ERR_ARG = 4
+DEVS = {'eeprom': 0, 'flash': 1}
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos, code = 0, 1
+    for b in data:
+        if b == 0:
+            out[code_pos] = code
+            code_pos, code = len(out), 1
+            out.append(0)
+        else:
+            out.append(b)
+            code += 1
+            if code == 0xFF:
+                out[code_pos] = code
+                code_pos, code = len(out), 1
+                out.append(0)
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Xfer:
+    def __init__(self, port, baud, timeout=1.0):
+        self.ser = serial.Serial(port, baud, timeout=0.05)
+        self.timeout = timeout
+        self.rxbuf = bytearray()
+        self.window = 8
+        self.data_max = 256
+
+    def send(self, cmd, seq, data=b''):
+        raw = bytes([cmd, seq & 0xFF]) + data
+        raw += struct.pack('<I', zlib.crc32(raw) & 0xFFFFFFFF)
+        self.ser.write(b'\0' + cobs_encode(raw) + b'\0')
+
+    def recv(self, timeout=None):
+        """返回(cmd, seq, data),超时返回None;CRC错误的帧和帧之间的文本输出直接丢掉"""
+        end = time.monotonic() + (self.timeout if timeout is None else timeout)
+        while time.monotonic() < end:
+            while b'\0' in self.rxbuf:
+                frame, _, rest = bytes(self.rxbuf).partition(b'\0')
+                self.rxbuf = bytearray(rest)
+                raw = cobs_decode(frame) if frame else None
+                if raw and len(raw) >= 6 and zlib.crc32(raw[:-4]) & 0xFFFFFFFF == struct.unpack('<I', raw[-4:])[0]:
+                    return raw[0], raw[1], raw[2:-4]
+            self.rxbuf += self.ser.read(max(1, self.ser.in_waiting))
+        return None
+
+    def ping(self):
+        for _ in range(3):
+            self.send(CMD_PING, 0)
+            end = time.monotonic() + self.timeout
+            while time.monotonic() < end:           # 丢掉之前没收完的DATA帧
+                r = self.recv(end - time.monotonic())
+                if r and r[0] == CMD_PONG:
+                    ver, self.window, self.data_max = struct.unpack('<BBH', r[2][:4])
+                    return ver
+        raise IOError('no response')
+
+    def baud(self, baud):
+        self.send(CMD_BAUD, 0, struct.pack('<I', baud))
+        r = self.recv()
+        if not r or r[0] != CMD_ACK:
+            raise IOError('baud not accepted')
+        time.sleep(0.05)
+        self.ser.baudrate = baud
+        self.ping()
+
+    def write(self, dev, addr, data):
+        """按窗口连续发送,收到NAK或超时从期望的序号开始重发(回退N帧)"""
+        self.ping()
+        chunks = [data[i:i + self.data_max] for i in range(0, len(data), self.data_max)]
+        base = 0                    # 最早没确认的帧
+        nxt = 0                     # 下一个要发的帧
+        retry = 0
+        while base < len(chunks):
+            while nxt < len(chunks) and nxt - base < self.window:
+                off = nxt * self.data_max
+                self.send(CMD_WRITE, nxt, struct.pack('<BI', dev, addr + off) + chunks[nxt])
+                nxt += 1
+            r = self.recv()
+            if r is None:
+                retry += 1
+                if retry > 5:
+                    raise IOError('write timeout at frame %d' % base)
+                nxt = base
+                continue
+            cmd, _, d = r
+            if cmd not in (CMD_ACK, CMD_NAK):
+                continue
+            expect = base + ((d[0] - base) & 0xFF)      # 8位序号展开
+            if base < expect <= nxt:
+                base, retry = expect, 0
+            if cmd == CMD_NAK:
+                if d[1] == ERR_ARG:
+                    raise IOError('bad device or address')
+                nxt = base
+            sys.stderr.write('\rwrite %d/%d' % (min(base * self.data_max, len(data)), len(data)))
+        sys.stderr.write('\n')
+
+    def read(self, dev, addr, length):
+        """设备连续发送DATA帧,丢失或出错的部分重新请求"""
+        self.ping()
+        out = bytearray(length)
+        pos = 0
+        while pos < length:
+            self.send(CMD_READ, 0, struct.pack('<BII', dev, addr + pos, length - pos))
+            while pos < length:
+                r = self.recv()
+                if r is None:
+                    break
+                cmd, _, d = r
+                if cmd == CMD_NAK:
+                    if d[1] == ERR_ARG:
+                        raise IOError('bad device or address')
+                    break                   # READ帧出错,重新请求
+                if cmd != CMD_DATA:
+                    continue
+                a = struct.unpack('<I', d[:4])[0] - addr
+                if a != pos:                # 中间丢了帧,从丢的位置重新读
+                    self.ping()
+                    break
+                out[pos:pos + len(d) - 4] = d[4:]
+                pos += len(d) - 4
+                sys.stderr.write('\rread %d/%d' % (pos, length))
+        sys.stderr.write('\n')
+        return bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='STM32H7 xfer client')
+    ap.add_argument('port')
+    ap.add_argument('--baud', type=int, default=0, help='连接后切换到这个波特率')
+    ap.add_argument('--init-baud', type=int, default=115200)
+    sub = ap.add_subparsers(dest='cmd', required=True)
+    sub.add_parser('ping')
+    p = sub.add_parser('read')
+    p.add_argument('dev', choices=DEVS)
+    p.add_argument('addr', type=lambda s: int(s, 0))
+    p.add_argument('len', type=lambda s: int(s, 0))
+    p.add_argument('file')
+    p = sub.add_parser('write')
+    p.add_argument('dev', choices=DEVS)
+    p.add_argument('addr', type=lambda s: int(s, 0))
+    p.add_argument('file')
+    a = ap.parse_args()
+
+    x = Xfer(a.port, a.init_baud)
+    print('device protocol v%d, window %d, %d bytes/frame' % (x.ping(), x.window, x.data_max))
+    if a.baud:
+        x.baud(a.baud)
+    t = time.monotonic()
+    if a.cmd == 'read':
+        data = x.read(DEVS[a.dev], a.addr, a.len)
+        open(a.file, 'wb').write(data)
+    elif a.cmd == 'write':
+        data = open(a.file, 'rb').read()
+        x.write(DEVS[a.dev], a.addr, data)
+    else:
+        return
+    t = time.monotonic() - t
+    print('%d bytes in %.2fs, %.1f KB/s' % (len(data), t, len(data) / t / 1024))
+
+
+if __name__ == '__main__':
+    main()
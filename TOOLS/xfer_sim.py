@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+# 在PC上运行设备端的xfer.c(SYSTEM/xfer/xfer_host.c编译出的程序,串口1是serial_host.c的pty),中间加一个转发的pty注入丢帧/错帧
+# 用法:
+#   xfer_sim.py xfer_host                打开转发pty并打印设备名,可以用xfer.py连接它手动测试
+#   xfer_sim.py xfer_host --loss 0.02    两个方向的帧按比例丢弃或改坏,测试重发
+#   xfer_sim.py xfer_host --test         自测:用xfer.py的Xfer类读写,带丢帧和CRC错误,TOOLS/hosttest.sh会运行
+# 需要pyserial(xfer.py用)
+import argparse
+import os
+import random
+import struct
+import subprocess
+import sys
+import threading
+import time
+import tty
+
+from xfer import CMD_ACK, CMD_NAK, CMD_READ, DEVS, ERR_ARG, Xfer
+
+FLASH_SIZE = 32 * 1024 * 1024
+
+
+class Proxy:
+    """在主机工具和xfer_host的pty之间逐帧转发,按loss丢弃帧或改坏一个字节"""
+
+    def __init__(self, dev_path, loss=0.0, seed=1):
+        self.loss = loss
+        self.rnd = random.Random(seed)
+        self.lost = 0
+        self.lock = threading.Lock()
+        self.dev = os.open(dev_path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.dev)
+        self.master, self.slave = os.openpty()
+        tty.setraw(self.slave)
+        self.name = os.ttyname(self.slave)
+        for src, dst in ((self.master, self.dev), (self.dev, self.master)):
+            threading.Thread(target=self.forward, args=(src, dst), daemon=True).start()
+
+    def fault(self, frame):
+        with self.lock:
+            if not self.loss or self.rnd.random() >= self.loss:
+                return frame
+            self.lost += 1
+            if self.rnd.random() < 0.5:
+                return None
+            frame = bytearray(frame)
+            frame[self.rnd.randrange(len(frame))] ^= 0x55
+            return bytes(frame.replace(b'\0', b'\1'))
+
+    def forward(self, src, dst):
+        buf = b''
+        while True:
+            try:
+                chunk = os.read(src, 4096)
+            except OSError:
+                return
+            if not chunk:
+                return
+            buf += chunk
+            while b'\0' in buf:
+                frame, _, buf = buf.partition(b'\0')
+                if frame:
+                    frame = self.fault(frame)
+                    if frame is not None:
+                        os.write(dst, b'\0' + frame + b'\0')
+
+
+class Host:
+    """运行xfer_host,第一行输出是pty设备名,之后的输出(退出时的统计)收集到lines"""
+
+    def __init__(self, path):
+        self.proc = subprocess.Popen([path], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True)
+        self.path = self.proc.stdout.readline().strip()
+        self.lines = []
+        threading.Thread(target=self.collect, daemon=True).start()
+
+    def collect(self):
+        for line in self.proc.stdout:
+            self.lines.append(line.strip())
+
+    def close(self):
+        """关闭标准输入,xfer_host输出统计后退出"""
+        self.proc.stdin.close()
+        self.proc.wait(5)
+        time.sleep(0.05)
+        return self.lines
+
+
+def self_test(path):
+    host = Host(path)
+    proxy = Proxy(host.path, 0.02)
+    x = Xfer(proxy.name, 115200, timeout=0.2)
+    stderr, sys.stderr = sys.stderr, open(os.devnull, 'w')     # xfer.py的进度输出
+    try:
+        assert x.ping() == 1 and x.window == 8 and x.data_max == 256
+        data = bytes(random.Random(2).randrange(256) for _ in range(100 * 1024))
+        t = time.monotonic()
+        x.write(DEVS['flash'], 0x1000, data)
+        assert x.read(DEVS['flash'], 0x1000, len(data)) == data
+        t = time.monotonic() - t
+        assert x.read(DEVS['flash'], 0, 16) == b'\xff' * 16
+        x.write(DEVS['eeprom'], 0, data[:256])
+        assert x.read(DEVS['eeprom'], 0, 256) == data[:256]
+
+        proxy.loss = 0          # 以下检查不带丢帧
+        try:
+            x.write(DEVS['eeprom'], 200, data[:100])
+            assert False, 'write past the end accepted'
+        except IOError:
+            pass
+        x.ping()
+        x.send(CMD_READ, 7, struct.pack('<BII', DEVS['flash'], 0, 0))     # 长度0的READ马上回ACK
+        r = x.recv()
+        assert r and r[0] == CMD_ACK and r[1] == 7, r
+        x.send(CMD_READ, 8, struct.pack('<BII', DEVS['flash'], FLASH_SIZE - 1, 2))
+        r = x.recv()
+        assert r and r[0] == CMD_NAK and r[2][1] == ERR_ARG, r
+        x.baud(921600)
+        assert x.read(DEVS['eeprom'], 0, 256) == data[:256]
+    finally:
+        sys.stderr = stderr
+    lines = host.close()
+    assert any(l.startswith('serial1 tx:') and ' baud 921600 ' in l for l in lines), lines
+    stat = [l for l in lines if l.startswith('xfer:')]
+    print('xfer_sim: ok (xfer.c on a pty, 100 KB write+read in %.2fs, %d frames lost or corrupted, %s)'
+          % (t, proxy.lost, stat[0][6:] if stat else '?'))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='run xfer.c (xfer_host) behind a lossy pty')
+    ap.add_argument('host', help='xfer_host程序')
+    ap.add_argument('--loss', type=float, default=0.0, help='丢弃或改坏的帧的比例')
+    ap.add_argument('--test', action='store_true', help='自测')
+    a = ap.parse_args()
+    if a.test:
+        self_test(a.host)
+        return
+    host = Host(a.host)
+    proxy = Proxy(host.path, a.loss)
+    print('xfer device on %s, Ctrl-C to quit' % proxy.name)
+    try:
+        while True:
+            time.sleep(1)
+    except KeyboardInterrupt:
+        print('\n'.join(host.close()))
+
+
+if __name__ == '__main__':
+    main()
@@ -59,16 +59,17 @@
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The DWT cycle counter used as CPU timestamp timer runs at the core clock, which on
+*                   the STM32H7 is twice HCLK (D1 HPRE = /2).
 *********************************************************************************************************
 */
 
 CPU_INT32U  BSP_CPU_ClkFreq (void)
 {
-    CPU_INT32U  hclk_freq;
+    CPU_INT32U  cpu_freq;
 
 
-    hclk_freq = HAL_RCC_GetHCLKFreq();
-    return (hclk_freq);
+    cpu_freq = SystemCoreClock;
+    return (cpu_freq);
 }
 
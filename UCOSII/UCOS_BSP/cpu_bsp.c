@@ -169,7 +169,7 @@ void  CPU_TS_TmrInit (void)
     fclk_freq = BSP_CPU_ClkFreq();
 
     CPU_REG_DEM_CR     |= (CPU_INT32U)CPU_BIT_DEM_CR_TRCENA;    /* Enable Cortex-M4's DWT CYCCNT reg.                   */
-    CPU_REG_DWT_CYCCNT  = (CPU_INT32U)0u;
+                                                                /* CYCCNT not cleared: boot profiler already running.   */
     CPU_REG_DWT_CR     |= (CPU_INT32U)CPU_BIT_DWT_CR_CYCCNTENA;
 
     CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ)fclk_freq);
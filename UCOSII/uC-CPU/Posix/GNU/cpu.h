@@ -0,0 +1,189 @@
+/*
+*********************************************************************************************************
+*                                                uC/CPU
+*                                    CPU CONFIGURATION & PORT LAYER
+*
+*                                            CPU PORT FILE
+*
+*                                          POSIX host (64-bit)
+*                                                 GNU C
+*
+* Filename      : cpu.h
+* Note(s)       : (1) Host port used ONLY to build & run the uC-LIB host tests (see TOOLS/hosttest.sh) on a
+*                     64-bit Linux PC; NOT part of the target build.
+*
+*                 (2) Addresses & 'CPU_SIZE_T' are 64-bit so that pointers survive the uC-LIB address
+*                     arithmetic; data words stay 32-bit like on the Cortex-M7.
+*
+*                 (3) Critical sections are a process-wide recursive mutex (see 'cpu_c.c'), so library code
+*                     protected by CPU_CRITICAL_ENTER() is safe between host threads.
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_MODULE_PRESENT
+#define  CPU_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                          CPU INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu_def.h>
+#include  <cpu_cfg.h>
+
+#undef   CPU_CFG_INT_DIS_MEAS_EN                                /* No interrupts disabled time measurement on host.     */
+#undef   CPU_CFG_LEAD_ZEROS_ASM_PRESENT                         /* Count leading/trailing zeros in 'cpu_c.c'.           */
+#undef   CPU_CFG_TRAIL_ZEROS_ASM_PRESENT
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           CPU DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef            void        CPU_VOID;
+typedef            char        CPU_CHAR;                        /*  8-bit character                                     */
+typedef  unsigned  char        CPU_BOOLEAN;                     /*  8-bit boolean or logical                            */
+typedef  unsigned  char        CPU_INT08U;                      /*  8-bit unsigned integer                              */
+typedef    signed  char        CPU_INT08S;                      /*  8-bit   signed integer                              */
+typedef  unsigned  short       CPU_INT16U;                      /* 16-bit unsigned integer                              */
+typedef    signed  short       CPU_INT16S;                      /* 16-bit   signed integer                              */
+typedef  unsigned  int         CPU_INT32U;                      /* 32-bit unsigned integer                              */
+typedef    signed  int         CPU_INT32S;                      /* 32-bit   signed integer                              */
+typedef  unsigned  long  long  CPU_INT64U;                      /* 64-bit unsigned integer                              */
+typedef    signed  long  long  CPU_INT64S;                      /* 64-bit   signed integer                              */
+
+typedef            float       CPU_FP32;                        /* 32-bit floating point                                */
+typedef            double      CPU_FP64;                        /* 64-bit floating point                                */
+
+typedef  volatile  CPU_INT08U  CPU_REG08;                       /*  8-bit register                                      */
+typedef  volatile  CPU_INT16U  CPU_REG16;                       /* 16-bit register                                      */
+typedef  volatile  CPU_INT32U  CPU_REG32;                       /* 32-bit register                                      */
+typedef  volatile  CPU_INT64U  CPU_REG64;                       /* 64-bit register                                      */
+
+typedef            void      (*CPU_FNCT_VOID)(void);
+typedef            void      (*CPU_FNCT_PTR )(void *p_obj);
+
+
+/*
+*********************************************************************************************************
+*                                       CPU WORD CONFIGURATION
+*
+* Note(s) : (1) See Note #2 above.
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_ADDR_SIZE              CPU_WORD_SIZE_64        /* Defines CPU address word size  (in octets).          */
+#define  CPU_CFG_DATA_SIZE              CPU_WORD_SIZE_32        /* Defines CPU data    word size  (in octets).          */
+#define  CPU_CFG_DATA_SIZE_MAX          CPU_WORD_SIZE_64        /* Defines CPU maximum word size  (in octets).          */
+
+#define  CPU_CFG_ENDIAN_TYPE            CPU_ENDIAN_TYPE_LITTLE  /* Defines CPU data    word-memory order.               */
+
+typedef  CPU_INT64U  CPU_ADDR;
+typedef  CPU_INT32U  CPU_DATA;
+
+typedef  CPU_DATA    CPU_ALIGN;                                 /* Defines CPU data-word-alignment size.                */
+typedef  CPU_ADDR    CPU_SIZE_T;                                /* Defines CPU standard 'size_t'   size.                */
+
+
+/*
+*********************************************************************************************************
+*                                       CPU STACK CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_STK_GROWTH       CPU_STK_GROWTH_HI_TO_LO
+#define  CPU_CFG_STK_ALIGN_BYTES  (16u)
+
+typedef  CPU_INT64U               CPU_STK;
+typedef  CPU_ADDR                 CPU_STK_SIZE;
+
+
+/*
+*********************************************************************************************************
+*                                   CRITICAL SECTION CONFIGURATION
+*
+* Note(s) : (1) See Note #3 above.
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_CRITICAL_METHOD    CPU_CRITICAL_METHOD_STATUS_LOCAL
+
+typedef  CPU_INT32U                 CPU_SR;
+
+#define  CPU_SR_ALLOC()             CPU_SR  cpu_sr = (CPU_SR)0
+
+#define  CPU_INT_DIS()         do { cpu_sr = CPU_SR_Save(); } while (0)
+#define  CPU_INT_EN()          do { CPU_SR_Restore(cpu_sr); } while (0)
+
+#define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS(); } while (0)
+#define  CPU_CRITICAL_EXIT()   do { CPU_INT_EN();  } while (0)
+
+
+/*
+*********************************************************************************************************
+*                                        MEMORY BARRIERS MACRO'S
+*********************************************************************************************************
+*/
+
+#define  CPU_MB()       __sync_synchronize()
+#define  CPU_RMB()      __sync_synchronize()
+#define  CPU_WMB()      __sync_synchronize()
+
+
+/*
+*********************************************************************************************************
+*                                        DSP INTRINSIC FUNCTIONS
+*
+* Note(s) : (1) C equivalents of the ARM compiler DSP intrinsics used by uC-LIB (see 'lib_math.h  MATH DSP
+*               INSTRUCTION CONFIGURATION'), so that the DSP build also compiles & runs on the host.
+*********************************************************************************************************
+*/
+
+static  __inline  CPU_INT64S  __smlald (CPU_INT32U  pair_a,
+                                        CPU_INT32U  pair_b,
+                                        CPU_INT64S  acc)
+{
+    return (acc + (CPU_INT64S)(CPU_INT16S)pair_a         * (CPU_INT16S)pair_b
+                + (CPU_INT64S)(CPU_INT16S)(pair_a >> 16) * (CPU_INT16S)(pair_b >> 16));
+}
+
+static  __inline  CPU_INT32S  __ssat (CPU_INT32S  val,
+                                      CPU_INT32U  nbr_bits)
+{
+    CPU_INT32S  max;
+
+
+    max = (CPU_INT32S)((1u << (nbr_bits - 1u)) - 1u);
+    return ((val > max) ? max : ((val < -max - 1) ? (-max - 1) : val));
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_SR      CPU_SR_Save      (void);
+void        CPU_SR_Restore   (CPU_SR      cpu_sr);
+
+
+/*
+*********************************************************************************************************
+*                                   CPU CONFIGURATION ERRORS & MODULE END
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                          /* End of CPU module include.                           */
@@ -0,0 +1,113 @@
+/*
+*********************************************************************************************************
+*                                                uC/CPU
+*                                    CPU CONFIGURATION & PORT LAYER
+*
+*                                            CPU PORT FILE
+*
+*                                          POSIX host (64-bit)
+*                                                 GNU C
+*
+* Filename      : cpu_c.c
+* Note(s)       : (1) Host port used ONLY to build & run the uC-LIB host tests; see 'cpu.h  Note #1'.
+*
+*                 (2) Provides the few uC/CPU functions the uC-LIB modules call, so 'cpu_core.c' (which needs
+*                     a timestamp timer BSP) is NOT built on the host.
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+#include  <pthread.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+
+
+static  pthread_mutex_t  CPU_CriticalMutex;
+static  pthread_once_t   CPU_CriticalOnce = PTHREAD_ONCE_INIT;
+
+
+static  void  CPU_CriticalInit (void)
+{
+    pthread_mutexattr_t  attr;
+
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);  /* Critical sections may nest.                          */
+    pthread_mutex_init(&CPU_CriticalMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CPU_SR_Save()
+*
+* Description : Enter a critical section : lock the process-wide recursive mutex.
+*
+* Return(s)   : 0 (no status register on host).
+*********************************************************************************************************
+*/
+
+CPU_SR  CPU_SR_Save (void)
+{
+    pthread_once(&CPU_CriticalOnce, CPU_CriticalInit);
+    pthread_mutex_lock(&CPU_CriticalMutex);
+    return ((CPU_SR)0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_SR_Restore()
+*
+* Description : Exit a critical section entered with CPU_SR_Save().
+*********************************************************************************************************
+*/
+
+void  CPU_SR_Restore (CPU_SR  cpu_sr)
+{
+    (void)cpu_sr;
+    pthread_mutex_unlock(&CPU_CriticalMutex);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CPU_SW_Exception()
+*
+* Description : Trap software exceptions (CPU_SW_EXCEPTION()) : abort the test program.
+*********************************************************************************************************
+*/
+
+void  CPU_SW_Exception (void)
+{
+    fprintf(stderr, "CPU_SW_Exception\n");
+    abort();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CPU_CntLeadZeros()
+*
+* Description : Count leading zeros with the compiler built-in.
+*********************************************************************************************************
+*/
+
+CPU_DATA  CPU_CntLeadZeros (CPU_DATA  val)
+{
+    return ((val == 0u) ? (CPU_DATA)32u : (CPU_DATA)__builtin_clz(val));
+}
+
+
+CPU_DATA  CPU_CntLeadZeros32 (CPU_INT32U  val)
+{
+    return ((val == 0u) ? (CPU_DATA)32u : (CPU_DATA)__builtin_clz(val));
+}
+
+
+CPU_DATA  CPU_CntTrailZeros (CPU_DATA  val)
+{
+    return ((val == 0u) ? (CPU_DATA)32u : (CPU_DATA)__builtin_ctz(val));
+}
@@ -57,6 +57,10 @@
 ;********************************************************************************************************
 
         EXPORT  Mem_Copy
+        EXPORT  Mem_DynPoolBlkPop
+        EXPORT  Mem_DynPoolBlkPush
+        EXPORT  Mem_DynPoolCntInc
+        EXPORT  Mem_DynPoolCntDec
 
 
 ;********************************************************************************************************
@@ -307,6 +311,154 @@ Mem_Copy_END
         LDMFD       SP!, {R3-R12}           ; restore registers from stack
         BX          LR                      ; return
 
+;$PAGE
+;********************************************************************************************************
+;                                         Mem_DynPoolBlkPop()
+;
+; Description : Remove the first block from a dynamic memory pool's free list.
+;
+; Argument(s) : p_head      Pointer to free list head.
+;
+; Return(s)   : Pointer to removed block, if free list NOT empty.
+;
+;               Pointer to NULL,          otherwise.
+;
+; Caller(s)   : Mem_DynPoolBlkGet().
+;
+; Note(s)     : (1) Exception entry & return clear the local exclusive monitor.  If the exclusive store
+;                   succeeds, the head & its next pointer were read without preemption, so the pop is
+;                   safe from ABA (see 'lib_mem.h  MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION  Note #1b').
+;********************************************************************************************************
+
+; void  *Mem_DynPoolBlkPop (void  **p_head)     ;  ==>  R0
+
+Mem_DynPoolBlkPop
+        LDREX       R1, [R0]                ; R1 = head
+        CBZ         R1, Mem_DynPoolBlkPop_Empty
+        LDR         R2, [R1]                ; R2 = head->next
+        STREX       R3, R2, [R0]            ; head = head->next, if NOT preempted (see Note #1)
+        CMP         R3, #0
+        BNE         Mem_DynPoolBlkPop       ; retry if exclusive store failed
+        MOV         R0, R1
+        BX          LR                      ; return removed blk
+
+Mem_DynPoolBlkPop_Empty
+        CLREX
+        MOVS        R0, #0
+        BX          LR                      ; return NULL if free list empty
+
+
+;$PAGE
+;********************************************************************************************************
+;                                         Mem_DynPoolBlkPush()
+;
+; Description : Insert a block at the head of a dynamic memory pool's free list.
+;
+; Argument(s) : p_head      Pointer to free list head.
+;
+;               p_blk       Pointer to block to insert.
+;
+; Return(s)   : none.
+;
+; Caller(s)   : Mem_DynPoolBlkFree().
+;
+; Note(s)     : (1) The block's next pointer is written BEFORE the exclusive load since a store between
+;                   an exclusive load & store MAY clear the exclusive monitor.  The head is then re-read
+;                   exclusively & the insertion retried if it changed meanwhile.
+;********************************************************************************************************
+
+; void  Mem_DynPoolBlkPush (void  **p_head,     ;  ==>  R0
+;                           void   *p_blk)      ;  ==>  R1
+
+Mem_DynPoolBlkPush
+        LDR         R2, [R0]                ; R2 = head
+        STR         R2, [R1]                ; blk->next = head (see Note #1)
+        LDREX       R3, [R0]
+        CMP         R3, R2
+        BNE         Mem_DynPoolBlkPush_Retry
+        STREX       R3, R1, [R0]            ; head = blk
+        CMP         R3, #0
+        BNE         Mem_DynPoolBlkPush      ; retry if exclusive store failed
+        BX          LR
+
+Mem_DynPoolBlkPush_Retry
+        CLREX
+        B           Mem_DynPoolBlkPush      ; retry if head changed
+
+
+;$PAGE
+;********************************************************************************************************
+;                                         Mem_DynPoolCntInc()
+;
+; Description : Increment a dynamic memory pool's allocated block count, up to a maximum.
+;
+; Argument(s) : p_cnt       Pointer to allocated block count.
+;
+;               cnt_max     Maximum allocated block count.
+;
+; Return(s)   : DEF_OK,   if count incremented.
+;
+;               DEF_FAIL, if count already at maximum.
+;
+; Caller(s)   : Mem_DynPoolBlkGet().
+;
+; Note(s)     : none.
+;********************************************************************************************************
+
+; CPU_BOOLEAN  Mem_DynPoolCntInc (CPU_SIZE_T  *p_cnt,       ;  ==>  R0
+;                                 CPU_SIZE_T   cnt_max)     ;  ==>  R1
+
+Mem_DynPoolCntInc
+        LDREX       R2, [R0]
+        CMP         R2, R1
+        BCS         Mem_DynPoolCntInc_Max
+        ADDS        R2, R2, #1
+        STREX       R3, R2, [R0]
+        CMP         R3, #0
+        BNE         Mem_DynPoolCntInc       ; retry if exclusive store failed
+        MOVS        R0, #1
+        BX          LR                      ; return DEF_OK
+
+Mem_DynPoolCntInc_Max
+        CLREX
+        MOVS        R0, #0
+        BX          LR                      ; return DEF_FAIL if cnt >= cnt_max
+
+
+;$PAGE
+;********************************************************************************************************
+;                                         Mem_DynPoolCntDec()
+;
+; Description : Decrement a dynamic memory pool's allocated block count, down to zero.
+;
+; Argument(s) : p_cnt       Pointer to allocated block count.
+;
+; Return(s)   : DEF_OK,   if count decremented.
+;
+;               DEF_FAIL, if count already zero.
+;
+; Caller(s)   : Mem_DynPoolBlkFree().
+;
+; Note(s)     : none.
+;********************************************************************************************************
+
+; CPU_BOOLEAN  Mem_DynPoolCntDec (CPU_SIZE_T  *p_cnt)       ;  ==>  R0
+
+Mem_DynPoolCntDec
+        LDREX       R2, [R0]
+        CBZ         R2, Mem_DynPoolCntDec_Zero
+        SUBS        R2, R2, #1
+        STREX       R3, R2, [R0]
+        CMP         R3, #0
+        BNE         Mem_DynPoolCntDec       ; retry if exclusive store failed
+        MOVS        R0, #1
+        BX          LR                      ; return DEF_OK
+
+Mem_DynPoolCntDec_Zero
+        CLREX
+        MOVS        R0, #0
+        BX          LR                      ; return DEF_FAIL if cnt == 0
+
 
         END
 
@@ -0,0 +1,230 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                     STANDARD MEMORY OPERATIONS
+*
+*                                          POSIX host (64-bit)
+*                                                 GNU C
+*
+* Filename      : lib_mem_c.c
+* Note(s)       : (1) Host port used ONLY to build & run the uC-LIB host tests (see TOOLS/hosttest.sh); NOT
+*                     part of the target build.  Build 'lib_mem.c' with '-DLIB_MEM_CFG_OPTIMIZE_ASM_EN=DEF_DISABLED'.
+*
+*                 (2) Host version of the lock-free dynamic pool primitives in 'lib_mem_a.asm', written with
+*                     C11-style atomic built-ins as LDREX/STREX (load-/store-exclusive) loops, so that the
+*                     same algorithm runs under the host stress test.
+*
+*                 (3) Host threads run truly in parallel, unlike tasks & ISRs on the single-core Cortex-M7
+*                     (see 'lib_mem.h  MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION  Note #1b').  The exclusive
+*                     monitor is therefore emulated like a multi-core global monitor : every monitored word has
+*                     a version (tag), incremented by each exclusive store, & a store-exclusive only succeeds
+*                     if the version is unchanged since the load-exclusive.  A pop that races with a pop & push
+*                     of the same block (ABA) thus fails & retries, as on the target.
+*
+*                 (4) Versions are kept in a small table hashed by address; words sharing an entry only cause
+*                     extra retries, like a monitor granule.
+*********************************************************************************************************
+*/
+
+#include  <lib_mem.h>
+
+
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)
+
+#define  MEM_HOST_MON_NBR                                64u
+
+
+static  CPU_INT64U  Mem_HostMonVer[MEM_HOST_MON_NBR];           /* Even : idle; odd : exclusive store in progress.      */
+
+
+static  CPU_INT64U  *Mem_HostMonGet (const  void  *p_addr)
+{
+    return (&Mem_HostMonVer[((CPU_ADDR)p_addr >> 3u) % MEM_HOST_MON_NBR]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Mem_HostLoadEx()
+*
+* Description : Load-exclusive of a pointer-size word.
+*
+* Argument(s) : p_addr      Pointer to word.
+*
+*               p_ver       Pointer to variable that will receive the monitor version.
+*
+* Return(s)   : Word value.
+*********************************************************************************************************
+*/
+
+static  CPU_ADDR  Mem_HostLoadEx (CPU_ADDR    *p_addr,
+                                  CPU_INT64U  *p_ver)
+{
+    CPU_INT64U  *p_mon;
+    CPU_INT64U   ver;
+    CPU_ADDR     val;
+
+
+    p_mon = Mem_HostMonGet(p_addr);
+    for (;;) {
+        ver = __atomic_load_n(p_mon, __ATOMIC_ACQUIRE);
+        if ((ver & 1u) != 0u) {                                 /* Exclusive store in progress.                         */
+            continue;
+        }
+        val = __atomic_load_n(p_addr, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(p_mon, __ATOMIC_ACQUIRE) == ver) {
+            break;
+        }
+    }
+   *p_ver = ver;
+    return (val);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Mem_HostStoreEx()
+*
+* Description : Store-exclusive of a pointer-size word.
+*
+* Argument(s) : p_addr      Pointer to word.
+*
+*               val         Value to store.
+*
+*               ver         Monitor version returned by Mem_HostLoadEx().
+*
+* Return(s)   : DEF_OK,   if stored.
+*
+*               DEF_FAIL, if the word was stored to since the load-exclusive.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Mem_HostStoreEx (CPU_ADDR    *p_addr,
+                                      CPU_ADDR     val,
+                                      CPU_INT64U   ver)
+{
+    CPU_INT64U  *p_mon;
+
+
+    p_mon = Mem_HostMonGet(p_addr);
+    if (!__atomic_compare_exchange_n(p_mon, &ver, ver + 1u, DEF_NO, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return (DEF_FAIL);
+    }
+    __atomic_store_n(p_addr, val, __ATOMIC_RELEASE);
+    __atomic_store_n(p_mon, ver + 2u, __ATOMIC_RELEASE);
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Mem_DynPoolBlkPop()
+*
+* Description : Remove the first block from a dynamic memory pool's free list.
+*
+* Note(s)     : (1) See 'lib_mem_a.asm  Mem_DynPoolBlkPop()'.
+*********************************************************************************************************
+*/
+
+void  *Mem_DynPoolBlkPop (void  **p_head)
+{
+    CPU_ADDR    head;
+    CPU_ADDR    next;
+    CPU_INT64U  ver;
+
+
+    do {
+        head = Mem_HostLoadEx((CPU_ADDR *)p_head, &ver);
+        if (head == 0u) {
+            return (DEF_NULL);
+        }
+        next = __atomic_load_n((CPU_ADDR *)head, __ATOMIC_RELAXED);     /* May be stale if preempted; store then fails. */
+    } while (Mem_HostStoreEx((CPU_ADDR *)p_head, next, ver) != DEF_OK);
+
+    return ((void *)head);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Mem_DynPoolBlkPush()
+*
+* Description : Insert a block at the head of a dynamic memory pool's free list.
+*
+* Note(s)     : (1) See 'lib_mem_a.asm  Mem_DynPoolBlkPush()'.
+*********************************************************************************************************
+*/
+
+void  Mem_DynPoolBlkPush (void  **p_head,
+                          void   *p_blk)
+{
+    CPU_ADDR    head;
+    CPU_INT64U  ver;
+
+
+    for (;;) {
+        head = __atomic_load_n((CPU_ADDR *)p_head, __ATOMIC_RELAXED);
+        __atomic_store_n((CPU_ADDR *)p_blk, head, __ATOMIC_RELAXED);    /* blk->next = head, before the excl load.      */
+        if (Mem_HostLoadEx((CPU_ADDR *)p_head, &ver) != head) {
+            continue;                                                   /* Head changed meanwhile.                      */
+        }
+        if (Mem_HostStoreEx((CPU_ADDR *)p_head, (CPU_ADDR)p_blk, ver) == DEF_OK) {
+            return;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Mem_DynPoolCntInc()
+*
+* Description : Increment a dynamic memory pool's allocated block count, up to a maximum.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Mem_DynPoolCntInc (CPU_SIZE_T  *p_cnt,
+                                CPU_SIZE_T   cnt_max)
+{
+    CPU_SIZE_T  cnt;
+    CPU_INT64U  ver;
+
+
+    do {
+        cnt = Mem_HostLoadEx(p_cnt, &ver);
+        if (cnt >= cnt_max) {
+            return (DEF_FAIL);
+        }
+    } while (Mem_HostStoreEx(p_cnt, cnt + 1u, ver) != DEF_OK);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Mem_DynPoolCntDec()
+*
+* Description : Decrement a dynamic memory pool's allocated block count, down to zero.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Mem_DynPoolCntDec (CPU_SIZE_T  *p_cnt)
+{
+    CPU_SIZE_T  cnt;
+    CPU_INT64U  ver;
+
+
+    do {
+        cnt = Mem_HostLoadEx(p_cnt, &ver);
+        if (cnt == 0u) {
+            return (DEF_FAIL);
+        }
+    } while (Mem_HostStoreEx(p_cnt, cnt - 1u, ver) != DEF_OK);
+
+    return (DEF_OK);
+}
+
+#endif
@@ -78,6 +78,24 @@
 *********************************************************************************************************
 */
 
+                                                                /* ------------- DSP INSTRUCTION MACRO'S -------------- */
+                                                                /* See 'lib_math.h  MATH DSP INSTRUCTION ...            */
+                                                                /* ... CONFIGURATION  Note #1'.                         */
+#if (LIB_MATH_CFG_OPTIMIZE_DSP_EN == DEF_ENABLED)
+#define  MATH_SMLALD(pair_a, pair_b, acc)           __smlald((pair_a), (pair_b), (acc))
+#define  MATH_SSAT16(val)                           __ssat((val), 16)
+
+#else
+#define  MATH_SMLALD(pair_a, pair_b, acc)         ((acc) + ((CPU_INT64S)(CPU_INT16S)(pair_a)         * (CPU_INT16S)(pair_b))  \
+                                                         + ((CPU_INT64S)(CPU_INT16S)((pair_a) >> 16) * (CPU_INT16S)((pair_b) >> 16)))
+#define  MATH_SSAT16(val)                         (((val) > MATH_Q15_MAX) ? MATH_Q15_MAX : (((val) < MATH_Q15_MIN) ? MATH_Q15_MIN : (val)))
+#endif
+
+                                                                /* Pack two Q15 values in a word, low half first.       */
+#define  MATH_Q15_PAIR(lo, hi)                    (((CPU_INT32U)(CPU_INT16U)(lo)) | ((CPU_INT32U)(CPU_INT16U)(hi) << 16))
+
+#define  MATH_ROTL32(val, nbr_bits)               (((val) << (nbr_bits)) | ((val) >> (32u - (nbr_bits))))
+
 
 /*
 *********************************************************************************************************
@@ -96,9 +114,35 @@
 /*
 *********************************************************************************************************
 *                                            LOCAL TABLES
+*
+* Note(s) : (1) Math_SortNetTbl[] holds the comparators of minimal-size sorting networks for 2 to
+*               MATH_SORT_NET_NBR_MAX values, one comparator per octet (lower index in the high nibble).
+*               The comparators for 'nbr' values are Math_SortNetTbl[Math_SortNetIxTbl[nbr]] up to (but
+*               not including) Math_SortNetTbl[Math_SortNetIxTbl[nbr + 1]].
+*
+*           (2) Each network was verified exhaustively over all 0/1 inputs (zero-one principle).
 *********************************************************************************************************
 */
 
+static  const  CPU_INT08U  Math_SortNetTbl[] = {                /* See Note #1.                                         */
+    0x01,                                                                                                   /*  2 */
+    0x02, 0x01, 0x12,                                                                                       /*  3 */
+    0x02, 0x13, 0x01, 0x23, 0x12,                                                                           /*  4 */
+    0x03, 0x14, 0x02, 0x13, 0x01, 0x24, 0x12, 0x34, 0x23,                                                   /*  5 */
+    0x05, 0x13, 0x24, 0x12, 0x34, 0x03, 0x25, 0x01, 0x23, 0x45, 0x12, 0x34,                                 /*  6 */
+    0x06, 0x23, 0x45, 0x02, 0x14, 0x36, 0x01, 0x25, 0x34, 0x12, 0x46, 0x23, 0x45, 0x12, 0x34, 0x56,         /*  7 */
+    0x02, 0x13, 0x46, 0x57, 0x04, 0x15, 0x26, 0x37, 0x01, 0x23, 0x45, 0x67, 0x24, 0x35, 0x14, 0x36,
+    0x12, 0x34, 0x56,                                                                                       /*  8 */
+    0x03, 0x17, 0x25, 0x48, 0x07, 0x24, 0x38, 0x56, 0x02, 0x13, 0x45, 0x78, 0x14, 0x36, 0x57, 0x01,
+    0x24, 0x35, 0x68, 0x23, 0x45, 0x67, 0x12, 0x34, 0x56,                                                   /*  9 */
+    0x08, 0x19, 0x27, 0x35, 0x46, 0x02, 0x14, 0x58, 0x79, 0x03, 0x24, 0x57, 0x69, 0x01, 0x36, 0x89,
+    0x15, 0x23, 0x48, 0x67, 0x12, 0x35, 0x46, 0x78, 0x23, 0x45, 0x67, 0x34, 0x56                            /* 10 */
+};
+
+static  const  CPU_INT08U  Math_SortNetIxTbl[MATH_SORT_NET_NBR_MAX + 2u] = {
+      0u,   0u,   0u,   1u,   4u,   9u,  18u,  30u,  46u,  65u,  90u, 119u
+};
+
 
 /*
 *********************************************************************************************************
@@ -279,3 +323,632 @@ RAND_NBR  Math_RandSeed (RAND_NBR  seed)
     return (rand_nbr);
 }
 
+
+/*
+*********************************************************************************************************
+*                                      Math_RandXoshiroSetSeed()
+*
+* Description : Seed a xoshiro128** pseudo-random number generator.
+*
+* Argument(s) : p_state     Pointer to generator state.
+*
+*               seed        Seed value.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The 128-bit state is filled from 'seed' with SplitMix32 so that nearby seeds give
+*                   unrelated sequences & the state is never all zeros.
+*********************************************************************************************************
+*/
+
+void  Math_RandXoshiroSetSeed (MATH_RAND_XOSHIRO  *p_state,
+                               CPU_INT32U          seed)
+{
+    CPU_INT32U  val;
+    CPU_INT08U  i;
+
+
+    for (i = 0u; i < 4u; i++) {                                 /* See Note #1.                                         */
+        seed += 0x9E3779B9u;
+        val   = seed;
+        val   = (val ^ (val >> 16)) * 0x85EBCA6Bu;
+        val   = (val ^ (val >> 13)) * 0xC2B2AE35u;
+        val   =  val ^ (val >> 16);
+        p_state->State[i] = val;
+    }
+
+    if ((p_state->State[0] | p_state->State[1] | p_state->State[2] | p_state->State[3]) == 0u) {
+        p_state->State[0] = 1u;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Math_RandXoshiro()
+*
+* Description : Calculate the next xoshiro128** pseudo-random number.
+*
+* Argument(s) : p_state     Pointer to generator state.
+*
+* Return(s)   : Next 32-bit pseudo-random number.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) xoshiro128** (Blackman & Vigna) has a period of 2^128 - 1 & passes the statistical tests
+*                   that the LCG in Math_Rand() fails, using only shifts, rotates, XORs & two multiplies.
+*
+*               (2) Math_RandXoshiro() is re-entrant for distinct generator states.  A state shared between
+*                   tasks MUST be accessed in a critical section.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  Math_RandXoshiro (MATH_RAND_XOSHIRO  *p_state)
+{
+    CPU_INT32U  *p_s;
+    CPU_INT32U   rand_nbr;
+    CPU_INT32U   t;
+
+
+    p_s      = &p_state->State[0];
+    rand_nbr =  MATH_ROTL32(p_s[1] * 5u, 7u) * 9u;
+    t        =  p_s[1] << 9;
+
+    p_s[2]  ^= p_s[0];
+    p_s[3]  ^= p_s[1];
+    p_s[1]  ^= p_s[2];
+    p_s[0]  ^= p_s[3];
+    p_s[2]  ^= t;
+    p_s[3]   = MATH_ROTL32(p_s[3], 11u);
+
+    return (rand_nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Math_MulQ15()
+*
+* Description : Multiply two Q15 numbers.
+*
+* Argument(s) : a           First  Q15 operand.
+*
+*               b           Second Q15 operand.
+*
+* Return(s)   : Q15 product, truncated & saturated.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Only (-1 * -1) overflows Q15; it saturates to MATH_Q15_MAX.
+*********************************************************************************************************
+*/
+
+MATH_Q15  Math_MulQ15 (MATH_Q15  a,
+                       MATH_Q15  b)
+{
+    CPU_INT32S  prod;
+
+
+    prod = ((CPU_INT32S)a * (CPU_INT32S)b) >> 15;
+
+    return ((MATH_Q15)MATH_SSAT16(prod));                       /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Math_MulQ31()
+*
+* Description : Multiply two Q31 numbers.
+*
+* Argument(s) : a           First  Q31 operand.
+*
+*               b           Second Q31 operand.
+*
+* Return(s)   : Q31 product, truncated & saturated.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Only (-1 * -1) overflows Q31; it saturates to MATH_Q31_MAX.
+*********************************************************************************************************
+*/
+
+MATH_Q31  Math_MulQ31 (MATH_Q31  a,
+                       MATH_Q31  b)
+{
+    CPU_INT64S  prod;
+
+
+    prod = ((CPU_INT64S)a * (CPU_INT64S)b) >> 31;
+    if (prod > MATH_Q31_MAX) {                                  /* See Note #1.                                         */
+        prod = MATH_Q31_MAX;
+    }
+
+    return ((MATH_Q31)prod);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Math_DotQ15()
+*
+* Description : Calculate the dot product of two Q15 vectors.
+*
+* Argument(s) : p_a         Pointer to first  vector.
+*
+*               p_b         Pointer to second vector.
+*
+*               len         Number of elements.
+*
+* Return(s)   : Dot product, in 34.30 format (no intermediate overflow for len < 2^33).
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) If both vectors are word-aligned, elements are read in pairs & multiply-accumulated two
+*                   at a time (see 'lib_math.h  MATH DSP INSTRUCTION CONFIGURATION  Note #1a').  Since the
+*                   sum of the pair products does not depend on the order of the halves, the result does
+*                   not depend on CPU endianness.
+*********************************************************************************************************
+*/
+
+CPU_INT64S  Math_DotQ15 (const  MATH_Q15    *p_a,
+                         const  MATH_Q15    *p_b,
+                                CPU_SIZE_T   len)
+{
+    const  CPU_INT32U  *p_a_pair;
+    const  CPU_INT32U  *p_b_pair;
+           CPU_INT64S   acc;
+
+
+    acc = 0;
+                                                                /* See Note #1.                                         */
+    if ((((CPU_ADDR)p_a | (CPU_ADDR)p_b) & (sizeof(CPU_INT32U) - 1u)) == 0u) {
+        p_a_pair = (const CPU_INT32U *)p_a;
+        p_b_pair = (const CPU_INT32U *)p_b;
+        while (len >= 4u) {
+            acc  = MATH_SMLALD(p_a_pair[0], p_b_pair[0], acc);
+            acc  = MATH_SMLALD(p_a_pair[1], p_b_pair[1], acc);
+            p_a_pair += 2u;
+            p_b_pair += 2u;
+            len      -= 4u;
+        }
+        p_a = (const MATH_Q15 *)p_a_pair;
+        p_b = (const MATH_Q15 *)p_b_pair;
+    }
+
+    while (len > 0u) {
+        acc += (CPU_INT32S)*p_a * (CPU_INT32S)*p_b;
+        p_a++;
+        p_b++;
+        len--;
+    }
+
+    return (acc);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Math_DotQ31()
+*
+* Description : Calculate the dot product of two Q31 vectors.
+*
+* Argument(s) : p_a         Pointer to first  vector.
+*
+*               p_b         Pointer to second vector.
+*
+*               len         Number of elements.
+*
+* Return(s)   : Dot product, in 16.48 format.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Each 2.62 product is shifted right by 14 bits before accumulation, as in CMSIS-DSP, which
+*                   leaves 16 guard bits (no overflow for len < 2^16).
+*********************************************************************************************************
+*/
+
+CPU_INT64S  Math_DotQ31 (const  MATH_Q31    *p_a,
+                         const  MATH_Q31    *p_b,
+                                CPU_SIZE_T   len)
+{
+    CPU_INT64S  acc;
+
+
+    acc = 0;
+    while (len > 0u) {
+        acc += ((CPU_INT64S)*p_a * (CPU_INT64S)*p_b) >> 14;     /* See Note #1.                                         */
+        p_a++;
+        p_b++;
+        len--;
+    }
+
+    return (acc);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Math_Sqrt32()
+*
+* Description : Calculate the integer square root of a 32-bit value.
+*
+* Argument(s) : val         Value.
+*
+* Return(s)   : floor(sqrt(val)).
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The root is computed one bit per iteration (binary digit-by-digit method), starting
+*                   from the highest power of 4 not greater than 'val', found by counting leading zeros.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  Math_Sqrt32 (CPU_INT32U  val)
+{
+    CPU_INT32U  root;
+    CPU_INT32U  bit;
+    CPU_INT32U  trial;
+
+
+    if (val == 0u) {
+        return (0u);
+    }
+
+    root = 0u;                                                  /* See Note #1.                                         */
+    bit  = 1u << ((31u - (CPU_INT32U)CPU_CntLeadZeros32(val)) & ~1u);
+    while (bit != 0u) {
+        trial = root + bit;
+        if (val >= trial) {
+            val  -= trial;
+            root  = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return ((CPU_INT16U)root);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Math_SortU16()
+*
+* Description : Sort an array of unsigned 16-bit values in ascending order.
+*
+* Argument(s) : p_buf       Pointer to array.
+*
+*               nbr         Number of values.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Math_MedianU16(),
+*               Application.
+*
+* Note(s)     : (1) Up to MATH_SORT_NET_NBR_MAX values are sorted with a fixed sorting network : the same
+*                   sequence of branch-free compare-exchanges for any input, with fewer comparisons than
+*                   bubble or insertion sort (e.g. 9 instead of 10 for 5 values, 29 instead of 45 for 10).
+*
+*                   See also 'LOCAL TABLES  Note #1'.
+*
+*               (2) Larger arrays are insertion sorted.
+*********************************************************************************************************
+*/
+
+void  Math_SortU16 (CPU_INT16U  *p_buf,
+                    CPU_SIZE_T   nbr)
+{
+    const  CPU_INT08U  *p_net;
+    const  CPU_INT08U  *p_net_end;
+           CPU_INT16U   val_lo;
+           CPU_INT16U   val_hi;
+           CPU_INT16U   val;
+           CPU_SIZE_T   i;
+           CPU_SIZE_T   j;
+
+
+    if (nbr <= MATH_SORT_NET_NBR_MAX) {                         /* See Note #1.                                         */
+        p_net     = &Math_SortNetTbl[Math_SortNetIxTbl[nbr]];
+        p_net_end = &Math_SortNetTbl[Math_SortNetIxTbl[nbr + 1u]];
+        while (p_net < p_net_end) {
+            i      = *p_net >> 4;
+            j      = *p_net &  0x0Fu;
+            val_lo =  p_buf[i];
+            val_hi =  p_buf[j];
+            p_buf[i] = (val_lo < val_hi) ? val_lo : val_hi;
+            p_buf[j] = (val_lo < val_hi) ? val_hi : val_lo;
+            p_net++;
+        }
+        return;
+    }
+
+    for (i = 1u; i < nbr; i++) {                                /* See Note #2.                                         */
+        val = p_buf[i];
+        j   = i;
+        while ((j > 0u) && (p_buf[j - 1u] > val)) {
+            p_buf[j] = p_buf[j - 1u];
+            j--;
+        }
+        p_buf[j] = val;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Math_MedianU16()
+*
+* Description : Calculate the median of an array of unsigned 16-bit values.
+*
+* Argument(s) : p_buf       Pointer to array (sorted in place).
+*
+*               nbr         Number of values.
+*
+* Return(s)   : Median value, if 'nbr' is odd;
+*
+*               upper of the two middle values, if 'nbr' is even;
+*
+*               0, if 'nbr' is 0.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  Math_MedianU16 (CPU_INT16U  *p_buf,
+                            CPU_SIZE_T   nbr)
+{
+    if (nbr == 0u) {
+        return (0u);
+    }
+
+    Math_SortU16(p_buf, nbr);
+
+    return (p_buf[nbr / 2u]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Math_AvgMovInit()
+*
+* Description : Initialize a moving average filter.
+*
+* Argument(s) : p_avg       Pointer to filter.
+*
+*               p_buf       Pointer to sample buffer, of 'len' samples.
+*
+*               len         Number of samples averaged (at most 65536 samples of 16 bits fit the sum).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Math_AvgMovInit (MATH_AVG_MOV  *p_avg,
+                       CPU_INT16U    *p_buf,
+                       CPU_INT16U     len)
+{
+    p_avg->BufPtr = p_buf;
+    p_avg->Len    = len;
+    p_avg->Ix     = 0u;
+    p_avg->Cnt    = 0u;
+    p_avg->Sum    = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Math_AvgMovUpdate()
+*
+* Description : Add a sample to a moving average filter.
+*
+* Argument(s) : p_avg       Pointer to filter.
+*
+*               sample      New sample.
+*
+* Return(s)   : Average of the last 'Len' samples (of all samples, until 'Len' samples were added).
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The oldest sample is subtracted from the running sum, so each update costs one
+*                   subtraction, one addition & one division regardless of 'Len'.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  Math_AvgMovUpdate (MATH_AVG_MOV  *p_avg,
+                               CPU_INT16U     sample)
+{
+    if (p_avg->Len == 0u) {
+        return (sample);
+    }
+
+    if (p_avg->Cnt < p_avg->Len) {
+        p_avg->Cnt++;
+    } else {
+        p_avg->Sum -= p_avg->BufPtr[p_avg->Ix];                 /* See Note #1.                                         */
+    }
+    p_avg->Sum                 += sample;
+    p_avg->BufPtr[p_avg->Ix]    = sample;
+    p_avg->Ix++;
+    if (p_avg->Ix >= p_avg->Len) {
+        p_avg->Ix = 0u;
+    }
+
+    return ((CPU_INT16U)(p_avg->Sum / p_avg->Cnt));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Math_IIR1Init()
+*
+* Description : Initialize a first-order IIR (exponential smoothing) filter.
+*
+* Argument(s) : p_iir       Pointer to filter.
+*
+*               shift       Smoothing shift (time constant of about 2^shift samples).
+*
+*               val_init    Initial filter output.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Samples MUST fit in (31 - 'shift') bits.
+*********************************************************************************************************
+*/
+
+void  Math_IIR1Init (MATH_IIR1   *p_iir,
+                     CPU_INT08U   shift,
+                     CPU_INT32S   val_init)
+{
+    p_iir->Shift = shift;
+    p_iir->Acc   = val_init * ((CPU_INT32S)1 << shift);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Math_IIR1Update()
+*
+* Description : Add a sample to a first-order IIR filter.
+*
+* Argument(s) : p_iir       Pointer to filter.
+*
+*               sample      New sample.
+*
+* Return(s)   : Filter output.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The output is kept scaled by 2^Shift so that no fraction is lost between updates.
+*
+*                   See also 'lib_math.h  FILTER DATA TYPES  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_INT32S  Math_IIR1Update (MATH_IIR1   *p_iir,
+                             CPU_INT32S   sample)
+{
+    p_iir->Acc += sample - (p_iir->Acc >> p_iir->Shift);        /* See Note #1.                                         */
+
+    return (p_iir->Acc >> p_iir->Shift);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Math_BiquadQ15Init()
+*
+* Description : Initialize a Q15 biquad filter.
+*
+* Argument(s) : p_biquad    Pointer to filter.
+*
+*               b0          Feed-forward coefficients, scaled down by 2^post_shift.
+*               b1
+*               b2
+*
+*               a1          Feedback coefficients, sign inverted & scaled down by 2^post_shift.
+*               a2
+*
+*               post_shift  Coefficient scale.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See 'lib_math.h  FILTER DATA TYPES  Note #3'.
+*********************************************************************************************************
+*/
+
+void  Math_BiquadQ15Init (MATH_BIQUAD_Q15  *p_biquad,
+                          MATH_Q15          b0,
+                          MATH_Q15          b1,
+                          MATH_Q15          b2,
+                          MATH_Q15          a1,
+                          MATH_Q15          a2,
+                          CPU_INT08U        post_shift)
+{
+    p_biquad->CoefB0    = b0;
+    p_biquad->CoefB12   = MATH_Q15_PAIR(b1, b2);
+    p_biquad->CoefA12   = MATH_Q15_PAIR(a1, a2);
+    p_biquad->StateX    = 0u;
+    p_biquad->StateY    = 0u;
+    p_biquad->PostShift = post_shift;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Math_BiquadQ15()
+*
+* Description : Filter a block of Q15 samples through a biquad filter.
+*
+* Argument(s) : p_biquad    Pointer to filter.
+*
+*               p_src       Pointer to input  samples.
+*
+*               p_dest      Pointer to output samples (MAY be the same as 'p_src').
+*
+*               len         Number of samples.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The five products are accumulated in 64 bits (b0 alone, then the b & a pairs with
+*                   one SMLALD each), then scaled back by 2^(15 - PostShift) & saturated to Q15.
+*********************************************************************************************************
+*/
+
+void  Math_BiquadQ15 (       MATH_BIQUAD_Q15  *p_biquad,
+                      const  MATH_Q15         *p_src,
+                             MATH_Q15         *p_dest,
+                             CPU_SIZE_T        len)
+{
+    CPU_INT32U  state_x;
+    CPU_INT32U  state_y;
+    CPU_INT64S  acc;
+    CPU_INT32S  x;
+    CPU_INT32S  y;
+    CPU_INT08U  shift;
+
+
+    state_x = p_biquad->StateX;
+    state_y = p_biquad->StateY;
+    shift   = 15u - p_biquad->PostShift;
+
+    while (len > 0u) {
+        x   = *p_src;
+        acc = (CPU_INT64S)p_biquad->CoefB0 * x;                 /* See Note #1.                                         */
+        acc =  MATH_SMLALD(p_biquad->CoefB12, state_x, acc);
+        acc =  MATH_SMLALD(p_biquad->CoefA12, state_y, acc);
+        acc >>= shift;
+        if (acc > MATH_Q15_MAX) {
+            y = MATH_Q15_MAX;
+        } else if (acc < MATH_Q15_MIN) {
+            y = MATH_Q15_MIN;
+        } else {
+            y = (CPU_INT32S)acc;
+        }
+
+        state_x = (state_x << 16) | (CPU_INT16U)x;              /* x[n-2] = x[n-1], x[n-1] = x[n].                      */
+        state_y = (state_y << 16) | (CPU_INT16U)y;
+       *p_dest  = (MATH_Q15)y;
+        p_src++;
+        p_dest++;
+        len--;
+    }
+
+    p_biquad->StateX = state_x;
+    p_biquad->StateY = state_y;
+}
@@ -110,6 +110,7 @@
 #include  <cpu_core.h>
 
 #include  <lib_def.h>
+#include  <lib_cfg.h>
 
 
 /*
@@ -125,6 +126,37 @@
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                        DEFAULT CONFIGURATION
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                 MATH DSP INSTRUCTION CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_MATH_CFG_OPTIMIZE_DSP_EN to enable/disable DSP instruction intrinsics in the
+*               fixed-point function(s) :
+*
+*               (a) Math_DotQ15() & Math_BiquadQ15() multiply-accumulate two Q15 pairs per SMLALD.
+*
+*               (b) Math_MulQ15() saturates with SSAT.
+*
+*               (c) Requires a compiler supporting the ARM DSP intrinsics (__smlald(), __ssat()) & a CPU
+*                   implementing the DSP extension (e.g. ARMv7E-M Cortex-M4/M7).  Otherwise, equivalent
+*                   portable C is used.
+*********************************************************************************************************
+*/
+
+                                                                /* Configure DSP instruction intrinsics [see Note #1] : */
+#ifndef  LIB_MATH_CFG_OPTIMIZE_DSP_EN
+#define  LIB_MATH_CFG_OPTIMIZE_DSP_EN           DEF_DISABLED
+                                                                /*   DEF_DISABLED     Portable C fnct(s)                */
+                                                                /*   DEF_ENABLED      DSP intrinsic fnct(s)             */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                               DEFINES
@@ -172,6 +204,34 @@
 #define  RAND_LCG_PARAM_B                              12345u   /* See Note #1b1A3.                                     */
 
 
+/*
+*********************************************************************************************************
+*                                    FIXED-POINT NUMBER DEFINES
+*
+* Note(s) : (1) Q15 numbers represent [-1, 1 - 2^-15] in a signed 16-bit integer; Q31 numbers represent
+*               [-1, 1 - 2^-31] in a signed 32-bit integer.
+*********************************************************************************************************
+*/
+
+#define  MATH_Q15_MAX                                  32767
+#define  MATH_Q15_MIN                                (-32767 - 1)
+
+#define  MATH_Q31_MAX                             2147483647L
+#define  MATH_Q31_MIN                           (-2147483647L - 1)
+
+
+/*
+*********************************************************************************************************
+*                                     SORTING NETWORK DEFINES
+*
+* Note(s) : (1) Math_SortU16() sorts up to MATH_SORT_NET_NBR_MAX values with a fixed sorting network
+*               (see 'lib_math.c  Math_SortNetTbl[]'); larger arrays are insertion sorted.
+*********************************************************************************************************
+*/
+
+#define  MATH_SORT_NET_NBR_MAX                            10u   /* See Note #1.                                         */
+
+
 /*
 *********************************************************************************************************
 *                                             DATA TYPES
@@ -187,6 +247,75 @@
 typedef  CPU_INT32U  RAND_NBR;
 
 
+/*
+*********************************************************************************************************
+*                                   XOSHIRO RANDOM NUMBER DATA TYPE
+*
+* Note(s) : (1) Each xoshiro128** generator keeps its own 128-bit state so that callers need no critical
+*               section; the state MUST NOT be all zeros (see 'Math_RandXoshiroSetSeed()').
+*********************************************************************************************************
+*/
+
+typedef  struct  math_rand_xoshiro {
+    CPU_INT32U  State[4];                                       /* Generator state (see Note #1).                       */
+} MATH_RAND_XOSHIRO;
+
+
+/*
+*********************************************************************************************************
+*                                    FIXED-POINT NUMBER DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT16S  MATH_Q15;                                  /* See 'FIXED-POINT NUMBER DEFINES  Note #1'.           */
+typedef  CPU_INT32S  MATH_Q31;
+
+
+/*
+*********************************************************************************************************
+*                                        FILTER DATA TYPES
+*
+* Note(s) : (1) Moving average over the last 'Len' samples, kept in a caller-supplied buffer.  The running
+*               sum is updated in O(1) per sample.
+*
+*           (2) First-order IIR (exponential) filter :  y[n] = y[n-1] + (x[n] - y[n-1]) / 2^Shift.
+*
+*           (3) Direct form I Q15 biquad :
+*
+*                   y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2]
+*
+*               (a) Feedback coefficients are given with their sign inverted, as in CMSIS-DSP.
+*
+*               (b) Coefficients are scaled down by 2^PostShift to fit Q15; the result is scaled back up.
+*
+*               (c) Coefficient & state pairs are packed in 32-bit words, low half first, so that each
+*                   pair is multiply-accumulated by a single SMLALD.
+*********************************************************************************************************
+*/
+
+typedef  struct  math_avg_mov {                                 /* See Note #1.                                         */
+    CPU_INT16U  *BufPtr;                                        /* Ptr to sample buf.                                   */
+    CPU_INT16U   Len;                                           /* Nbr of samples averaged.                             */
+    CPU_INT16U   Ix;                                            /* Ix of oldest sample.                                 */
+    CPU_INT16U   Cnt;                                           /* Nbr of samples in buf.                               */
+    CPU_INT32U   Sum;                                           /* Sum of samples in buf.                               */
+} MATH_AVG_MOV;
+
+typedef  struct  math_iir1 {                                    /* See Note #2.                                         */
+    CPU_INT32S   Acc;                                           /* Filter output, scaled by 2^Shift.                    */
+    CPU_INT08U   Shift;                                         /* Smoothing shift.                                     */
+} MATH_IIR1;
+
+typedef  struct  math_biquad_q15 {                              /* See Note #3.                                         */
+    CPU_INT32S   CoefB0;                                        /* b0.                                                  */
+    CPU_INT32U   CoefB12;                                       /* b1 | b2 (see Note #3c).                              */
+    CPU_INT32U   CoefA12;                                       /* a1 | a2.                                             */
+    CPU_INT32U   StateX;                                        /* x[n-1] | x[n-2].                                     */
+    CPU_INT32U   StateY;                                        /* y[n-1] | y[n-2].                                     */
+    CPU_INT08U   PostShift;                                     /* Coef scale (see Note #3b).                           */
+} MATH_BIQUAD_Q15;
+
+
 /*
 *********************************************************************************************************
 *                                          GLOBAL VARIABLES
@@ -278,6 +407,62 @@ RAND_NBR  Math_Rand       (void);
 
 RAND_NBR  Math_RandSeed   (RAND_NBR  seed);
 
+void        Math_RandXoshiroSetSeed(MATH_RAND_XOSHIRO  *p_state,
+                                    CPU_INT32U          seed);
+
+CPU_INT32U  Math_RandXoshiro       (MATH_RAND_XOSHIRO  *p_state);
+
+                                                                /* --------------- FIXED-POINT FNCTS ------------------ */
+MATH_Q15    Math_MulQ15            (MATH_Q15            a,
+                                    MATH_Q15            b);
+
+MATH_Q31    Math_MulQ31            (MATH_Q31            a,
+                                    MATH_Q31            b);
+
+CPU_INT64S  Math_DotQ15            (const  MATH_Q15    *p_a,
+                                    const  MATH_Q15    *p_b,
+                                    CPU_SIZE_T          len);
+
+CPU_INT64S  Math_DotQ31            (const  MATH_Q31    *p_a,
+                                    const  MATH_Q31    *p_b,
+                                    CPU_SIZE_T          len);
+
+CPU_INT16U  Math_Sqrt32            (CPU_INT32U          val);
+
+                                                                /* -------------- SORT & FILTER FNCTS ----------------- */
+void        Math_SortU16           (CPU_INT16U         *p_buf,
+                                    CPU_SIZE_T          nbr);
+
+CPU_INT16U  Math_MedianU16         (CPU_INT16U         *p_buf,
+                                    CPU_SIZE_T          nbr);
+
+void        Math_AvgMovInit        (MATH_AVG_MOV       *p_avg,
+                                    CPU_INT16U         *p_buf,
+                                    CPU_INT16U          len);
+
+CPU_INT16U  Math_AvgMovUpdate      (MATH_AVG_MOV       *p_avg,
+                                    CPU_INT16U          sample);
+
+void        Math_IIR1Init          (MATH_IIR1          *p_iir,
+                                    CPU_INT08U          shift,
+                                    CPU_INT32S          val_init);
+
+CPU_INT32S  Math_IIR1Update        (MATH_IIR1          *p_iir,
+                                    CPU_INT32S          sample);
+
+void        Math_BiquadQ15Init     (MATH_BIQUAD_Q15    *p_biquad,
+                                    MATH_Q15            b0,
+                                    MATH_Q15            b1,
+                                    MATH_Q15            b2,
+                                    MATH_Q15            a1,
+                                    MATH_Q15            a2,
+                                    CPU_INT08U          post_shift);
+
+void        Math_BiquadQ15         (MATH_BIQUAD_Q15    *p_biquad,
+                                    const  MATH_Q15    *p_src,
+                                    MATH_Q15           *p_dest,
+                                    CPU_SIZE_T          len);
+
 
 /*
 *********************************************************************************************************
@@ -285,6 +470,18 @@ RAND_NBR  Math_RandSeed   (RAND_NBR  seed);
 *********************************************************************************************************
 */
 
+#ifndef  LIB_MATH_CFG_OPTIMIZE_DSP_EN
+#error  "LIB_MATH_CFG_OPTIMIZE_DSP_EN          not #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+
+#elif  ((LIB_MATH_CFG_OPTIMIZE_DSP_EN != DEF_DISABLED) && \
+        (LIB_MATH_CFG_OPTIMIZE_DSP_EN != DEF_ENABLED ))
+#error  "LIB_MATH_CFG_OPTIMIZE_DSP_EN    illegally #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -0,0 +1,241 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                   MATHEMATIC OPERATIONS HOST BENCHMARK
+*
+* Filename      : lib_math_bench.c
+* Note(s)       : (1) Host-only benchmark; NOT part of the target build.  TOOLS/hosttest.sh bench builds it with
+*                     the Posix/GNU CPU port & compares each function against the straightforward C or C
+*                     library way of doing the same thing.
+*
+*                 (2) On the host the DSP intrinsics are plain C (see 'cpu.h  DSP INTRINSIC FUNCTIONS'), so
+*                     only the algorithmic gains show here; SMLALD/SSAT gains need a target measurement.
+*********************************************************************************************************
+*/
+
+#include  <lib_math.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <math.h>
+#include  <time.h>
+
+
+#define  BENCH_DOT_LEN                                256u
+
+
+static  MATH_RAND_XOSHIRO  BenchRand;
+static  MATH_Q15           BenchA[BENCH_DOT_LEN];
+static  MATH_Q15           BenchB[BENCH_DOT_LEN];
+volatile  CPU_INT64S       BenchSink;                           /* Keeps results alive.                                 */
+
+
+static  double  BenchNow (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+
+static  int  BenchCmpU16 (const  void  *p_a,
+                          const  void  *p_b)
+{
+    return ((int)*(const CPU_INT16U *)p_a - (int)*(const CPU_INT16U *)p_b);
+}
+
+
+static  void  BenchPrint (const  char    *p_name,
+                                 double   t_lib,
+                                 double   t_ref,
+                                 double   iter)
+{
+    printf("  %-28s %8.1f %8.1f\n", p_name, t_lib * 1e9 / iter, t_ref * 1e9 / iter);
+}
+
+
+static  void  BenchSqrt (void)
+{
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    double      t0;
+    double      t_lib;
+    double      t_ref;
+
+
+    iter = 10000000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += Math_Sqrt32(i * 2654435761u);
+    }
+    t_lib = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += (CPU_INT16U)sqrt((double)(i * 2654435761u));
+    }
+    t_ref = BenchNow() - t0;
+    BenchPrint("Math_Sqrt32 / sqrt()", t_lib, t_ref, iter);
+}
+
+
+static  void  BenchSort (CPU_SIZE_T  nbr)
+{
+    CPU_INT16U  src[64][16];
+    CPU_INT16U  buf[16];
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    CPU_INT32U  j;
+    char        name[40];
+    double      t0;
+    double      t_lib;
+    double      t_ref;
+
+
+    for (i = 0u; i < 64u; i++) {
+        for (j = 0u; j < 16u; j++) {
+            src[i][j] = (CPU_INT16U)Math_RandXoshiro(&BenchRand);
+        }
+    }
+    iter = 2000000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        for (j = 0u; j < nbr; j++) {
+            buf[j] = src[i & 63u][j];
+        }
+        BenchSink += Math_MedianU16(buf, nbr);
+    }
+    t_lib = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        for (j = 0u; j < nbr; j++) {
+            buf[j] = src[i & 63u][j];
+        }
+        qsort(buf, nbr, sizeof(buf[0]), BenchCmpU16);
+        BenchSink += buf[nbr / 2u];
+    }
+    t_ref = BenchNow() - t0;
+    snprintf(name, sizeof(name), "Math_MedianU16(%u) / qsort()", (unsigned)nbr);
+    BenchPrint(name, t_lib, t_ref, iter);
+}
+
+
+static  void  BenchDot (void)
+{
+    CPU_INT64S  acc;
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    CPU_INT32U  j;
+    double      t0;
+    double      t_lib;
+    double      t_ref;
+
+
+    for (i = 0u; i < BENCH_DOT_LEN; i++) {
+        BenchA[i] = (MATH_Q15)Math_RandXoshiro(&BenchRand);
+        BenchB[i] = (MATH_Q15)Math_RandXoshiro(&BenchRand);
+    }
+    iter = 200000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += Math_DotQ15(BenchA, BenchB, BENCH_DOT_LEN);
+    }
+    t_lib = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        acc = 0;
+        for (j = 0u; j < BENCH_DOT_LEN; j++) {
+            acc += (CPU_INT32S)BenchA[j] * BenchB[j];
+        }
+        BenchSink += acc;
+    }
+    t_ref = BenchNow() - t0;
+    BenchPrint("Math_DotQ15(256) / loop", t_lib, t_ref, iter);
+}
+
+
+static  void  BenchRandNbr (void)
+{
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    double      t0;
+    double      t_lib;
+    double      t_ref;
+
+
+    iter = 10000000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += Math_RandXoshiro(&BenchRand);
+    }
+    t_lib = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += Math_Rand();
+    }
+    t_ref = BenchNow() - t0;
+    BenchPrint("Math_RandXoshiro / Math_Rand", t_lib, t_ref, iter);
+}
+
+
+static  void  BenchBiquad (void)
+{
+    MATH_BIQUAD_Q15  biquad;
+    MATH_Q15         out[BENCH_DOT_LEN];
+    CPU_INT32U       iter;
+    CPU_INT32U       i;
+    CPU_INT32U       j;
+    double           xd[3];
+    double           yd[3];
+    double           t0;
+    double           t_lib;
+    double           t_ref;
+
+
+    Math_BiquadQ15Init(&biquad, 3277, 6554, 3277, 9830, -4915, 1u);
+    iter = 20000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        Math_BiquadQ15(&biquad, BenchA, out, BENCH_DOT_LEN);
+        BenchSink += out[0];
+    }
+    t_lib = BenchNow() - t0;
+
+    xd[1] = 0.0; xd[2] = 0.0;
+    yd[1] = 0.0; yd[2] = 0.0;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        for (j = 0u; j < BENCH_DOT_LEN; j++) {
+            xd[0]  = BenchA[j];
+            yd[0]  = 0.2 * xd[0] + 0.4 * xd[1] + 0.2 * xd[2] + 0.6 * yd[1] - 0.3 * yd[2];
+            xd[2]  = xd[1]; xd[1] = xd[0];
+            yd[2]  = yd[1]; yd[1] = yd[0];
+            out[j] = (MATH_Q15)yd[0];
+        }
+        BenchSink += out[0];
+    }
+    t_ref = BenchNow() - t0;
+    BenchPrint("Math_BiquadQ15(256) / double", t_lib, t_ref, iter);
+}
+
+
+int  main (void)
+{
+    Math_Init();
+    Math_RandXoshiroSetSeed(&BenchRand, 1u);
+
+    printf("lib_math bench (ns/call)           lib_math reference\n");
+    BenchSqrt();
+    BenchSort(9u);
+    BenchSort(16u);
+    BenchDot();
+    BenchRandNbr();
+    BenchBiquad();
+    return (0);
+}
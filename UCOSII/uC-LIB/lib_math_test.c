@@ -0,0 +1,238 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                     MATHEMATIC OPERATIONS HOST TEST
+*
+* Filename      : lib_math_test.c
+* Note(s)       : (1) Host-only test; NOT part of the target build.  TOOLS/hosttest.sh builds it twice, with &
+*                     without '-DLIB_MATH_CFG_OPTIMIZE_DSP_EN=DEF_DISABLED', against the Posix/GNU CPU port
+*                     (see 'cpu.h  DSP INTRINSIC FUNCTIONS').
+*
+*                 (2) Integer functions are compared bit-exactly against straightforward references on random
+*                     & boundary inputs; filters are compared against a double precision reference.
+*********************************************************************************************************
+*/
+
+#include  <lib_math.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <math.h>
+
+
+#define  TEST_CHK(cond)     do { if (!(cond)) { printf("lib_math: FAILED line %d: %s\n", __LINE__, #cond); TestErr++; } } while (0)
+
+
+static  CPU_INT32U          TestErr;
+static  MATH_RAND_XOSHIRO   TestRand;
+
+
+static  int  TestCmpU16 (const  void  *p_a,
+                         const  void  *p_b)
+{
+    return ((int)*(const CPU_INT16U *)p_a - (int)*(const CPU_INT16U *)p_b);
+}
+
+
+static  void  TestXoshiro (void)
+{
+    MATH_RAND_XOSHIRO  state;
+
+
+    state.State[0] = 1u;                                        /* Reference xoshiro128** output for state {1,2,3,4}.   */
+    state.State[1] = 2u;
+    state.State[2] = 3u;
+    state.State[3] = 4u;
+    TEST_CHK(Math_RandXoshiro(&state) == 11520u);
+    TEST_CHK(Math_RandXoshiro(&state) == 0u);
+    TEST_CHK(Math_RandXoshiro(&state) == 5927040u);
+    TEST_CHK(Math_RandXoshiro(&state) == 70819200u);
+
+    Math_RandXoshiroSetSeed(&state, 0u);                        /* Any seed gives a non-zero state.                     */
+    TEST_CHK((state.State[0] | state.State[1] | state.State[2] | state.State[3]) != 0u);
+}
+
+
+static  void  TestSqrt (void)
+{
+    CPU_INT32U  val;
+    CPU_INT32U  i;
+    CPU_INT16U  root;
+
+
+    for (i = 0u; i < 2000000u; i++) {
+        val  = (i < 100000u) ? i : Math_RandXoshiro(&TestRand) >> (i & 31u);
+        root = Math_Sqrt32(val);
+        if (root != (CPU_INT16U)floor(sqrt((double)val))) {
+            printf("lib_math: Math_Sqrt32(%u) = %u\n", val, root);
+            TestErr++;
+            return;
+        }
+    }
+    TEST_CHK(Math_Sqrt32(0xFFFFFFFFu) == 65535u);
+    TEST_CHK(Math_Sqrt32(0xFFFE0001u) == 65535u);
+    TEST_CHK(Math_Sqrt32(0xFFFE0000u) == 65534u);
+}
+
+
+static  void  TestSort (void)
+{
+    CPU_INT16U  buf[40];
+    CPU_INT16U  ref[40];
+    CPU_INT16U  med;
+    CPU_INT32U  nbr;
+    CPU_INT32U  k;
+    CPU_INT32U  i;
+
+
+    for (k = 0u; k < 300000u; k++) {                            /* Sorting networks (n <= 16) & insertion sort above.   */
+        nbr = Math_RandXoshiro(&TestRand) % 31u;
+        for (i = 0u; i < nbr; i++) {                            /* Odd passes : many duplicates.                        */
+            buf[i] = (CPU_INT16U)(Math_RandXoshiro(&TestRand) % (((k & 1u) != 0u) ? 4u : 65536u));
+            ref[i] = buf[i];
+        }
+        qsort(ref, nbr, sizeof(ref[0]), TestCmpU16);
+        med = Math_MedianU16(buf, nbr);
+        for (i = 0u; i < nbr; i++) {
+            if (buf[i] != ref[i]) {
+                printf("lib_math: Math_SortU16() n = %u\n", nbr);
+                TestErr++;
+                return;
+            }
+        }
+        TEST_CHK(med == ((nbr == 0u) ? 0u : ref[nbr / 2u]));
+    }
+}
+
+
+static  void  TestQ15 (void)
+{
+    MATH_Q15    a[70];
+    MATH_Q15    b[70];
+    CPU_INT64S  ref;
+    CPU_INT32U  nbr;
+    CPU_INT32U  off;
+    CPU_INT32U  k;
+    CPU_INT32U  i;
+    CPU_INT32S  x;
+    CPU_INT32S  y;
+
+
+    for (k = 0u; k < 20000u; k++) {                             /* Aligned (pairs) & unaligned vectors.                 */
+        nbr = Math_RandXoshiro(&TestRand) % 65u;
+        off = k & 1u;
+        for (i = 0u; i < nbr + 1u; i++) {
+            a[i] = (MATH_Q15)Math_RandXoshiro(&TestRand);
+            b[i] = (MATH_Q15)Math_RandXoshiro(&TestRand);
+            if ((k % 5u) == 0u) {                               /* Largest products.                                    */
+                a[i] = MATH_Q15_MIN;
+                b[i] = MATH_Q15_MIN;
+            }
+        }
+        ref = 0;
+        for (i = 0u; i < nbr; i++) {
+            ref += (CPU_INT32S)a[i + off] * b[i + off];
+        }
+        if (Math_DotQ15(a + off, b + off, nbr) != ref) {
+            printf("lib_math: Math_DotQ15() n = %u\n", nbr);
+            TestErr++;
+            return;
+        }
+    }
+
+    for (x = MATH_Q15_MIN; x <= MATH_Q15_MAX; x += 7) {         /* Truncated product, -1 * -1 saturated.                */
+        y = (CPU_INT32S)(CPU_INT16S)Math_RandXoshiro(&TestRand);
+        if (Math_MulQ15((MATH_Q15)x, (MATH_Q15)y) != (MATH_Q15)((x * y) >> 15)) {
+            printf("lib_math: Math_MulQ15(%d, %d)\n", x, y);
+            TestErr++;
+            return;
+        }
+    }
+    TEST_CHK(Math_MulQ15(MATH_Q15_MIN, MATH_Q15_MIN) == MATH_Q15_MAX);
+    TEST_CHK(Math_MulQ15(16384, 16384) == 8192);
+    TEST_CHK(Math_MulQ15(-16384, 16384) == -8192);
+    TEST_CHK(Math_MulQ31(MATH_Q31_MIN, MATH_Q31_MIN) == MATH_Q31_MAX);
+    TEST_CHK(Math_MulQ31(1 << 30, 1 << 30) == 1 << 29);
+    TEST_CHK(Math_MulQ31(MATH_Q31_MIN, MATH_Q31_MAX) == -MATH_Q31_MAX);
+}
+
+
+static  void  TestFilt (void)
+{
+    static  const  CPU_INT16U  avg_in[]  = {  4u,  8u, 12u, 16u, 20u, 24u };
+    static  const  CPU_INT16U  avg_out[] = {  4u,  6u,  8u, 10u, 14u, 18u };
+                   CPU_INT16U  avg_buf[4];
+                   MATH_AVG_MOV     avg;
+                   MATH_IIR1        iir;
+                   MATH_BIQUAD_Q15  biquad;
+                   MATH_Q15         x[200];
+                   MATH_Q15         y[200];
+                   CPU_INT32S       out;
+                   CPU_INT32U       i;
+                   double           xd[3];
+                   double           yd[3];
+                   double           err;
+                   double           err_max;
+
+
+    Math_AvgMovInit(&avg, avg_buf, 4u);                         /* Averages the samples so far, then the last 4.        */
+    for (i = 0u; i < 6u; i++) {
+        TEST_CHK(Math_AvgMovUpdate(&avg, avg_in[i]) == avg_out[i]);
+    }
+
+    Math_IIR1Init(&iir, 3u, 0);                                 /* Settles on a step; starts at the initial value.      */
+    for (i = 0u; i < 100u; i++) {
+        out = Math_IIR1Update(&iir, 1000);
+    }
+    TEST_CHK(out == 1000);
+    Math_IIR1Init(&iir, 4u, -500);
+    TEST_CHK(Math_IIR1Update(&iir, -500) == -500);
+
+                                                                /* Biquad, coefficients / 2 & post shift 1 ...          */
+    Math_BiquadQ15Init(&biquad, (MATH_Q15)(0.2 * 16384), (MATH_Q15)(0.4 * 16384), (MATH_Q15)(0.2 * 16384),
+                                (MATH_Q15)(0.6 * 16384), (MATH_Q15)(-0.3 * 16384), 1u);
+    for (i = 0u; i < 200u; i++) {
+        x[i] = (MATH_Q15)((CPU_INT32S)(Math_RandXoshiro(&TestRand) % 20000u) - 10000);
+    }
+    Math_BiquadQ15(&biquad, &x[0],   &y[0],   100u);            /* ... in two blocks (state carried over).              */
+    Math_BiquadQ15(&biquad, &x[100], &y[100], 100u);
+
+    xd[1]   = 0.0; xd[2] = 0.0;
+    yd[1]   = 0.0; yd[2] = 0.0;
+    err_max = 0.0;
+    for (i = 0u; i < 200u; i++) {
+        xd[0] = x[i] / 32768.0;
+        yd[0] = 0.2 * xd[0] + 0.4 * xd[1] + 0.2 * xd[2] + 0.6 * yd[1] - 0.3 * yd[2];
+        err   = fabs(yd[0] - y[i] / 32768.0);
+        if (err > err_max) {
+            err_max = err;
+        }
+        xd[2] = xd[1]; xd[1] = xd[0];
+        yd[2] = yd[1]; yd[1] = yd[0];
+    }
+    TEST_CHK(err_max < 4.0 / 32768.0);                          /* Coefficient rounding & output truncation.            */
+}
+
+
+int  main (void)
+{
+    Math_Init();
+    Math_RandXoshiroSetSeed(&TestRand, 12345u);
+
+    TestXoshiro();
+    TestSqrt();
+    TestSort();
+    TestQ15();
+    TestFilt();
+
+    if (TestErr != 0u) {
+        return (1);
+    }
+#if (LIB_MATH_CFG_OPTIMIZE_DSP_EN == DEF_ENABLED)
+    printf("lib_math: ok (DSP intrinsics)\n");
+#else
+    printf("lib_math: ok (C)\n");
+#endif
+    return (0);
+}
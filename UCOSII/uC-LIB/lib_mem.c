@@ -1965,7 +1965,7 @@ void  Mem_DynPoolCreateHW (const  CPU_CHAR      *p_name,
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'lib_mem.h  MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION  Note #1'.
 *********************************************************************************************************
 */
 
@@ -1974,7 +1974,9 @@ void  *Mem_DynPoolBlkGet (MEM_DYN_POOL  *p_pool,
 {
            void      *p_blk;
     const  CPU_CHAR  *p_pool_name;
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN != DEF_ENABLED)
     CPU_SR_ALLOC();
+#endif
 
 
 #if (LIB_MEM_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
@@ -1988,6 +1990,23 @@ void  *Mem_DynPoolBlkGet (MEM_DYN_POOL  *p_pool,
     }
 #endif
 
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)          /* See Note #1.                                         */
+                                                                /* Ensure pool is not empty if qty is limited.          */
+    if (p_pool->BlkQtyMax != LIB_MEM_BLK_QTY_UNLIMITED) {
+        if (Mem_DynPoolCntInc(&p_pool->BlkAllocCnt, p_pool->BlkQtyMax) != DEF_OK) {
+           *p_err = LIB_MEM_ERR_POOL_EMPTY;
+            return (DEF_NULL);
+        }
+    }
+
+                                                                /* --------------- ALLOC FROM FREE LIST --------------- */
+    p_blk = Mem_DynPoolBlkPop(&p_pool->BlkFreePtr);
+    if (p_blk != DEF_NULL) {
+       *p_err = LIB_MEM_ERR_NONE;
+
+        return (p_blk);
+    }
+#else
                                                                 /* Ensure pool is not empty if qty is limited.          */
     if (p_pool->BlkQtyMax != LIB_MEM_BLK_QTY_UNLIMITED) {
         CPU_CRITICAL_ENTER();
@@ -2014,6 +2033,7 @@ void  *Mem_DynPoolBlkGet (MEM_DYN_POOL  *p_pool,
         return (p_blk);
     }
     CPU_CRITICAL_EXIT();
+#endif
 
                                                                 /* ------------------ ALLOC NEW BLK ------------------- */
 #if (LIB_MEM_CFG_DBG_INFO_EN == DEF_ENABLED)
@@ -2056,7 +2076,12 @@ void  *Mem_DynPoolBlkGet (MEM_DYN_POOL  *p_pool,
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'lib_mem.h  MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION  Note #1'.
+*
+*               (2) The block is put back on the free list BEFORE the allocated count is decremented.
+*                   Otherwise, a concurrent Mem_DynPoolBlkGet() could pass the limit check while the block is
+*                   on neither side, find the free list empty & allocate a new block from the segment, so
+*                   that a limited pool would grow beyond 'blk_qty_max' blocks.
 *********************************************************************************************************
 */
 
@@ -2064,7 +2089,9 @@ void  Mem_DynPoolBlkFree (MEM_DYN_POOL  *p_pool,
                           void          *p_blk,
                           LIB_ERR       *p_err)
 {
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN != DEF_ENABLED)
     CPU_SR_ALLOC();
+#endif
 
 
 #if (LIB_MEM_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
@@ -2083,8 +2110,21 @@ void  Mem_DynPoolBlkFree (MEM_DYN_POOL  *p_pool,
     }
 #endif
 
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)          /* See Note #1.                                         */
+    if (p_pool->BlkQtyMax != LIB_MEM_BLK_QTY_UNLIMITED) {       /* Ensure pool is not full.                             */
+        if (p_pool->BlkAllocCnt == 0u) {
+           *p_err = LIB_MEM_ERR_POOL_FULL;
+            return;
+        }
+    }
+
+    Mem_DynPoolBlkPush(&p_pool->BlkFreePtr, p_blk);
+    if (p_pool->BlkQtyMax != LIB_MEM_BLK_QTY_UNLIMITED) {       /* See Note #2.                                         */
+        (void)Mem_DynPoolCntDec(&p_pool->BlkAllocCnt);
+    }
+#else
+    CPU_CRITICAL_ENTER();
     if (p_pool->BlkQtyMax != LIB_MEM_BLK_QTY_UNLIMITED) {       /* Ensure pool is not full.                             */
-        CPU_CRITICAL_ENTER();
         if (p_pool->BlkAllocCnt == 0u) {
             CPU_CRITICAL_EXIT();
 
@@ -2092,14 +2132,13 @@ void  Mem_DynPoolBlkFree (MEM_DYN_POOL  *p_pool,
             return;
         }
 
-        p_pool->BlkAllocCnt--;
-        CPU_CRITICAL_EXIT();
+        p_pool->BlkAllocCnt--;                                  /* See Note #2.                                         */
     }
 
-    CPU_CRITICAL_ENTER();
    *((void **)p_blk)   = p_pool->BlkFreePtr;
     p_pool->BlkFreePtr = p_blk;
     CPU_CRITICAL_EXIT();
+#endif
 
    *p_err = LIB_MEM_ERR_NONE;
 }
@@ -184,6 +184,34 @@
 #endif
 
 
+/*
+*********************************************************************************************************
+*                             MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN to enable/disable lock-free dynamic memory
+*               pool block get/free :
+*
+*               (a) The free list head & the allocated block count are updated with exclusive load/store
+*                   (LDREX/STREX) instead of disabling interrupts.
+*
+*               (b) On a single-core processor, exception entry & return clear the local exclusive
+*                   monitor.  A free list pop whose exclusive store succeeds was therefore NOT preempted
+*                   between reading the head & its next pointer, so the pop is safe from ABA without
+*                   tagging the head.
+*
+*               (c) Block allocation from the pool's memory segment, when the free list is empty, still
+*                   uses a critical section.
+*********************************************************************************************************
+*/
+
+                                                                /* Cfg lock-free dyn pool fnct(s) [see Note #1] :       */
+#ifndef  LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN
+#define  LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN  DEF_DISABLED
+                                                                /* DEF_DISABLED     Lock-free dyn pool fnct(s) DISABLED */
+                                                                /* DEF_ENABLED      Lock-free dyn pool fnct(s) ENABLED  */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                          MEMORY ALLOCATION DEBUG INFORMATION CONFIGURATION
@@ -1327,6 +1355,18 @@ void               Mem_DynPoolBlkFree       (       MEM_DYN_POOL      *p_pool,
 CPU_SIZE_T         Mem_DynPoolBlkNbrAvailGet(       MEM_DYN_POOL      *p_pool,
                                                     LIB_ERR           *p_err);
 
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)          /* See 'lib_mem_a.asm'.                                 */
+void              *Mem_DynPoolBlkPop        (       void             **p_head);
+
+void               Mem_DynPoolBlkPush       (       void             **p_head,
+                                                    void              *p_blk);
+
+CPU_BOOLEAN        Mem_DynPoolCntInc        (       CPU_SIZE_T        *p_cnt,
+                                                    CPU_SIZE_T         cnt_max);
+
+CPU_BOOLEAN        Mem_DynPoolCntDec        (       CPU_SIZE_T        *p_cnt);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -1361,6 +1401,19 @@ CPU_SIZE_T         Mem_DynPoolBlkNbrAvailGet(       MEM_DYN_POOL      *p_pool,
 #endif
 
 
+#ifndef  LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN
+#error  "LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN  not #define'd in 'lib_cfg.h'"
+#error  "                             [MUST be  DEF_DISABLED]           "
+#error  "                             [     ||  DEF_ENABLED ]           "
+
+#elif  ((LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN != DEF_DISABLED) && \
+        (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN != DEF_ENABLED ))
+#error  "LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN  illegally #define'd in 'lib_cfg.h'"
+#error  "                             [MUST be  DEF_DISABLED]           "
+#error  "                             [     ||  DEF_ENABLED ]           "
+#endif
+
+
 #ifndef  LIB_MEM_CFG_HEAP_SIZE
 #error  "LIB_MEM_CFG_HEAP_SIZE              not #define'd in 'lib_cfg.h'"
 #error  "                                   [MUST be  >= 0]             "
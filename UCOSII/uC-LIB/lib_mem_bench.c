@@ -0,0 +1,112 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                   DYNAMIC MEMORY POOL HOST BENCHMARK
+*
+* Filename      : lib_mem_bench.c
+* Note(s)       : (1) Host-only benchmark; NOT part of the target build.  TOOLS/hosttest.sh bench builds it twice :
+*
+*                     (a) with the configuration in lib_cfg.h, i.e. the lock-free block get/free;
+*                     (b) with '-DLIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN=DEF_DISABLED', i.e. the original critical
+*                         section version.
+*
+*                 (2) On the host the critical section is a mutex (see 'cpu_c.c  CPU_SR_Save()') & the
+*                     exclusive load/store an emulation (see 'lib_mem_c.c'); host timings only compare the two
+*                     versions under contention.
+*********************************************************************************************************
+*/
+
+#include  <lib_mem.h>
+#include  <pthread.h>
+#include  <stdio.h>
+#include  <time.h>
+
+
+#define  BENCH_THREAD_NBR_MAX                           4u
+#define  BENCH_PAIRS                              2000000u      /* Get/free pairs per thread.                           */
+
+
+static  CPU_INT08U    BenchSegMem[64u * 1024u];
+static  MEM_SEG       BenchSeg;
+static  MEM_DYN_POOL  BenchPool;
+
+
+static  double  BenchNow (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+
+static  void  *BenchThread (void  *p_arg)
+{
+    void        *p_blk;
+    CPU_INT32U   i;
+    LIB_ERR      err;
+
+
+    (void)p_arg;
+    for (i = 0u; i < BENCH_PAIRS; i++) {
+        p_blk = Mem_DynPoolBlkGet(&BenchPool, &err);
+        if (p_blk != DEF_NULL) {
+            Mem_DynPoolBlkFree(&BenchPool, p_blk, &err);
+        }
+    }
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           BenchRun()
+*
+* Description : Run 'thread_nbr' threads of get/free pairs; prints ns per pair per thread.
+*********************************************************************************************************
+*/
+
+static  void  BenchRun (CPU_INT32U  thread_nbr)
+{
+    pthread_t   thread[BENCH_THREAD_NBR_MAX];
+    CPU_INT32U  i;
+    double      t0;
+    double      t;
+
+
+    t0 = BenchNow();
+    for (i = 0u; i < thread_nbr; i++) {
+        pthread_create(&thread[i], DEF_NULL, BenchThread, DEF_NULL);
+    }
+    for (i = 0u; i < thread_nbr; i++) {
+        pthread_join(thread[i], DEF_NULL);
+    }
+    t = BenchNow() - t0;
+    printf("  %u thread(s)   %7.1f\n", (unsigned)thread_nbr, t * 1e9 / BENCH_PAIRS);
+}
+
+
+int  main (void)
+{
+    LIB_ERR  err;
+
+
+    Mem_Init();
+    Mem_SegCreate("bench seg", &BenchSeg, (CPU_ADDR)BenchSegMem, sizeof(BenchSegMem), LIB_MEM_PADDING_ALIGN_NONE, &err);
+    Mem_DynPoolCreate("bench", &BenchPool, &BenchSeg, 32u, sizeof(void *), 16u, 16u, &err);
+    if (err != LIB_MEM_ERR_NONE) {
+        printf("lib_mem bench: Mem_DynPoolCreate() err %u\n", err);
+        return (1);
+    }
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)
+    printf("lib_mem bench: lock-free get+free (ns/pair)\n");
+#else
+    printf("lib_mem bench: critical section get+free (ns/pair)\n");
+#endif
+    BenchRun(1u);
+    BenchRun(BENCH_THREAD_NBR_MAX);
+    return (0);
+}
@@ -0,0 +1,272 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                              DYNAMIC MEMORY POOL MULTI-THREAD HOST STRESS TEST
+*
+* Filename      : lib_mem_test.c
+* Note(s)       : (1) Host-only test; NOT part of the target build.  Build & run with TOOLS/hosttest.sh, or :
+*
+*                         gcc -O2 -w -pthread -DLIB_MEM_CFG_OPTIMIZE_ASM_EN=DEF_DISABLED
+*                             -IUCOSII/uC-LIB -IUCOSII/uC-CPU -IUCOSII/uC-CPU/Posix/GNU -IUCOSII/uCOS-CONFIG
+*                             UCOSII/uC-LIB/lib_mem_test.c UCOSII/uC-LIB/lib_mem.c UCOSII/uC-LIB/lib_str.c
+*                             UCOSII/uC-LIB/lib_ascii.c UCOSII/uC-LIB/Ports/Posix/GNU/lib_mem_c.c
+*                             UCOSII/uC-CPU/Posix/GNU/cpu_c.c
+*
+*                 (2) TEST_THREAD_NBR threads get & free blocks of a limited & an unlimited dynamic pool as
+*                     fast as possible, holding a random number of blocks at a time :
+*
+*                     (a) each block carries an in-use flag, set with compare-&-swap when the block is got
+*                         & cleared before it is freed, so a block handed out twice is detected at once;
+*                     (b) the number of blocks in use from the limited pool never exceeds its maximum;
+*                     (c) when all threads are done, the allocated count is zero & each pool's free list
+*                         holds exactly the blocks ever allocated from the segment, with no cycle.
+*
+*                 (3) Build with '-DLIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN=DEF_DISABLED' to run the same test on
+*                     the critical section version.
+*********************************************************************************************************
+*/
+
+#include  <lib_mem.h>
+#include  <pthread.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+
+
+#define  TEST_THREAD_NBR                                8u
+#define  TEST_ITER                                 400000u      /* Get/free per thread & pool.                          */
+#define  TEST_HOLD_MAX                                  8u      /* Blocks held at a time per thread.                    */
+#define  TEST_POOL_QTY_MAX                              6u      /* < TEST_HOLD_MAX : the pool runs empty.               */
+#define  TEST_BLK_SIZE                                 32u
+
+                                                                /* Block layout while in use.                           */
+typedef  struct  test_blk {
+    void        *NextPtr;                                       /* Overwritten by the free list while free.             */
+    CPU_INT32U   InUse;                                         /* 1 while got (see Note #2a).                          */
+    CPU_INT32U   Owner;
+    CPU_INT32U   Seq;
+} TEST_BLK;
+
+
+static  CPU_INT08U    TestSegMem[256u * 1024u];
+static  MEM_SEG       TestSeg;
+static  MEM_DYN_POOL  TestPoolLim;
+static  MEM_DYN_POOL  TestPoolUnlim;
+static  CPU_INT32U    TestLimInUse;                             /* Blocks in use from TestPoolLim.                      */
+static  CPU_INT32U    TestLimInUseMax;
+static  CPU_INT32U    TestLimEmpty;                             /* LIB_MEM_ERR_POOL_EMPTY count.                        */
+static  CPU_INT32U    TestBlkNew;                               /* Blocks allocated from the segment (both pools).      */
+static  CPU_INT32U    TestErr;
+
+
+static  void  TestFail (const  char  *p_msg)
+{
+    printf("lib_mem: FAILED %s\n", p_msg);
+    __atomic_store_n(&TestErr, 1u, __ATOMIC_RELAXED);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TestBlkGot()
+*
+* Description : Mark a block in use; a block already in use was handed out twice.
+*********************************************************************************************************
+*/
+
+static  void  TestBlkGot (TEST_BLK    *p_blk,
+                          CPU_INT32U   owner,
+                          CPU_INT32U   seq)
+{
+    CPU_INT32U  in_use;
+
+
+    in_use = 0u;
+    if (!__atomic_compare_exchange_n(&p_blk->InUse, &in_use, 1u, DEF_NO, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        TestFail("block got twice");
+    }
+    p_blk->Owner = owner;
+    p_blk->Seq   = seq;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TestBlkFree()
+*
+* Description : Check a block still holds what its owner wrote & mark it free.
+*********************************************************************************************************
+*/
+
+static  void  TestBlkFree (TEST_BLK    *p_blk,
+                           CPU_INT32U   owner,
+                           CPU_INT32U   seq)
+{
+    if ((p_blk->Owner != owner) || (p_blk->Seq != seq)) {
+        TestFail("block overwritten while in use");
+    }
+    __atomic_store_n(&p_blk->InUse, 0u, __ATOMIC_RELEASE);
+}
+
+
+static  void  *TestThread (void  *p_arg)
+{
+    TEST_BLK      *held_blk[TEST_HOLD_MAX];
+    CPU_INT32U     held_seq[TEST_HOLD_MAX];
+    CPU_INT32U     held_nbr;
+    CPU_INT32U     owner;
+    CPU_INT32U     iter;
+    CPU_INT32U     in_use;
+    CPU_INT32U     hold;
+    CPU_INT32U     seed;
+    MEM_DYN_POOL  *p_pool;
+    TEST_BLK      *p_blk;
+    LIB_ERR        err;
+    int            pass;
+
+
+    owner = (CPU_INT32U)(CPU_ADDR)p_arg;
+    seed  = owner * 2654435761u + 1u;
+    for (pass = 0; pass < 2; pass++) {
+        p_pool   = (pass == 0) ? &TestPoolLim : &TestPoolUnlim;
+        held_nbr = 0u;
+        for (iter = 0u; iter < TEST_ITER; iter++) {
+            seed = seed * 1103515245u + 12345u;
+            hold = (seed >> 16) % (TEST_HOLD_MAX + 1u);
+            if ((held_nbr < hold) && (held_nbr < TEST_HOLD_MAX)) {  /* Get ...                                          */
+                p_blk = (TEST_BLK *)Mem_DynPoolBlkGet(p_pool, &err);
+                if (err == LIB_MEM_ERR_POOL_EMPTY) {
+                    __atomic_add_fetch(&TestLimEmpty, 1u, __ATOMIC_RELAXED);
+                    continue;
+                }
+                if ((err != LIB_MEM_ERR_NONE) || (p_blk == DEF_NULL)) {
+                    TestFail("Mem_DynPoolBlkGet() error");
+                    break;
+                }
+                TestBlkGot(p_blk, owner, iter);
+                if (p_pool == &TestPoolLim) {
+                    in_use = __atomic_add_fetch(&TestLimInUse, 1u, __ATOMIC_RELAXED);
+                    if (in_use > TEST_POOL_QTY_MAX) {
+                        TestFail("more blocks in use than the pool maximum");
+                    }
+                    if (in_use > __atomic_load_n(&TestLimInUseMax, __ATOMIC_RELAXED)) {
+                        __atomic_store_n(&TestLimInUseMax, in_use, __ATOMIC_RELAXED);
+                    }
+                }
+                held_blk[held_nbr] = p_blk;
+                held_seq[held_nbr] = iter;
+                held_nbr++;
+            } else if (held_nbr > 0u) {                         /* ... or free a random held block.                     */
+                hold  = (seed >> 8) % held_nbr;
+                p_blk = held_blk[hold];
+                TestBlkFree(p_blk, owner, held_seq[hold]);
+                held_nbr--;
+                held_blk[hold] = held_blk[held_nbr];
+                held_seq[hold] = held_seq[held_nbr];
+                if (p_pool == &TestPoolLim) {
+                    __atomic_sub_fetch(&TestLimInUse, 1u, __ATOMIC_RELAXED);
+                }
+                Mem_DynPoolBlkFree(p_pool, p_blk, &err);
+                if (err != LIB_MEM_ERR_NONE) {
+                    TestFail("Mem_DynPoolBlkFree() error");
+                }
+            }
+            if (__atomic_load_n(&TestErr, __ATOMIC_RELAXED) != 0u) {
+                return (DEF_NULL);
+            }
+        }
+        while (held_nbr > 0u) {                                 /* Give everything back.                                */
+            held_nbr--;
+            TestBlkFree(held_blk[held_nbr], owner, held_seq[held_nbr]);
+            if (p_pool == &TestPoolLim) {
+                __atomic_sub_fetch(&TestLimInUse, 1u, __ATOMIC_RELAXED);
+            }
+            Mem_DynPoolBlkFree(p_pool, held_blk[held_nbr], &err);
+        }
+    }
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TestFreeList()
+*
+* Description : Count the blocks on a pool's free list (see Note #2c).
+*
+* Return(s)   : Number of blocks, or ~0 if the list is longer than the blocks ever allocated (cycle).
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  TestFreeList (MEM_DYN_POOL  *p_pool)
+{
+    void        *p_blk;
+    CPU_INT32U   nbr;
+
+
+    nbr = 0u;
+    for (p_blk = p_pool->BlkFreePtr; p_blk != DEF_NULL; p_blk = *(void **)p_blk) {
+        if (((TEST_BLK *)p_blk)->InUse != 0u) {
+            TestFail("block on free list marked in use");
+        }
+        if (++nbr > TestBlkNew) {
+            return (~0u);
+        }
+    }
+    return (nbr);
+}
+
+
+int  main (void)
+{
+    pthread_t   thread[TEST_THREAD_NBR];
+    CPU_INT32U  i;
+    CPU_INT32U  nbr_lim;
+    CPU_INT32U  nbr_unlim;
+    CPU_SIZE_T  seg_rem;
+    LIB_ERR     err;
+
+
+    Mem_Init();
+    Mem_SegCreate("test seg", &TestSeg, (CPU_ADDR)TestSegMem, sizeof(TestSegMem), LIB_MEM_PADDING_ALIGN_NONE, &err);
+    if (err != LIB_MEM_ERR_NONE) {
+        printf("lib_mem: Mem_SegCreate() err %u\n", err);
+        return (1);
+    }
+    Mem_DynPoolCreate("test lim",   &TestPoolLim,   &TestSeg, TEST_BLK_SIZE, sizeof(void *), 0u, TEST_POOL_QTY_MAX, &err);
+    Mem_DynPoolCreate("test unlim", &TestPoolUnlim, &TestSeg, TEST_BLK_SIZE, sizeof(void *), 0u, LIB_MEM_BLK_QTY_UNLIMITED, &err);
+    seg_rem = Mem_SegRemSizeGet(&TestSeg, sizeof(void *), DEF_NULL, &err);
+
+    for (i = 0u; i < TEST_THREAD_NBR; i++) {
+        pthread_create(&thread[i], DEF_NULL, TestThread, (void *)(CPU_ADDR)(i + 1u));
+    }
+    for (i = 0u; i < TEST_THREAD_NBR; i++) {
+        pthread_join(thread[i], DEF_NULL);
+    }
+    if (TestErr != 0u) {
+        return (1);
+    }
+
+    TestBlkNew = (CPU_INT32U)((seg_rem - Mem_SegRemSizeGet(&TestSeg, sizeof(void *), DEF_NULL, &err)) / TEST_BLK_SIZE);
+    nbr_lim    = TestFreeList(&TestPoolLim);
+    nbr_unlim  = TestFreeList(&TestPoolUnlim);
+    if ((TestPoolLim.BlkAllocCnt != 0u) ||
+        (Mem_DynPoolBlkNbrAvailGet(&TestPoolLim, &err) != TEST_POOL_QTY_MAX)) {
+        TestFail("allocated count not zero");
+    }
+    if ((nbr_lim > TEST_POOL_QTY_MAX) || (nbr_lim + nbr_unlim != TestBlkNew)) {
+        printf("lib_mem: free lists %u + %u, %u blocks allocated\n", nbr_lim, nbr_unlim, TestBlkNew);
+        TestFail("blocks lost or duplicated");
+    }
+    if (TestErr != 0u) {
+        return (1);
+    }
+#if (LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN == DEF_ENABLED)
+    printf("lib_mem: ok (lock-free, %u threads, max in use %u/%u, %u empty)\n",
+#else
+    printf("lib_mem: ok (critical section, %u threads, max in use %u/%u, %u empty)\n",
+#endif
+           TEST_THREAD_NBR, TestLimInUseMax, TEST_POOL_QTY_MAX, TestLimEmpty);
+    return (0);
+}
@@ -76,9 +76,29 @@
 /*
 *********************************************************************************************************
 *                                            LOCAL DEFINES
+*
+* Note(s) : (1) STR_WORD_HAS_ZERO() returns non-zero if any octet of a 32-bit word is zero.  Octets that
+*               compare equal to a search character are found by first XOR'ing the word with the search
+*               character replicated in every octet.
+*
+*           (2) Str_Str_N()'s bad-character shift table is indexed by the low-order bits of each character
+*               so that the table fits in 32 octets of task stack.
 *********************************************************************************************************
 */
 
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+#define  STR_WORD_SIZE                      (sizeof(CPU_INT32U))
+#define  STR_WORD_ALIGN_MSK                 (sizeof(CPU_INT32U) - 1u)
+
+#define  STR_WORD_OCTET_LSB                  0x01010101u
+#define  STR_WORD_OCTET_MSB                  0x80808080u
+                                                                /* See Note #1.                                         */
+#define  STR_WORD_HAS_ZERO(word)          ((((word) - STR_WORD_OCTET_LSB) & ~(word)) & STR_WORD_OCTET_MSB)
+
+#define  STR_SRCH_TBL_SIZE                   32u                /* See Note #2.                                         */
+#define  STR_SRCH_TBL_MSK                   (STR_SRCH_TBL_SIZE - 1u)
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -97,6 +117,9 @@
 /*
 *********************************************************************************************************
 *                                            LOCAL TABLES
+*
+* Note(s) : (1) Str_FmtDigPairTbl[] is NOT NULL-terminated; decimal digit pair 'n' is found at index
+*               (2 * n).
 *********************************************************************************************************
 */
 
@@ -140,6 +163,27 @@ static  const  CPU_INT32U  Str_MultOvfThTbl_Int32U[] = {
    (CPU_INT32U)(DEF_INT_32U_MAX_VAL / 36u)          /* 32-bit mult ovf th for base 36.  */
 };
 
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+static  const  CPU_CHAR  Str_FmtDigPairTbl[200] =           /* Dec dig pairs "00" to "99" (see Note #1).            */
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static  const  CPU_INT32U  Str_FmtPow10Tbl[DEF_INT_32U_NBR_DIG_MAX - 1u] = {
+             10u,
+            100u,
+           1000u,
+          10000u,
+         100000u,
+        1000000u,
+       10000000u,
+      100000000u,
+     1000000000u
+};
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -163,6 +207,14 @@ static  CPU_CHAR    *Str_FmtNbr_Int32  (       CPU_INT32U     nbr,
                                                CPU_BOOLEAN    nul,
                                                CPU_CHAR      *pstr);
 
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+static  CPU_CHAR    *Str_FmtNbr_Dig    (       CPU_INT32U     nbr,
+                                               CPU_INT08U     nbr_dig,
+                                               CPU_INT08U     nbr_base,
+                                               CPU_BOOLEAN    lower_case,
+                                               CPU_CHAR      *pstr_fmt);
+#endif
+
 static  CPU_INT32U   Str_ParseNbr_Int32(const  CPU_CHAR      *pstr,
                                                CPU_CHAR     **pstr_next,
                                                CPU_INT08U     nbr_base,
@@ -272,6 +324,12 @@ CPU_SIZE_T  Str_Len (const  CPU_CHAR  *pstr)
 *
 *                   (c) 'len_max' number of characters searched.
 *                       (1) 'len_max' number of characters does NOT include the terminating NULL character.
+*
+*               (4) If LIB_STR_CFG_OPTIMIZE_WORD_EN is enabled, whole aligned words are skipped until a
+*                   word contains the terminating NULL character; the remaining characters are then
+*                   counted one at a time.
+*
+*                   See also 'lib_str.h  STRING WORD-AT-A-TIME CONFIGURATION  Note #1'.
 *********************************************************************************************************
 */
 
@@ -280,10 +338,35 @@ CPU_SIZE_T  Str_Len_N (const  CPU_CHAR    *pstr,
 {
     const  CPU_CHAR    *pstr_len;
            CPU_SIZE_T   len;
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+    const  CPU_INT32U  *pstr_word;
+#endif
 
 
     pstr_len = pstr;
     len      = 0u;
+
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)               /* See Note #4.                                         */
+    if (pstr_len != (const CPU_CHAR *)0) {
+        while ((((CPU_ADDR)pstr_len & STR_WORD_ALIGN_MSK) != 0u) &&
+               (  *pstr_len != (CPU_CHAR  )'\0') &&
+               (   len      <  (CPU_SIZE_T)len_max)) {          /* Calc len of unaligned leading chars.                 */
+            pstr_len++;
+            len++;
+        }
+
+        if (((CPU_ADDR)pstr_len & STR_WORD_ALIGN_MSK) == 0u) {
+            pstr_word = (const CPU_INT32U *)pstr_len;
+            while (((len_max - len) >= STR_WORD_SIZE) &&        /* Skip words with NO NULL char.                        */
+                   (STR_WORD_HAS_ZERO(*pstr_word) == 0u)) {
+                pstr_word++;
+                len += STR_WORD_SIZE;
+            }
+            pstr_len = (const CPU_CHAR *)pstr_word;
+        }
+    }
+#endif
+
     while (( pstr_len != (const CPU_CHAR *)  0 ) &&             /* Calc str len until NULL ptr (see Note #3a) ...       */
            (*pstr_len != (      CPU_CHAR  )'\0') &&             /* ... or NULL char found      (see Note #3b) ...       */
            ( len      <  (      CPU_SIZE_T)len_max)) {          /* ... or max nbr chars srch'd (see Note #3c).          */
@@ -848,6 +931,12 @@ CPU_INT16S  Str_Cmp (const  CPU_CHAR  *p1_str,
 *
 *               (4) Since 16-bit signed arithmetic is performed to calculate a non-identical comparison
 *                   return value, 'CPU_CHAR' native data type size MUST be 8-bit.
+*
+*               (5) If LIB_STR_CFG_OPTIMIZE_WORD_EN is enabled & both strings share the same word
+*                   alignment, whole words are compared until a word differs or contains the terminating
+*                   NULL character; the remaining characters are then compared one at a time.
+*
+*                   See also 'lib_str.h  STRING WORD-AT-A-TIME CONFIGURATION  Note #1'.
 *********************************************************************************************************
 */
 
@@ -861,6 +950,10 @@ CPU_INT16S  Str_Cmp_N (const  CPU_CHAR    *p1_str,
     const  CPU_CHAR    *p2_str_cmp_next;
            CPU_INT16S   cmp_val;
            CPU_SIZE_T   cmp_len;
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+    const  CPU_INT32U  *p1_str_word;
+    const  CPU_INT32U  *p2_str_word;
+#endif
 
 
     if (len_max < 1) {                                          /* If cmp len = 0,        rtn 0       (see Note #3d1A). */
@@ -888,6 +981,36 @@ CPU_INT16S  Str_Cmp_N (const  CPU_CHAR    *p1_str,
     p2_str_cmp_next++;
     cmp_len         = 0u;
 
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)               /* See Note #5.                                         */
+    if ((((CPU_ADDR)p1_str_cmp ^ (CPU_ADDR)p2_str_cmp) & STR_WORD_ALIGN_MSK) == 0u) {
+        while ((((CPU_ADDR)p1_str_cmp & STR_WORD_ALIGN_MSK) != 0u) &&
+               (  *p1_str_cmp == *p2_str_cmp)          &&
+               (  *p1_str_cmp != (CPU_CHAR  )'\0')     &&
+               (   cmp_len    <  (CPU_SIZE_T)len_max)) {    /* Cmp unaligned leading chars.                         */
+            p1_str_cmp++;
+            p2_str_cmp++;
+            cmp_len++;
+        }
+
+        if (((CPU_ADDR)p1_str_cmp & STR_WORD_ALIGN_MSK) == 0u) {
+            p1_str_word = (const CPU_INT32U *)p1_str_cmp;
+            p2_str_word = (const CPU_INT32U *)p2_str_cmp;
+            while (((len_max - cmp_len) >= STR_WORD_SIZE) &&    /* Cmp words until non-matching or NULL char found.     */
+                   (*p1_str_word == *p2_str_word)         &&
+                   (STR_WORD_HAS_ZERO(*p1_str_word) == 0u)) {
+                p1_str_word++;
+                p2_str_word++;
+                cmp_len += STR_WORD_SIZE;
+            }
+            p1_str_cmp = (const CPU_CHAR *)p1_str_word;
+            p2_str_cmp = (const CPU_CHAR *)p2_str_word;
+        }
+
+        p1_str_cmp_next = p1_str_cmp + 1u;
+        p2_str_cmp_next = p2_str_cmp + 1u;
+    }
+#endif
+
     while ((*p1_str_cmp      == *p2_str_cmp)            &&      /* Cmp strs until non-matching chars (see Note #3c) ... */
            (*p1_str_cmp      != (      CPU_CHAR  )'\0') &&      /* ... or NULL chars                 (see Note #3b) ... */
            ( p1_str_cmp_next != (const CPU_CHAR *)  0 ) &&      /* ... or NULL ptr(s) found          (see Note #3a2).   */
@@ -1344,6 +1467,12 @@ CPU_CHAR  *Str_Char (const  CPU_CHAR  *pstr,
 *                           of characters; NULL pointer returned.
 *                       (2) 'len_max' number of characters MAY include terminating NULL character
 *                           (see Note #2a2).
+*
+*               (4) If LIB_STR_CFG_OPTIMIZE_WORD_EN is enabled, whole aligned words are skipped until a
+*                   word contains the terminating NULL character or the search character; the remaining
+*                   characters are then searched one at a time.
+*
+*                   See also 'lib_str.h  STRING WORD-AT-A-TIME CONFIGURATION  Note #1'.
 *********************************************************************************************************
 */
 
@@ -1353,6 +1482,10 @@ CPU_CHAR  *Str_Char_N (const  CPU_CHAR    *pstr,
 {
     const  CPU_CHAR    *pstr_char;
            CPU_SIZE_T   len_srch;
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+    const  CPU_INT32U  *pstr_word;
+           CPU_INT32U   srch_word;
+#endif
 
 
     if (pstr == (const CPU_CHAR *)0) {                          /* Rtn NULL if srch str ptr NULL (see Note #3a1).       */
@@ -1367,6 +1500,28 @@ CPU_CHAR  *Str_Char_N (const  CPU_CHAR    *pstr,
     pstr_char = pstr;
     len_srch  = 0u;
 
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)               /* See Note #4.                                         */
+    while ((((CPU_ADDR)pstr_char & STR_WORD_ALIGN_MSK) != 0u) &&
+           (  *pstr_char != (CPU_CHAR  )'\0')      &&
+           (  *pstr_char != (CPU_CHAR  )srch_char) &&
+           (   len_srch  <  (CPU_SIZE_T)len_max)) {             /* Srch unaligned leading chars.                        */
+        pstr_char++;
+        len_srch++;
+    }
+
+    if (((CPU_ADDR)pstr_char & STR_WORD_ALIGN_MSK) == 0u) {
+        srch_word = (CPU_INT32U)((CPU_INT08U)srch_char) * STR_WORD_OCTET_LSB;
+        pstr_word = (const CPU_INT32U *)pstr_char;
+        while (((len_max - len_srch) >= STR_WORD_SIZE)            &&
+               (STR_WORD_HAS_ZERO(*pstr_word)              == 0u) &&
+               (STR_WORD_HAS_ZERO(*pstr_word ^ srch_word)  == 0u)) {
+            pstr_word++;                                        /* Skip words with NO NULL or srch char.                */
+            len_srch += STR_WORD_SIZE;
+        }
+        pstr_char = (const CPU_CHAR *)pstr_word;
+    }
+#endif
+
     while (( pstr_char != (const CPU_CHAR *)  0 )      &&       /* Srch str until NULL ptr     [see Note #3b]  ...      */
            (*pstr_char != (      CPU_CHAR  )'\0')      &&       /* ... or NULL char            (see Note #3c)  ...      */
            (*pstr_char != (      CPU_CHAR  )srch_char) &&       /* ... or srch char found      (see Note #3d); ...      */
@@ -1844,6 +1999,21 @@ CPU_CHAR  *Str_Str (const  CPU_CHAR  *pstr,
 *                   (g) 'len_max' number of characters searched.
 *                       (1) 'len_max' number of characters does NOT include terminating NULL character
 *                           (see Note #2a2).
+*
+*               (4) If LIB_STR_CFG_OPTIMIZE_WORD_EN is enabled, the string is searched Boyer-Moore-Horspool
+*                   style :
+*
+*                   (a) Only positions whose last character matches the search string's last character
+*                       are compared via Str_Cmp_N().
+*
+*                   (b) The search then advances by the bad-character shift of the string character
+*                       aligned with the search string's last character.  Characters sharing a shift table
+*                       entry use the smallest of their shifts, which is always a safe shift.
+*
+*                   (c) One-character search strings are searched via Str_Char_N().
+*
+*                   See also 'lib_str.h  STRING WORD-AT-A-TIME CONFIGURATION  Note #1b'
+*                          & 'LOCAL DEFINES  Note #2'.
 *********************************************************************************************************
 */
 
@@ -1856,8 +2026,15 @@ CPU_CHAR  *Str_Str_N (const  CPU_CHAR    *pstr,
            CPU_SIZE_T    len_max_srch;
            CPU_SIZE_T    srch_len;
            CPU_SIZE_T    srch_ix;
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+           CPU_SIZE_T    srch_shift;
+           CPU_CHAR      srch_char;
+           CPU_CHAR      srch_char_last;
+           CPU_INT08U    srch_tbl[STR_SRCH_TBL_SIZE];
+#else
            CPU_BOOLEAN   srch_done;
            CPU_INT16S    srch_cmp;
+#endif
     const  CPU_CHAR     *pstr_str;
     const  CPU_CHAR     *pstr_srch_ix;
 
@@ -1897,6 +2074,40 @@ CPU_CHAR  *Str_Str_N (const  CPU_CHAR    *pstr,
 
 
     srch_len  = str_len - str_len_srch;                         /* Calc srch len (see Note #3e2).                       */
+
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)               /* See Note #4.                                         */
+    if (str_len_srch == 1u) {                                   /* See Note #4c.                                        */
+        pstr_srch_ix = Str_Char_N(pstr, str_len, *pstr_srch);
+        return ((CPU_CHAR *)pstr_srch_ix);
+    }
+                                                                /* Build bad-character shift tbl (see Note #4b).        */
+    srch_shift = (str_len_srch < DEF_INT_08U_MAX_VAL) ? str_len_srch : DEF_INT_08U_MAX_VAL;
+    for (srch_ix = 0u; srch_ix < STR_SRCH_TBL_SIZE; srch_ix++) {
+        srch_tbl[srch_ix] = (CPU_INT08U)srch_shift;
+    }
+    for (srch_ix = 0u; srch_ix < (str_len_srch - 1u); srch_ix++) {
+        srch_shift = str_len_srch - 1u - srch_ix;               /* Later chars have smaller shifts & overwrite ...      */
+        if (srch_shift > DEF_INT_08U_MAX_VAL) {                 /* ... earlier chars sharing the same tbl entry.        */
+            srch_shift = DEF_INT_08U_MAX_VAL;
+        }
+        srch_tbl[(CPU_INT08U)pstr_srch[srch_ix] & STR_SRCH_TBL_MSK] = (CPU_INT08U)srch_shift;
+    }
+
+    srch_char_last = pstr_srch[str_len_srch - 1u];
+    srch_ix        = 0u;
+    while (srch_ix <= srch_len) {
+        pstr_srch_ix = (const CPU_CHAR *)(pstr + srch_ix);
+        srch_char    =  pstr_srch_ix[str_len_srch - 1u];
+        if ((srch_char == srch_char_last) &&                    /* See Note #4a.                                        */
+            (Str_Cmp_N(pstr_srch_ix, pstr_srch, str_len_srch - 1u) == 0)) {
+            return ((CPU_CHAR *)pstr_srch_ix);                  /* Rtn ptr to found srch str (see Note #3f1).           */
+        }
+        srch_ix += srch_tbl[(CPU_INT08U)srch_char & STR_SRCH_TBL_MSK];
+    }
+
+    return ((CPU_CHAR *)0);                                     /* Rtn NULL if srch str NOT found (see Note #3e2).      */
+
+#else
     srch_ix   = 0u;
     srch_done = DEF_NO;
 
@@ -1913,6 +2124,7 @@ CPU_CHAR  *Str_Str_N (const  CPU_CHAR    *pstr,
     }
 
     return ((CPU_CHAR *)pstr_srch_ix);                          /* Else rtn ptr to found srch str (see Note #3f1).      */
+#endif
 }
 
 
@@ -3442,6 +3654,11 @@ CPU_INT32S  Str_ParseNbr_Int32S (const  CPU_CHAR     *pstr,
 *                          number of     =  {
 *                       question marks      {  (b)  'nbr_dig'         ,  if 'nbr_dig' > 0
 *
+*               (8) If LIB_STR_CFG_FMT_FAST_EN is enabled, all significant digits are formatted at once
+*                   by Str_FmtNbr_Dig(); only leading characters & the negative sign are then formatted
+*                   one character at a time.
+*
+*                   See also 'lib_str.h  STRING FAST NUMBER FORMAT CONFIGURATION  Note #1'.
 *********************************************************************************************************
 */
 
@@ -3522,6 +3739,15 @@ static  CPU_CHAR  *Str_FmtNbr_Int32 (CPU_INT32U    nbr,
         nbr_fmt     = nbr;
         nbr_log     = nbr;
         nbr_dig_max = 1u;
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+        if (nbr_base == DEF_NBR_BASE_DEC) {                     /* Calc max nbr dec digs by pow's of 10 (see Note #8).  */
+            while ((nbr_dig_max <  DEF_INT_32U_NBR_DIG_MAX) &&
+                   (nbr_log     >= Str_FmtPow10Tbl[nbr_dig_max - 1u])) {
+                nbr_dig_max++;
+            }
+            nbr_log = 0u;
+        }
+#endif
         while (nbr_log >= nbr_base) {                           /* While nbr base digs avail, ...                       */
             nbr_dig_max++;                                      /* ... calc max nbr digs.                               */
             nbr_log /= nbr_base;
@@ -3564,8 +3790,20 @@ static  CPU_CHAR  *Str_FmtNbr_Int32 (CPU_INT32U    nbr,
     }
     pstr_fmt--;
 
+    i = 0u;
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+    if (fmt_invalid == DEF_NO) {                                /* Fmt all sig digs (see Note #8).                      */
+        pstr_fmt = Str_FmtNbr_Dig(nbr_fmt,
+                                  nbr_dig_min,
+                                  nbr_base,
+                                  lower_case,
+                                  pstr_fmt);
+        nbr_fmt  = 0u;
+        i        = nbr_dig_min;
+    }
+#endif
 
-    for (i = 0u; i < nbr_dig_fmtd; i++) {                       /* Fmt str for desired nbr digs :                       */
+    for ( ; i < nbr_dig_fmtd; i++) {                            /* Fmt str for desired nbr digs :                       */
         if (fmt_invalid == DEF_NO) {
             if ((nbr_fmt > 0) ||                                /* If fmt nbr > 0                               ...     */
                 (i == 0u)) {                                    /* ... OR on one's  dig to fmt (see Note #3c1), ...     */
@@ -3611,6 +3849,101 @@ static  CPU_CHAR  *Str_FmtNbr_Int32 (CPU_INT32U    nbr,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          Str_FmtNbr_Dig()
+*
+* Description : Format the significant digits of a 32-bit unsigned integer, least-significant digit first.
+*
+* Argument(s) : nbr             Number           to format.
+*
+*               nbr_dig         Number of significant digits of 'nbr' in 'nbr_base'.
+*
+*               nbr_base        Base   of number to format.
+*
+*               lower_case      Format alphabetic characters (if any) in lower case :
+*
+*                                   DEF_NO          Format alphabetic characters in upper case.
+*                                   DEF_YES         Format alphabetic characters in lower case.
+*
+*               pstr_fmt        Pointer to character array position of the least-significant digit.
+*
+* Return(s)   : Pointer to character array position preceding the most-significant digit.
+*
+* Caller(s)   : Str_FmtNbr_Int32().
+*
+* Note(s)     : (1) Arguments validated in Str_FmtNbr_Int32().
+*
+*               (2) Decimal digits are formatted in pairs (see 'lib_str.h  STRING FAST NUMBER FORMAT
+*                   CONFIGURATION  Note #1a').
+*
+*               (3) Power-of-two base digits are formatted by shift & mask (see 'lib_str.h  STRING FAST
+*                   NUMBER FORMAT CONFIGURATION  Note #1c').
+*********************************************************************************************************
+*/
+
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+static  CPU_CHAR  *Str_FmtNbr_Dig (CPU_INT32U    nbr,
+                                   CPU_INT08U    nbr_dig,
+                                   CPU_INT08U    nbr_base,
+                                   CPU_BOOLEAN   lower_case,
+                                   CPU_CHAR     *pstr_fmt)
+{
+    CPU_INT32U  nbr_quot;
+    CPU_INT32U  dig_ix;
+    CPU_INT08U  dig_val;
+    CPU_INT08U  dig_shift;
+    CPU_CHAR    dig_char_a;
+
+
+    if (nbr_base == DEF_NBR_BASE_DEC) {                         /* See Note #2.                                         */
+        while (nbr_dig >= 2u) {
+            nbr_quot    =  nbr / 100u;
+            dig_ix      = (nbr - (nbr_quot * 100u)) * 2u;
+           *pstr_fmt--  =  Str_FmtDigPairTbl[dig_ix + 1u];
+           *pstr_fmt--  =  Str_FmtDigPairTbl[dig_ix];
+            nbr         =  nbr_quot;
+            nbr_dig    -=  2u;
+        }
+        if (nbr_dig > 0u) {
+           *pstr_fmt--  = (CPU_CHAR)(nbr + '0');
+        }
+        return (pstr_fmt);
+    }
+
+
+    dig_shift = 0u;
+    if ((nbr_base & (nbr_base - 1u)) == 0u) {                   /* See Note #3.                                         */
+        while ((1u << dig_shift) < nbr_base) {
+            dig_shift++;
+        }
+    }
+
+    dig_char_a = (lower_case != DEF_YES) ? 'A' : 'a';
+
+    while (nbr_dig > 0u) {
+        if (dig_shift > 0u) {
+            dig_val  = (CPU_INT08U)(nbr & (nbr_base - 1u));
+            nbr    >>=  dig_shift;
+        } else {
+            nbr_quot =  nbr / nbr_base;
+            dig_val  = (CPU_INT08U)(nbr - (nbr_quot * nbr_base));
+            nbr      =  nbr_quot;
+        }
+
+        if (dig_val < 10u) {
+           *pstr_fmt-- = (CPU_CHAR)(dig_val + '0');
+        } else {
+           *pstr_fmt-- = (CPU_CHAR)((dig_val - 10u) + dig_char_a);
+        }
+        nbr_dig--;
+    }
+
+    return (pstr_fmt);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        Str_ParseNbr_Int32()
@@ -211,6 +211,53 @@
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                 STRING WORD-AT-A-TIME CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_STR_CFG_OPTIMIZE_WORD_EN to enable/disable word-at-a-time string function(s) :
+*
+*               (a) Str_Len_N(), Str_Char_N() & Str_Cmp_N() test four characters per aligned 32-bit
+*                   read for a terminating NULL &/or search character, then finish byte-by-byte.
+*
+*               (b) Str_Str_N() searches with a Boyer-Moore-Horspool bad-character shift table.
+*
+*               (c) Aligned 32-bit reads MAY read up to three octets past a string's terminating NULL
+*                   character, but never past the aligned word containing it.
+*********************************************************************************************************
+*/
+
+                                                                /* Configure word-at-a-time function(s) [see Note #1] : */
+#ifndef  LIB_STR_CFG_OPTIMIZE_WORD_EN
+#define  LIB_STR_CFG_OPTIMIZE_WORD_EN           DEF_DISABLED
+                                                                /*   DEF_DISABLED     Word-at-a-time fnct(s) DISABLED   */
+                                                                /*   DEF_ENABLED      Word-at-a-time fnct(s) ENABLED    */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                STRING FAST NUMBER FORMAT CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_STR_CFG_FMT_FAST_EN to enable/disable fast integer formatting :
+*
+*               (a) Decimal numbers are formatted two digits at a time from a 200-octet digit pair table,
+*                   dividing by the constant 100 which compilers implement as a reciprocal multiply.
+*
+*               (b) The number of decimal digits is found by comparing against powers of ten.
+*
+*               (c) Power-of-two bases are formatted with shifts & masks instead of divisions.
+*********************************************************************************************************
+*/
+
+                                                                /* Configure fast number format [see Note #1] :         */
+#ifndef  LIB_STR_CFG_FMT_FAST_EN
+#define  LIB_STR_CFG_FMT_FAST_EN                DEF_DISABLED
+                                                                /*   DEF_DISABLED     Fast number format DISABLED       */
+                                                                /*   DEF_ENABLED      Fast number format ENABLED        */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                               DEFINES
@@ -417,6 +464,32 @@ CPU_INT32S   Str_ParseNbr_Int32S(const  CPU_CHAR      *pstr,
 #endif
 
 
+#ifndef  LIB_STR_CFG_OPTIMIZE_WORD_EN
+#error  "LIB_STR_CFG_OPTIMIZE_WORD_EN          not #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+
+#elif  ((LIB_STR_CFG_OPTIMIZE_WORD_EN != DEF_DISABLED) && \
+        (LIB_STR_CFG_OPTIMIZE_WORD_EN != DEF_ENABLED ))
+#error  "LIB_STR_CFG_OPTIMIZE_WORD_EN    illegally #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+#endif
+
+
+#ifndef  LIB_STR_CFG_FMT_FAST_EN
+#error  "LIB_STR_CFG_FMT_FAST_EN               not #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+
+#elif  ((LIB_STR_CFG_FMT_FAST_EN != DEF_DISABLED) && \
+        (LIB_STR_CFG_FMT_FAST_EN != DEF_ENABLED ))
+#error  "LIB_STR_CFG_FMT_FAST_EN         illegally #define'd in 'lib_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]           "
+#error  "                                [     ||  DEF_ENABLED ]           "
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -0,0 +1,182 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                  ASCII STRING MANAGEMENT HOST BENCHMARK
+*
+* Filename      : lib_str_bench.c
+* Note(s)       : (1) Host-only benchmark; NOT part of the target build.  TOOLS/hosttest.sh bench builds it twice :
+*
+*                     (a) with the configuration in lib_cfg.h;
+*                     (b) with '-DLIB_STR_CFG_OPTIMIZE_WORD_EN=DEF_DISABLED -DLIB_STR_CFG_FMT_FAST_EN=DEF_DISABLED',
+*                         i.e. the original byte-by-byte search & digit-by-digit format functions.
+*
+*                 (2) Host timings only compare the two versions.
+*********************************************************************************************************
+*/
+
+#include  <lib_str.h>
+#include  <string.h>
+#include  <stdio.h>
+#include  <time.h>
+
+
+#define  BENCH_BUF_SIZE                         1100u
+#define  BENCH_OCTETS                       (64u * 1024u * 1024u)   /* Octets scanned per measurement.                  */
+
+
+static  CPU_CHAR  BenchBufA[BENCH_BUF_SIZE];
+static  CPU_CHAR  BenchBufB[BENCH_BUF_SIZE];
+static  CPU_CHAR  BenchPat[]  = "abcabd";
+volatile  CPU_SIZE_T  BenchSink;                                /* Keeps results alive.                                 */
+
+
+static  double  BenchNow (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           BenchStr()
+*
+* Description : Time the search & compare functions on strings of 'len' octets; prints ns per call.
+*********************************************************************************************************
+*/
+
+static  void  BenchStr (CPU_SIZE_T  len)
+{
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    double      t0;
+    double      t_len;
+    double      t_cmp;
+    double      t_chr;
+    double      t_str;
+
+
+    for (i = 0u; i < len; i++) {                                /* "abcabcab..." : frequent partial matches.            */
+        BenchBufA[i] = 'a' + i % 3u;
+    }
+    BenchBufA[len] = '\0';
+    memcpy(BenchBufB, BenchBufA, len + 1u);
+    iter = BENCH_OCTETS / (len + 1u);
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += Str_Len_N(BenchBufA + (i & 1u), len + 1u);
+    }
+    t_len = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += (CPU_SIZE_T)Str_Cmp_N(BenchBufA, BenchBufB, len + 1u);
+    }
+    t_cmp = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += (CPU_SIZE_T)Str_Char_N(BenchBufA + (i & 1u), len + 1u, 'z');
+    }
+    t_chr = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        BenchSink += (CPU_SIZE_T)Str_Str_N(BenchBufA + (i & 1u), BenchPat, len + 1u);
+    }
+    t_str = BenchNow() - t0;
+
+    printf("  %4u   %9.1f %9.1f %9.1f %9.1f\n",
+           (unsigned)len,
+           t_len * 1e9 / iter,
+           t_cmp * 1e9 / iter,
+           t_chr * 1e9 / iter,
+           t_str * 1e9 / iter);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          BenchFmtNbr()
+*
+* Description : Time Str_FmtNbr_Int32U() & Str_FmtNbr_Int32S() against snprintf(); prints ns per call.
+*********************************************************************************************************
+*/
+
+static  void  BenchFmtNbr (void)
+{
+    CPU_CHAR    buf[16];
+    CPU_INT32U  iter;
+    CPU_INT32U  i;
+    double      t0;
+    double      t_dec;
+    double      t_hex;
+    double      t_neg;
+    double      t_lib;
+
+
+    iter = 10000000u;
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        Str_FmtNbr_Int32U(i * 7919u, DEF_INT_32U_NBR_DIG_MAX, 10u, '\0', DEF_NO, DEF_YES, buf);
+        BenchSink += buf[0];
+    }
+    t_dec = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        Str_FmtNbr_Int32U(i * 7919u, 8u, 16u, '0', DEF_NO, DEF_YES, buf);
+        BenchSink += buf[0];
+    }
+    t_hex = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        Str_FmtNbr_Int32S(((CPU_INT32S)i - 5000000) * 100, 10u, 10u, ' ', DEF_NO, DEF_YES, buf);
+        BenchSink += buf[0];
+    }
+    t_neg = BenchNow() - t0;
+
+    t0 = BenchNow();
+    for (i = 0u; i < iter; i++) {
+        snprintf(buf, sizeof(buf), "%u", (unsigned)(i * 7919u));
+        BenchSink += buf[0];
+    }
+    t_lib = BenchNow() - t0;
+
+    printf("  Str_FmtNbr_Int32U %%u     %6.1f\n", t_dec * 1e9 / iter);
+    printf("  Str_FmtNbr_Int32U %%08X   %6.1f\n", t_hex * 1e9 / iter);
+    printf("  Str_FmtNbr_Int32S %%10d   %6.1f\n", t_neg * 1e9 / iter);
+    printf("  snprintf %%u              %6.1f\n", t_lib * 1e9 / iter);
+}
+
+
+int  main (void)
+{
+    static  const  CPU_SIZE_T  len_tbl[] = { 8u, 32u, 128u, 1024u };
+    CPU_INT32U  i;
+
+
+#if (LIB_STR_CFG_OPTIMIZE_WORD_EN == DEF_ENABLED)
+    printf("lib_str bench: word-at-a-time (ns/call)\n");
+#else
+    printf("lib_str bench: byte-by-byte (ns/call)\n");
+#endif
+    printf("  len     Str_Len_N Str_Cmp_N Str_Chr_N Str_Str_N\n");
+    for (i = 0u; i < sizeof(len_tbl) / sizeof(len_tbl[0]); i++) {
+        BenchStr(len_tbl[i]);
+    }
+#if (LIB_STR_CFG_FMT_FAST_EN == DEF_ENABLED)
+    printf("lib_str bench: table-driven format (ns/call)\n");
+#else
+    printf("lib_str bench: digit-by-digit format (ns/call)\n");
+#endif
+    BenchFmtNbr();
+    return (0);
+}
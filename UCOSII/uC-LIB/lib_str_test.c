@@ -0,0 +1,327 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*                                  ASCII STRING MANAGEMENT HOST TEST
+*
+* Filename      : lib_str_test.c
+* Note(s)       : (1) Host-only test; NOT part of the target build.  Build & run with TOOLS/hosttest.sh, or :
+*
+*                         gcc -O2 -w -IUCOSII/uC-LIB -IUCOSII/uC-CPU -IUCOSII/uC-CPU/ARM-Cortex-M4/RealView
+*                             -IUCOSII/uCOS-CONFIG UCOSII/uC-LIB/lib_str_test.c UCOSII/uC-LIB/lib_str.c
+*                             UCOSII/uC-LIB/lib_ascii.c
+*
+*                 (2) Search & compare functions are checked against the C library with random strings over
+*                     small alphabets (so that partial matches are frequent), every word alignment & random
+*                     length limits.  Build with '-DLIB_STR_CFG_OPTIMIZE_WORD_EN=DEF_DISABLED' to check the
+*                     byte-by-byte versions.
+*
+*                 (3) Str_FmtNbr_Int32U() & Str_FmtNbr_Int32S() are checked against a straightforward reference
+*                     formatter (see 'lib_str.c  Str_FmtNbr_Int32()  Notes #3, #6 & #7') for every base, widths
+*                     0 to 12 & the usual leading characters.  Build with '-DLIB_STR_CFG_FMT_FAST_EN=DEF_DISABLED'
+*                     to check the digit-by-digit version.
+*********************************************************************************************************
+*/
+
+#include  <lib_str.h>
+#include  <string.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+
+
+#define  TEST_ITER                            1000000u
+#define  TEST_STR_LEN_MAX                          40
+#define  TEST_FMT_ITER                        3000000u
+
+
+static  CPU_CHAR  TestBufA[300];
+static  CPU_CHAR  TestBufB[300];
+
+
+static  int  TestSign (int  val)
+{
+    return ((val < 0) ? -1 : (val > 0));
+}
+
+
+static  int  TestFail (const  char  *p_fnct,
+                       const  char  *p_a,
+                       const  char  *p_b,
+                       CPU_SIZE_T    len_max)
+{
+    printf("lib_str: %s FAILED a=\"%s\" b=\"%s\" n=%u\n", p_fnct, p_a, p_b, (unsigned)len_max);
+    return (1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TestStrSearch()
+*
+* Description : Compare Str_Len(), Str_Len_N(), Str_Cmp(), Str_Cmp_N(), Str_Char(), Str_Char_N(), Str_Str() &
+*               Str_Str_N() against the C library.
+*
+* Return(s)   : 0, if all results match.
+*               1, otherwise.
+*********************************************************************************************************
+*/
+
+static  int  TestStrSearch (void)
+{
+    CPU_INT32U   iter;
+    CPU_CHAR    *p_a;
+    CPU_CHAR    *p_b;
+    CPU_CHAR    *p_exp;
+    CPU_CHAR     c;
+    CPU_CHAR     sav;
+    CPU_SIZE_T   len_a;
+    CPU_SIZE_T   len_b;
+    CPU_SIZE_T   len_max;
+    CPU_SIZE_T   len_srch;
+    CPU_SIZE_T   i;
+    CPU_SIZE_T   start;
+    int          alpha;
+
+
+    srand(1);
+    for (iter = 0u; iter < TEST_ITER; iter++) {
+        p_a     = TestBufA + rand() % 8;                        /* All word alignments.                                 */
+        p_b     = TestBufB + rand() % 8;
+        len_a   = rand() % TEST_STR_LEN_MAX;
+        len_b   = rand() % TEST_STR_LEN_MAX;
+        len_max = rand() % 50;
+        alpha   = 2 + rand() % 4;
+
+        memset(TestBufA, 'x', sizeof(TestBufA));                /* Junk after the terminator.                           */
+        memset(TestBufB, 'y', sizeof(TestBufB));
+        for (i = 0u; i < len_a; i++) {
+            p_a[i] = 'a' + rand() % alpha;
+        }
+        p_a[len_a] = '\0';
+
+        if (rand() % 2) {                                       /* Unrelated string ...                                 */
+            for (i = 0u; i < len_b; i++) {
+                p_b[i] = 'a' + rand() % alpha;
+            }
+            p_b[len_b] = '\0';
+        } else {                                                /* ... or (part of) the same string, maybe one change.  */
+            len_b = (len_a < len_b) ? len_a : len_b;
+            memcpy(p_b, p_a, len_b);
+            if ((len_b > 0u) && (rand() % 2)) {
+                p_b[rand() % len_b] = 'a' + rand() % alpha;
+            }
+            p_b[len_b] = '\0';
+            if (rand() % 3 == 0) {
+                start = rand() % (len_a + 1u);
+                len_b = rand() % (len_a - start + 1u);
+                memcpy(p_b, p_a + start, len_b);
+                p_b[len_b] = '\0';
+            }
+        }
+
+        if (Str_Len(p_a) != strlen(p_a)) {
+            return (TestFail("Str_Len", p_a, p_b, 0u));
+        }
+        if (Str_Len_N(p_a, len_max) != strnlen(p_a, len_max)) {
+            return (TestFail("Str_Len_N", p_a, p_b, len_max));
+        }
+        if (TestSign(Str_Cmp(p_a, p_b)) != TestSign(strcmp(p_a, p_b))) {
+            return (TestFail("Str_Cmp", p_a, p_b, 0u));
+        }
+        if (TestSign(Str_Cmp_N(p_a, p_b, len_max)) != TestSign(strncmp(p_a, p_b, len_max))) {
+            return (TestFail("Str_Cmp_N", p_a, p_b, len_max));
+        }
+
+        c = (rand() % 8 == 0) ? '\0' : (CPU_CHAR)('a' + rand() % alpha);
+        if (Str_Char(p_a, c) != strchr(p_a, c)) {
+            return (TestFail("Str_Char", p_a, p_b, 0u));
+        }
+        len_srch = (len_max < len_a + 1u) ? len_max : len_a + 1u;
+        if (Str_Char_N(p_a, len_max, c) != memchr(p_a, c, len_srch)) {
+            return (TestFail("Str_Char_N", p_a, p_b, len_max));
+        }
+
+        p_exp = (len_b > 0u) ? strstr(p_a, p_b) : p_a;
+        if (Str_Str(p_a, p_b) != p_exp) {
+            return (TestFail("Str_Str", p_a, p_b, 0u));
+        }
+        len_srch = (len_max < len_a) ? len_max : len_a;         /* Str_Str_N() only searches the first len_max chars.   */
+        sav           = p_a[len_srch];
+        p_a[len_srch] = '\0';
+        p_exp         = strstr(p_a, p_b);
+        p_a[len_srch] = sav;
+        if (len_max == 0u) {
+            p_exp = DEF_NULL;
+        } else if (len_b == 0u) {
+            p_exp = p_a;
+        }
+        if (Str_Str_N(p_a, p_b, len_max) != p_exp) {
+            return (TestFail("Str_Str_N", p_a, p_b, len_max));
+        }
+    }
+    return (0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TestFmtRef()
+*
+* Description : Reference integer format, one digit at a time.
+*
+* Argument(s) : nbr_mag     Magnitude of the number.
+*
+*               nbr_neg     Number is negative.
+*
+*               (other)     See Str_FmtNbr_Int32U().
+*
+*               p_str       Buffer for the expected string.
+*
+* Return(s)   : DEF_OK, if the number fits in 'nbr_dig' characters.
+*               DEF_FAIL, otherwise ('nbr_dig' question marks formatted).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TestFmtRef (CPU_INT32U    nbr_mag,
+                                 CPU_BOOLEAN   nbr_neg,
+                                 CPU_INT08U    nbr_dig,
+                                 CPU_INT08U    nbr_base,
+                                 CPU_CHAR      lead_char,
+                                 CPU_BOOLEAN   lower_case,
+                                 CPU_CHAR     *p_str)
+{
+    CPU_CHAR    dig_buf[40];
+    CPU_INT08U  dig_cnt;
+    CPU_INT08U  dig_val;
+    CPU_INT08U  len;
+    CPU_INT08U  i;
+
+
+    dig_cnt = 0u;
+    do {                                                        /* Digits, least significant first.                     */
+        dig_val            = nbr_mag % nbr_base;
+        dig_buf[dig_cnt++] = (dig_val < 10u) ? (CPU_CHAR)('0' + dig_val)
+                                             : (CPU_CHAR)((lower_case == DEF_YES ? 'a' : 'A') + dig_val - 10u);
+        nbr_mag           /= nbr_base;
+    } while (nbr_mag > 0u);
+
+    if ((nbr_dig == 0u) || (dig_cnt + (nbr_neg ? 1u : 0u) > nbr_dig)) {
+        memset(p_str, '?', nbr_dig);
+        p_str[nbr_dig] = '\0';
+        return (DEF_FAIL);
+    }
+
+    len = 0u;
+    if ((nbr_neg) && (lead_char == '0')) {                      /* '-' before leading zeros ...                         */
+        p_str[len++] = '-';
+    }
+    if (lead_char != '\0') {
+        for (i = dig_cnt + (nbr_neg ? 1u : 0u); i < nbr_dig; i++) {
+            p_str[len++] = lead_char;
+        }
+    }
+    if ((nbr_neg) && (lead_char != '0')) {                      /* ... else right before the digits.                    */
+        p_str[len++] = '-';
+    }
+    while (dig_cnt > 0u) {
+        p_str[len++] = dig_buf[--dig_cnt];
+    }
+    p_str[len] = '\0';
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TestFmtNbr()
+*
+* Description : Compare Str_FmtNbr_Int32U() & Str_FmtNbr_Int32S() against TestFmtRef() & snprintf().
+*
+* Return(s)   : 0, if all results match.
+*               1, otherwise.
+*********************************************************************************************************
+*/
+
+static  int  TestFmtNbr (void)
+{
+    static  const  CPU_CHAR  lead_tbl[] = { '\0', ' ', '0', '#' };
+    CPU_CHAR     exp_buf[48];
+    CPU_CHAR     lib_buf[48];
+    CPU_CHAR    *p_rtn;
+    CPU_INT32U   iter;
+    CPU_INT32U   nbr;
+    CPU_INT32S   nbr_s;
+    CPU_INT08U   nbr_dig;
+    CPU_INT08U   nbr_base;
+    CPU_CHAR     lead_char;
+    CPU_BOOLEAN  lower_case;
+    CPU_BOOLEAN  ok;
+    int          k;
+
+
+    srand(2);
+    for (iter = 0u; iter < TEST_FMT_ITER; iter++) {
+        k   = rand() % 4;                                       /* Small, large, near max & random numbers.            */
+        nbr = (k == 0) ? (CPU_INT32U)(rand() % 1000)
+            : (k == 1) ? (CPU_INT32U)rand() * 7919u
+            : (k == 2) ? 0xFFFFFFFFu - (CPU_INT32U)(rand() % 5)
+            :            (CPU_INT32U)rand();
+        if (rand() % 8 == 0) {
+            nbr = (rand() % 2) ? 0u : 0x80000000u;
+        }
+        nbr_dig    = rand() % 13;
+        nbr_base   = (rand() % 3 == 0) ? ((rand() % 2) ? 10u : 16u) : 2u + rand() % 35;
+        lead_char  = lead_tbl[rand() % 4];
+        lower_case = (rand() % 2) ? DEF_YES : DEF_NO;
+
+        memset(lib_buf, 'z', sizeof(lib_buf));
+        ok    = TestFmtRef(nbr, DEF_NO, nbr_dig, nbr_base, lead_char, lower_case, exp_buf);
+        p_rtn = Str_FmtNbr_Int32U(nbr, nbr_dig, nbr_base, lead_char, lower_case, DEF_YES, lib_buf);
+        if ((strcmp(lib_buf, exp_buf) != 0) || ((p_rtn != DEF_NULL) != ok)) {
+            printf("lib_str: Str_FmtNbr_Int32U FAILED %u dig=%u base=%u lead=%d \"%s\" != \"%s\"\n",
+                   (unsigned)nbr, nbr_dig, nbr_base, lead_char, lib_buf, exp_buf);
+            return (1);
+        }
+
+        nbr_s = (CPU_INT32S)nbr;
+        memset(lib_buf, 'z', sizeof(lib_buf));
+        ok    = TestFmtRef((nbr_s < 0) ? 0u - nbr : nbr, (nbr_s < 0), nbr_dig, nbr_base, lead_char, lower_case, exp_buf);
+        p_rtn = Str_FmtNbr_Int32S(nbr_s, nbr_dig, nbr_base, lead_char, lower_case, DEF_YES, lib_buf);
+        if ((strcmp(lib_buf, exp_buf) != 0) || ((p_rtn != DEF_NULL) != ok)) {
+            printf("lib_str: Str_FmtNbr_Int32S FAILED %d dig=%u base=%u lead=%d \"%s\" != \"%s\"\n",
+                   (int)nbr_s, nbr_dig, nbr_base, lead_char, lib_buf, exp_buf);
+            return (1);
+        }
+    }
+                                                                /* Cross-check the reference with the C library.        */
+    for (nbr_s = -100000; nbr_s < 100000; nbr_s += 13) {
+        Str_FmtNbr_Int32S(nbr_s, 8u, 10u, '0', DEF_NO, DEF_YES, lib_buf);
+        snprintf(exp_buf, sizeof(exp_buf), "%08d", (int)nbr_s);
+        if (strcmp(lib_buf, exp_buf) != 0) {
+            printf("lib_str: Str_FmtNbr_Int32S FAILED \"%s\" != \"%s\"\n", lib_buf, exp_buf);
+            return (1);
+        }
+        nbr = (CPU_INT32U)nbr_s * 2654435761u;
+        Str_FmtNbr_Int32U(nbr, 8u, 16u, '0', DEF_YES, DEF_YES, lib_buf);
+        snprintf(exp_buf, sizeof(exp_buf), "%08x", (unsigned)nbr);
+        if (strcmp(lib_buf, exp_buf) != 0) {
+            printf("lib_str: Str_FmtNbr_Int32U FAILED \"%s\" != \"%s\"\n", lib_buf, exp_buf);
+            return (1);
+        }
+    }
+    return (0);
+}
+
+
+int  main (void)
+{
+    if (TestStrSearch() != 0) {
+        return (1);
+    }
+    if (TestFmtNbr() != 0) {
+        return (1);
+    }
+    printf("lib_str: ok\n");
+    return (0);
+}
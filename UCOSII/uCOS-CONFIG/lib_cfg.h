@@ -83,7 +83,23 @@
                                                                 /* Assembly-optimized function(s).                      */
                                                                 /* Enable/disable assembly-optimized memory ...         */
                                                                 /* ... function(s). [see Note #1]                       */
+#ifndef  LIB_MEM_CFG_OPTIMIZE_ASM_EN                            /* Disabled on the command line for host builds.        */
 #define  LIB_MEM_CFG_OPTIMIZE_ASM_EN        DEF_ENABLED
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 MEMORY LIBRARY LOCK-FREE POOL CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN to enable/disable lock-free dynamic memory pool
+*               block get/free.  Requires exclusive load/store support in the port's 'lib_mem_a.asm'.
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN                      /* Lock-free dynamic pool block get/free.               */
+#define  LIB_MEM_CFG_DYN_POOL_LOCK_FREE_EN  DEF_ENABLED
+#endif
 
 
 /*
@@ -161,6 +177,66 @@
 #define  LIB_STR_CFG_FP_MAX_NBR_DIG_SIG         LIB_STR_FP_MAX_NBR_DIG_SIG_DFLT
 
 
+/*
+*********************************************************************************************************
+*                                 STRING WORD-AT-A-TIME CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_STR_CFG_OPTIMIZE_WORD_EN to enable/disable word-at-a-time (32-bit) string
+*               search & compare function(s).
+*
+*               See also 'lib_str.h  STRING WORD-AT-A-TIME CONFIGURATION  Note #1'.
+*
+*           (2) May be overridden on the compiler command line (see 'lib_str_bench.c  Note #1').
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_STR_CFG_OPTIMIZE_WORD_EN                           /* Enable/disable word-at-a-time string functions.      */
+#define  LIB_STR_CFG_OPTIMIZE_WORD_EN           DEF_ENABLED
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                STRING FAST NUMBER FORMAT CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_STR_CFG_FMT_FAST_EN to enable/disable table-driven integer formatting in
+*               Str_FmtNbr_Int32U() & Str_FmtNbr_Int32S().
+*
+*               See also 'lib_str.h  STRING FAST NUMBER FORMAT CONFIGURATION  Note #1'.
+*
+*           (2) May be overridden on the compiler command line (see 'lib_str_bench.c  Note #1').
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_STR_CFG_FMT_FAST_EN                                /* Enable/disable fast integer to string functions.     */
+#define  LIB_STR_CFG_FMT_FAST_EN                DEF_ENABLED
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     MATH LIBRARY CONFIGURATION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                 MATH DSP INSTRUCTION CONFIGURATION
+*
+* Note(s) : (1) Configure LIB_MATH_CFG_OPTIMIZE_DSP_EN to enable/disable DSP instruction intrinsics
+*               (SMLALD, SSAT) in fixed-point math function(s).
+*
+*               See also 'lib_math.h  MATH DSP INSTRUCTION CONFIGURATION  Note #1'.
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_MATH_CFG_OPTIMIZE_DSP_EN                           /* Enable/disable DSP intrinsic math functions.         */
+#define  LIB_MATH_CFG_OPTIMIZE_DSP_EN           DEF_ENABLED
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
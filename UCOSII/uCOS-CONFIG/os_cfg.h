@@ -30,6 +30,8 @@
 #define OS_APP_HOOKS_EN           1u   /* Application-defined hooks are called from the uC/OS-II hooks */
 #define OS_ARG_CHK_EN             0u   /* Enable (1) or Disable (0) argument checking                  */
 #define OS_CPU_HOOKS_EN           1u   /* uC/OS-II hooks are found in the processor port files         */
+#define OS_LIB_MEM_EN             1u   /* OS_MemClr()/OS_MemCopy() use uC-LIB Mem_Clr()/Mem_Copy()     */
+#define OS_INT_DIS_MEAS_EN        1u   /* Measure interrupts disabled time per OS_EXIT_CRITICAL() site */
 
 #define OS_DEBUG_EN               0u   /* Enable(1) debug variables                                    */
 
@@ -52,6 +52,10 @@
 #define  OS_CPU_EXCEPT_STK_SIZE    128u          /* Default exception stack size is 128 OS_STK entries */
 #endif
 
+#ifndef  OS_CPU_INT_DIS_MEAS_SITE_NBR
+#define  OS_CPU_INT_DIS_MEAS_SITE_NBR   32u      /* Nbr of critical section sites tracked              */
+#endif
+
 /*
 *********************************************************************************************************
 *                                               DEFINES
@@ -132,15 +136,25 @@ typedef unsigned int   OS_CPU_SR;                /* Define size of CPU status re
 *             disable interrupts.  'cpu_sr' is allocated in all of uC/OS-II's functions that need to
 *             disable interrupts.  You would restore the interrupt disable state by copying back 'cpu_sr'
 *             into the CPU's status register.
+*
+* Note(s) : (1) When OS_INT_DIS_MEAS_EN is enabled, the time interrupts stay disabled is measured with the
+*               DWT cycle counter for every outermost critical section (i.e. 'cpu_sr' shows that PRIMASK
+*               was clear on entry).  The maximum is recorded per OS_EXIT_CRITICAL() call site, identified
+*               by __FILE__ & __LINE__, in OS_CPU_IntDisSiteTbl[].
 *********************************************************************************************************
 */
 
 #define  OS_CRITICAL_METHOD   3u
 
 #if OS_CRITICAL_METHOD == 3u
+#if OS_INT_DIS_MEAS_EN > 0u                       /* See Note #1                                       */
+#define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save(); OS_CPU_IntDisMeasStart(cpu_sr);}
+#define  OS_EXIT_CRITICAL()   {OS_CPU_IntDisMeasStop(cpu_sr, __FILE__, __LINE__); OS_CPU_SR_Restore(cpu_sr);}
+#else
 #define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save();}
 #define  OS_EXIT_CRITICAL()   {OS_CPU_SR_Restore(cpu_sr);}
 #endif
+#endif
 
 
 /*
@@ -163,6 +177,21 @@ typedef unsigned int   OS_CPU_SR;                /* Define size of CPU status re
 OS_CPU_EXT  OS_STK   OS_CPU_ExceptStk[OS_CPU_EXCEPT_STK_SIZE];
 OS_CPU_EXT  OS_STK  *OS_CPU_ExceptStkBase;
 
+#if OS_INT_DIS_MEAS_EN > 0u
+typedef  struct  os_cpu_int_dis_site {
+    const  char  *FileName;                       /* File name of the OS_EXIT_CRITICAL() call site     */
+    INT32U        Line;                           /* Line  nbr of the OS_EXIT_CRITICAL() call site     */
+    INT32U        Ctr;                            /* Nbr of critical sections measured at this site    */
+    INT32U        MaxCnts;                        /* Max ints disabled time, in DWT CYCCNT counts      */
+} OS_CPU_INT_DIS_SITE;
+
+OS_CPU_EXT  OS_CPU_INT_DIS_SITE  OS_CPU_IntDisSiteTbl[OS_CPU_INT_DIS_MEAS_SITE_NBR];
+OS_CPU_EXT  INT32U               OS_CPU_IntDisSiteNbr;  /* Nbr of entries used in OS_CPU_IntDisSiteTbl[] */
+OS_CPU_EXT  INT32U               OS_CPU_IntDisSiteOvf;  /* Nbr of measurements lost, table full          */
+OS_CPU_EXT  INT32U               OS_CPU_IntDisMaxCnts;  /* Overall max ints disabled time               */
+OS_CPU_EXT  INT32U               OS_CPU_IntDisStartCnts;/* CYCCNT when outermost section was entered    */
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -185,6 +214,14 @@ void  OS_CPU_PendSVHandler   (void);
 void  OS_CPU_SysTickHandler  (void);
 void  OS_CPU_SysTickInit     (INT32U    cnts);
 
+#if OS_INT_DIS_MEAS_EN > 0u
+void  OS_CPU_IntDisMeasInit  (void);
+void  OS_CPU_IntDisMeasStart (OS_CPU_SR  cpu_sr);
+void  OS_CPU_IntDisMeasStop  (OS_CPU_SR  cpu_sr,
+                              const  char  *p_file,
+                              INT32U     line);
+#endif
+
 #if (OS_CPU_ARM_FP_EN > 0u)
 void  OS_CPU_FP_Reg_Push     (OS_STK   *stkPtr);
 void  OS_CPU_FP_Reg_Pop      (OS_STK   *stkPtr);
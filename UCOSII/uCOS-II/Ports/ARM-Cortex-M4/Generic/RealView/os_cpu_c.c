@@ -87,6 +87,20 @@ static  INT16U  OSTmrCtr;
 #define  OS_CPU_CM4_NVIC_PRIO_MIN                               0xFFu    /* Min handler prio.          */
 
 
+/*
+*********************************************************************************************************
+*                                       DWT CYCLE COUNTER DEFINES
+*********************************************************************************************************
+*/
+
+#define  OS_CPU_CM4_DEMCR           (*((volatile INT32U *)0xE000EDFCuL)) /* Debug Exception & Monitor Ctrl.      */
+#define  OS_CPU_CM4_DWT_CTRL        (*((volatile INT32U *)0xE0001000uL)) /* DWT Control Reg.           */
+#define  OS_CPU_CM4_DWT_CYCCNT      (*((volatile INT32U *)0xE0001004uL)) /* DWT Cycle Count Reg.       */
+
+#define  OS_CPU_CM4_DEMCR_TRCENA                          0x01000000uL   /* Trace enable.              */
+#define  OS_CPU_CM4_DWT_CTRL_CYCCNTENA                    0x00000001uL   /* Cycle counter enable.      */
+
+
 /*
 *********************************************************************************************************
 *                                       OS INITIALIZATION HOOK
@@ -120,6 +134,10 @@ void  OSInitHookBegin (void)
 #if OS_TMR_EN > 0u
     OSTmrCtr = 0u;
 #endif
+
+#if OS_INT_DIS_MEAS_EN > 0u
+    OS_CPU_IntDisMeasInit();
+#endif
 }
 #endif
 
@@ -509,3 +527,135 @@ void  OS_CPU_SysTickInit (INT32U  cnts)
                                                             /* Enable timer interrupt.                                */
     OS_CPU_CM4_NVIC_ST_CTRL |= OS_CPU_CM4_NVIC_ST_CTRL_INTEN;
 }
+
+
+/*
+*********************************************************************************************************
+*                              INITIALIZE INTERRUPTS DISABLED TIME MEASUREMENT
+*
+* Description: Clear the per call site interrupts disabled time table & start the DWT cycle counter.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) The cycle counter is NOT reset; other modules (e.g. the boot profiler, CPU_TS) may
+*                 already be using it.
+*
+*              2) Also called by the application to restart the measurement.  Interrupts are disabled
+*                 while the table is cleared.
+*********************************************************************************************************
+*/
+
+#if OS_INT_DIS_MEAS_EN > 0u
+void  OS_CPU_IntDisMeasInit (void)
+{
+    INT32U     i;
+    OS_CPU_SR  cpu_sr;
+
+
+    OS_CPU_CM4_DEMCR    |= OS_CPU_CM4_DEMCR_TRCENA;
+    OS_CPU_CM4_DWT_CTRL |= OS_CPU_CM4_DWT_CTRL_CYCCNTENA;
+
+    cpu_sr = OS_CPU_SR_Save();                              /* Not OS_ENTER_CRITICAL(): must not measure itself.      */
+    for (i = 0u; i < OS_CPU_INT_DIS_MEAS_SITE_NBR; i++) {
+        OS_CPU_IntDisSiteTbl[i].FileName = (const char *)0;
+        OS_CPU_IntDisSiteTbl[i].Line     = 0u;
+        OS_CPU_IntDisSiteTbl[i].Ctr      = 0u;
+        OS_CPU_IntDisSiteTbl[i].MaxCnts  = 0u;
+    }
+    OS_CPU_IntDisSiteNbr   = 0u;
+    OS_CPU_IntDisSiteOvf   = 0u;
+    OS_CPU_IntDisMaxCnts   = 0u;
+    OS_CPU_IntDisStartCnts = OS_CPU_CM4_DWT_CYCCNT;
+    OS_CPU_SR_Restore(cpu_sr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                               START INTERRUPTS DISABLED TIME MEASUREMENT
+*
+* Description: Called by OS_ENTER_CRITICAL() right after interrupts have been disabled.
+*
+* Arguments  : cpu_sr       Value of PRIMASK before the critical section was entered.
+*
+* Note(s)    : 1) Nested critical sections are not timed; only the outermost one is (PRIMASK clear on
+*                 entry).
+*********************************************************************************************************
+*/
+
+#if OS_INT_DIS_MEAS_EN > 0u
+void  OS_CPU_IntDisMeasStart (OS_CPU_SR  cpu_sr)
+{
+    if ((cpu_sr & 1u) == 0u) {
+        OS_CPU_IntDisStartCnts = OS_CPU_CM4_DWT_CYCCNT;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                STOP INTERRUPTS DISABLED TIME MEASUREMENT
+*
+* Description: Called by OS_EXIT_CRITICAL() right before interrupts are re-enabled.  Records the time
+*              interrupts were disabled against the call site.
+*
+* Arguments  : cpu_sr       Value of PRIMASK before the critical section was entered.
+*
+*              p_file       Pointer to the call site file name (__FILE__).
+*
+*              line         Call site line number (__LINE__).
+*
+* Note(s)    : 1) Call sites are matched on the file name pointer; the compiler merges identical
+*                 __FILE__ strings within a translation unit.
+*
+*              2) When the table is full, measurements from new sites only update the overall maximum
+*                 & OS_CPU_IntDisSiteOvf.
+*********************************************************************************************************
+*/
+
+#if OS_INT_DIS_MEAS_EN > 0u
+void  OS_CPU_IntDisMeasStop (OS_CPU_SR     cpu_sr,
+                             const  char  *p_file,
+                             INT32U        line)
+{
+    INT32U                cnts;
+    INT32U                i;
+    OS_CPU_INT_DIS_SITE  *p_site;
+
+
+    if ((cpu_sr & 1u) != 0u) {                              /* Nested section, interrupts stay disabled.              */
+        return;
+    }
+
+    cnts = OS_CPU_CM4_DWT_CYCCNT - OS_CPU_IntDisStartCnts;
+    if (cnts > OS_CPU_IntDisMaxCnts) {
+        OS_CPU_IntDisMaxCnts = cnts;
+    }
+
+    p_site = &OS_CPU_IntDisSiteTbl[0];
+    for (i = 0u; i < OS_CPU_IntDisSiteNbr; i++) {
+        if ((p_site->Line     == line) &&
+            (p_site->FileName == p_file)) {
+            break;
+        }
+        p_site++;
+    }
+
+    if (i == OS_CPU_IntDisSiteNbr) {                        /* New call site.                                         */
+        if (i >= OS_CPU_INT_DIS_MEAS_SITE_NBR) {
+            OS_CPU_IntDisSiteOvf++;
+            return;
+        }
+        p_site->FileName = p_file;
+        p_site->Line     = line;
+        OS_CPU_IntDisSiteNbr++;
+    }
+
+    p_site->Ctr++;
+    if (cnts > p_site->MaxCnts) {
+        p_site->MaxCnts = cnts;
+    }
+}
+#endif
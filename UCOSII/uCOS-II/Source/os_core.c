@@ -28,6 +28,10 @@
 #include <ucos_ii.h>
 #endif
 
+#if OS_LIB_MEM_EN > 0u
+#include <lib_mem.h>
+#endif
+
 /*
 *********************************************************************************************************
 *                                      PRIORITY RESOLUTION TABLE
@@ -1594,18 +1598,24 @@ static  void  OS_InitTCBList (void)
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Note that we can only clear up to 64K bytes of RAM.  This is not an issue because none
 *                 of the uses of this function gets close to this limit.
-*              3) The clear is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the destination.
+*              3) When OS_LIB_MEM_EN is enabled the clear is delegated to uC-LIB's Mem_Clr() which fills
+*                 the aligned part of the block a CPU word at a time.  Otherwise the clear is done one
+*                 byte at a time since this will work on any processor irrespective of the alignment of
+*                 the destination.
 *********************************************************************************************************
 */
 
 void  OS_MemClr (INT8U  *pdest,
                  INT16U  size)
 {
+#if OS_LIB_MEM_EN > 0u
+    Mem_Clr((void *)pdest, (CPU_SIZE_T)size);
+#else
     while (size > 0u) {
         *pdest++ = (INT8U)0;
         size--;
     }
+#endif
 }
 /*$PAGE*/
 /*
@@ -1627,8 +1637,10 @@ void  OS_MemClr (INT8U  *pdest,
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
 *              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              3) When OS_LIB_MEM_EN is enabled the copy is delegated to uC-LIB's Mem_Copy() (assembly
+*                 optimized when LIB_MEM_CFG_OPTIMIZE_ASM_EN is enabled).  Otherwise the copy is done one
+*                 byte at a time since this will work on any processor irrespective of the alignment of
+*                 the source and destination.
 *********************************************************************************************************
 */
 
@@ -1636,10 +1648,14 @@ void  OS_MemCopy (INT8U  *pdest,
                   INT8U  *psrc,
                   INT16U  size)
 {
+#if OS_LIB_MEM_EN > 0u
+    Mem_Copy((void *)pdest, (void *)psrc, (CPU_SIZE_T)size);
+#else
     while (size > 0u) {
         *pdest++ = *psrc++;
         size--;
     }
+#endif
 }
 /*$PAGE*/
 /*
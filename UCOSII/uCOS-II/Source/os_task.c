@@ -27,6 +27,10 @@
 #include <ucos_ii.h>
 #endif
 
+#if OS_LIB_MEM_EN > 0u
+#include <lib_mem.h>
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1316,6 +1320,8 @@ void  OS_TaskReturn (void)
 *                       specific.  See OS_TASK_OPT_??? in uCOS-II.H.
 *
 * Returns    : none
+*
+* Note       : When OS_LIB_MEM_EN is enabled the stack is cleared with uC-LIB's Mem_Clr().
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
@@ -1325,7 +1331,13 @@ void  OS_TaskStkClr (OS_STK  *pbos,
 {
     if ((opt & OS_TASK_OPT_STK_CHK) != 0x0000u) {      /* See if stack checking has been enabled       */
         if ((opt & OS_TASK_OPT_STK_CLR) != 0x0000u) {  /* See if stack needs to be cleared             */
+#if OS_LIB_MEM_EN > 0u
 #if OS_STK_GROWTH == 1u
+            Mem_Clr((void *)pbos, (CPU_SIZE_T)(size * sizeof(OS_STK)));
+#else
+            Mem_Clr((void *)(pbos - size + 1u), (CPU_SIZE_T)(size * sizeof(OS_STK)));
+#endif
+#elif OS_STK_GROWTH == 1u
             while (size > 0u) {                        /* Stack grows from HIGH to LOW memory          */
                 size--;
                 *pbos++ = (OS_STK)0;                   /* Clear from bottom of stack and up!           */
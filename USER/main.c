@@ -14,6 +14,17 @@
 #include "pcf8574.h"
 #include "rs485.h"
 #include "fdcan.h"
+#include "bootprof.h"
+#include "isrmon.h"
+#include "log.h"
+#include "memmon.h"
+#include "xfer.h"
+#include "modbus.h"
+#include "mbpoll.h"
+#include "isotp.h"
+#include "canlog.h"
+#include "canopen.h"
+#include "gateway.h"
 /************************************************
 ҪʵֵĹܣ
 1.ֱʵIICQSPIEEROMFLASHĶд  							
@@ -31,14 +42,243 @@ u8 TEXT_Buffer[16] = {0};
 // const u8 Refresh[16] = {0};
 #define SIZE sizeof(TEXT_Buffer) 
 u32 flashsize=32*1024*1024;
-u8 buffer[16];
+u8 buffer[SERIAL2_RX_LEN];		//RS485_Receive_DataдSERIAL2_RX_LENֽ
+
+//ΪModbus RTUվļĴ:ּĴ0/1ӦLED0/LED1(дʱLED),Ĵ0Ϊ
+#define MB_SLAVE_ADDR		1		//վַ,0Ϊվ
+u16 mb_holding[2];
+u16 mb_input[1];
+u8 mb_led_write(u16 addr,u16 num)
+{
+	LED0(mb_holding[0]!=0);
+	LED1(mb_holding[1]!=0);
+	return 0;
+}
+const _mb_map mb_map[]=
+{
+	{MB_HOLDING,0,2,mb_holding,mb_led_write},
+	{MB_INPUT,0,1,mb_input,NULL},
+};
+
+//ΪModbusվѯ:ڶȡԶ˰ӵĴ0()ͱּĴ0/1(LED״̬)
+#define MB_PEER_ADDR		0		//Զ˴վַ,0ѯ
+u16 mb_peer_input[1];
+u16 mb_peer_holding[2];
+_mbpoll_node mb_poll[]=
+{
+	{MB_PEER_ADDR,MB_FC_READ_HOLDING,0,2,mb_peer_holding,100,0,50},
+	{MB_PEER_ADDR,MB_FC_READ_INPUT,0,1,mb_peer_input,1000,1,50},
+};
+
+//CAN:λʱFDCAN1_Init_Rate
+#define CAN_BITRATE			500000	//
+#define CAN_SP				800		//(0.1%)
+#define CAN_AUTOBAUD		0		//1,ϵʱԶⲨ(ҪڵڷͺӦ,2),û⵽CAN_BITRATE
+#if CAN_AUTOBAUD
+const u32 can_rates[]={500000,250000,1000000,125000,800000,100000,50000,20000,10000};
+#endif
+
+//ISO-TP:Զ0x7E0ϢֱдW25QXX16MB,W25QXX0x7E8ȥ
+#define TP_FLASH_ADDR		0x01000000	//ISO-TPϢW25QXXĵַ
+#if FDCAN1_FD_EN
+#define TP_FLAGS			(TP_F_FD|TP_F_BRS)
+#define TP_DL				64
+#else
+#define TP_FLAGS			0
+#define TP_DL				8
+#endif
+void tp_echo_done(_tp_link *l,u8 dir,u8 err)
+{
+	printf("isotp %s %u bytes, err %d\r\n",dir==TP_DIR_RX?"receive":"send",dir==TP_DIR_RX?l->rx_len:l->tx_len,err);
+	if(dir==TP_DIR_RX&&err==TP_OK&&ISOTP_Send(l,l->rx_len))printf("isotp echo busy\r\n");
+}
+_tp_link tp_echo=
+{
+	0x7E8,0x7E0,TP_FLAGS,TP_DL,8,0,0xCC,1024*1024,
+	NULL,ISOTP_FlashRead,ISOTP_FlashWrite,tp_echo_done,NULL,NULL,TP_FLASH_ADDR
+};
+_fdcan_frame can_frame;		//can_taskյ֡,ջ
+
+//CANopenڵ:TPDO1İ(仯ʱ,ֹʱ10ms,ÿһ),
+//RPDO1նԶ˰ӵTPDO1;0x2001ΪLED״̬,SDOд(bitΪ1ʱ);ӵCO_NODE_ID/CO_PEER_ID
+#define CO_NODE_ID			1		//ڵ
+#define CO_PEER_ID			2		//Զ˽ڵ,0նԶ˵PDO
+#define CO_HB_TIME			500		//(ms)
+u8 co_key;					//0x2000:İ
+u8 co_led;					//0x2001:bit0 LED0,bit1 LED1
+u32 co_uptime;				//0x2002:
+u8 co_peer_key;				//0x2100:Զİ
+u32 co_peer_uptime;			//0x2101:Զ˵
+const u32 co_devtype=0;		//0x1000:û豸Э
+const u32 co_vendor=0;		//0x1018:1 ID
+const u8 co_sub1=1,co_sub2=2,co_sub5=5;	//¼
+_co_pdo_cfg co_tpdo[1]=
+{
+	{0x180+CO_NODE_ID,CO_PDO_EVENT,100,1000,2,{CO_MAP_ENTRY(0x2000,0,8),CO_MAP_ENTRY(0x2002,0,32)}},
+};
+_co_pdo_cfg co_rpdo[1]=
+{
+	{CO_PEER_ID?0x180+CO_PEER_ID:CO_PDO_OFF,CO_PDO_EVENT,0,0,2,{CO_MAP_ENTRY(0x2100,0,8),CO_MAP_ENTRY(0x2101,0,32)}},
+};
+_co_hbc co_hbc[1]={{CO_PEER_ID,CO_HB_TIME*3}};
+extern _co_node co_node;
+const _co_entry co_od[]=
+{
+	CO_VAR(0x1000,0,CO_RO,co_devtype),
+	CO_VAR(0x1001,0,CO_RO,co_node.err),
+	CO_STR(0x1008,0,"STM32H743 CANopen-lite"),
+	CO_VAR(0x1017,0,CO_RW,co_node.hb_time),
+	CO_VAR(0x1018,0,CO_RO,co_sub1),
+	CO_VAR(0x1018,1,CO_RO,co_vendor),
+	CO_VAR(0x1400,0,CO_RO,co_sub2),
+	CO_VAR(0x1400,1,CO_RW,co_rpdo[0].cob),
+	CO_VAR(0x1400,2,CO_RW,co_rpdo[0].type),
+	CO_VAR(0x1600,0,CO_RO,co_rpdo[0].num),
+	CO_VAR(0x1600,1,CO_RO,co_rpdo[0].map[0]),
+	CO_VAR(0x1600,2,CO_RO,co_rpdo[0].map[1]),
+	CO_VAR(0x1800,0,CO_RO,co_sub5),
+	CO_VAR(0x1800,1,CO_RW,co_tpdo[0].cob),
+	CO_VAR(0x1800,2,CO_RW,co_tpdo[0].type),
+	CO_VAR(0x1800,3,CO_RW,co_tpdo[0].inhibit),
+	CO_VAR(0x1800,5,CO_RW,co_tpdo[0].event),
+	CO_VAR(0x1A00,0,CO_RO,co_tpdo[0].num),
+	CO_VAR(0x1A00,1,CO_RO,co_tpdo[0].map[0]),
+	CO_VAR(0x1A00,2,CO_RO,co_tpdo[0].map[1]),
+	CO_VAR(0x2000,0,CO_RO|CO_MAP,co_key),
+	CO_VAR(0x2001,0,CO_RW,co_led),
+	CO_VAR(0x2002,0,CO_RO|CO_MAP,co_uptime),
+	CO_VAR(0x2100,0,CO_RW|CO_MAP,co_peer_key),
+	CO_VAR(0x2101,0,CO_RW|CO_MAP,co_peer_uptime),
+};
+void co_write_done(_co_node *co,const _co_entry *e)
+{
+	if(e->index!=0x2001)return;
+	LED0(!(co_led&0x01));
+	LED1(!(co_led&0x02));
+}
+void co_rpdo_done(_co_node *co,u8 n)
+{
+	printf("CANopen peer key %d, up %us\r\n",co_peer_key,co_peer_uptime);
+}
+void co_hb_change(_co_node *co,u8 node,u8 state)
+{
+	if(state==CO_HB_LOST)printf("CANopen node %d lost\r\n",node);
+	else printf("CANopen node %d state %#x\r\n",node,state);
+}
+_co_node co_node=
+{
+	CO_NODE_ID,1,CO_HB_TIME,co_od,sizeof(co_od)/sizeof(co_od[0]),co_tpdo,1,co_rpdo,1,co_hbc,CO_PEER_ID?1:0,
+	NULL,NULL,co_rpdo_done,co_write_done,co_hb_change,NULL
+};
+
+//֡:뷢Ͷ,CAN_KEY_TIMEOUT msû(ûнսڵӦæ)ʧ
+#define CAN_KEY_TIMEOUT		100
+#define CAN_KEY_IDLE		0xFF
+volatile u8 can_key_status=CAN_KEY_IDLE;	//֡ķͽ,FDCAN1_TX_xxx
+void can_key_done(void *arg,u8 status,u16 ts)
+{
+	can_key_status=status;		//ж,can_task
+}
+
+//RS485<->CAN·ɱ:RS485ַ0x40~0x4F֡ȥַCAN 0x6A0~0x6AF,
+//CAN 0x6C0~0x6CF֡ϵַ0x40~0x4FRS485;֡ת,վɽModbus/CANopen/
+//ΧCANopenԤCOB-ID;ͬʱʱ෴IDͬ,ת
+#define GW_ROUTE_EN			1		//0,ת
+const _gw_rule gw_rules[]=
+{
+	{GW_BUS_RS485,GW_BUS_CAN,GW_X_ADDR,0,0x40,0xF0,0x660},
+	{GW_BUS_CAN,GW_BUS_RS485,GW_X_ADDR,0,0x6C0,0x7F0,0x680},
+};
 
 OS_EVENT * msg_key;			//¼ָ
 OS_EVENT * sem_buf;			//źָ
 
+//ӳٳʼ:0,mainOSInit֮ǰʼ;
+//			 1,AT24CXX/W25QXX/RS485/FDCANŵOSStart֮start_taskʼ,
+//			   RS485_InitPCF857410msȴOSʱ,ں˿Ը翪ʼ
+#define BOOT_DEFER_INIT		0
+
 void clear_buffer()
 {
-	memset(buffer,0,16*sizeof(u8));
+	memset(buffer,0,sizeof(buffer));
+}
+
+//ʼ,BOOT_DEFER_INITΪ1ʱstart_taskе
+void periph_init(void)
+{
+	AT24CXX_Init();					//ʼAT24CXX
+	BOOTPROF_Mark("AT24CXX_Init");
+	W25QXX_Init();		            //ʼW25QXX
+	BOOTPROF_Mark("W25QXX_Init");
+	RS485_Init(9600);				//ʼRS485
+	MODBUS_Init(9600);				//3.5ַ֡
+	MODBUS_Slave(MB_SLAVE_ADDR,mb_map,sizeof(mb_map)/sizeof(mb_map[0]));
+	MBPOLL_Init(mb_poll,MB_PEER_ADDR?sizeof(mb_poll)/sizeof(mb_poll[0]):0,OSTimeGet());
+	BOOTPROF_Mark("RS485_Init");
+#if CAN_AUTOBAUD
+	if(FDCAN1_AutoBaud(can_rates,sizeof(can_rates)/sizeof(can_rates[0]),CAN_SP,200,2000,FDCAN_MODE_NORMAL)==0)
+#endif
+	FDCAN1_Init_Rate(CAN_BITRATE,CAN_SP,FDCAN_MODE_NORMAL);
+	ISOTP_Open(&tp_echo);
+	if(CANOPEN_Open(&co_node))printf("canopen: bad object dictionary\r\n");
+	if(GATEWAY_Init(gw_rules,GW_ROUTE_EN?sizeof(gw_rules)/sizeof(gw_rules[0]):0))printf("gateway: no memory\r\n");
+	BOOTPROF_Mark("FDCAN1_Mode_Init");
+	if(CANLOG_Init())printf("canlog: no memory\r\n");	//ɨW25QXXļ¼,ʼ¼CAN֡
+	BOOTPROF_Mark("CANLOG_Init");
+}
+
+//:"stats"жӳͳ,"stats reset"ͳ,"bench"Ըʽٶ,"mem"ڴʹ,
+//"uart"1ʹ2(RS485)շʹ,"rs485"RS485շлʱ,"modbus"Modbusͳ,"mbpoll"ѯͳ,"can"CANշͳơ״̬͸,"isotp"ISO-TPͳ,
+//"canopen"CANopenڵ״̬,"gateway"ÿ·ɵͳ,"canlog"CAN¼ͳ,"canlog dump"/"canlog asc"candump/ASCʽ¼,"canlog erase"¼,"xfer"ƴͳ
+//֡,main_taskXFER_Poll
+//EEPROM/FLASHд
+void usart_cmd(void)
+{
+	u8 *line;
+	u16 len;
+	line=usart_rx_peek(&len);
+	if(line==NULL)return;
+	if(len==5&&memcmp(line,"stats",5)==0)ISRMON_Report();
+	else if(len==11&&memcmp(line,"stats reset",11)==0)ISRMON_Reset();
+	else if(len==4&&memcmp(line,"uart",4)==0)
+	{
+		SERIAL_Stat(SERIAL1);
+		SERIAL_Stat(SERIAL2);
+	}
+	else if(len==5&&memcmp(line,"rs485",5)==0)RS485_Report();
+	else if(len==6&&memcmp(line,"modbus",6)==0)MODBUS_Report();
+	else if(len==6&&memcmp(line,"mbpoll",6)==0)MBPOLL_Report();
+	else if(len==3&&memcmp(line,"can",3)==0)FDCAN1_Report();
+	else if(len==5&&memcmp(line,"isotp",5)==0)ISOTP_Report();
+	else if(len==7&&memcmp(line,"canopen",7)==0)CANOPEN_Report();
+	else if(len==7&&memcmp(line,"gateway",7)==0)GATEWAY_Report();
+	else if(len==6&&memcmp(line,"canlog",6)==0)CANLOG_Report();
+	else if(len==11&&memcmp(line,"canlog dump",11)==0)CANLOG_Export(CANLOG_FMT_CANDUMP);
+	else if(len==10&&memcmp(line,"canlog asc",10)==0)CANLOG_Export(CANLOG_FMT_ASC);
+	else if(len==12&&memcmp(line,"canlog erase",12)==0)CANLOG_Erase();
+	else if(len==4&&memcmp(line,"xfer",4)==0)XFER_Report();
+#if MEMMON_EN
+	else if(len==3&&memcmp(line,"mem",3)==0)MEMMON_Report();
+#endif
+#if LOG_BENCH_EN
+	else if(len==5&&memcmp(line,"bench",5)==0)log_bench();
+#endif
+	else return;
+	usart_rx_pop(line);
+}
+
+//ȡյһ,ضϻ0SIZEֽ
+//ֵ:,NULLʾûյ,usart_rx_popͷ
+u8 *usart_get_text(u8 *text)
+{
+	u8 *line;
+	u16 len;
+	line=usart_rx_peek(&len);
+	if(line==NULL)return NULL;
+	if(len>SIZE)len=SIZE;
+	memset(text,0,SIZE);
+	memcpy(text,line,len);
+	return line;
 }
 
 /////////////////////////UCOSII///////////////////////////////////
@@ -51,6 +291,12 @@ void clear_buffer()
 OS_STK START_TASK_STK[START_STK_SIZE];
 //
 void start_task(void *pdata);	
+
+//CAN¼,дFLASHʱæȴ,ȼ
+#define CANLOG_TASK_PRIO				11
+#define CANLOG_STK_SIZE					256
+OS_STK CANLOG_TASK_STK[CANLOG_STK_SIZE];
+void canlog_task(void *pdata);
  			   
 //LED
 //ȼ
@@ -83,12 +329,12 @@ OS_STK SEND_TASK_STK[SEND_STK_SIZE];
 void send_task(void *pdata);
 
 #define CAN_TASK_PRIO			4
-#define CAN_STK_SIZE			128
+#define CAN_STK_SIZE			256
 OS_STK CAN_TASK_STK[CAN_STK_SIZE];
 void can_task(void *pdata);
 
 #define RS485_TASK_PRIO			3
-#define RS485_STK_SIZE			128
+#define RS485_STK_SIZE			256
 OS_STK RS485_TASK_STK[RS485_STK_SIZE];
 void rs485_task(void *pdata);
 
@@ -102,25 +348,37 @@ void main_task(void *pdata);
 OS_STK KEY_TASK_STK[KEY_STK_SIZE];
 void key_task(void *pdata);
 
+//ʹĸ:MAIN_TASK_PRIO/RS485_TASK_PRIO/CAN_TASK_PRIO
+//RS485CANһֱ(շModbusCANopenת),WKUPKEY2ֻл֡߷
+volatile u8 key_owner=MAIN_TASK_PRIO;
+
 
 //////////////////////////////////////////////////////////////////////////////
 
 int main(void)
 {
+	BOOTPROF_Init();				//ʼͳʱ
 	Cache_Enable();                 //L1-Cache
+	BOOTPROF_Mark("Cache_Enable");
 	HAL_Init();				        //ʼHAL
+	BOOTPROF_Mark("HAL_Init");
 	Stm32_Clock_Init(160,5,2,4);    //ʱ,400Mhz 
+	BOOTPROF_Mark("Stm32_Clock_Init");
 	delay_init(400);				//ʱʼ
-	uart_init(115200);				//ڳʼ
+	ISRMON_Init();					//жӳͳƳʼ
+	Mem_Init();						//uC-LIBڴʼ
+	MEMMON_Init();					//ڴʹͳƳʼ
+	uart_init(115200);				//ڳʼ,ƴʱBAUDлߵĲ
+	XFER_Init();					//ƴЭʼ
     LED_Init();                     //ʼLED
     KEY_Init();                     //ʼ
-	AT24CXX_Init();					//ʼAT24CXX
-	W25QXX_Init();		            //ʼW25QXX
-	RS485_Init(9600);				//ʼRS485
-	FDCAN1_Mode_Init(10,8,31,8,FDCAN_MODE_NORMAL); //ػ
+	BOOTPROF_Mark("uart/LED/KEY");
+#if !BOOT_DEFER_INIT
+	periph_init();					//ʼ
+#endif
 	
 	OSInit();                       //UCOSʼ
-
+	BOOTPROF_Mark("OSInit");
 	
     OSTaskCreateExt((void(*)(void*) )start_task,                //
                     (void*          )0,                         //ݸĲ
@@ -131,6 +389,7 @@ int main(void)
                     (INT32U         )START_STK_SIZE,            //ջС
                     (void*          )0,                         //ûĴ洢
                     (INT16U         )OS_TASK_OPT_STK_CHK|OS_TASK_OPT_STK_CLR|OS_TASK_OPT_SAVE_FP);//ѡ,Ϊ˱񶼱渡Ĵֵ
+	BOOTPROF_Mark("start_task create");
 	OSStart(); //ʼ
 }
 
@@ -138,13 +397,17 @@ int main(void)
 //ʼ
 void start_task(void *pdata)
 {
-	OS_CPU_SR cpu_sr=0; 
 	pdata=pdata;
+	BOOTPROF_Mark("OSStart");
 	printf("task started\n\r");
+#if BOOT_DEFER_INIT
+	periph_init();					//OSѾʼ,ٳʼ
+#endif
 	msg_key=OSMboxCreate((void*)0);	//Ϣ
 	sem_buf=OSSemCreate(1);
 	OSStatInit();  //ͳ
-	OS_ENTER_CRITICAL();  //ٽ(رж)
+	BOOTPROF_Mark("OSStatInit");
+	OSSchedLock();		//,ڼ䲻л,ж
     //LED
     OSTaskCreateExt((void(*)(void*) )led_task,                 
                     (void*          )0,
@@ -236,14 +499,25 @@ void start_task(void *pdata)
                     (void*          )0,                         
                     (INT16U         )OS_TASK_OPT_STK_CHK|OS_TASK_OPT_STK_CLR|OS_TASK_OPT_SAVE_FP);
 
+	OSTaskCreateExt((void(*)(void*)	)canlog_task,
+					(void*			)0,
+					(OS_STK*		)&CANLOG_TASK_STK[CANLOG_STK_SIZE-1],
+					(INT8U			)CANLOG_TASK_PRIO,
+					(INT16U			)CANLOG_TASK_PRIO,
+					(OS_STK*		)&CANLOG_TASK_STK[0],
+					(INT32U			)CANLOG_STK_SIZE,
+					(void*			)0,
+					(INT16U			)OS_TASK_OPT_STK_CHK|OS_TASK_OPT_STK_CLR|OS_TASK_OPT_SAVE_FP);
+
 	OSTaskSuspend(SR_TASK_PRIO);
 	OSTaskSuspend(SS_TASK_PRIO);
 	OSTaskSuspend(RECEIVE_TASK_PRIO);
 	OSTaskSuspend(SEND_TASK_PRIO);
-	OSTaskSuspend(CAN_TASK_PRIO);
-	OSTaskSuspend(RS485_TASK_PRIO);
+	BOOTPROF_Mark("task create");
 
-    OS_EXIT_CRITICAL();             //˳ٽ(ж)
+    OSSchedUnlock();                //
+	BOOTPROF_Report();				//ʱϸ
+	MEMMON_Map();					//ڴ沼
 	OSTaskSuspend(START_TASK_PRIO); //ʼ
 }
  
@@ -264,6 +538,15 @@ void led_task(void *pdata)
 	}									 
 }   
 
+//Ѽ¼CAN֡дW25QXX,¼
+void canlog_task(void *pdata)
+{
+	while(1)
+	{
+		OSTimeDly(CANLOG_Poll());
+	}
+}
+
 void key_task(void *pdata)
 {
 	u8 key;
@@ -282,6 +565,8 @@ void main_task(void *pdata)
 	while(1)
 	{
 		key=(u32)OSMboxPend(msg_key,10,&err);
+		usart_cmd();				//
+		XFER_Poll();				//ƴ֡
 		switch(key)
 		{
 			case KEY0_PRES:
@@ -305,7 +590,7 @@ void main_task(void *pdata)
 			case WKUP_PRES:
 				// printf("WKUP_PRES\n");
 				printf("MAIN_CTRL->rs485\n\r");
-				OSTaskResume(RS485_TASK_PRIO);
+				key_owner=RS485_TASK_PRIO;
 				OSTaskSuspend(MAIN_TASK_PRIO);
 				delay_ms(10);
 				break;
@@ -318,6 +603,8 @@ void main_task(void *pdata)
 
 void receive_task(void *pdata)
 {
+	u8 text[SIZE];
+	u8 *line;
 	int i;
 	printf("USART_ISR_EOBF=%X\n",(USART1->ISR&USART_ISR_EOBF)>>12);
 	while(1)
@@ -328,22 +615,24 @@ void receive_task(void *pdata)
 			delay_ms(1000);
 			LED0_Toggle;
 		}
-		//UARTյ
-		if(USART_RX_STA&0x8000)
+		//UARTյһ
+		line=usart_get_text(text);
+		if(line!=NULL)
 		{
 			printf("USART_ISR_EOBF=%X\n",(USART1->ISR&USART_ISR_EOBF)>>12);
 			//յдEEROM
-			AT24CXX_Write(0,(u8*)USART_RX_BUF,SIZE);
+			AT24CXX_Write(0,text,SIZE);
 			printf("дEEPROM 24C02:");
 			i=0;
-			//UARTռĴеݴӡĻϣսռĴ
+			//յݴӡĻ
 			while(i<SIZE)
 			{
-				printf("%c",USART_RX_BUF[i]);
-				USART_RX_BUF[i]=USART_RX_BUF[i]&0;
+				printf("%c",text[i]);
 				i++;
 			}
 			printf("\n\r");
+			//ͷһ,һвܱȡ
+			usart_rx_pop(line);
 			//д룬ָ
 			OSTaskResume(SEND_TASK_PRIO);
 		}
@@ -364,10 +653,8 @@ void send_task(void *pdata)
 		AT24CXX_Read(0,(u8*)TEXT_Buffer,SIZE);
 		printf("EEPROM 24C02еΪ:\n");
 		//EEROMеͨڴӡĻ
-		HAL_UART_Transmit(&UART1_Handler,(uint8_t*)TEXT_Buffer,SIZE,1000);
+		usart_write(TEXT_Buffer,SIZE);
 		printf("\n\r");
-		//UART״̬ǣUSART_ISR_EOBFλ0
-		USART_RX_STA=0;
 		//񣬵ȴд
 		OSTaskSuspend(SEND_TASK_PRIO);
 	}
@@ -376,6 +663,8 @@ void send_task(void *pdata)
 
 void sr_task(void *pdata)
 {
+	u8 text[SIZE];
+	u8 *line;
 	int i;
 	while(1)
 	{
@@ -385,23 +674,24 @@ void sr_task(void *pdata)
 			delay_ms(1000);
 			LED0_Toggle;
 		}
-		//UARTյ
-		if(USART_RX_STA&0x8000)
+		//UARTյһ
+		line=usart_get_text(text);
+		if(line!=NULL)
 		{
-			//յʱISRĴĵ12λΪ1USART_RX_STA&0x8000ų
 			printf("USART_ISR_EOBF=%X\n",(USART1->ISR&USART_ISR_EOBF)>>12);
 			//յдFLASH
-			W25QXX_Write((u8*)USART_RX_BUF,flashsize-100,SIZE);
+			W25QXX_Write(text,flashsize-100,SIZE);
 			printf("дFLASH W25Q256:");
 			i=0;
-			//UARTռĴеݴӡĻϣսռĴ
+			//յݴӡĻ
 			while(i<SIZE)
 			{
-				printf("%c",USART_RX_BUF[i]);
-				USART_RX_BUF[i]=USART_RX_BUF[i]&0;
+				printf("%c",text[i]);
 				i++;
 			}
 			printf("\n\r");
+			//ͷһ,һвܱȡ
+			usart_rx_pop(line);
 			//д룬ָ
 			OSTaskResume(SS_TASK_PRIO);
 		}
@@ -422,10 +712,8 @@ void ss_task(void *pdata)
 		W25QXX_Read(TEXT_Buffer,flashsize-100,SIZE);
 		printf("FLASH W25Q256еΪ:\n");
 		//FLASHеͨڴӡĻ
-		HAL_UART_Transmit(&UART1_Handler,(uint8_t*)TEXT_Buffer,SIZE,1000);
+		usart_write(TEXT_Buffer,SIZE);
 		printf("\n\r");
-		//UART״̬ǣUSART_ISR_EOBFλ0
-		USART_RX_STA=0;
 		//񣬵ȴд
 		OSTaskSuspend(SS_TASK_PRIO);
 	}
@@ -433,11 +721,23 @@ void ss_task(void *pdata)
 
 void rs485_task(void *pdata)
 {
-	u32 key=0;
+	u32 key=0,wait,t;
 	u8 err;
 	while(1)
 	{
-		key=(u32)OSMboxPend(msg_key,10,&err);
+		wait=MBPOLL_Run(OSTimeGet());	//ύڵѯ
+		t=MODBUS_Poll();				//ŶӵModbus
+		if(t<wait)wait=t;
+		t=GATEWAY_Poll(GW_BUS_RS485);	//תRS485֡
+		if(t<wait)wait=t;
+		RS485_Wait(wait);				//ȴRS485յһ֡,10ms,յ
+		mb_input[0]=(u16)(OSTimeGet()/OS_TICKS_PER_SEC);
+		key=0;
+		if(key_owner==RS485_TASK_PRIO)
+		{
+			key=(u32)OSMboxAccept(msg_key);
+			usart_cmd();				//
+		}
 		if(key)
 		{
 			OSSemPend(sem_buf,0,&err);
@@ -448,16 +748,15 @@ void rs485_task(void *pdata)
 				printf("rs485->CAN\n\r");
 				clear_buffer();
 				OSSemPost(sem_buf);
-				OSTaskResume(CAN_TASK_PRIO);
-				OSTaskSuspend(RS485_TASK_PRIO);
+				key_owner=CAN_TASK_PRIO;
 			}
 			else if(key==WKUP_PRES)
 			{
 				printf("rs485->MAIN_CTRL\n\r");
 				clear_buffer();
 				OSSemPost(sem_buf);
+				key_owner=MAIN_TASK_PRIO;
 				OSTaskResume(MAIN_TASK_PRIO);
-				OSTaskSuspend(RS485_TASK_PRIO);
 			}
 			else
 			{
@@ -467,8 +766,11 @@ void rs485_task(void *pdata)
 		}
 
 		OSSemPend(sem_buf,0,&err);
+		key=0;
 		RS485_Receive_Data(buffer,(u8*)&key);
-		if(key==1)
+		if(key&&GATEWAY_Input(GW_BUS_RS485,0,0,buffer,key))key=0;	//ƥ·ɵ֡,ת
+		if(key&&MODBUS_Input(buffer,key))key=0;	//Modbus֡,Ѿ(վӦ)
+		if(key==1)									//Ϣ
 		{
 			printf("rs485 receive %d\n",buffer[0]);
 			switch(buffer[0])
@@ -500,33 +802,56 @@ void rs485_task(void *pdata)
 
 void can_task(void *pdata)
 {
-	u32 key=0;
+	u32 key=0,wait,t;
 	u8 err;
 	u8 res=0;
 	while(1)
 	{
-		key=(u32)OSMboxPend(msg_key,10,&err);
+		wait=ISOTP_Poll();			//ISO-TP֡/֡
+		t=FDCAN1_TxPoll();			//鷢ͳʱ
+		if(t<wait)wait=t;
+		t=FDCAN1_BusPoll();			//߹رջָ,ͳ
+		if(t<wait)wait=t;
+		co_uptime=OSTimeGet()/OS_TICKS_PER_SEC;
+		t=CANOPEN_Poll();			//CANopenTPDO
+		if(t<wait)wait=t;
+		t=GATEWAY_Poll(GW_BUS_CAN);	//Ͷʱµת֡
+		if(t<wait)wait=t;
+		FDCAN1_Wait(wait);			//ȴCANյһ֡,10ms,յ
+		res=can_key_status;
+		if(res!=CAN_KEY_IDLE)
+		{
+			can_key_status=CAN_KEY_IDLE;
+			if(res==FDCAN1_TX_TIMEOUT)printf("CAN Failed!\n");
+		}
+		key=0;
+		if(key_owner==CAN_TASK_PRIO)
+		{
+			key=(u32)OSMboxAccept(msg_key);
+			usart_cmd();				//
+		}
 		if(key)
 		{
 			OSSemPend(sem_buf,0,&err);
 			buffer[0]=key;
-			res=FDCAN1_Send_Msg(buffer,FDCAN_DLC_BYTES_8);
-			if(res) printf("CAN Failed!\n");
+			co_key=key;
+			co_tpdo_event(&co_node,0);		//ͬһٰһҲTPDO1
+			res=FDCAN1_Submit(0x12,0,buffer,8,CAN_KEY_TIMEOUT,can_key_done,NULL);	//ͬFDCAN1_Send_Msg,ͽcan_key_done
+			if(res) printf("CAN Failed!\n");	//Ͷ
 			if(key==KEY2_PRES)
 			{
 				printf("CAN->rs485\n\r");
 				clear_buffer();
 				OSSemPost(sem_buf);
-				OSTaskResume(RS485_TASK_PRIO);
-				OSTaskSuspend(CAN_TASK_PRIO);
+				key_owner=RS485_TASK_PRIO;
 			}
 			else if(key==WKUP_PRES)
 			{
 				printf("CAN->MAIN_CTRL\n\r");
 				clear_buffer();
 				OSSemPost(sem_buf);
+				key_owner=MAIN_TASK_PRIO;
 				OSTaskResume(MAIN_TASK_PRIO);
-				OSTaskSuspend(CAN_TASK_PRIO);
 			}
 			else
 			{
@@ -536,7 +861,16 @@ void can_task(void *pdata)
 		}
 		
 		OSSemPend(sem_buf,0,&err);
-		key=FDCAN1_Receive_Msg(buffer);
+		key=0;
+		while(FDCAN1_Read(&can_frame,0))
+		{
+			if(ISOTP_Input(&can_frame))continue;	//ISO-TP֡,Ѿ
+			if(CANOPEN_Input(&can_frame))continue;	//CANopen֡,Ѿ
+			if(GATEWAY_Input(GW_BUS_CAN,can_frame.id,can_frame.flags,can_frame.data,can_frame.len))continue;	//ƥ·ɵ֡,ת
+			memcpy(buffer,can_frame.data,can_frame.len);
+			key=can_frame.len;
+			break;
+		}
 		if(key)
 		{
 			printf("CAN receive %d\n",buffer[0]);